@@ -0,0 +1,109 @@
+#include "bench_harness.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+volatile uint64_t bench_sink = 0;
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int result_count = 0;
+
+static double now_ns(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double value_a = *(const double*)a;
+    double value_b = *(const double*)b;
+    return (value_a > value_b) - (value_a < value_b);
+}
+
+BenchConfig bench_parse_args(int argc, char** argv) {
+    BenchConfig config = {BENCH_DEFAULT_WARMUP, BENCH_DEFAULT_REPETITIONS, NULL, NULL, ""};
+    for (int i = 1; i < argc; i++) {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--warmup") == 0 && has_value) {
+            config.warmup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reps") == 0 && has_value) {
+            config.repetitions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && has_value) {
+            config.filter = argv[++i];
+        } else if (strcmp(argv[i], "--json") == 0 && has_value) {
+            config.json_path = argv[++i];
+        } else if (strcmp(argv[i], "--label") == 0 && has_value) {
+            config.label = argv[++i];
+        } else {
+            fprintf(stderr, "usage: %s [--warmup N] [--reps N] [--filter S] [--json PATH] [--label S]\n", argv[0]);
+            exit(2);
+        }
+    }
+    if (config.repetitions < 1) {
+        config.repetitions = 1;
+    }
+    printf("%-40s %10s %12s %12s %12s\n", "benchmark", "ops/batch", "median_ns", "p99_ns", "min_ns");
+    return config;
+}
+
+void bench_run(const BenchConfig* config, const char* name, int iterations, BenchFunction function, void* context) {
+    if ((config->filter && !strstr(name, config->filter)) || result_count == BENCH_MAX_RESULTS) {
+        return;
+    }
+    
+    for (int i = 0; i < config->warmup; i++) {
+        function(context, iterations);
+    }
+    
+    double* samples = malloc((size_t)config->repetitions * sizeof(double));
+    if (!samples) {
+        return;
+    }
+    double total = 0.0;
+    for (int rep = 0; rep < config->repetitions; rep++) {
+        double start = now_ns();
+        function(context, iterations);
+        samples[rep] = (now_ns() - start) / iterations;
+        total += samples[rep];
+    }
+    qsort(samples, (size_t)config->repetitions, sizeof(double), compare_doubles);
+    
+    BenchResult* result = &results[result_count++];
+    result->name = name;
+    result->iterations = iterations;
+    result->repetitions = config->repetitions;
+    result->median_ns = samples[config->repetitions / 2];
+    result->p99_ns = samples[(config->repetitions * 99) / 100];
+    result->min_ns = samples[0];
+    result->mean_ns = total / config->repetitions;
+    free(samples);
+    
+    printf("%-40s %10d %12.1f %12.1f %12.1f\n", name, iterations, result->median_ns, result->p99_ns, result->min_ns);
+}
+
+int bench_finish(const BenchConfig* config) {
+    if (!config->json_path) {
+        return 0;
+    }
+    FILE* file = fopen(config->json_path, "w");
+    if (!file) {
+        fprintf(stderr, "cannot write %s\n", config->json_path);
+        return 1;
+    }
+    
+    // Stable key order and one benchmark per line, so reports diff cleanly across commits
+    fprintf(file, "{\n  \"schema\": 1,\n  \"label\": \"%s\",\n  \"unit\": \"ns/op\",\n", config->label);
+    fprintf(file, "  \"warmup\": %d,\n  \"repetitions\": %d,\n  \"benchmarks\": [\n", config->warmup, config->repetitions);
+    for (int i = 0; i < result_count; i++) {
+        const BenchResult* result = &results[i];
+        fprintf(file, "    {\"name\": \"%s\", \"ops_per_batch\": %d, \"median\": %.2f, \"p99\": %.2f, \"min\": %.2f, \"mean\": %.2f}%s\n",
+                result->name, result->iterations, result->median_ns, result->p99_ns,
+                result->min_ns, result->mean_ns, i + 1 < result_count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    printf("wrote %s\n", config->json_path);
+    return 0;
+}
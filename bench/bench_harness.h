@@ -0,0 +1,43 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdint.h>
+
+// Microbenchmark harness: each benchmark is a function that runs `iterations`
+// operations. The harness runs warmup batches, then timed repetitions, and
+// reports per-operation nanoseconds (median, p99, min, mean) as a table and JSON.
+
+typedef void (*BenchFunction)(void* context, int iterations);
+
+typedef struct {
+    int warmup;                              // Untimed batches before measuring
+    int repetitions;                         // Timed batches
+    const char* filter;                      // Run only benchmarks whose name contains this
+    const char* json_path;                   // JSON report destination (NULL = none)
+    const char* label;                       // Free-form run label, e.g. a commit id
+} BenchConfig;
+
+typedef struct {
+    const char* name;
+    int iterations;                          // Operations per timed batch
+    int repetitions;
+    double median_ns;
+    double p99_ns;
+    double min_ns;
+    double mean_ns;
+} BenchResult;
+
+#define BENCH_MAX_RESULTS 64
+#define BENCH_DEFAULT_WARMUP 20
+#define BENCH_DEFAULT_REPETITIONS 200
+
+// Parses --warmup N, --reps N, --filter S, --json PATH, --label S
+BenchConfig bench_parse_args(int argc, char** argv);
+void bench_run(const BenchConfig* config, const char* name, int iterations, BenchFunction function, void* context);
+// Writes the JSON report (if requested); returns 0 on success
+int bench_finish(const BenchConfig* config);
+
+// Keeps results alive so the optimizer cannot drop benchmarked work
+extern volatile uint64_t bench_sink;
+
+#endif
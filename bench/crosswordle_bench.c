@@ -0,0 +1,314 @@
+// crosswordle_bench - microbenchmarks for the hot game-logic paths
+//
+// Usage: crosswordle_bench [--warmup N] [--reps N] [--filter S] [--json PATH] [--label S]
+//
+// Inputs are fixed (seeded RNG, built-in word lists, scripted keys), so the
+// JSON reports of two commits can be compared benchmark by benchmark.
+
+#include "systems.h"
+#include "crosswordle.h"
+#include "bench_harness.h"
+#include "render_snapshot.h"
+
+#define BENCH_SEED 20240531u
+
+static uint32_t bench_random_state = BENCH_SEED;
+
+static uint32_t bench_random(void) {
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 17;
+    bench_random_state ^= bench_random_state << 5;
+    return bench_random_state;
+}
+
+// ============= SCORING AND DICTIONARY =============
+
+#define WORD_SAMPLE_COUNT 1024
+
+typedef struct {
+    int word_length;
+    char guesses[WORD_SAMPLE_COUNT][MAX_WORD_LENGTH + 1];
+    char targets[WORD_SAMPLE_COUNT][MAX_WORD_LENGTH + 1];
+    PackedWord probes[WORD_SAMPLE_COUNT];    // Half dictionary words, half random
+} WordSamples;
+
+static void fill_word_samples(WordSamples* samples, int word_length) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    const WordKernels* kernels = get_word_kernels(word_length);
+    samples->word_length = word_length;
+    for (int i = 0; i < WORD_SAMPLE_COUNT; i++) {
+        kernels->unpack(dictionary->words[bench_random() % dictionary->count], samples->guesses[i]);
+        kernels->unpack(dictionary->words[bench_random() % dictionary->count], samples->targets[i]);
+        if (i % 2 == 0) {
+            samples->probes[i] = dictionary->words[bench_random() % dictionary->count];
+        } else {
+            char random_word[MAX_WORD_LENGTH + 1] = {0};
+            for (int c = 0; c < word_length; c++) {
+                random_word[c] = (char)('A' + bench_random() % 26);
+            }
+            samples->probes[i] = kernels->pack(random_word);
+        }
+    }
+}
+
+static void bench_calculate_letter_state(void* context, int iterations) {
+    const WordSamples* samples = context;
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        int s = i & (WORD_SAMPLE_COUNT - 1);
+        for (int c = 0; c < samples->word_length; c++) {
+            total += calculate_letter_state(samples->guesses[s][c], c, samples->targets[s]);
+        }
+    }
+    bench_sink += total;
+}
+
+static void bench_kernel_score_guess(void* context, int iterations) {
+    const WordSamples* samples = context;
+    const WordKernels* kernels = get_word_kernels(samples->word_length);
+    LetterState states[MAX_WORD_LENGTH];
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        int s = i & (WORD_SAMPLE_COUNT - 1);
+        kernels->score_guess(samples->guesses[s], samples->targets[s], states);
+        total += feedback_code(states, samples->word_length);
+    }
+    bench_sink += total;
+}
+
+static void bench_dictionary_find(void* context, int iterations) {
+    const WordSamples* samples = context;
+    const WordDictionary* dictionary = get_word_dictionary(samples->word_length);
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        total += (uint64_t)dictionary_find(dictionary, samples->probes[i & (WORD_SAMPLE_COUNT - 1)]);
+    }
+    bench_sink += total;
+}
+
+static void bench_is_dictionary_word(void* context, int iterations) {
+    const WordSamples* samples = context;
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        total += is_dictionary_word(samples->guesses[i & (WORD_SAMPLE_COUNT - 1)], samples->word_length);
+    }
+    bench_sink += total;
+}
+
+static void bench_get_word_for_level(void* context, int iterations) {
+    const WordSamples* samples = context;
+    char word[MAX_WORD_LENGTH + 1];
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        get_word_for_level(samples->word_length, 1 + (i & 31), word);
+        total += (uint64_t)word[0];
+    }
+    bench_sink += total;
+}
+
+// ============= PER-FRAME SYSTEMS =============
+
+typedef struct {
+    GameState template_state;                // Restored at the start of each batch
+    GameState state;
+} FrameContext;
+
+static GameState bench_wordle_state(void) {
+    GameState state = create_game_state("");
+    state.current_view = VIEW_WORDLE;
+    strcpy(state.core.target_word, "EAGLE");
+    
+    // A few completed guesses so layout and HUD have rows to account for
+    static const char* guesses[] = {"STARE", "CLOUD", "EAGER"};
+    for (int g = 0; g < 3; g++) {
+        strcpy(state.history.level_guesses[g], guesses[g]);
+        get_word_kernels(5)->score_guess(guesses[g], state.core.target_word, state.history.level_letter_states[g]);
+    }
+    state.history.level_guess_count = 3;
+    return state;
+}
+
+static void bench_session_state_pack(void* context, int iterations) {
+    FrameContext* frame = context;
+    SessionState session;
+    for (int i = 0; i < iterations; i++) {
+        session_state_pack(&frame->template_state, &session);
+        bench_sink += session.target;
+    }
+}
+
+static void bench_session_state_guess(void* context, int iterations) {
+    SessionState* session = context;
+    LetterState states[MAX_WORD_LENGTH];
+    for (int i = 0; i < iterations; i++) {
+        // A wrong guess every time; the history stops growing at MAX_RECENT_GUESSES
+        bench_sink += (uint64_t)session_state_guess(session, "STARE", states, 0);
+    }
+}
+
+static void bench_calculate_layout(void* context, int iterations) {
+    FrameContext* frame = context;
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        frame->template_state.system.camera_offset_y = (float)(i & 63);
+        LayoutConfig layout = calculate_layout(frame->template_state);
+        total += (uint64_t)(layout.board_start_y + layout.cell_size);
+    }
+    bench_sink += total;
+}
+
+static void bench_update_particles(void* context, int iterations) {
+    FrameContext* frame = context;
+    frame->state.ui = frame->template_state.ui;
+    for (int i = 0; i < iterations; i++) {
+        update_particles(&frame->state, 0.0001f);
+    }
+    bench_sink += (uint64_t)frame->state.ui.particle_count;
+}
+
+static void bench_animation_update_system(void* context, int iterations) {
+    FrameContext* frame = context;
+    frame->state = frame->template_state;
+    for (int i = 0; i < iterations; i++) {
+        frame->state = animation_update_system(frame->state);
+    }
+    bench_sink += (uint64_t)frame->state.ui.particle_count;
+}
+
+static void bench_hud_update_system(void* context, int iterations) {
+    FrameContext* frame = context;
+    frame->state = frame->template_state;
+    for (int i = 0; i < iterations; i++) {
+        frame->state = hud_update_system(frame->state);
+    }
+    bench_sink += (uint64_t)frame->state.ui.hud.level_title[0];
+}
+
+static void bench_crossword_word_validation(void* context, int iterations) {
+    FrameContext* frame = context;
+    uint64_t total = 0;
+    for (int i = 0; i < iterations; i++) {
+        // Same filled word every time: the result is discarded, not fed back
+        GameState result = crossword_word_validation_system(frame->template_state);
+        total += (uint64_t)result.crossword.current_word_index + result.crossword.letter_states[1][0];
+    }
+    bench_sink += total;
+}
+
+// ============= FULL HEADLESS TICK =============
+
+typedef struct {
+    GameState state;
+    int frame;
+    int guess;
+} TickContext;
+
+// Scripted player: types a guess every 8 frames (every third guess is the
+// answer) and continues with Space once a level is solved
+static GameInput script_input(TickContext* tick) {
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    int slot = tick->frame & 7;
+    if (tick->state.core.play_state == GAME_STATE_LEVEL_COMPLETE) {
+        crosswordle_input_press(&input, GAME_KEY_SPACE);
+    } else if (tick->state.core.play_state == GAME_STATE_INPUT && slot < tick->state.core.word_length) {
+        const char* word = (tick->guess % 3 == 2) ? tick->state.core.target_word : "STARE";
+        crosswordle_input_press(&input, GAME_KEY_A + (word[slot] - 'A'));
+    } else if (tick->state.core.play_state == GAME_STATE_INPUT && slot == 7) {
+        crosswordle_input_press(&input, GAME_KEY_ENTER);
+        tick->guess++;
+    }
+    tick->frame++;
+    return input;
+}
+
+static void bench_headless_tick(void* context, int iterations) {
+    TickContext* tick = context;
+    for (int i = 0; i < iterations; i++) {
+        GameInput input = script_input(tick);
+        tick->state = game_tick(tick->state, &input);
+    }
+    bench_sink += (uint64_t)tick->state.core.current_level;
+}
+
+// ============= RENDER SNAPSHOTS =============
+
+typedef struct {
+    RenderSnapshotBuffer buffer;
+    GameState state;
+} SnapshotContext;
+
+// Update thread's publish plus the window thread's acquire, one frame apiece
+static void bench_render_snapshot_handover(void* context, int iterations) {
+    SnapshotContext* snapshots = context;
+    for (int i = 0; i < iterations; i++) {
+        snapshots->state.system.latency_mark_count = 1;
+        render_snapshot_publish(&snapshots->buffer, &snapshots->state);
+        bench_sink += render_snapshot_acquire(&snapshots->buffer)->sequence;
+    }
+}
+
+int main(int argc, char** argv) {
+    BenchConfig config = bench_parse_args(argc, argv);
+    srand(BENCH_SEED);
+    
+    static WordSamples samples[WORD_LENGTH_MODE_COUNT];
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        fill_word_samples(&samples[length - MIN_WORD_LENGTH], length);
+    }
+    WordSamples* five = &samples[DEFAULT_WORD_LENGTH - MIN_WORD_LENGTH];
+    
+    static const char* SCORE_NAMES[] = {"score.kernel_score_guess.4", "score.kernel_score_guess.5",
+                                        "score.kernel_score_guess.6", "score.kernel_score_guess.7"};
+    bench_run(&config, "score.calculate_letter_state.5", 10000, bench_calculate_letter_state, five);
+    for (int i = 0; i < WORD_LENGTH_MODE_COUNT; i++) {
+        bench_run(&config, SCORE_NAMES[i], 10000, bench_kernel_score_guess, &samples[i]);
+    }
+    bench_run(&config, "dictionary.find.5", 10000, bench_dictionary_find, five);
+    bench_run(&config, "dictionary.is_dictionary_word.5", 10000, bench_is_dictionary_word, five);
+    bench_run(&config, "words.get_word_for_level.5", 10000, bench_get_word_for_level, five);
+    
+    static FrameContext frame;
+    frame.template_state = bench_wordle_state();
+    bench_run(&config, "layout.calculate_layout", 10000, bench_calculate_layout, &frame);
+    bench_run(&config, "session.session_state_pack", 1000, bench_session_state_pack, &frame);
+    
+    static SessionState session;
+    session_state_init(&session, DEFAULT_WORD_LENGTH, "EAGLE");
+    bench_run(&config, "session.session_state_guess", 10000, bench_session_state_guess, &session);
+    
+    frame.template_state = bench_wordle_state();
+    spawn_particles(&frame.template_state, (Vector2){400.0f, 300.0f}, WORDLE_GREEN, 50);
+    bench_run(&config, "particles.update_particles.50", 1000, bench_update_particles, &frame);
+    
+    frame.template_state.system.frame_time = 0.00001;
+    trigger_word_celebration(&frame.template_state);
+    trigger_level_celebration(&frame.template_state);
+    trigger_letter_ease(&frame.template_state);
+    frame.template_state.ui.letter_revealing = 1;
+    bench_run(&config, "animation.animation_update_system", 1000, bench_animation_update_system, &frame);
+    
+    frame.template_state = hud_update_system(bench_wordle_state());
+    bench_run(&config, "hud.hud_update_system.steady", 1000, bench_hud_update_system, &frame);
+    
+    frame.template_state = create_game_state("");
+    frame.template_state.current_view = VIEW_CROSSWORD;
+    for (int i = 0; i < 5; i++) {
+        crossword_set_cell(&frame.template_state.crossword, 1 + i, 0, "SWORD"[i]);
+    }
+    frame.template_state.crossword.should_validate = 1;
+    bench_run(&config, "crossword.word_validation_system", 1000, bench_crossword_word_validation, &frame);
+    
+    static TickContext tick;
+    tick.state = create_game_state("");
+    GameInput start = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    crosswordle_input_press(&start, GAME_KEY_ENTER);
+    tick.state = game_tick(tick.state, &start);
+    bench_run(&config, "tick.headless_frame", 1000, bench_headless_tick, &tick);
+    
+    static SnapshotContext snapshots;
+    snapshots.state = tick.state;
+    render_snapshot_init(&snapshots.buffer, &snapshots.state);
+    bench_run(&config, "snapshot.publish_acquire", 1000, bench_render_snapshot_handover, &snapshots);
+    
+    return bench_finish(&config);
+}
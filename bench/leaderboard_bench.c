@@ -0,0 +1,101 @@
+// leaderboard_bench - grows a leaderboard store to 1,000,000 records
+//
+// Records go through the batched writer thread in random key order across a
+// few thousand boards. At each size the store is closed and reopened (header
+// and leaf index only), then top-10 queries and single submit+flush inserts
+// are timed. Query and insert cost should grow with log n, not with n.
+
+#include "leaderboard.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_PROFILES 512
+#define QUERIES_PER_SIZE 10000
+#define SINGLE_INSERTS_PER_SIZE 200
+#define REOPENS_PER_SIZE 20
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static uint32_t random_board(void) {
+    return leaderboard_board((uint32_t)(rand() % BENCH_PROFILES),
+                             (LeaderboardMode)(rand() % LEADERBOARD_MODE_COUNT),
+                             (LeaderboardMetric)(rand() % LEADERBOARD_METRIC_COUNT));
+}
+
+static LeaderboardRecord random_record(void) {
+    LeaderboardRecord record = {0};
+    record.board = random_board();
+    record.value = (uint32_t)(rand() % 100000);
+    record.level = (uint16_t)(rand() % 1000 + 1);
+    record.word_length = 5;
+    record.recorded_at = 1;
+    return record;
+}
+
+int main(void) {
+    static const int sizes[] = {10000, 100000, 1000000};
+    const char* path = "leaderboard_bench.cwlb";
+    srand(12345);
+    remove(path);
+    if (!leaderboard_open(path)) {
+        fprintf(stderr, "failed to open %s\n", path);
+        return 1;
+    }
+
+    printf("%10s %14s %12s %12s %16s\n", "records", "inserts_per_s", "reopen_us", "top10_us", "insert_flush_us");
+    int inserted = 0;
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int batch_count = sizes[s] - inserted;
+        double start = now_seconds();
+        for (; inserted < sizes[s]; inserted++) {
+            leaderboard_submit(random_record());
+        }
+        leaderboard_flush();
+        double batch_seconds = now_seconds() - start;
+
+        double reopen_total = 0.0;
+        for (int run = 0; run < REOPENS_PER_SIZE; run++) {
+            leaderboard_close();
+            double opened = now_seconds();
+            if (!leaderboard_open(path)) {
+                fprintf(stderr, "failed to reopen %s\n", path);
+                return 1;
+            }
+            reopen_total += now_seconds() - opened;
+        }
+
+        LeaderboardRecord top[10];
+        int found = 0;
+        start = now_seconds();
+        for (int q = 0; q < QUERIES_PER_SIZE; q++) {
+            found += leaderboard_top(random_board(), top, 10);
+        }
+        double query_seconds = now_seconds() - start;
+
+        start = now_seconds();
+        for (int i = 0; i < SINGLE_INSERTS_PER_SIZE; i++) {
+            leaderboard_submit(random_record());
+            leaderboard_flush();
+        }
+        double single_seconds = now_seconds() - start;
+        inserted += SINGLE_INSERTS_PER_SIZE;
+
+        printf("%10llu %14.0f %12.1f %12.2f %16.2f\n", (unsigned long long)leaderboard_record_count(),
+               batch_count / batch_seconds, reopen_total * 1e6 / REOPENS_PER_SIZE,
+               query_seconds * 1e6 / QUERIES_PER_SIZE, single_seconds * 1e6 / SINGLE_INSERTS_PER_SIZE);
+        if (found == 0) {
+            fprintf(stderr, "top-10 queries found no records\n");
+            return 1;
+        }
+    }
+
+    leaderboard_close();
+    remove(path);
+    return 0;
+}
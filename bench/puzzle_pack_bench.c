@@ -0,0 +1,91 @@
+// puzzle_pack_bench - times loading from a pack of 10,000 crosswords
+//
+// The pack holds the daily crosswords of 10,000 days, each with a clue per
+// word. Opening is timed cold from the writer's file, then puzzles are
+// decoded into CrosswordLevels in order and at random. Opening should not
+// grow with the pack, and a level should cost well under a microsecond.
+
+#include "systems.h"
+#include "puzzle_pack.h"
+
+#include <time.h>
+
+#define BENCH_PUZZLES 10000
+#define BENCH_OPENS 1000
+#define BENCH_RANDOM_LOADS 1000000
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static long file_size(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+int main(void) {
+    const char* path = "puzzle_pack_bench.cwpk";
+    static PuzzleSource puzzles[BENCH_PUZZLES];
+    static const char* const clues[] = {"First across", "First down", "Second across", "Second down"};
+    for (int i = 0; i < BENCH_PUZZLES; i++) {
+        puzzles[i].level = get_daily_crossword_level(i);
+        for (int w = 0; w < puzzles[i].level.word_count && w < 4; w++) {
+            puzzles[i].clues[w] = clues[w];
+        }
+    }
+
+    double start = now_seconds();
+    if (!puzzle_pack_write(path, puzzles, BENCH_PUZZLES)) {
+        fprintf(stderr, "failed to write %s\n", path);
+        return 1;
+    }
+    double write_seconds = now_seconds() - start;
+
+    start = now_seconds();
+    for (int run = 0; run < BENCH_OPENS; run++) {
+        if (!load_puzzle_pack(path)) {
+            fprintf(stderr, "failed to open %s\n", path);
+            return 1;
+        }
+    }
+    double open_seconds = (now_seconds() - start) / BENCH_OPENS;
+
+    // Every puzzle once, in order, checked against its source
+    CrosswordLevel level;
+    int mismatches = 0;
+    start = now_seconds();
+    for (int i = 0; i < BENCH_PUZZLES; i++) {
+        mismatches += !puzzle_pack_level(i, &level) ||
+                      memcmp(level.words, puzzles[i].level.words, sizeof(level.words)) != 0;
+    }
+    double sequential_seconds = now_seconds() - start;
+
+    srand(49);
+    uint64_t checksum = 0;
+    start = now_seconds();
+    for (int n = 0; n < BENCH_RANDOM_LOADS; n++) {
+        if (puzzle_pack_level(rand() % BENCH_PUZZLES, &level)) {
+            checksum += (uint64_t)level.solution[level.words[0].start_x][level.words[0].start_y];
+        }
+    }
+    double random_seconds = now_seconds() - start;
+
+    printf("%d puzzles, %ld bytes (%.1f per puzzle), written in %.1f ms\n", BENCH_PUZZLES, file_size(path),
+           (double)file_size(path) / BENCH_PUZZLES, write_seconds * 1000.0);
+    printf("%12s %16s %16s %10s\n", "open_us", "sequential_ns", "random_ns", "mismatches");
+    printf("%12.2f %16.1f %16.1f %10d\n", open_seconds * 1e6, sequential_seconds * 1e9 / BENCH_PUZZLES,
+           random_seconds * 1e9 / BENCH_RANDOM_LOADS, mismatches);
+    printf("checksum %llu\n", (unsigned long long)checksum);
+
+    unload_puzzle_pack();
+    remove(path);
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,290 @@
+// server_loadgen - load generator for crosswordle_server
+//
+// Usage:
+//   server_loadgen --socket PATH [--connections N] [--sessions N] [--guesses N] [--window N]
+//   server_loadgen --script N [--sessions N] | crosswordle_server > /dev/null
+//
+// Socket mode opens N connections, each owning its own sessions, and keeps up
+// to --window guesses in flight per connection (at most one per session, so
+// feedback is never stale). Solved sessions move on with NEXT. Reports
+// guesses/s and exits nonzero if the server answered any request with ERR.
+// Script mode prints a request stream for the server's stdin mode instead.
+
+#include "systems.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LOADGEN_MAX_CONNECTIONS 256
+#define LOADGEN_READ_CHUNK 65536
+#define LOADGEN_LINE_SIZE 64
+
+typedef struct {
+    const char* socket_path;
+    int connections;
+    int sessions;                     // Per connection
+    uint64_t guesses;                 // Total across connections
+    uint64_t guesses_per_connection;
+    int window;
+} LoadgenConfig;
+
+typedef struct {
+    const LoadgenConfig* config;
+    int index;
+    uint64_t guesses_done;
+    uint64_t levels_solved;
+    uint64_t errors;
+    int failed;
+} LoadgenConnection;
+
+static const WordDictionary* loadgen_dictionary;
+
+static double loadgen_clock_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+static uint32_t loadgen_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// Appends "<command> <session>[ <word>]\n"; returns the new length
+static int append_request(char* buffer, int length, const char* command, uint64_t session, const char* word) {
+    length += sprintf(&buffer[length], "%s %llu", command, (unsigned long long)session);
+    if (word) {
+        length += sprintf(&buffer[length], " %s", word);
+    }
+    buffer[length++] = '\n';
+    return length;
+}
+
+static void random_guess(uint32_t* rng, char* out_word) {
+    int index = (int)(loadgen_random(rng) % (uint32_t)loadgen_dictionary->count);
+    get_word_kernels(loadgen_dictionary->word_length)->unpack(loadgen_dictionary->words[index], out_word);
+}
+
+static int write_all(int fd, const char* buffer, int length) {
+    while (length > 0) {
+        ssize_t written = write(fd, buffer, (size_t)length);
+        if (written <= 0) {
+            return 0;
+        }
+        buffer += written;
+        length -= (int)written;
+    }
+    return 1;
+}
+
+static void* connection_main(void* arg) {
+    LoadgenConnection* connection = arg;
+    const LoadgenConfig* config = connection->config;
+    int sessions = config->sessions;
+    uint64_t base = (uint64_t)connection->index * (uint64_t)sessions + 1;
+    uint32_t rng = 0x9E3779B9u ^ (uint32_t)(connection->index + 1) * 2654435761u;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un address = {0};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, config->socket_path, sizeof(address.sun_path) - 1);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        connection->failed = 1;
+        return NULL;
+    }
+
+    // busy[i]: session i has a request in flight; needs_next[i]: it was solved
+    uint8_t* busy = calloc((size_t)sessions, 1);
+    uint8_t* needs_next = calloc((size_t)sessions, 1);
+    char* out = malloc((size_t)(sessions + config->window + 1) * LOADGEN_LINE_SIZE);
+    char* in = malloc(LOADGEN_READ_CHUNK + LOADGEN_LINE_SIZE);
+    if (!busy || !needs_next || !out || !in) {
+        connection->failed = 1;
+        goto done;
+    }
+
+    // Create every session up front
+    int out_length = 0;
+    for (int i = 0; i < sessions; i++) {
+        out_length = append_request(out, out_length, "NEW", base + (uint64_t)i, NULL);
+        busy[i] = 1;
+    }
+    int outstanding = sessions;
+    if (!write_all(fd, out, out_length)) {
+        connection->failed = 1;
+        goto done;
+    }
+
+    uint64_t guesses_sent = 0;
+    int next_session = 0;
+    int in_length = 0;
+    while (connection->guesses_done < config->guesses_per_connection) {
+        // Top up the window, round-robin over idle sessions
+        out_length = 0;
+        for (int scanned = 0; scanned < sessions && outstanding < config->window; scanned++) {
+            int i = next_session;
+            next_session = (next_session + 1) % sessions;
+            if (busy[i]) {
+                continue;
+            }
+            if (needs_next[i]) {
+                out_length = append_request(out, out_length, "NEXT", base + (uint64_t)i, NULL);
+                needs_next[i] = 0;
+            } else if (guesses_sent < config->guesses_per_connection) {
+                char word[MAX_WORD_LENGTH + 1];
+                random_guess(&rng, word);
+                out_length = append_request(out, out_length, "GUESS", base + (uint64_t)i, word);
+                guesses_sent++;
+            } else {
+                continue;
+            }
+            busy[i] = 1;
+            outstanding++;
+        }
+        if (out_length > 0 && !write_all(fd, out, out_length)) {
+            connection->failed = 1;
+            break;
+        }
+
+        ssize_t received = read(fd, &in[in_length], LOADGEN_READ_CHUNK);
+        if (received <= 0) {
+            connection->failed = 1;
+            break;
+        }
+        in_length += (int)received;
+
+        int line_start = 0;
+        for (int pos = 0; pos < in_length; pos++) {
+            if (in[pos] != '\n') {
+                continue;
+            }
+            char* line = &in[line_start];
+            in[pos] = '\0';
+            line_start = pos + 1;
+
+            char kind[8] = {0};
+            unsigned long long session = 0;
+            if (sscanf(line, "%7s %llu", kind, &session) != 2 || session < base || session >= base + (uint64_t)sessions) {
+                connection->errors++;
+                continue;
+            }
+            int i = (int)(session - base);
+            busy[i] = 0;
+            outstanding--;
+            if (strcmp(kind, "FB") == 0) {
+                connection->guesses_done++;
+                if (in[pos - 1] == '1') {              // Trailing <solved> field
+                    needs_next[i] = 1;
+                    connection->levels_solved++;
+                }
+            } else if (strcmp(kind, "ERR") == 0) {
+                connection->errors++;
+            }
+        }
+        memmove(in, &in[line_start], (size_t)(in_length - line_start));
+        in_length -= line_start;
+    }
+
+    // Free the sessions on the server; their answers are not waited for
+    out_length = 0;
+    for (int i = 0; i < sessions; i++) {
+        out_length = append_request(out, out_length, "END", base + (uint64_t)i, NULL);
+    }
+    write_all(fd, out, out_length);
+
+done:
+    close(fd);
+    free(busy);
+    free(needs_next);
+    free(out);
+    free(in);
+    return NULL;
+}
+
+// Prints NEW for every session, then guesses round-robin (stdin mode has no
+// feedback loop, so solved sessions answer ERR SOLVED until the stream ends)
+static int write_script(uint64_t request_count, int sessions) {
+    uint32_t rng = 0x9E3779B9u;
+    for (int i = 0; i < sessions; i++) {
+        printf("NEW %d\n", i + 1);
+    }
+    for (uint64_t r = 0; r < request_count; r++) {
+        char word[MAX_WORD_LENGTH + 1];
+        random_guess(&rng, word);
+        printf("GUESS %llu %s\n", (unsigned long long)(r % (uint64_t)sessions) + 1, word);
+    }
+    printf("STATS\n");
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    LoadgenConfig config = {NULL, 8, 1000, 1000000, 0, 256};
+    uint64_t script_requests = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            config.socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--connections") == 0 && i + 1 < argc) {
+            config.connections = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sessions") == 0 && i + 1 < argc) {
+            config.sessions = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--guesses") == 0 && i + 1 < argc) {
+            config.guesses = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+            config.window = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+            script_requests = strtoull(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "usage: server_loadgen --socket PATH [--connections N] [--sessions N] [--guesses N] [--window N]\n"
+                            "       server_loadgen --script N [--sessions N]\n");
+            return 2;
+        }
+    }
+    if (config.sessions < 1) config.sessions = 1;
+    if (config.window < 1) config.window = 1;
+    if (config.window > config.sessions) config.window = config.sessions;
+    if (config.connections < 1) config.connections = 1;
+    if (config.connections > LOADGEN_MAX_CONNECTIONS) config.connections = LOADGEN_MAX_CONNECTIONS;
+    config.guesses_per_connection = (config.guesses + (uint64_t)config.connections - 1) / (uint64_t)config.connections;
+
+    loadgen_dictionary = get_word_dictionary(DEFAULT_WORD_LENGTH);
+    if (script_requests > 0) {
+        return write_script(script_requests, config.sessions);
+    }
+    if (!config.socket_path) {
+        fprintf(stderr, "server_loadgen: --socket or --script is required\n");
+        return 2;
+    }
+
+    static LoadgenConnection connections[LOADGEN_MAX_CONNECTIONS];
+    static pthread_t threads[LOADGEN_MAX_CONNECTIONS];
+    double start = loadgen_clock_seconds();
+    for (int i = 0; i < config.connections; i++) {
+        connections[i].config = &config;
+        connections[i].index = i;
+        pthread_create(&threads[i], NULL, connection_main, &connections[i]);
+    }
+
+    uint64_t guesses = 0, solved = 0, errors = 0;
+    int failed = 0;
+    for (int i = 0; i < config.connections; i++) {
+        pthread_join(threads[i], NULL);
+        guesses += connections[i].guesses_done;
+        solved += connections[i].levels_solved;
+        errors += connections[i].errors;
+        failed += connections[i].failed;
+    }
+    double elapsed = loadgen_clock_seconds() - start;
+
+    printf("server_loadgen: %d connections x %d sessions, window %d\n", config.connections, config.sessions, config.window);
+    printf("server_loadgen: %llu guesses in %.3f s = %.0f guesses/s (%llu levels solved, %llu errors, %d failed connections)\n",
+           (unsigned long long)guesses, elapsed, elapsed > 0.0 ? (double)guesses / elapsed : 0.0,
+           (unsigned long long)solved, (unsigned long long)errors, failed);
+    return (errors > 0 || failed > 0) ? 1 : 0;
+}
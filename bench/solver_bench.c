@@ -0,0 +1,290 @@
+// solver_bench - times the crossword fill counter on 15x15 grids
+//
+// The grid has blocks on row 5 and columns 3 and 8 (68 slots of 3 to 9
+// letters). Its letters are random, and each length's word list holds the
+// grid's own words plus a growing number of random decoys. The decoys first
+// make the search harder and then admit second fills. Each size is counted
+// inline and again with the job system's workers splitting the root branches,
+// then once more within a node budget, as an interactive caller would.
+//
+// Past a few hundred decoys a node strikes most of several domains, and at a
+// thousand decoys the full count takes two to three seconds; the budgeted
+// count gives up with "unknown" after about a fifth of that.
+//
+// Given a word list (one word per line), the bench also fills a sparse
+// lattice of 9- and 5-letter words from it and counts that fill against the
+// whole list, then searches a dense lattice and the 68-slot grid above within
+// node budgets, which gives the cost of a node at that list size.
+//
+// Usage: solver_bench [word_list.txt]
+
+#include "crossword_solver.h"
+#include "jobs.h"
+#include "worddb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_GRID 15
+#define BENCH_LENGTHS 16
+#define BENCH_MAX_WORDS 4096
+#define BENCH_RUNS 5
+#define BENCH_NODE_BUDGET 1000
+#define BENCH_FILL_BUDGET 100000              // Nodes spent on a lattice
+
+static PackedWord words[BENCH_LENGTHS][BENCH_MAX_WORDS];
+static int word_counts[BENCH_LENGTHS];
+static PackedWord* list_words[BENCH_LENGTHS];
+static int list_counts[BENCH_LENGTHS];
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static int compare_packed(const void* a, const void* b) {
+    PackedWord left = *(const PackedWord*)a;
+    PackedWord right = *(const PackedWord*)b;
+    return (left > right) - (left < right);
+}
+
+static void add_word(const char* text, int length) {
+    if (word_counts[length] < BENCH_MAX_WORDS) {
+        words[length][word_counts[length]++] = word_db_pack_word(text, length);
+    }
+}
+
+// Counts the pattern BENCH_RUNS times; returns the mean seconds per count
+static double time_count(const CrosswordSolver* solver, const CrosswordPattern* pattern, CrosswordSolveResult* result) {
+    double start = now_seconds();
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        crossword_solver_count(solver, pattern, CROSSWORD_SOLVER_MAX_FILLS, result);
+    }
+    return (now_seconds() - start) / BENCH_RUNS;
+}
+
+// Sorts a length's words and drops repeats; returns how many are left
+static int sort_unique(PackedWord* list, int count) {
+    qsort(list, (size_t)count, sizeof(PackedWord), compare_packed);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || list[unique - 1] != list[i]) {
+            list[unique++] = list[i];
+        }
+    }
+    return unique;
+}
+
+// Reads the words of 2 to 15 letters A-Z (any case) from a word list
+static int read_word_list(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 0;
+    }
+    int capacities[BENCH_LENGTHS] = {0};
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char text[BENCH_GRID + 2];
+        int length = 0;
+        for (const char* c = line; *c && *c != '\n' && *c != '\r'; c++) {
+            int upper = *c >= 'a' && *c <= 'z' ? *c - 'a' + 'A' : *c;
+            if (upper < 'A' || upper > 'Z' || length > BENCH_GRID) {
+                length = 0;
+                break;
+            }
+            text[length++] = (char)upper;
+        }
+        if (length < 2 || length > BENCH_GRID) {
+            continue;
+        }
+        text[length] = '\0';
+        if (list_counts[length] == capacities[length]) {
+            capacities[length] = capacities[length] ? capacities[length] * 2 : 1024;
+            PackedWord* grown = realloc(list_words[length], sizeof(PackedWord) * (size_t)capacities[length]);
+            if (!grown) {
+                fclose(file);
+                return 0;
+            }
+            list_words[length] = grown;
+        }
+        list_words[length][list_counts[length]++] = word_db_pack_word(text, length);
+    }
+    fclose(file);
+    for (int length = 0; length < BENCH_LENGTHS; length++) {
+        list_counts[length] = sort_unique(list_words[length], list_counts[length]);
+    }
+    return 1;
+}
+
+// Counts a pattern within a node budget and prints the cost of a node
+static void time_nodes(const CrosswordSolver* solver, const CrosswordPattern* pattern, uint64_t budget) {
+    CrosswordSolveResult result;
+    double start = now_seconds();
+    int count = crossword_solver_count_within(solver, pattern, CROSSWORD_SOLVER_MAX_FILLS, budget, &result);
+    double seconds = now_seconds() - start;
+    char count_text[16];
+    if (count == CROSSWORD_SOLVER_UNKNOWN) {
+        snprintf(count_text, sizeof(count_text), "unknown");
+    } else {
+        snprintf(count_text, sizeof(count_text), "%d", count);
+    }
+    printf("%d slots within %llu nodes: %s fills, %llu nodes, %.2f ms, %.2f us per node\n", pattern->slot_count,
+           (unsigned long long)budget, count_text, (unsigned long long)result.nodes, seconds * 1000.0,
+           result.nodes > 0 ? seconds * 1e6 / (double)result.nodes : 0.0);
+}
+
+// Fills a sparse lattice from the word list and counts it against the whole
+// list, then times nodes on a dense lattice and on the 68-slot grid
+static int time_word_list(const char* path, const CrosswordPattern* grid) {
+    if (!read_word_list(path)) {
+        return 1;
+    }
+    WordDictionary dictionaries[BENCH_LENGTHS];
+    const WordDictionary* lists[BENCH_LENGTHS];
+    int list_count = 0;
+    int total = 0;
+    for (int length = 0; length < BENCH_LENGTHS; length++) {
+        if (list_counts[length] > 0) {
+            dictionaries[list_count] = (WordDictionary){length, list_counts[length], list_words[length], NULL, NULL};
+            lists[list_count] = &dictionaries[list_count];
+            list_count++;
+            total += list_counts[length];
+        }
+    }
+    CrosswordSolver* solver = crossword_solver_create(lists, list_count);
+    if (!solver) {
+        fprintf(stderr, "failed to build the solver\n");
+        return 1;
+    }
+    printf("\n%s: %d words, %d of 5 letters, %d of 9\n", path, total, list_counts[5], list_counts[9]);
+
+    // Sparse: every fourth row and column. Dense: every other one. Both are
+    // cut into runs of 9 and 5 letters.
+    uint8_t sparse_mask[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID] = {{0}};
+    uint8_t dense_mask[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID] = {{0}};
+    for (int x = 0; x < BENCH_GRID; x++) {
+        for (int y = 0; y < BENCH_GRID; y++) {
+            sparse_mask[x][y] = (y % 4 == 0 && x != 9) || (x % 4 == 0 && y != 9);
+            dense_mask[x][y] = (y % 2 == 0 && x != 9) || (x % 2 == 0 && y != 5);
+        }
+    }
+    CrosswordPattern sparse;
+    CrosswordPattern dense;
+    crossword_pattern_from_mask(BENCH_GRID, BENCH_GRID, sparse_mask, &sparse);
+    crossword_pattern_from_mask(BENCH_GRID, BENCH_GRID, dense_mask, &dense);
+
+    CrosswordSolveResult result;
+    double start = now_seconds();
+    int found = crossword_solver_count_within(solver, &sparse, 1, BENCH_FILL_BUDGET, &result);
+    printf("%d slots: fill %s in %.2f ms, %llu nodes\n", sparse.slot_count, found == 1 ? "found" : "not found",
+           (now_seconds() - start) * 1000.0, (unsigned long long)result.nodes);
+    if (found == 1) {
+        for (int s = 0; s < sparse.slot_count; s++) {
+            if (sparse.slots[s].direction == 0 && sparse.slots[s].start_x == 0) {
+                char text[BENCH_GRID + 1] = {0};
+                PackedWord word = result.fills[0][s];
+                for (int p = sparse.slots[s].length - 1; p >= 0; p--, word >>= PACKED_LETTER_BITS) {
+                    text[p] = (char)('A' - 1 + (int)(word & PACKED_LETTER_MASK));
+                }
+                printf("  %s\n", text);
+            }
+        }
+        double seconds = time_count(solver, &sparse, &result);
+        printf("%d slots: %d fills, %llu nodes, %.2f ms\n", sparse.slot_count, result.fill_count,
+               (unsigned long long)result.nodes, seconds * 1000.0);
+    }
+    time_nodes(solver, &dense, BENCH_FILL_BUDGET);
+    time_nodes(solver, grid, BENCH_NODE_BUDGET);
+
+    crossword_solver_destroy(solver);
+    for (int length = 0; length < BENCH_LENGTHS; length++) {
+        free(list_words[length]);
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    static const int decoy_counts[] = {0, 200, 400, 600, 800, 1000};
+    uint8_t mask[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID] = {{0}};
+    char letters[BENCH_GRID][BENCH_GRID];
+    srand(48);
+    for (int x = 0; x < BENCH_GRID; x++) {
+        for (int y = 0; y < BENCH_GRID; y++) {
+            mask[x][y] = y != 5 && x != 3 && x != 8;
+            letters[x][y] = (char)('A' + rand() % 26);
+        }
+    }
+    CrosswordPattern pattern;
+    if (!crossword_pattern_from_mask(BENCH_GRID, BENCH_GRID, mask, &pattern)) {
+        fprintf(stderr, "bad mask\n");
+        return 1;
+    }
+
+    int workers = jobs_init(0);
+    printf("%d slots, %d workers\n", pattern.slot_count, workers);
+    jobs_shutdown();
+    printf("%8s %6s %10s %12s %12s %10s %12s\n", "decoys", "fills", "nodes", "inline_ms", "jobs_ms",
+           "budgeted", "budget_ms");
+    for (size_t d = 0; d < sizeof(decoy_counts) / sizeof(decoy_counts[0]); d++) {
+        memset(word_counts, 0, sizeof(word_counts));
+        for (int s = 0; s < pattern.slot_count; s++) {
+            const CrosswordWord* slot = &pattern.slots[s];
+            char text[BENCH_GRID + 1] = {0};
+            for (int p = 0; p < slot->length; p++) {
+                text[p] = letters[slot->start_x + (slot->direction == 0 ? p : 0)][slot->start_y + (slot->direction == 0 ? 0 : p)];
+            }
+            add_word(text, slot->length);
+        }
+
+        WordDictionary dictionaries[BENCH_LENGTHS];
+        const WordDictionary* lists[BENCH_LENGTHS];
+        int list_count = 0;
+        for (int length = 0; length < BENCH_LENGTHS; length++) {
+            if (word_counts[length] == 0) {
+                continue;
+            }
+            for (int i = 0; i < decoy_counts[d]; i++) {
+                char text[BENCH_GRID + 1] = {0};
+                for (int p = 0; p < length; p++) {
+                    text[p] = (char)('A' + rand() % 26);
+                }
+                add_word(text, length);
+            }
+            int unique = sort_unique(words[length], word_counts[length]);
+            dictionaries[list_count] = (WordDictionary){length, unique, words[length], NULL, NULL};
+            lists[list_count] = &dictionaries[list_count];
+            list_count++;
+        }
+
+        CrosswordSolver* solver = crossword_solver_create(lists, list_count);
+        if (!solver) {
+            fprintf(stderr, "failed to build the solver\n");
+            return 1;
+        }
+        CrosswordSolveResult result;
+        double inline_seconds = time_count(solver, &pattern, &result);
+        jobs_init(0);
+        double jobs_seconds = time_count(solver, &pattern, &result);
+        jobs_shutdown();
+        CrosswordSolveResult budgeted;
+        double budget_start = now_seconds();
+        int budgeted_count = crossword_solver_count_within(solver, &pattern, CROSSWORD_SOLVER_MAX_FILLS,
+                                                           BENCH_NODE_BUDGET, &budgeted);
+        double budget_seconds = now_seconds() - budget_start;
+        char budgeted_text[16];
+        if (budgeted_count == CROSSWORD_SOLVER_UNKNOWN) {
+            snprintf(budgeted_text, sizeof(budgeted_text), "unknown");
+        } else {
+            snprintf(budgeted_text, sizeof(budgeted_text), "%d", budgeted_count);
+        }
+        printf("%8d %6d %10llu %12.2f %12.2f %10s %12.2f\n", decoy_counts[d], result.fill_count,
+               (unsigned long long)result.nodes, inline_seconds * 1000.0, jobs_seconds * 1000.0,
+               budgeted_text, budget_seconds * 1000.0);
+        crossword_solver_destroy(solver);
+    }
+    return argc > 1 ? time_word_list(argv[1], &pattern) : 0;
+}
@@ -0,0 +1,113 @@
+// worddb_startup - measures packed word database startup time across list sizes
+//
+// For each list size a synthetic database is written to a temporary file, then
+// opened (mmap + header check), probed with one lookup and closed, many times.
+// Startup cost should stay flat from 200 to 200,000 words.
+
+#include "worddb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WORD_LENGTH_UNDER_TEST 5
+#define RUNS_PER_SIZE 200
+
+static double now_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static int compare_words(const void* a, const void* b) {
+    uint64_t word_a = *(const uint64_t*)a;
+    uint64_t word_b = *(const uint64_t*)b;
+    return (word_a > word_b) - (word_a < word_b);
+}
+
+static uint64_t random_packed_word(void) {
+    uint64_t packed = 0;
+    for (int i = 0; i < WORD_LENGTH_UNDER_TEST; i++) {
+        packed = (packed << WORD_DB_LETTER_BITS) | (uint64_t)(rand() % 26 + 1);
+    }
+    return packed;
+}
+
+static int generate_database(const char* path, int target_count) {
+    int capacity = target_count + target_count / 4;
+    uint64_t* words = malloc((size_t)capacity * sizeof(uint64_t));
+    if (!words) {
+        return 0;
+    }
+    for (int i = 0; i < capacity; i++) {
+        words[i] = random_packed_word();
+    }
+    qsort(words, (size_t)capacity, sizeof(uint64_t), compare_words);
+    
+    int count = 0;
+    for (int i = 0; i < capacity && count < target_count; i++) {
+        if (count == 0 || words[count - 1] != words[i]) {
+            words[count++] = words[i];
+        }
+    }
+    
+    int ok = word_db_write(path, WORD_LENGTH_UNDER_TEST, words, NULL, NULL, count);
+    free(words);
+    return ok;
+}
+
+static int lookup(const WordDatabase* database, uint64_t word) {
+    int low = 0;
+    int high = database->word_count - 1;
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        if (database->words[mid] == word) {
+            return mid;
+        } else if (database->words[mid] < word) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+int main(void) {
+    static const int sizes[] = {200, 2000, 20000, 200000};
+    const char* path = "worddb_startup_bench.cwdb";
+    srand(12345);
+    
+    printf("%10s %14s %14s\n", "words", "open_us", "open+probe_us");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        if (!generate_database(path, sizes[s])) {
+            fprintf(stderr, "failed to generate %d-word database\n", sizes[s]);
+            return 1;
+        }
+        
+        double open_total = 0.0;
+        double probe_total = 0.0;
+        int found = 0;
+        for (int run = 0; run < RUNS_PER_SIZE; run++) {
+            WordDatabase database;
+            double start = now_seconds();
+            if (!word_db_open(path, &database)) {
+                fprintf(stderr, "failed to open %s\n", path);
+                return 1;
+            }
+            double opened = now_seconds();
+            found += lookup(&database, random_packed_word()) >= 0;
+            double probed = now_seconds();
+            word_db_close(&database);
+            
+            open_total += opened - start;
+            probe_total += probed - start;
+        }
+        
+        printf("%10d %14.2f %14.2f\n", sizes[s],
+               open_total * 1e6 / RUNS_PER_SIZE, probe_total * 1e6 / RUNS_PER_SIZE);
+        (void)found;
+    }
+    
+    remove(path);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "server.h"
+
+// Request parsing and response formatting. Runs once per line on the I/O and
+// worker threads, so nothing here allocates or goes through printf.
+
+static const char* SERVER_ERROR_NAMES[SERVER_ERROR_COUNT] = {
+    "NONE", "BAD_COMMAND", "BAD_LENGTH", "BAD_WORD", "EXISTS", "UNKNOWN_SESSION", "SOLVED", "NOT_SOLVED",
+    "NO_MEMORY"
+};
+
+typedef struct {
+    const char* name;
+    int length;
+    ServerOp op;
+} ServerCommand;
+
+static const ServerCommand SERVER_COMMANDS[] = {
+    {"NEW", 3, SERVER_OP_NEW},
+    {"GUESS", 5, SERVER_OP_GUESS},
+    {"NEXT", 4, SERVER_OP_NEXT},
+    {"END", 3, SERVER_OP_END},
+    {"STATS", 5, SERVER_OP_STATS},
+};
+
+// Next space-separated field of line[*pos..length); returns its length
+static int next_field(const char* line, int length, int* pos, const char** out_field) {
+    while (*pos < length && (line[*pos] == ' ' || line[*pos] == '\t' || line[*pos] == '\r')) {
+        (*pos)++;
+    }
+    int start = *pos;
+    while (*pos < length && line[*pos] != ' ' && line[*pos] != '\t' && line[*pos] != '\r') {
+        (*pos)++;
+    }
+    *out_field = &line[start];
+    return *pos - start;
+}
+
+static int parse_u64(const char* field, int length, uint64_t* out_value) {
+    if (length == 0 || length > 19) {
+        return 0;
+    }
+    uint64_t value = 0;
+    for (int i = 0; i < length; i++) {
+        if (field[i] < '0' || field[i] > '9') {
+            return 0;
+        }
+        value = value * 10 + (uint64_t)(field[i] - '0');
+    }
+    *out_value = value;
+    return 1;
+}
+
+// Parses one line (without the newline). Malformed requests come back with
+// op SERVER_OP_INVALID or an error set, so the worker can still answer them.
+ServerRequest server_parse_request(const char* line, int length) {
+    ServerRequest request = {0};
+    request.op = SERVER_OP_INVALID;
+    request.error = SERVER_ERROR_BAD_COMMAND;
+
+    int pos = 0;
+    const char* field;
+    int field_length = next_field(line, length, &pos, &field);
+    for (size_t i = 0; i < sizeof(SERVER_COMMANDS) / sizeof(SERVER_COMMANDS[0]); i++) {
+        if (field_length == SERVER_COMMANDS[i].length && memcmp(field, SERVER_COMMANDS[i].name, (size_t)field_length) == 0) {
+            request.op = (uint8_t)SERVER_COMMANDS[i].op;
+            break;
+        }
+    }
+    if (request.op == SERVER_OP_INVALID) {
+        return request;
+    }
+    if (request.op == SERVER_OP_STATS) {
+        request.error = SERVER_ERROR_NONE;
+        return request;
+    }
+
+    field_length = next_field(line, length, &pos, &field);
+    if (!parse_u64(field, field_length, &request.session)) {
+        request.op = SERVER_OP_INVALID;
+        return request;
+    }
+    request.error = SERVER_ERROR_NONE;
+
+    field_length = next_field(line, length, &pos, &field);
+    if (request.op == SERVER_OP_NEW && field_length > 0) {
+        uint64_t word_length = 0;
+        if (!parse_u64(field, field_length, &word_length) || !is_supported_word_length((int)word_length)) {
+            request.error = SERVER_ERROR_BAD_LENGTH;
+        } else {
+            request.word_length = (uint8_t)word_length;
+        }
+    } else if (request.op == SERVER_OP_GUESS) {
+        if (field_length < MIN_WORD_LENGTH || field_length > MAX_WORD_LENGTH) {
+            request.error = SERVER_ERROR_BAD_WORD;
+            return request;
+        }
+        for (int i = 0; i < field_length; i++) {
+            char letter = (char)toupper((unsigned char)field[i]);
+            if (letter < 'A' || letter > 'Z') {
+                request.error = SERVER_ERROR_BAD_WORD;
+                return request;
+            }
+            request.word[i] = letter;
+        }
+        request.word[field_length] = '\0';
+    }
+    return request;
+}
+
+// splitmix64 finalizer, so sequential ids spread evenly over shards
+uint32_t server_shard_for(uint64_t session, int shard_count) {
+    uint64_t hash = session + 0x9E3779B97F4A7C15ull;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return (uint32_t)(hash % (uint64_t)shard_count);
+}
+
+int server_format_u64(char* buffer, uint64_t value) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    for (int i = 0; i < count; i++) {
+        buffer[i] = digits[count - 1 - i];
+    }
+    buffer[count] = '\0';
+    return count;
+}
+
+// Appends a string; returns the new length
+int server_append(char* out, int length, const char* text) {
+    while (*text) {
+        out[length++] = *text++;
+    }
+    out[length] = '\0';
+    return length;
+}
+
+int server_format_error(char* out, uint64_t session, ServerError error) {
+    int length = server_append(out, 0, "ERR ");
+    length += server_format_u64(&out[length], session);
+    out[length++] = ' ';
+    length = server_append(out, length, SERVER_ERROR_NAMES[error]);
+    return server_append(out, length, "\n");
+}
@@ -0,0 +1,119 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "systems.h"
+
+// Headless multi-session server.
+//
+// Line protocol (one request per line, one response line per request):
+//   NEW <session> [length]   -> OK <session> NEW <length> <level>
+//   GUESS <session> <word>   -> FB <session> <code> <pattern> <guesses> <solved>
+//   NEXT <session>           -> OK <session> LEVEL <level>
+//   END <session>            -> OK <session> END
+//   STATS                    -> STATS <sessions> <guesses>
+// Failures answer ERR <session> <reason>. <code> is feedback_code() of the
+// guess, <pattern> spells it per letter (G correct, Y present, . absent).
+//
+// Sessions are sharded by id across worker threads. Each worker owns its
+// shard's session table outright; the I/O thread only talks to workers through
+// single-producer/single-consumer rings, so there is no lock on the hot path.
+// Responses for one session keep their order; responses for sessions on
+// different shards may interleave. STATS waits for every earlier request from
+// its connection, so its counts include them and it is answered after them.
+
+#define SERVER_MAX_SHARDS 64
+#define SERVER_RING_SIZE 4096                 // Per shard and direction; power of two
+#define SERVER_RESPONSE_TEXT_SIZE 64
+#define SERVER_DEFAULT_SOCKET "crosswordle.sock"
+#define SERVER_MAX_CLIENTS 1024
+#define SERVER_READ_CHUNK 65536
+
+typedef enum {
+    SERVER_OP_NEW = 0,
+    SERVER_OP_GUESS,
+    SERVER_OP_NEXT,
+    SERVER_OP_END,
+    SERVER_OP_STATS,
+    SERVER_OP_INVALID
+} ServerOp;
+
+typedef enum {
+    SERVER_ERROR_NONE = 0,
+    SERVER_ERROR_BAD_COMMAND,
+    SERVER_ERROR_BAD_LENGTH,
+    SERVER_ERROR_BAD_WORD,
+    SERVER_ERROR_EXISTS,
+    SERVER_ERROR_UNKNOWN_SESSION,
+    SERVER_ERROR_SOLVED,
+    SERVER_ERROR_NOT_SOLVED,
+    SERVER_ERROR_NO_MEMORY,
+    SERVER_ERROR_COUNT
+} ServerError;
+
+// Hosted session: the packed game state (see session_state.c), 256 bytes
+typedef struct {
+    uint64_t id;
+    SessionState state;
+} ServerSession;
+
+typedef struct {
+    uint32_t client;                          // Connection the response goes to
+    uint8_t op;                               // ServerOp
+    uint8_t word_length;                      // NEW: requested length, 0 = default
+    uint8_t error;                            // Set by the parser
+    uint8_t padding;
+    uint64_t session;
+    char word[MAX_WORD_LENGTH + 1];
+} ServerRequest;
+
+typedef struct {
+    uint32_t client;
+    uint16_t length;
+    char text[SERVER_RESPONSE_TEXT_SIZE];     // One line including '\n'
+} ServerResponse;
+
+// Open-addressing id -> session table, owned by one shard
+typedef struct {
+    ServerSession* sessions;                  // Dense array
+    int* slots;                               // Hash slots: index into sessions, -1 empty
+    int count;
+    int capacity;                             // Dense array capacity
+    int slot_count;                           // Power of two
+    uint64_t rng_state;                       // Target word draws for this shard
+    uint64_t guesses;
+} SessionTable;
+
+// Protocol (protocol.c)
+ServerRequest server_parse_request(const char* line, int length);
+uint32_t server_shard_for(uint64_t session, int shard_count);
+int server_format_u64(char* buffer, uint64_t value);
+int server_append(char* out, int length, const char* text);
+int server_format_error(char* out, uint64_t session, ServerError error);
+
+// Sessions (session.c); single-threaded, one table per shard
+void session_table_init(SessionTable* table, uint64_t seed);
+void session_table_free(SessionTable* table);
+ServerSession* session_table_find(SessionTable* table, uint64_t id);
+// Handles one request against the table and writes the response line
+void session_handle_request(SessionTable* table, const ServerRequest* request, ServerResponse* out_response);
+
+// Shards and worker threads (shard.c)
+int server_shards_start(int shard_count, uint64_t seed);
+void server_shards_stop(void);
+int server_shard_count(void);
+// Queues a request for its shard; spins (draining responses through `drain`)
+// while the shard's ring is full
+void server_submit(const ServerRequest* request, void (*drain)(void));
+// Pops up to max_responses finished responses from every shard; returns the count
+int server_collect(ServerResponse* out_responses, int max_responses);
+// Requests submitted whose responses have not been collected yet
+uint64_t server_pending(void);
+// Read end of a pipe the workers write to when responses are ready and the
+// I/O thread has armed it, so the I/O thread can sleep in poll() with its sockets
+int server_wake_fd(void);
+void server_arm_wake(void);
+void server_clear_wake(void);
+uint64_t server_total_sessions(void);
+uint64_t server_total_guesses(void);
+
+#endif
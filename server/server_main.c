@@ -0,0 +1,433 @@
+// crosswordle_server - headless multi-session game server
+//
+// Usage: crosswordle_server [--socket PATH] [--threads N] [--seed N] [--data DIR]
+//
+// Without --socket, requests are read from stdin and responses written to
+// stdout; a summary goes to stderr at end of input. With --socket, clients
+// connect to a Unix stream socket and each gets the responses to its own
+// requests. See server.h for the protocol.
+
+#include "server.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SERVER_MAX_LINE 256
+#define SERVER_COLLECT_BATCH 1024
+
+typedef struct {
+    int in_fd;
+    int out_fd;
+    int active;
+    int eof;
+    uint32_t generation;
+    char in_buffer[SERVER_READ_CHUNK + SERVER_MAX_LINE];
+    int in_length;
+    char* out_buffer;
+    int out_length;
+    int out_capacity;
+    int in_flight;                            // Requests submitted, responses not yet appended
+    int stats_waiting;                        // A STATS waits for in_flight to reach 0; parsing paused
+    int discarding;                           // Skipping the rest of an overlong line
+} ServerClient;
+
+static ServerClient* clients = NULL;
+static int client_count = 0;                  // Highest slot in use + 1
+static volatile sig_atomic_t server_stop_requested = 0;
+
+static void handle_stop_signal(int signal_number) {
+    (void)signal_number;
+    server_stop_requested = 1;
+}
+
+static double server_clock_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+}
+
+// Client ids carry a generation so responses to a closed connection are not
+// delivered to the next client that reuses its slot
+static uint32_t client_id(int slot) {
+    return (uint32_t)slot | (clients[slot].generation << 16);
+}
+
+static ServerClient* client_for_id(uint32_t id) {
+    int slot = (int)(id & 0xFFFF);
+    if (slot >= client_count || !clients[slot].active || clients[slot].generation != (id >> 16)) {
+        return NULL;
+    }
+    return &clients[slot];
+}
+
+static void client_close(int slot);
+
+// Closes the client if its output cannot grow: dropping a response would
+// leave it waiting forever
+static void client_append(ServerClient* client, const char* text, int length) {
+    if (client->out_length + length > client->out_capacity) {
+        int capacity = client->out_capacity ? client->out_capacity * 2 : 65536;
+        while (capacity < client->out_length + length) {
+            capacity *= 2;
+        }
+        char* buffer = realloc(client->out_buffer, (size_t)capacity);
+        if (!buffer) {
+            fprintf(stderr, "crosswordle_server: out of memory for a client's responses; closing it\n");
+            client_close((int)(client - clients));
+            return;
+        }
+        client->out_buffer = buffer;
+        client->out_capacity = capacity;
+    }
+    memcpy(&client->out_buffer[client->out_length], text, (size_t)length);
+    client->out_length += length;
+}
+
+static void client_flush(ServerClient* client) {
+    int written_total = 0;
+    while (written_total < client->out_length) {
+        ssize_t written = write(client->out_fd, &client->out_buffer[written_total], (size_t)(client->out_length - written_total));
+        if (written <= 0) {
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            break;                            // EAGAIN: finish on POLLOUT; errors close on read
+        }
+        written_total += (int)written;
+    }
+    memmove(client->out_buffer, &client->out_buffer[written_total], (size_t)(client->out_length - written_total));
+    client->out_length -= written_total;
+}
+
+static void client_close(int slot) {
+    ServerClient* client = &clients[slot];
+    if (client->in_fd > STDERR_FILENO) {
+        close(client->in_fd);
+    }
+    client->active = 0;
+    client->generation = (client->generation + 1) & 0xFFFF;
+    client->in_length = 0;
+    client->out_length = 0;
+    client->in_flight = 0;
+    client->stats_waiting = 0;
+    client->discarding = 0;
+}
+
+// Moves finished responses into client output buffers; returns the count
+static int drain_responses(void) {
+    static ServerResponse responses[SERVER_COLLECT_BATCH];
+    int total = 0;
+    int count;
+    while ((count = server_collect(responses, SERVER_COLLECT_BATCH)) > 0) {
+        for (int i = 0; i < count; i++) {
+            ServerClient* client = client_for_id(responses[i].client);
+            if (client) {
+                client->in_flight--;
+                client_append(client, responses[i].text, responses[i].length);
+            }
+        }
+        total += count;
+    }
+    return total;
+}
+
+// Called while a shard's request ring is full
+static void drain_and_flush(void) {
+    drain_responses();
+    for (int slot = 0; slot < client_count; slot++) {
+        if (clients[slot].active && clients[slot].out_length > 0) {
+            client_flush(&clients[slot]);
+        }
+    }
+}
+
+// Answered on the I/O thread from the shards' published counters, which
+// include every response already collected
+static void answer_stats(int slot) {
+    char text[SERVER_RESPONSE_TEXT_SIZE];
+    int text_length = server_append(text, 0, "STATS ");
+    text_length += server_format_u64(&text[text_length], server_total_sessions());
+    text[text_length++] = ' ';
+    text_length += server_format_u64(&text[text_length], server_total_guesses());
+    text_length = server_append(text, text_length, "\n");
+    client_append(&clients[slot], text, text_length);
+}
+
+static void handle_line(int slot, const char* line, int length) {
+    ServerClient* client = &clients[slot];
+    ServerRequest request = server_parse_request(line, length);
+    request.client = client_id(slot);
+    if (request.op == SERVER_OP_STATS) {
+        // Earlier requests first: pause this client until they are answered
+        if (client->in_flight > 0) {
+            client->stats_waiting = 1;
+        } else {
+            answer_stats(slot);
+        }
+        return;
+    }
+    server_submit(&request, drain_and_flush);
+    client->in_flight++;
+}
+
+// Handles every complete line in the input buffer, stopping early if a STATS
+// has to wait
+static void client_parse(int slot) {
+    ServerClient* client = &clients[slot];
+    int line_start = 0;
+    for (int i = 0; i < client->in_length && client->active && !client->stats_waiting; i++) {
+        if (client->in_buffer[i] == '\n') {
+            if (client->discarding) {
+                client->discarding = 0;
+            } else if (i > line_start) {
+                handle_line(slot, &client->in_buffer[line_start], i - line_start);
+            }
+            line_start = i + 1;
+        }
+    }
+    if (!client->active) {
+        return;
+    }
+    int leftover = client->in_length - line_start;
+    if (!client->stats_waiting && (client->discarding || leftover >= SERVER_MAX_LINE)) {
+        // Overlong line: answer it as malformed once and skip it through its
+        // newline, however many reads that takes
+        if (!client->discarding) {
+            handle_line(slot, "", 0);
+            client->discarding = 1;
+        }
+        leftover = 0;
+        line_start = client->in_length;
+    }
+    memmove(client->in_buffer, &client->in_buffer[line_start], (size_t)leftover);
+    client->in_length = leftover;
+}
+
+// Answers a waiting STATS once the client's earlier requests are answered,
+// then carries on with the lines behind it
+static void resume_waiting_clients(void) {
+    for (int slot = 0; slot < client_count; slot++) {
+        ServerClient* client = &clients[slot];
+        if (client->active && client->stats_waiting && client->in_flight == 0) {
+            client->stats_waiting = 0;
+            answer_stats(slot);
+            if (client->active) {
+                client_parse(slot);
+            }
+        }
+    }
+}
+
+// Reads what is available and submits every complete line. A paused client
+// is not read, so its buffer never holds more than one chunk and a line.
+static void client_read(int slot) {
+    ServerClient* client = &clients[slot];
+    if (client->stats_waiting) {
+        return;
+    }
+    ssize_t received = read(client->in_fd, &client->in_buffer[client->in_length], SERVER_READ_CHUNK);
+    if (received <= 0) {
+        if (received < 0 && (errno == EAGAIN || errno == EINTR)) {
+            return;
+        }
+        client->eof = 1;
+        return;
+    }
+    client->in_length += (int)received;
+    client_parse(slot);
+}
+
+static int add_client(int in_fd, int out_fd) {
+    int slot = 0;
+    while (slot < client_count && clients[slot].active) {
+        slot++;
+    }
+    if (slot == SERVER_MAX_CLIENTS) {
+        return -1;
+    }
+    if (slot == client_count) {
+        client_count++;
+    }
+    ServerClient* client = &clients[slot];
+    client->in_fd = in_fd;
+    client->out_fd = out_fd;
+    client->active = 1;
+    client->eof = 0;
+    client->in_length = 0;
+    client->out_length = 0;
+    client->in_flight = 0;
+    client->stats_waiting = 0;
+    client->discarding = 0;
+    return slot;
+}
+
+static int open_listen_socket(const char* path) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    struct sockaddr_un address = {0};
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    unlink(path);
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 128) != 0) {
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, O_NONBLOCK);
+    return fd;
+}
+
+static int default_thread_count(void) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    // One core stays with the I/O thread
+    return cpus > 2 ? (int)cpus - 1 : 1;
+}
+
+int main(int argc, char** argv) {
+    const char* socket_path = NULL;
+    const char* data_directory = "data";
+    int thread_count = default_thread_count();
+    uint64_t seed = (uint64_t)time(NULL);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            thread_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            data_directory = argv[++i];
+        } else {
+            fprintf(stderr, "usage: crosswordle_server [--socket PATH] [--threads N] [--seed N] [--data DIR]\n");
+            return 2;
+        }
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, handle_stop_signal);
+    signal(SIGTERM, handle_stop_signal);
+
+    load_word_databases(data_directory);
+    clients = calloc(SERVER_MAX_CLIENTS, sizeof(ServerClient));
+    if (!clients || !server_shards_start(thread_count, seed)) {
+        fprintf(stderr, "crosswordle_server: failed to start workers\n");
+        return 1;
+    }
+
+    int listen_fd = -1;
+    if (socket_path) {
+        listen_fd = open_listen_socket(socket_path);
+        if (listen_fd < 0) {
+            fprintf(stderr, "crosswordle_server: cannot listen on %s\n", socket_path);
+            server_shards_stop();
+            return 1;
+        }
+        fprintf(stderr, "crosswordle_server: %d workers on %s\n", server_shard_count(), socket_path);
+    } else {
+        add_client(STDIN_FILENO, STDOUT_FILENO);
+    }
+
+    double start_time = server_clock_seconds();
+    static struct pollfd poll_fds[SERVER_MAX_CLIENTS + 2];
+    static int poll_slots[SERVER_MAX_CLIENTS + 2];
+
+    while (!server_stop_requested) {
+        drain_and_flush();
+        resume_waiting_clients();
+
+        // Clients that hit end of input close once their responses are out
+        int live_clients = 0;
+        for (int slot = 0; slot < client_count; slot++) {
+            ServerClient* client = &clients[slot];
+            if (client->active && client->eof && !client->stats_waiting &&
+                (server_pending() == 0 || client->in_fd != STDIN_FILENO) && client->out_length == 0) {
+                client_close(slot);
+            }
+            live_clients += clients[slot].active;
+        }
+        if (!socket_path && live_clients == 0) {
+            break;
+        }
+
+        int poll_count = 0;
+        poll_fds[poll_count] = (struct pollfd){server_wake_fd(), POLLIN, 0};
+        poll_slots[poll_count++] = -1;
+        if (listen_fd >= 0) {
+            poll_fds[poll_count] = (struct pollfd){listen_fd, POLLIN, 0};
+            poll_slots[poll_count++] = -1;
+        }
+        for (int slot = 0; slot < client_count; slot++) {
+            ServerClient* client = &clients[slot];
+            if (!client->active) {
+                continue;
+            }
+            short events = client->eof || client->stats_waiting ? 0 : POLLIN;
+            if (client->out_length > 0 && client->out_fd != STDOUT_FILENO) {
+                events |= POLLOUT;
+            }
+            poll_fds[poll_count] = (struct pollfd){client->in_fd, events, 0};
+            poll_slots[poll_count++] = slot;
+        }
+
+        // Sleep only if no response arrived after arming the wake pipe
+        server_arm_wake();
+        int timeout = drain_responses() > 0 ? 0 : 100;
+        if (poll(poll_fds, (nfds_t)poll_count, timeout) < 0 && errno != EINTR) {
+            break;
+        }
+        server_clear_wake();
+
+        for (int i = 0; i < poll_count; i++) {
+            if (poll_slots[i] >= 0 && (poll_fds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                client_read(poll_slots[i]);
+            }
+        }
+        if (listen_fd >= 0 && (poll_fds[1].revents & POLLIN)) {
+            int fd;
+            while ((fd = accept(listen_fd, NULL, NULL)) >= 0) {
+                fcntl(fd, F_SETFL, O_NONBLOCK);
+                if (add_client(fd, fd) < 0) {
+                    close(fd);
+                }
+            }
+        }
+    }
+
+    // Let in-flight requests finish so their responses are written
+    while (server_pending() > 0) {
+        drain_and_flush();
+        sched_yield();
+    }
+    drain_and_flush();
+
+    double elapsed = server_clock_seconds() - start_time;
+    uint64_t guesses = server_total_guesses();
+    fprintf(stderr, "crosswordle_server: %llu guesses, %llu sessions, %.3f s, %.0f guesses/s\n",
+            (unsigned long long)guesses, (unsigned long long)server_total_sessions(), elapsed,
+            elapsed > 0.0 ? (double)guesses / elapsed : 0.0);
+
+    server_shards_stop();
+    for (int slot = 0; slot < client_count; slot++) {
+        if (clients[slot].active) {
+            client_close(slot);
+        }
+        free(clients[slot].out_buffer);
+    }
+    free(clients);
+    if (listen_fd >= 0) {
+        close(listen_fd);
+        unlink(socket_path);
+    }
+    unload_word_databases();
+    return 0;
+}
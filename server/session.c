@@ -0,0 +1,273 @@
+#include "server.h"
+
+// Session table and request handling for one shard. Only the shard's worker
+// thread touches a table, so nothing here locks.
+
+#define SESSION_TABLE_INITIAL_CAPACITY 256
+
+static uint32_t session_slot_hash(uint64_t id) {
+    return (uint32_t)((id * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+void session_table_init(SessionTable* table, uint64_t seed) {
+    memset(table, 0, sizeof(*table));
+    table->rng_state = seed ? seed : 0x9E3779B97F4A7C15ull;
+}
+
+void session_table_free(SessionTable* table) {
+    free(table->sessions);
+    free(table->slots);
+    memset(table, 0, sizeof(*table));
+}
+
+// Slot holding `id`, or the empty slot where it would go
+static int find_slot(const SessionTable* table, uint64_t id) {
+    uint32_t mask = (uint32_t)table->slot_count - 1;
+    uint32_t slot = session_slot_hash(id) & mask;
+    while (table->slots[slot] >= 0 && table->sessions[table->slots[slot]].id != id) {
+        slot = (slot + 1) & mask;
+    }
+    return (int)slot;
+}
+
+static int rehash(SessionTable* table, int slot_count) {
+    int* slots = malloc((size_t)slot_count * sizeof(int));
+    if (!slots) {
+        return 0;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    memset(slots, 0xFF, (size_t)slot_count * sizeof(int));
+    for (int i = 0; i < table->count; i++) {
+        table->slots[find_slot(table, table->sessions[i].id)] = i;
+    }
+    return 1;
+}
+
+ServerSession* session_table_find(SessionTable* table, uint64_t id) {
+    if (table->count == 0) {
+        return NULL;
+    }
+    int index = table->slots[find_slot(table, id)];
+    return index >= 0 ? &table->sessions[index] : NULL;
+}
+
+// Inserts a zeroed session; NULL if it exists or memory runs out (callers
+// look the id up first, so NULL from them means memory)
+static ServerSession* session_table_insert(SessionTable* table, uint64_t id) {
+    if (table->count == table->capacity) {
+        int capacity = table->capacity ? table->capacity * 2 : SESSION_TABLE_INITIAL_CAPACITY;
+        ServerSession* sessions = realloc(table->sessions, (size_t)capacity * sizeof(ServerSession));
+        if (!sessions) {
+            return NULL;
+        }
+        table->sessions = sessions;
+        table->capacity = capacity;
+    }
+    // Keep the load factor at or below one half
+    if ((table->count + 1) * 2 > table->slot_count &&
+        !rehash(table, table->slot_count ? table->slot_count * 2 : SESSION_TABLE_INITIAL_CAPACITY * 2)) {
+        return NULL;
+    }
+
+    int slot = find_slot(table, id);
+    if (table->slots[slot] >= 0) {
+        return NULL;
+    }
+    ServerSession* session = &table->sessions[table->count];
+    memset(session, 0, sizeof(*session));
+    session->id = id;
+    table->slots[slot] = table->count++;
+    return session;
+}
+
+// Removes with backward-shift deletion (no tombstones), then moves the last
+// dense entry into the hole
+static void session_table_remove(SessionTable* table, uint64_t id) {
+    uint32_t mask = (uint32_t)table->slot_count - 1;
+    uint32_t slot = (uint32_t)find_slot(table, id);
+    int index = table->slots[slot];
+    if (index < 0) {
+        return;
+    }
+
+    uint32_t hole = slot;
+    uint32_t next = (hole + 1) & mask;
+    while (table->slots[next] >= 0) {
+        uint32_t home = session_slot_hash(table->sessions[table->slots[next]].id) & mask;
+        // Move the entry back if its home is not in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            table->slots[hole] = table->slots[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    table->slots[hole] = -1;
+
+    int last = --table->count;
+    if (index != last) {
+        table->sessions[index] = table->sessions[last];
+        table->slots[find_slot(table, table->sessions[index].id)] = index;
+    }
+}
+
+static int draw_target(SessionTable* table, int word_length, int level, char* out_word) {
+    int index = draw_word_index_for_level(word_length, level, &table->rng_state);
+    if (index < 0) {
+        return 0;
+    }
+    get_word_kernels(word_length)->unpack(get_word_dictionary(word_length)->words[index], out_word);
+    return 1;
+}
+
+static void respond_error(ServerResponse* response, uint64_t session, ServerError error) {
+    response->length = (uint16_t)server_format_error(response->text, session, error);
+}
+
+// "OK <session> <what> [value]\n"
+static void respond_ok(ServerResponse* response, uint64_t session, const char* what, int value) {
+    char* out = response->text;
+    int length = server_append(out, 0, "OK ");
+    length += server_format_u64(&out[length], session);
+    out[length++] = ' ';
+    length = server_append(out, length, what);
+    if (value >= 0) {
+        out[length++] = ' ';
+        length += format_int(&out[length], value);
+    }
+    response->length = (uint16_t)server_append(out, length, "\n");
+}
+
+static void handle_new(SessionTable* table, const ServerRequest* request, ServerResponse* response) {
+    int word_length = request->word_length ? request->word_length : DEFAULT_WORD_LENGTH;
+    if (session_table_find(table, request->session)) {
+        respond_error(response, request->session, SERVER_ERROR_EXISTS);
+        return;
+    }
+    ServerSession* session = session_table_insert(table, request->session);
+    if (!session) {
+        respond_error(response, request->session, SERVER_ERROR_NO_MEMORY);
+        return;
+    }
+    char target[MAX_WORD_LENGTH + 1];
+    if (!draw_target(table, word_length, 1, target)) {
+        session_table_remove(table, request->session);
+        respond_error(response, request->session, SERVER_ERROR_BAD_LENGTH);
+        return;
+    }
+    session_state_init(&session->state, word_length, target);
+
+    // "OK <session> NEW <length> <level>\n"
+    char* out = response->text;
+    int length = server_append(out, 0, "OK ");
+    length += server_format_u64(&out[length], request->session);
+    length = server_append(out, length, " NEW ");
+    length += format_int(&out[length], word_length);
+    out[length++] = ' ';
+    length += format_int(&out[length], session->state.level);
+    response->length = (uint16_t)server_append(out, length, "\n");
+}
+
+// Same rules as complete_word_validation: any A-Z word of the session's length
+// counts as a guess, and solving awards one letter of the target
+static void handle_guess(SessionTable* table, const ServerRequest* request, ServerResponse* response) {
+    ServerSession* session = session_table_find(table, request->session);
+    if (!session) {
+        respond_error(response, request->session, SERVER_ERROR_UNKNOWN_SESSION);
+        return;
+    }
+    if (session_state_play_state(&session->state) != GAME_STATE_INPUT) {
+        respond_error(response, request->session, SERVER_ERROR_SOLVED);
+        return;
+    }
+    int word_length = session_state_word_length(&session->state);
+    if ((int)strlen(request->word) != word_length) {
+        respond_error(response, request->session, SERVER_ERROR_BAD_WORD);
+        return;
+    }
+
+    LetterState states[MAX_WORD_LENGTH];
+    int award_index = (int)(table->rng_state % (uint64_t)word_length);
+    int solved = session_state_guess(&session->state, request->word, states, award_index);
+    if (solved) {
+        table->rng_state = table->rng_state * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    table->guesses++;
+
+    // "FB <session> <code> <pattern> <guesses> <solved>\n"
+    char* out = response->text;
+    int length = server_append(out, 0, "FB ");
+    length += server_format_u64(&out[length], request->session);
+    out[length++] = ' ';
+    length += format_int(&out[length], feedback_code(states, word_length));
+    out[length++] = ' ';
+    for (int i = 0; i < word_length; i++) {
+        out[length++] = states[i] == LETTER_CORRECT ? 'G' : (states[i] == LETTER_WRONG_POS ? 'Y' : '.');
+    }
+    out[length++] = ' ';
+    length += format_int(&out[length], session->state.guesses_this_level);
+    out[length++] = ' ';
+    out[length++] = (char)('0' + solved);
+    response->length = (uint16_t)server_append(out, length, "\n");
+}
+
+static void handle_next(SessionTable* table, const ServerRequest* request, ServerResponse* response) {
+    ServerSession* session = session_table_find(table, request->session);
+    if (!session) {
+        respond_error(response, request->session, SERVER_ERROR_UNKNOWN_SESSION);
+        return;
+    }
+    if (session_state_play_state(&session->state) != GAME_STATE_LEVEL_COMPLETE) {
+        respond_error(response, request->session, SERVER_ERROR_NOT_SOLVED);
+        return;
+    }
+    char target[MAX_WORD_LENGTH + 1];
+    int level = session->state.level + 1;
+    if (!draw_target(table, session_state_word_length(&session->state), level, target)) {
+        session_state_target(&session->state, target);
+    }
+    session_state_next_level(&session->state, target);
+    respond_ok(response, request->session, "LEVEL", session->state.level);
+}
+
+void session_handle_request(SessionTable* table, const ServerRequest* request, ServerResponse* out_response) {
+    out_response->client = request->client;
+    if (request->error != SERVER_ERROR_NONE) {
+        respond_error(out_response, request->session, (ServerError)request->error);
+        return;
+    }
+
+    switch (request->op) {
+        case SERVER_OP_NEW:
+            handle_new(table, request, out_response);
+            break;
+        case SERVER_OP_GUESS:
+            handle_guess(table, request, out_response);
+            break;
+        case SERVER_OP_NEXT:
+            handle_next(table, request, out_response);
+            break;
+        case SERVER_OP_END:
+            if (!session_table_find(table, request->session)) {
+                respond_error(out_response, request->session, SERVER_ERROR_UNKNOWN_SESSION);
+            } else {
+                session_table_remove(table, request->session);
+                respond_ok(out_response, request->session, "END", -1);
+            }
+            break;
+        case SERVER_OP_STATS: {
+            // Per-table figures; the server answers STATS itself across shards
+            char* out = out_response->text;
+            int length = server_append(out, 0, "STATS ");
+            length += format_int(&out[length], table->count);
+            out[length++] = ' ';
+            length += server_format_u64(&out[length], table->guesses);
+            out_response->length = (uint16_t)server_append(out, length, "\n");
+            break;
+        }
+        default:
+            respond_error(out_response, request->session, SERVER_ERROR_BAD_COMMAND);
+            break;
+    }
+}
@@ -0,0 +1,231 @@
+#include "server.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+// One worker thread per shard. The I/O thread is the only producer of each
+// shard's request ring and the only consumer of its response ring; the worker
+// is the other side of both. Indices are free-running and masked on access,
+// as in the log ring.
+
+#define SERVER_RING_MASK (SERVER_RING_SIZE - 1)
+#define SERVER_WORKER_SPINS 2000             // Empty polls before a worker sleeps
+
+typedef struct {
+    ServerRequest requests[SERVER_RING_SIZE];
+    ServerResponse responses[SERVER_RING_SIZE];
+    _Alignas(64) atomic_uint request_write;   // Written by the I/O thread
+    _Alignas(64) atomic_uint request_read;    // Written by the worker
+    _Alignas(64) atomic_uint response_write;  // Written by the worker
+    _Alignas(64) atomic_uint response_read;   // Written by the I/O thread
+    _Alignas(64) atomic_int sleeping;
+    atomic_int running;
+    atomic_uint_fast64_t published_sessions;  // Snapshot for STATS
+    atomic_uint_fast64_t published_guesses;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;
+    pthread_t thread;
+    SessionTable table;                       // Owned by the worker
+} ServerShard;
+
+static ServerShard* server_shards = NULL;
+static int server_shard_total = 0;
+static int server_wake_pipe[2] = {-1, -1};
+static atomic_int server_wake_armed;
+static uint64_t server_submitted = 0;         // I/O thread only
+static uint64_t server_collected = 0;
+
+static void wake_io_thread(void) {
+    if (atomic_exchange(&server_wake_armed, 0)) {
+        char byte = 1;
+        ssize_t written = write(server_wake_pipe[1], &byte, 1);
+        (void)written;
+    }
+}
+
+static void* shard_worker_main(void* arg) {
+    ServerShard* shard = arg;
+    int idle_spins = 0;
+
+    while (atomic_load_explicit(&shard->running, memory_order_acquire)) {
+        unsigned read = atomic_load_explicit(&shard->request_read, memory_order_relaxed);
+        unsigned write = atomic_load_explicit(&shard->request_write, memory_order_acquire);
+
+        if (read == write) {
+            if (++idle_spins < SERVER_WORKER_SPINS) {
+                sched_yield();
+                continue;
+            }
+            // Sleep until the I/O thread signals; sleeping is set before the
+            // ring is re-checked so a concurrent submit cannot be missed
+            pthread_mutex_lock(&shard->mutex);
+            atomic_store(&shard->sleeping, 1);
+            while (atomic_load(&shard->request_write) == read && atomic_load(&shard->running)) {
+                pthread_cond_wait(&shard->wake, &shard->mutex);
+            }
+            atomic_store(&shard->sleeping, 0);
+            pthread_mutex_unlock(&shard->mutex);
+            idle_spins = 0;
+            continue;
+        }
+        idle_spins = 0;
+
+        unsigned response_write = atomic_load_explicit(&shard->response_write, memory_order_relaxed);
+        while (read != write) {
+            // Wait for room in the response ring
+            while (response_write - atomic_load_explicit(&shard->response_read, memory_order_acquire) == SERVER_RING_SIZE) {
+                atomic_store_explicit(&shard->response_write, response_write, memory_order_release);
+                wake_io_thread();
+                sched_yield();
+            }
+            session_handle_request(&shard->table, &shard->requests[read & SERVER_RING_MASK],
+                                   &shard->responses[response_write & SERVER_RING_MASK]);
+            read++;
+            response_write++;
+        }
+        // Counters first, so they are current once the responses are visible
+        atomic_store_explicit(&shard->published_sessions, (uint64_t)shard->table.count, memory_order_relaxed);
+        atomic_store_explicit(&shard->published_guesses, shard->table.guesses, memory_order_relaxed);
+        atomic_store_explicit(&shard->request_read, read, memory_order_release);
+        atomic_store_explicit(&shard->response_write, response_write, memory_order_release);
+        wake_io_thread();
+    }
+    return NULL;
+}
+
+int server_shards_start(int shard_count, uint64_t seed) {
+    if (shard_count < 1) shard_count = 1;
+    if (shard_count > SERVER_MAX_SHARDS) shard_count = SERVER_MAX_SHARDS;
+
+    // Selectors are built here, single-threaded; workers only read them
+    prepare_word_selectors();
+
+    if (pipe(server_wake_pipe) != 0) {
+        return 0;
+    }
+    fcntl(server_wake_pipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(server_wake_pipe[1], F_SETFL, O_NONBLOCK);
+
+    server_shards = calloc((size_t)shard_count, sizeof(ServerShard));
+    if (!server_shards) {
+        return 0;
+    }
+    for (int i = 0; i < shard_count; i++) {
+        ServerShard* shard = &server_shards[i];
+        session_table_init(&shard->table, seed ^ ((uint64_t)(i + 1) * 0x9E3779B97F4A7C15ull));
+        pthread_mutex_init(&shard->mutex, NULL);
+        pthread_cond_init(&shard->wake, NULL);
+        atomic_store(&shard->running, 1);
+        if (pthread_create(&shard->thread, NULL, shard_worker_main, shard) != 0) {
+            atomic_store(&shard->running, 0);
+            server_shard_total = i;
+            server_shards_stop();
+            return 0;
+        }
+        server_shard_total = i + 1;
+    }
+    return 1;
+}
+
+void server_shards_stop(void) {
+    for (int i = 0; i < server_shard_total; i++) {
+        ServerShard* shard = &server_shards[i];
+        pthread_mutex_lock(&shard->mutex);
+        atomic_store(&shard->running, 0);
+        pthread_cond_signal(&shard->wake);
+        pthread_mutex_unlock(&shard->mutex);
+        pthread_join(shard->thread, NULL);
+        session_table_free(&shard->table);
+        pthread_mutex_destroy(&shard->mutex);
+        pthread_cond_destroy(&shard->wake);
+    }
+    free(server_shards);
+    server_shards = NULL;
+    server_shard_total = 0;
+    for (int i = 0; i < 2; i++) {
+        if (server_wake_pipe[i] >= 0) {
+            close(server_wake_pipe[i]);
+            server_wake_pipe[i] = -1;
+        }
+    }
+}
+
+int server_shard_count(void) {
+    return server_shard_total;
+}
+
+void server_submit(const ServerRequest* request, void (*drain)(void)) {
+    ServerShard* shard = &server_shards[server_shard_for(request->session, server_shard_total)];
+    unsigned write = atomic_load_explicit(&shard->request_write, memory_order_relaxed);
+    while (write - atomic_load_explicit(&shard->request_read, memory_order_acquire) == SERVER_RING_SIZE) {
+        if (drain) {
+            drain();
+        }
+        sched_yield();
+    }
+    shard->requests[write & SERVER_RING_MASK] = *request;
+    atomic_store(&shard->request_write, write + 1);
+    server_submitted++;
+
+    if (atomic_load(&shard->sleeping)) {
+        pthread_mutex_lock(&shard->mutex);
+        pthread_cond_signal(&shard->wake);
+        pthread_mutex_unlock(&shard->mutex);
+    }
+}
+
+int server_collect(ServerResponse* out_responses, int max_responses) {
+    int count = 0;
+    for (int i = 0; i < server_shard_total && count < max_responses; i++) {
+        ServerShard* shard = &server_shards[i];
+        unsigned read = atomic_load_explicit(&shard->response_read, memory_order_relaxed);
+        unsigned write = atomic_load_explicit(&shard->response_write, memory_order_acquire);
+        while (read != write && count < max_responses) {
+            out_responses[count++] = shard->responses[read & SERVER_RING_MASK];
+            read++;
+        }
+        atomic_store_explicit(&shard->response_read, read, memory_order_release);
+    }
+    server_collected += (uint64_t)count;
+    return count;
+}
+
+uint64_t server_pending(void) {
+    return server_submitted - server_collected;
+}
+
+int server_wake_fd(void) {
+    return server_wake_pipe[0];
+}
+
+// Arm before re-checking server_collect and sleeping in poll() on the wake fd
+void server_arm_wake(void) {
+    atomic_store(&server_wake_armed, 1);
+}
+
+void server_clear_wake(void) {
+    char buffer[256];
+    atomic_store(&server_wake_armed, 0);
+    while (read(server_wake_pipe[0], buffer, sizeof(buffer)) > 0) {
+    }
+}
+
+uint64_t server_total_sessions(void) {
+    uint64_t total = 0;
+    for (int i = 0; i < server_shard_total; i++) {
+        total += atomic_load_explicit(&server_shards[i].published_sessions, memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t server_total_guesses(void) {
+    uint64_t total = 0;
+    for (int i = 0; i < server_shard_total; i++) {
+        total += atomic_load_explicit(&server_shards[i].published_guesses, memory_order_relaxed);
+    }
+    return total;
+}
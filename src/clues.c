@@ -0,0 +1,211 @@
+#include "systems.h"
+#include "clues.h"
+#include "worddb.h"
+
+// Crossword clues. The mapped .cwcl file is the only copy: a clue is named by
+// its index entry (plus one, so 0 means "no clue") and its text is read
+// straight from the mapping, so nothing is allocated per clue and the pages
+// of clues never shown are never read from disk.
+
+static void* clue_mapping = NULL;
+static size_t clue_mapping_size = 0;
+static const ClueDbHeader* clue_header = NULL;
+static const ClueIndexEntry* clue_index = NULL;
+static const char* clue_strings = NULL;
+static uint32_t clue_version = 0;            // Bumped on every load and unload
+
+// Maps a clue database. Returns 1 on success.
+int load_clue_database(const char* path) {
+    size_t size = 0;
+    void* view = word_db_map_file(path, &size);
+    if (!view) {
+        return 0;
+    }
+    const ClueDbHeader* header = (const ClueDbHeader*)view;
+    int valid = size >= sizeof(ClueDbHeader) &&
+                header->magic == CLUE_DB_MAGIC &&
+                header->version == CLUE_DB_VERSION &&
+                header->file_size == size &&
+                header->index_offset % 8 == 0 &&
+                word_db_section_fits(header->strings_offset, header->strings_size, 1, size) &&
+                word_db_section_fits(header->index_offset, header->clue_count, sizeof(ClueIndexEntry),
+                                     header->strings_offset) &&
+                header->strings_size <= UINT32_MAX &&
+                (header->strings_size == 0 ||
+                 ((const char*)view)[header->strings_offset + header->strings_size - 1] == '\0');
+    if (!valid) {
+        word_db_unmap_file(view, size);
+        return 0;
+    }
+
+    unload_clue_database();
+    clue_mapping = view;
+    clue_mapping_size = size;
+    clue_header = header;
+    clue_index = (const ClueIndexEntry*)((const uint8_t*)view + header->index_offset);
+    clue_strings = (const char*)view + header->strings_offset;
+    clue_version++;
+    return 1;
+}
+
+void unload_clue_database(void) {
+    if (clue_mapping) {
+        word_db_unmap_file(clue_mapping, clue_mapping_size);
+    }
+    clue_mapping = NULL;
+    clue_mapping_size = 0;
+    clue_header = NULL;
+    clue_index = NULL;
+    clue_strings = NULL;
+    clue_version++;
+}
+
+// Changes whenever clue numbers from clue_find stop being valid
+uint32_t clue_database_version(void) {
+    return clue_version;
+}
+
+int clue_database_count(void) {
+    return clue_header ? (int)clue_header->clue_count : 0;
+}
+
+// Binary search of the index: about 17 probes for 100k clues, touching one
+// page of the index per probe at most
+uint32_t clue_find(uint64_t word) {
+    if (!clue_header || word == 0) {
+        return 0;
+    }
+    uint32_t low = 0;
+    uint32_t high = clue_header->clue_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        uint64_t entry = clue_index[middle].word;
+        if (entry == word) {
+            return middle + 1;
+        }
+        if (entry < word) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return 0;
+}
+
+// Text of a clue from clue_find, or NULL. Valid until the database is unloaded.
+const char* clue_text(uint32_t clue) {
+    if (!clue_header || clue == 0 || clue > clue_header->clue_count) {
+        return NULL;
+    }
+    const ClueIndexEntry* entry = &clue_index[clue - 1];
+    if ((uint64_t)entry->text_offset + entry->text_length >= clue_header->strings_size) {
+        return NULL;
+    }
+    return clue_strings + entry->text_offset;
+}
+
+// Word ID of one of a level's words: its solution letters, packed
+uint64_t crossword_word_id(const CrosswordLevel* level, int word_index) {
+    if (word_index < 0 || word_index >= level->word_count) {
+        return 0;
+    }
+    const CrosswordWord* word = &level->words[word_index];
+    char letters[9 + 1];
+    if (word->length > 9) {
+        return 0;
+    }
+    for (int i = 0; i < word->length; i++) {
+        int x = word->start_x + (word->direction == 0 ? i : 0);
+        int y = word->start_y + (word->direction == 0 ? 0 : i);
+        if (x < 0 || y < 0 || x >= 9 || y >= 9) {
+            return 0;
+        }
+        letters[i] = level->solution[x][y];
+    }
+    letters[word->length] = '\0';
+    return word_db_pack_word(letters, word->length);
+}
+
+// ============= WRITER =============
+
+typedef struct {
+    uint64_t word;
+    int position;                             // In the caller's array, to keep the first duplicate
+} ClueOrder;
+
+static int compare_clue_order(const void* a, const void* b) {
+    const ClueOrder* left = a;
+    const ClueOrder* right = b;
+    if (left->word != right->word) {
+        return left->word < right->word ? -1 : 1;
+    }
+    return left->position - right->position;
+}
+
+int clue_db_write(const char* path, const ClueSource* clues, int clue_count) {
+    if (clue_count < 0) {
+        return 0;
+    }
+    size_t capacity = clue_count > 0 ? (size_t)clue_count : 1;
+    ClueOrder* order = malloc(sizeof(ClueOrder) * capacity);
+    ClueIndexEntry* index = malloc(sizeof(ClueIndexEntry) * capacity);
+    const char** texts = malloc(sizeof(const char*) * capacity);
+    int ok = order && index && texts;
+    
+    uint32_t count = 0;
+    uint64_t strings_size = 0;
+    if (ok) {
+        for (int i = 0; i < clue_count; i++) {
+            order[i].word = clues[i].word;
+            order[i].position = i;
+        }
+        qsort(order, (size_t)clue_count, sizeof(ClueOrder), compare_clue_order);
+        for (int i = 0; i < clue_count; i++) {
+            const ClueSource* source = &clues[order[i].position];
+            if (source->word == 0 || (count > 0 && index[count - 1].word == source->word)) {
+                continue;
+            }
+            size_t length = source->text ? strlen(source->text) : 0;
+            if (length > CLUE_MAX_LENGTH) {
+                length = CLUE_MAX_LENGTH;
+            }
+            index[count].word = source->word;
+            index[count].text_offset = (uint32_t)strings_size;
+            index[count].text_length = (uint32_t)length;
+            texts[count] = source->text;
+            strings_size += length + 1;
+            count++;
+        }
+        ok = strings_size <= UINT32_MAX;
+    }
+    
+    FILE* file = ok ? fopen(path, "wb") : NULL;
+    if (file) {
+        ClueDbHeader header = {0};
+        header.magic = CLUE_DB_MAGIC;
+        header.version = CLUE_DB_VERSION;
+        header.clue_count = count;
+        header.index_offset = sizeof(ClueDbHeader);
+        header.strings_offset = header.index_offset + (uint64_t)count * sizeof(ClueIndexEntry);
+        header.strings_size = strings_size;
+        header.file_size = header.strings_offset + strings_size;
+        
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(index, sizeof(ClueIndexEntry), count, file) == count;
+        for (uint32_t i = 0; ok && i < count; i++) {
+            if (index[i].text_length > 0) {
+                ok = fwrite(texts[i], index[i].text_length, 1, file) == 1;
+            }
+            ok = ok && fputc('\0', file) != EOF;
+        }
+        if (fclose(file) != 0) {
+            ok = 0;
+        }
+    } else {
+        ok = 0;
+    }
+    free(order);
+    free(index);
+    free(texts);
+    return ok;
+}
@@ -0,0 +1,50 @@
+#ifndef CLUES_H
+#define CLUES_H
+
+#include <stdint.h>
+
+// Crossword clue database file (.cwcl)
+//
+// Layout (little-endian, 8-byte aligned):
+//   ClueDbHeader
+//   ClueIndexEntry index[clue_count]   sorted by word, one entry per word
+//   char strings[strings_size]         clue texts, each NUL-terminated
+//
+// A clue is keyed by its answer's word ID: the answer packed the way .cwdb
+// words are (5 bits per letter), which also tells answers of different lengths
+// apart. The file is mapped, never read: opening validates the header, a
+// lookup binary-searches the index and a clue's text is touched only when it is
+// shown, so resident memory follows the clues on screen, not the file size.
+
+#define CLUE_DB_MAGIC 0x4C435743u             // "CWCL"
+#define CLUE_DB_VERSION 1u
+#define CLUE_MAX_LENGTH 255                   // Bytes of text per clue, longer ones are cut
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t clue_count;
+    uint32_t reserved;
+    uint64_t index_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t file_size;
+} ClueDbHeader;
+
+typedef struct {
+    uint64_t word;                            // Answer's word ID
+    uint32_t text_offset;                     // Into the string table
+    uint32_t text_length;                     // Without the terminator
+} ClueIndexEntry;
+
+// One clue handed to clue_db_write
+typedef struct {
+    uint64_t word;
+    const char* text;
+} ClueSource;
+
+// Writes a database from clues in any order. A word listed twice keeps its
+// first clue; entries with a zero word are skipped. Returns 1 on success.
+int clue_db_write(const char* path, const ClueSource* clues, int clue_count);
+
+#endif
@@ -1,7 +1,7 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
-#include "raylib.h"
+#include "platform_types.h"
 
 #define DEFAULT_SCREEN_WIDTH 800
 #define DEFAULT_SCREEN_HEIGHT 600
@@ -11,10 +11,23 @@
 #define BOARD_MARGIN_TOP 120
 #define BOARD_MARGIN_BOTTOM 150
 
+// On-screen keyboard: QWERTY letter rows, ENTER and BACKSPACE on the last row
+#define KEYBOARD_KEY_COUNT 28
+#define KEYBOARD_KEY_SPACING 4
+#define KEYBOARD_CROSSWORD_MARGIN_BOTTOM 90  // Room for the crossword's bottom bar
+
 // Level system constants
 #define MAX_RECENT_GUESSES 20
 #define RESULT_DISPLAY_TIME 1.5f
 
+// Word difficulty progression constants
+#define DIFFICULTY_BUCKET_COUNT 8            // Equal-size difficulty tiers per dictionary
+#define LEVELS_PER_DIFFICULTY_BUCKET 3       // Levels spent in each tier before moving up
+#define DEFAULT_WORD_REPEAT_WINDOW 8         // Draws before a repeat; the smallest built-in list allows 8
+#define WORD_DRAW_MAX_ATTEMPTS 16            // Redraws allowed when hitting a recent word
+#define FEEDBACK_MATRIX_MAX_WORDS 1024       // Larger lists rely on precomputed difficulty
+#define SOLVER_MAX_GUESSES 20                // Solver gives up (and rates hardest) here
+
 // Animation constants
 #define LETTER_REVEAL_DURATION 0.6f          // Total time for letter reveal animation
 #define LETTER_REVEAL_STAGGER 0.1f           // Delay between each letter reveal
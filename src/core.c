@@ -0,0 +1,148 @@
+#include "systems.h"
+#include "crosswordle.h"
+
+// Frame pipeline and the public API of the core library
+
+GameState game_tick(GameState state, const GameInput* input) {
+    state = input_system(state, input);
+    
+    // One pass of the gameplay systems per queued input event (at least one
+    // pass per frame), so every key pressed this frame is applied in order
+    do {
+        state = input_action_system(state);
+        state = view_switching_system(state);
+        
+        if (state.current_view == VIEW_HOME_SCREEN) {
+            state = home_screen_input_system(state);
+        } else if (state.current_view == VIEW_WORDLE) {
+            state = word_editing_system(state);
+            state = word_validation_system(state);
+            state = result_display_system(state);
+            state = level_progression_system(state);
+            
+            // Handle new level setup
+            if (state.core.play_state == GAME_STATE_INPUT_READY) {
+                // Draw the next level's word from its difficulty tier
+                get_themed_word_for_level(state.core.word_length, state.core.current_level + 1, state.core.theme,
+                                          state.core.target_word);
+                state = new_level_system(state);
+            }
+        } else if (state.current_view == VIEW_CROSSWORD) {
+            state = crossword_input_system(state);
+            state = crossword_word_validation_system(state);
+        } else if (state.current_view == VIEW_CROSSWORD_COMPLETE) {
+            state = crossword_completion_input_system(state);
+        }
+    } while (input_event_count(&state.system.events) > 0);
+    
+    // Update animations for all views
+    state = animation_update_system(state);
+    
+    // Refresh cached HUD text (only rebuilds strings whose numbers changed)
+    state = hud_update_system(state);
+    return state;
+}
+
+// ============= PUBLIC API =============
+
+struct CrosswordleGame {
+    GameState state;
+};
+
+int crosswordle_api_version(void) {
+    return CROSSWORDLE_API_VERSION;
+}
+
+CrosswordleGame* crosswordle_create(void) {
+    CrosswordleGame* game = malloc(sizeof(CrosswordleGame));
+    if (game) {
+        game->state = create_game_state("");
+    }
+    return game;
+}
+
+void crosswordle_destroy(CrosswordleGame* game) {
+    free(game);
+}
+
+// Monotonic high-resolution clock in seconds, for GameInput.time. Input
+// latency and speed mode timers are differences of its readings.
+double crosswordle_clock(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+GameInput crosswordle_input(float frame_time, int screen_width, int screen_height) {
+    GameInput input = {0};
+    input.frame_time = frame_time;
+    input.screen_width = screen_width;
+    input.screen_height = screen_height;
+    return input;
+}
+
+// Appends a key to this frame's key queue, in press order
+void crosswordle_input_press(GameInput* input, int key) {
+    if (input->key_count < GAME_INPUT_MAX_KEYS) {
+        input->keys[input->key_count++] = key;
+    } else {
+        input->keys_dropped++;
+    }
+}
+
+// Left click at a screen position (the on-screen keyboard turns it into a key)
+void crosswordle_input_click(GameInput* input, int x, int y) {
+    input->buttons |= GAME_BUTTON_CLICK;
+    input->mouse_x = x;
+    input->mouse_y = y;
+}
+
+void crosswordle_tick(CrosswordleGame* game, const GameInput* input) {
+    game->state = game_tick(game->state, input);
+}
+
+const GameState* crosswordle_state(const CrosswordleGame* game) {
+    return &game->state;
+}
+
+GameViewState crosswordle_view(const CrosswordleGame* game) {
+    return game->state.current_view;
+}
+
+int crosswordle_current_level(const CrosswordleGame* game) {
+    return game->state.core.current_level;
+}
+
+int crosswordle_word_length(const CrosswordleGame* game) {
+    return game->state.core.word_length;
+}
+
+int crosswordle_guess_count(const CrosswordleGame* game) {
+    return game->state.core.guesses_this_level;
+}
+
+int crosswordle_level_complete(const CrosswordleGame* game) {
+    return game->state.core.level_complete;
+}
+
+int crosswordle_last_feedback(const CrosswordleGame* game, LetterState* out_states) {
+    const GameHistoryState* history = &game->state.history;
+    if (history->level_guess_count == 0) {
+        return 0;
+    }
+    int length = game->state.core.word_length;
+    memcpy(out_states, history->level_letter_states[history->level_guess_count - 1], (size_t)length * sizeof(LetterState));
+    return length;
+}
+
+int crosswordle_token_count(const CrosswordleGame* game, char letter) {
+    return token_ledger_count(&game->state.stats.tokens, letter);
+}
+
+int crosswordle_token_total(const CrosswordleGame* game) {
+    return token_ledger_total(&game->state.stats.tokens);
+}
+
+int crosswordle_crossword_complete(const CrosswordleGame* game) {
+    return game->state.crossword.puzzle_completed;
+}
@@ -0,0 +1,1042 @@
+#include <stdatomic.h>
+#include "systems.h"
+#include "crossword_solver.h"
+#include "jobs.h"
+
+// Fill counting for crossword patterns; see crossword_solver.h for the method.
+// Word i of a length is bit i of a domain; chunk k of a domain holds words
+// 64k..64k+63. Each slot also counts, per cell and letter, how many words of
+// its domain have that letter there. A count that reaches zero strikes the
+// words with that letter from the crossing slot, whose counts then lose the
+// struck words: word by word, or by recounting the words left when fewer
+// remain than went. Domain chunks are logged on a trail as (position, old
+// value); a slot's counts are copied aside the first time a branch changes
+// them, and copied back when the branch is undone.
+
+#define SOLVER_LETTERS 26
+#define SOLVER_MAX_COVER 4                    // Slots sharing one cell
+#define SOLVER_MAX_ARCS (CROSSWORD_SOLVER_MAX_GRID * CROSSWORD_SOLVER_MAX_GRID * SOLVER_MAX_COVER * (SOLVER_MAX_COVER - 1))
+#define SOLVER_JOBS_PER_WORKER 4              // Root ranges per thread, for balance
+#define SOLVER_TRAIL_INITIAL 4096
+#define SOLVER_SAVES_INITIAL 4096
+
+typedef struct {
+    int length;
+    int word_count;
+    int chunk_count;
+    int summary_count;                        // Words of a domain's chunk summary
+    const PackedWord* words;
+    uint64_t* index;                          // [chunk][position][letter]
+    int* counts;                              // [position][letter]: words with that letter there
+} SolverLexicon;
+
+struct CrosswordSolver {
+    SolverLexicon lexicons[CROSSWORD_SOLVER_MAX_GRID + 1];
+};
+
+// Cell shared by two slots: from's from_position is to's to_position
+typedef struct {
+    uint16_t from;
+    uint16_t from_position;
+    uint16_t to;
+    uint16_t to_position;
+} SolverArc;
+
+typedef struct {
+    const CrosswordSolver* solver;
+    const CrosswordPattern* pattern;
+    int domain_offset[CROSSWORD_SOLVER_MAX_SLOTS];
+    int domain_size;                          // Domain chunks over all slots
+    int cell_offset[CROSSWORD_SOLVER_MAX_SLOTS];
+    int cell_count;                           // Slot cells over all slots
+    int count_offset[CROSSWORD_SOLVER_MAX_SLOTS + 1];  // Counts of slot s: [count_offset[s], count_offset[s + 1])
+    uint8_t crossed[CROSSWORD_SOLVER_MAX_SLOTS][CROSSWORD_SOLVER_MAX_GRID];  // Positions shared with another slot;
+    int crossed_count[CROSSWORD_SOLVER_MAX_SLOTS];                            // only their letters are counted
+    int arc_first[CROSSWORD_SOLVER_MAX_SLOTS + 1];  // Arcs out of slot s: [arc_first[s], arc_first[s + 1])
+    int arc_count;
+    SolverArc arcs[SOLVER_MAX_ARCS];
+    int limit;
+    uint64_t node_budget;                     // 0: search until the count is decided
+    _Atomic int fill_count;
+    _Atomic uint64_t nodes;
+    _Atomic uint64_t budget_used;             // Nodes charged to node_budget, over all threads
+    _Atomic int out_of_budget;
+    _Atomic int out_of_memory;
+    CrosswordSolveResult* result;
+} SolverProblem;
+
+typedef struct {
+    uint32_t position;
+    uint64_t value;
+} SolverTrailEntry;
+
+typedef struct {
+    uint16_t slot;
+    uint16_t position;
+} SolverCell;
+
+// Where a branch started: undoing it goes back to these
+typedef struct {
+    int trail_count;
+    int save_count;
+    int depth;
+} SolverMark;
+
+typedef struct {
+    SolverProblem* problem;
+    uint64_t* domains;
+    int* counts;                              // Per slot: each cell's letter counts, each cell's letter set, words left
+    int* saved_depth;                         // Per slot, the branch depth its counts were last saved at
+    int depth;                                // Open branches
+    int* saves;                               // Slot counts as before a branch changed them, each followed by (slot, depth)
+    int save_count;
+    int save_capacity;
+    SolverTrailEntry* trail;
+    int trail_count;
+    int trail_capacity;
+    uint32_t* lost;                           // Per cell, letters gone and not yet struck from crossings
+    SolverCell* lost_cells;                   // Ring of cells with lost letters
+    int lost_head;
+    int lost_count;
+    uint64_t* struck;                         // Words one arc strikes, per chunk listed in struck_chunks
+    int* struck_chunks;
+    int struck_count;
+    uint64_t nodes;
+} SolverSearch;
+
+// ============= LEXICONS =============
+
+static int packed_letter(PackedWord word, int length, int position) {
+    return (int)((word >> (PACKED_LETTER_BITS * (length - 1 - position))) & PACKED_LETTER_MASK) - 1;
+}
+
+static int lexicon_build(SolverLexicon* lexicon, const WordDictionary* dictionary) {
+    lexicon->length = dictionary->word_length;
+    lexicon->word_count = dictionary->count;
+    lexicon->chunk_count = (dictionary->count + 63) / 64;
+    lexicon->summary_count = (lexicon->chunk_count + 63) / 64;
+    lexicon->words = dictionary->words;
+    size_t size = (size_t)lexicon->length * SOLVER_LETTERS * (size_t)lexicon->chunk_count;
+    lexicon->index = calloc(size > 0 ? size : 1, sizeof(uint64_t));
+    lexicon->counts = calloc((size_t)lexicon->length * SOLVER_LETTERS, sizeof(int));
+    if (!lexicon->index || !lexicon->counts) {
+        return 0;
+    }
+    for (int i = 0; i < dictionary->count; i++) {
+        for (int p = 0; p < lexicon->length; p++) {
+            int letter = packed_letter(dictionary->words[i], lexicon->length, p);
+            if (letter >= 0 && letter < SOLVER_LETTERS) {
+                size_t row = ((size_t)(i / 64) * (size_t)lexicon->length + (size_t)p) * SOLVER_LETTERS + (size_t)letter;
+                lexicon->index[row] |= 1ull << (i % 64);
+                lexicon->counts[p * SOLVER_LETTERS + letter]++;
+            }
+        }
+    }
+    return 1;
+}
+
+CrosswordSolver* crossword_solver_create(const WordDictionary* const* dictionaries, int dictionary_count) {
+    CrosswordSolver* solver = calloc(1, sizeof(CrosswordSolver));
+    if (!solver) {
+        return NULL;
+    }
+    int count = dictionaries ? dictionary_count : WORD_LENGTH_MODE_COUNT;
+    for (int i = 0; i < count; i++) {
+        const WordDictionary* dictionary = dictionaries ? dictionaries[i] : get_word_dictionary(MIN_WORD_LENGTH + i);
+        if (!dictionary || dictionary->word_length < 1 || dictionary->word_length > CROSSWORD_SOLVER_MAX_GRID ||
+            solver->lexicons[dictionary->word_length].index) {
+            continue;
+        }
+        if (!lexicon_build(&solver->lexicons[dictionary->word_length], dictionary)) {
+            crossword_solver_destroy(solver);
+            return NULL;
+        }
+    }
+    return solver;
+}
+
+void crossword_solver_destroy(CrosswordSolver* solver) {
+    if (!solver) {
+        return;
+    }
+    for (int i = 0; i <= CROSSWORD_SOLVER_MAX_GRID; i++) {
+        free(solver->lexicons[i].index);
+        free(solver->lexicons[i].counts);
+    }
+    free(solver);
+}
+
+// ============= PATTERNS =============
+
+int crossword_pattern_from_level(const CrosswordLevel* level, CrosswordPattern* out_pattern) {
+    if (level->word_count < 0 || level->word_count > 10) {
+        return 0;
+    }
+    memset(out_pattern, 0, sizeof(*out_pattern));
+    out_pattern->width = 9;
+    out_pattern->height = 9;
+    out_pattern->slot_count = level->word_count;
+    for (int i = 0; i < level->word_count; i++) {
+        out_pattern->slots[i] = level->words[i];
+    }
+    return 1;
+}
+
+int crossword_pattern_from_mask(int width, int height, const uint8_t mask[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID],
+                                CrosswordPattern* out_pattern) {
+    if (width < 1 || height < 1 || width > CROSSWORD_SOLVER_MAX_GRID || height > CROSSWORD_SOLVER_MAX_GRID) {
+        return 0;
+    }
+    memset(out_pattern, 0, sizeof(*out_pattern));
+    out_pattern->width = width;
+    out_pattern->height = height;
+    for (int direction = 0; direction < 2; direction++) {
+        int lines = direction == 0 ? height : width;
+        int cells = direction == 0 ? width : height;
+        for (int line = 0; line < lines; line++) {
+            int run = 0;
+            for (int i = 0; i <= cells; i++) {
+                int x = direction == 0 ? i : line;
+                int y = direction == 0 ? line : i;
+                if (i < cells && mask[x][y]) {
+                    run++;
+                    continue;
+                }
+                if (run >= 2) {
+                    if (out_pattern->slot_count == CROSSWORD_SOLVER_MAX_SLOTS) {
+                        return 0;
+                    }
+                    CrosswordWord* slot = &out_pattern->slots[out_pattern->slot_count++];
+                    slot->start_x = direction == 0 ? i - run : line;
+                    slot->start_y = direction == 0 ? line : i - run;
+                    slot->direction = direction;
+                    slot->length = run;
+                }
+                run = 0;
+            }
+        }
+    }
+    return 1;
+}
+
+// ============= SEARCH =============
+
+static const SolverLexicon* slot_lexicon(const SolverProblem* problem, int slot) {
+    return &problem->solver->lexicons[problem->pattern->slots[slot].length];
+}
+
+static uint64_t* slot_domain(SolverSearch* search, int slot) {
+    return search->domains + search->problem->domain_offset[slot];
+}
+
+// Bit k is set while chunk k of the slot's domain holds words, so scans skip
+// the empty chunks
+static uint64_t* slot_summary(SolverSearch* search, int slot) {
+    return slot_domain(search, slot) + slot_lexicon(search->problem, slot)->chunk_count;
+}
+
+// Letter counts of a slot's cells, SOLVER_LETTERS per cell
+static int* slot_counts(SolverSearch* search, int slot) {
+    return search->counts + search->problem->count_offset[slot];
+}
+
+// Per cell of a slot, the letters with a nonzero count
+static int* slot_letters(SolverSearch* search, int slot) {
+    return slot_counts(search, slot) + search->problem->pattern->slots[slot].length * SOLVER_LETTERS;
+}
+
+// Words left in a slot's domain
+static int* slot_size(SolverSearch* search, int slot) {
+    return search->counts + search->problem->count_offset[slot + 1] - 1;
+}
+
+static int trail_set(SolverSearch* search, uint64_t* chunk, uint64_t value) {
+    if (search->trail_count == search->trail_capacity) {
+        int capacity = search->trail_capacity * 2;
+        SolverTrailEntry* trail = realloc(search->trail, sizeof(SolverTrailEntry) * (size_t)capacity);
+        if (!trail) {
+            atomic_store(&search->problem->out_of_memory, 1);
+            return 0;
+        }
+        search->trail = trail;
+        search->trail_capacity = capacity;
+    }
+    SolverTrailEntry* entry = &search->trail[search->trail_count++];
+    entry->position = (uint32_t)(chunk - search->domains);
+    entry->value = *chunk;
+    *chunk = value;
+    return 1;
+}
+
+static void trail_undo(SolverSearch* search, int mark) {
+    while (search->trail_count > mark) {
+        SolverTrailEntry* entry = &search->trail[--search->trail_count];
+        search->domains[entry->position] = entry->value;
+    }
+}
+
+// Narrows chunk k of a slot's domain, and its summary bit once it is empty
+static int chunk_set(SolverSearch* search, int slot, int k, uint64_t value) {
+    if (!trail_set(search, &slot_domain(search, slot)[k], value)) {
+        return 0;
+    }
+    uint64_t* summary = &slot_summary(search, slot)[k / 64];
+    return value != 0 || trail_set(search, summary, *summary & ~(1ull << (k % 64)));
+}
+
+static SolverMark search_mark(SolverSearch* search) {
+    SolverMark mark = {search->trail_count, search->save_count, search->depth++};
+    return mark;
+}
+
+// Undoes what the search changed since the mark
+static void search_undo(SolverSearch* search, const SolverMark* mark) {
+    trail_undo(search, mark->trail_count);
+    while (search->save_count > mark->save_count) {
+        int slot = search->saves[search->save_count - 2];
+        int size = search->problem->count_offset[slot + 1] - search->problem->count_offset[slot];
+        search->saved_depth[slot] = search->saves[search->save_count - 1];
+        search->save_count -= size + 2;
+        memcpy(slot_counts(search, slot), search->saves + search->save_count, sizeof(int) * (size_t)size);
+    }
+    search->depth = mark->depth;
+}
+
+// Copies a slot's counts aside the first time the open branch changes them.
+// Returns 0 if there is no room.
+static int counts_touch(SolverSearch* search, int slot) {
+    if (search->saved_depth[slot] == search->depth) {
+        return 1;
+    }
+    int size = search->problem->count_offset[slot + 1] - search->problem->count_offset[slot];
+    if (search->save_count + size + 2 > search->save_capacity) {
+        int capacity = search->save_capacity * 2 + size + 2;
+        int* saves = realloc(search->saves, sizeof(int) * (size_t)capacity);
+        if (!saves) {
+            atomic_store(&search->problem->out_of_memory, 1);
+            return 0;
+        }
+        search->saves = saves;
+        search->save_capacity = capacity;
+    }
+    memcpy(search->saves + search->save_count, slot_counts(search, slot), sizeof(int) * (size_t)size);
+    search->save_count += size;
+    search->saves[search->save_count++] = slot;
+    search->saves[search->save_count++] = search->saved_depth[slot];
+    search->saved_depth[slot] = search->depth;
+    return 1;
+}
+
+// Drops letters from a cell's set and queues them to be struck from the crossings
+static void lose_letters(SolverSearch* search, int slot, int position, uint32_t letters) {
+    int cell = search->problem->cell_offset[slot] + position;
+    slot_letters(search, slot)[position] &= ~(int)letters;
+    if (search->lost[cell] == 0) {
+        int tail = search->lost_head + search->lost_count++;
+        tail -= tail >= search->problem->cell_count ? search->problem->cell_count : 0;
+        search->lost_cells[tail] = (SolverCell){(uint16_t)slot, (uint16_t)position};
+    }
+    search->lost[cell] |= letters;
+}
+
+static SolverCell lost_pop(SolverSearch* search) {
+    SolverCell cell = search->lost_cells[search->lost_head];
+    search->lost_head = search->lost_head + 1 == search->problem->cell_count ? 0 : search->lost_head + 1;
+    search->lost_count--;
+    return cell;
+}
+
+static void lost_clear(SolverSearch* search) {
+    while (search->lost_count > 0) {
+        SolverCell cell = lost_pop(search);
+        search->lost[search->problem->cell_offset[cell.slot] + cell.position] = 0;
+    }
+}
+
+// Takes struck words of chunk k off their slot's letter counts
+static void take_words(SolverSearch* search, int slot, int k, uint64_t struck) {
+    const SolverProblem* problem = search->problem;
+    const SolverLexicon* lexicon = slot_lexicon(problem, slot);
+    int* counts = slot_counts(search, slot);
+    for (; struck; struck &= struck - 1) {
+        PackedWord word = lexicon->words[k * 64 + __builtin_ctzll(struck)];
+        for (int i = 0; i < problem->crossed_count[slot]; i++) {
+            int p = problem->crossed[slot][i];
+            int letter = packed_letter(word, lexicon->length, p);
+            if (letter >= 0 && letter < SOLVER_LETTERS && --counts[p * SOLVER_LETTERS + letter] == 0) {
+                lose_letters(search, slot, p, 1u << letter);
+            }
+        }
+    }
+}
+
+// Letters with a nonzero count at one cell of a slot
+static uint32_t letters_left(const int* cell_counts) {
+    uint32_t letters = 0;
+    for (int c = 0; c < SOLVER_LETTERS; c++) {
+        letters |= cell_counts[c] > 0 ? 1u << c : 0u;
+    }
+    return letters;
+}
+
+// Counts a slot's letters again from the words it has left
+static void recount_words(SolverSearch* search, int slot) {
+    const SolverProblem* problem = search->problem;
+    const SolverLexicon* lexicon = slot_lexicon(problem, slot);
+    const uint64_t* domain = slot_domain(search, slot);
+    const uint64_t* summary = slot_summary(search, slot);
+    int* counts = slot_counts(search, slot);
+    const int* before = slot_letters(search, slot);
+    uint32_t after[CROSSWORD_SOLVER_MAX_GRID] = {0};
+    memset(counts, 0, sizeof(int) * (size_t)lexicon->length * SOLVER_LETTERS);
+    for (int w = 0; w < lexicon->summary_count; w++) {
+        for (uint64_t live = summary[w]; live; live &= live - 1) {
+            int k = w * 64 + __builtin_ctzll(live);
+            for (uint64_t bits = domain[k]; bits; bits &= bits - 1) {
+                PackedWord word = lexicon->words[k * 64 + __builtin_ctzll(bits)];
+                for (int i = 0; i < problem->crossed_count[slot]; i++) {
+                    int p = problem->crossed[slot][i];
+                    int letter = packed_letter(word, lexicon->length, p);
+                    if (letter >= 0 && letter < SOLVER_LETTERS) {
+                        counts[p * SOLVER_LETTERS + letter]++;
+                        after[p] |= 1u << letter;
+                    }
+                }
+            }
+        }
+    }
+    for (int i = 0; i < problem->crossed_count[slot]; i++) {
+        int p = problem->crossed[slot][i];
+        uint32_t lost = (uint32_t)before[p] & ~after[p];
+        if (lost) {
+            lose_letters(search, slot, p, lost);
+        }
+    }
+}
+
+// Strikes the listed struck words from a slot (`count` in all) and updates
+// the letter counts by whichever is fewer, the words struck or the words
+// left. Returns 0 if no word is left.
+static int strike_words(SolverSearch* search, int slot, int count) {
+    const uint64_t* domain = slot_domain(search, slot);
+    int* size = slot_size(search, slot);
+    if (!counts_touch(search, slot)) {
+        return 0;
+    }
+    int recount = count > *size - count;
+    for (int i = 0; i < search->struck_count; i++) {
+        int k = search->struck_chunks[i];
+        if (!chunk_set(search, slot, k, domain[k] & ~search->struck[i])) {
+            return 0;
+        }
+        if (!recount) {
+            take_words(search, slot, k, search->struck[i]);
+        }
+    }
+    *size -= count;
+    if (*size == 0) {
+        return 0;
+    }
+    if (recount) {
+        recount_words(search, slot);
+    }
+    return 1;
+}
+
+// Strikes one word from a slot. Returns 0 if no word is left.
+static int strike_word(SolverSearch* search, int slot, int word) {
+    const uint64_t* chunk = &slot_domain(search, slot)[word / 64];
+    uint64_t bit = 1ull << (word % 64);
+    if (!counts_touch(search, slot) || !chunk_set(search, slot, word / 64, *chunk & ~bit)) {
+        return 0;
+    }
+    take_words(search, slot, word / 64, bit);
+    return --*slot_size(search, slot) > 0;
+}
+
+// Strikes from arc->to every word with one of `removed` at the crossing, by
+// the removed letters' index rows or, when fewer, the `kept` letters' rows.
+// Only letters arc->to still has there matter. Returns 0 if no word is left.
+static int strike_letters(SolverSearch* search, const SolverArc* arc, uint32_t removed, uint32_t kept) {
+    uint32_t present = (uint32_t)slot_letters(search, arc->to)[arc->to_position];
+    removed &= present;
+    kept &= present;
+    if (!removed) {
+        return 1;
+    }
+    const SolverLexicon* lexicon = slot_lexicon(search->problem, arc->to);
+    const uint64_t* to = slot_domain(search, arc->to);
+    const uint64_t* summary = slot_summary(search, arc->to);
+    int by_kept = __builtin_popcount(kept) < __builtin_popcount(removed);
+    uint32_t letters = by_kept ? kept : removed;
+    int count = 0;
+    search->struck_count = 0;
+    for (int w = 0; w < lexicon->summary_count; w++) {
+        for (uint64_t live = summary[w]; live; live &= live - 1) {
+            int k = w * 64 + __builtin_ctzll(live);
+            const uint64_t* rows = lexicon->index + ((size_t)k * (size_t)lexicon->length + arc->to_position) * SOLVER_LETTERS;
+            uint64_t matched = 0;
+            for (uint32_t rest = letters; rest; rest &= rest - 1) {
+                matched |= rows[__builtin_ctz(rest)];
+            }
+            uint64_t struck = to[k] & (by_kept ? ~matched : matched);
+            if (struck) {
+                search->struck[search->struck_count] = struck;
+                search->struck_chunks[search->struck_count++] = k;
+                count += __builtin_popcountll(struck);
+            }
+        }
+    }
+    return count == 0 || strike_words(search, arc->to, count);
+}
+
+// Strikes the lost letters' words from the crossing slots until no letter is
+// left to pass on; the counts tell which letters went without rescanning any
+// domain. Returns 0 on a wipeout.
+static int propagate(SolverSearch* search) {
+    const SolverProblem* problem = search->problem;
+    while (search->lost_count > 0) {
+        SolverCell cell = lost_pop(search);
+        int index = problem->cell_offset[cell.slot] + cell.position;
+        uint32_t removed = search->lost[index];
+        uint32_t kept = (uint32_t)slot_letters(search, cell.slot)[cell.position];
+        search->lost[index] = 0;
+        for (int a = problem->arc_first[cell.slot]; a < problem->arc_first[cell.slot + 1]; a++) {
+            const SolverArc* arc = &problem->arcs[a];
+            if (arc->from_position == cell.position && !strike_letters(search, arc, removed, kept)) {
+                lost_clear(search);
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static int first_word(SolverSearch* search, int slot) {
+    const uint64_t* summary = slot_summary(search, slot);
+    for (int w = 0; w < slot_lexicon(search->problem, slot)->summary_count; w++) {
+        if (summary[w]) {
+            int k = w * 64 + __builtin_ctzll(summary[w]);
+            return k * 64 + __builtin_ctzll(slot_domain(search, slot)[k]);
+        }
+    }
+    return -1;
+}
+
+// Narrows a slot to one word, strikes the word from the other slots of its
+// length and propagates. Returns 0 on a wipeout.
+static int assign(SolverSearch* search, int slot, int word) {
+    const CrosswordPattern* pattern = search->problem->pattern;
+    const uint64_t* domain = slot_domain(search, slot);
+    const uint64_t* summary = slot_summary(search, slot);
+    uint64_t bit = 1ull << (word % 64);
+    search->struck_count = 0;
+    for (int w = 0; w < slot_lexicon(search->problem, slot)->summary_count; w++) {
+        for (uint64_t live = summary[w]; live; live &= live - 1) {
+            int k = w * 64 + __builtin_ctzll(live);
+            uint64_t struck = domain[k] & (k == word / 64 ? ~bit : ~0ull);
+            if (struck) {
+                search->struck[search->struck_count] = struck;
+                search->struck_chunks[search->struck_count++] = k;
+            }
+        }
+    }
+    if (*slot_size(search, slot) > 1 && !strike_words(search, slot, *slot_size(search, slot) - 1)) {
+        lost_clear(search);
+        return 0;
+    }
+
+    for (int s = 0; s < pattern->slot_count; s++) {
+        if (s == slot || pattern->slots[s].length != pattern->slots[slot].length) {
+            continue;
+        }
+        if ((slot_domain(search, s)[word / 64] & bit) && !strike_word(search, s, word)) {
+            lost_clear(search);
+            return 0;
+        }
+    }
+    return propagate(search);
+}
+
+// Strikes a word from a slot and propagates. Returns 0 on a wipeout.
+static int refute(SolverSearch* search, int slot, int word) {
+    if (!strike_word(search, slot, word)) {
+        lost_clear(search);
+        return 0;
+    }
+    return propagate(search);
+}
+
+// Slot with the fewest candidates above one, or -1 if every slot has one
+static int choose_slot(SolverSearch* search) {
+    int best = -1;
+    int best_count = INT32_MAX;
+    for (int s = 0; s < search->problem->pattern->slot_count; s++) {
+        int count = *slot_size(search, s);
+        if (count > 1 && count < best_count) {
+            best = s;
+            best_count = count;
+            if (count == 2) {
+                break;
+            }
+        }
+    }
+    return best;
+}
+
+static int limit_reached(SolverSearch* search) {
+    return atomic_load_explicit(&search->problem->fill_count, memory_order_relaxed) >= search->problem->limit ||
+           atomic_load_explicit(&search->problem->out_of_budget, memory_order_relaxed) ||
+           atomic_load_explicit(&search->problem->out_of_memory, memory_order_relaxed);
+}
+
+// Charges one node to the budget; 0 once it is spent
+static int charge_node(SolverProblem* problem) {
+    if (problem->node_budget == 0) {
+        return 1;
+    }
+    if (atomic_fetch_add_explicit(&problem->budget_used, 1, memory_order_relaxed) < problem->node_budget) {
+        return 1;
+    }
+    atomic_store_explicit(&problem->out_of_budget, 1, memory_order_relaxed);
+    return 0;
+}
+
+// Every slot has one word: a fill, unless two slots share a word
+static void record_fill(SolverSearch* search) {
+    SolverProblem* problem = search->problem;
+    PackedWord words[CROSSWORD_SOLVER_MAX_SLOTS];
+    for (int s = 0; s < problem->pattern->slot_count; s++) {
+        const SolverLexicon* lexicon = slot_lexicon(problem, s);
+        words[s] = lexicon->words[first_word(search, s)];
+        for (int t = 0; t < s; t++) {
+            if (words[t] == words[s]) {
+                return;
+            }
+        }
+    }
+    int index = atomic_fetch_add(&problem->fill_count, 1);
+    if (index < problem->limit && index < CROSSWORD_SOLVER_MAX_FILLS) {
+        memcpy(problem->result->fills[index], words, sizeof(PackedWord) * (size_t)problem->pattern->slot_count);
+    }
+}
+
+static void search_node(SolverSearch* search) {
+    search->nodes++;
+    if (!charge_node(search->problem) || limit_reached(search)) {
+        return;
+    }
+    int slot = choose_slot(search);
+    if (slot < 0) {
+        record_fill(search);
+        return;
+    }
+
+    // Try each candidate in turn; a failed one is struck out before the next
+    SolverMark mark = search_mark(search);
+    for (int word = first_word(search, slot); word >= 0; word = first_word(search, slot)) {
+        SolverMark child = search_mark(search);
+        if (assign(search, slot, word)) {
+            search_node(search);
+        }
+        search_undo(search, &child);
+        if (limit_reached(search) || !refute(search, slot, word)) {
+            break;
+        }
+    }
+    search_undo(search, &mark);
+}
+
+// Copies `from`'s domains and counts, or with NULL starts every slot on every
+// word of its length
+static int search_init(SolverSearch* search, SolverProblem* problem, const SolverSearch* from) {
+    memset(search, 0, sizeof(*search));
+    search->problem = problem;
+    int max_chunks = 1;
+    for (int s = 0; s < problem->pattern->slot_count; s++) {
+        int chunk_count = slot_lexicon(problem, s)->chunk_count;
+        max_chunks = chunk_count > max_chunks ? chunk_count : max_chunks;
+    }
+    int cells = problem->cell_count > 0 ? problem->cell_count : 1;
+    int slots = problem->pattern->slot_count > 0 ? problem->pattern->slot_count : 1;
+    search->domains = calloc((size_t)(problem->domain_size > 0 ? problem->domain_size : 1), sizeof(uint64_t));
+    int count_size = problem->count_offset[problem->pattern->slot_count];
+    search->counts = calloc((size_t)(count_size > 0 ? count_size : 1), sizeof(int));
+    search->saved_depth = calloc((size_t)slots, sizeof(int));
+    search->save_capacity = SOLVER_SAVES_INITIAL;
+    search->saves = malloc(sizeof(int) * (size_t)search->save_capacity);
+    search->trail_capacity = SOLVER_TRAIL_INITIAL;
+    search->trail = malloc(sizeof(SolverTrailEntry) * (size_t)search->trail_capacity);
+    search->lost = calloc((size_t)cells, sizeof(uint32_t));
+    search->lost_cells = malloc(sizeof(SolverCell) * (size_t)cells);
+    search->struck = malloc(sizeof(uint64_t) * (size_t)max_chunks);
+    search->struck_chunks = malloc(sizeof(int) * (size_t)max_chunks);
+    if (!search->domains || !search->counts || !search->saved_depth || !search->saves || !search->trail || !search->lost ||
+        !search->lost_cells || !search->struck || !search->struck_chunks) {
+        atomic_store(&problem->out_of_memory, 1);
+        return 0;
+    }
+    if (from) {
+        memcpy(search->domains, from->domains, sizeof(uint64_t) * (size_t)problem->domain_size);
+        memcpy(search->counts, from->counts, sizeof(int) * (size_t)count_size);
+        return 1;
+    }
+    for (int s = 0; s < problem->pattern->slot_count; s++) {
+        const SolverLexicon* lexicon = slot_lexicon(problem, s);
+        uint64_t* domain = slot_domain(search, s);
+        for (int i = 0; i < lexicon->word_count; i++) {
+            domain[i / 64] |= 1ull << (i % 64);
+        }
+        for (int k = 0; k < lexicon->chunk_count; k++) {
+            domain[lexicon->chunk_count + k / 64] |= 1ull << (k % 64);
+        }
+        *slot_size(search, s) = lexicon->word_count;
+        int* counts = slot_counts(search, s);
+        for (int i = 0; i < problem->crossed_count[s]; i++) {
+            int p = problem->crossed[s][i];
+            memcpy(counts + p * SOLVER_LETTERS, lexicon->counts + p * SOLVER_LETTERS, sizeof(int) * SOLVER_LETTERS);
+            uint32_t present = letters_left(counts + p * SOLVER_LETTERS);
+            slot_letters(search, s)[p] = (int)present;
+            if (present != (1u << SOLVER_LETTERS) - 1) {
+                lose_letters(search, s, p, ~present & ((1u << SOLVER_LETTERS) - 1));
+            }
+        }
+    }
+    return 1;
+}
+
+static void search_free(SolverSearch* search) {
+    atomic_fetch_add(&search->problem->nodes, search->nodes);
+    free(search->domains);
+    free(search->counts);
+    free(search->saved_depth);
+    free(search->saves);
+    free(search->trail);
+    free(search->lost);
+    free(search->lost_cells);
+    free(search->struck);
+    free(search->struck_chunks);
+}
+
+// ============= ROOT SPLIT =============
+
+typedef struct {
+    SolverProblem* problem;
+    const SolverSearch* search;               // After the root propagation
+    int slot;
+    const int* candidates;
+} SolverRoot;
+
+static void search_root_range(void* context, int begin, int end) {
+    SolverRoot* root = context;
+    SolverSearch search;
+    if (search_init(&search, root->problem, root->search)) {
+        for (int i = begin; i < end && !limit_reached(&search); i++) {
+            SolverMark mark = search_mark(&search);
+            if (assign(&search, root->slot, root->candidates[i])) {
+                search_node(&search);
+            }
+            search_undo(&search, &mark);
+        }
+    }
+    search_free(&search);
+}
+
+// Arcs between every pair of slots sharing a cell, grouped by `from`, and the
+// crossed positions of each slot
+static int build_arcs(SolverProblem* problem) {
+    const CrosswordPattern* pattern = problem->pattern;
+    int cover_slot[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID][SOLVER_MAX_COVER];
+    int cover_position[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID][SOLVER_MAX_COVER];
+    int cover_count[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID] = {{0}};
+
+    for (int s = 0; s < pattern->slot_count; s++) {
+        const CrosswordWord* slot = &pattern->slots[s];
+        for (int p = 0; p < slot->length; p++) {
+            int x = slot->start_x + (slot->direction == 0 ? p : 0);
+            int y = slot->start_y + (slot->direction == 0 ? 0 : p);
+            int n = cover_count[x][y]++;
+            if (n == SOLVER_MAX_COVER) {
+                return 0;
+            }
+            cover_slot[x][y][n] = s;
+            cover_position[x][y][n] = p;
+        }
+    }
+
+    problem->arc_count = 0;
+    for (int s = 0; s < pattern->slot_count; s++) {
+        problem->arc_first[s] = problem->arc_count;
+        const CrosswordWord* slot = &pattern->slots[s];
+        for (int p = 0; p < slot->length; p++) {
+            int x = slot->start_x + (slot->direction == 0 ? p : 0);
+            int y = slot->start_y + (slot->direction == 0 ? 0 : p);
+            for (int n = 0; n < cover_count[x][y]; n++) {
+                if (cover_slot[x][y][n] == s) {
+                    continue;
+                }
+                SolverArc* arc = &problem->arcs[problem->arc_count++];
+                arc->from = (uint16_t)s;
+                arc->from_position = (uint16_t)p;
+                arc->to = (uint16_t)cover_slot[x][y][n];
+                arc->to_position = (uint16_t)cover_position[x][y][n];
+            }
+            if (cover_count[x][y] > 1) {
+                problem->crossed[s][problem->crossed_count[s]++] = (uint8_t)p;
+            }
+        }
+    }
+    problem->arc_first[pattern->slot_count] = problem->arc_count;
+    return 1;
+}
+
+// Counts the fills of one connected pattern
+static int count_connected(const CrosswordSolver* solver, const CrosswordPattern* pattern, int limit,
+                           uint64_t node_budget, CrosswordSolveResult* out_result) {
+    memset(out_result, 0, sizeof(*out_result));
+    SolverProblem* problem = calloc(1, sizeof(SolverProblem));
+    if (!problem) {
+        return -1;
+    }
+    problem->solver = solver;
+    problem->pattern = pattern;
+    problem->limit = limit;
+    problem->node_budget = node_budget;
+    problem->result = out_result;
+    int solvable = 1;
+    for (int s = 0; s < pattern->slot_count; s++) {
+        problem->domain_offset[s] = problem->domain_size;
+        problem->domain_size += slot_lexicon(problem, s)->chunk_count + slot_lexicon(problem, s)->summary_count;
+        problem->cell_offset[s] = problem->cell_count;
+        problem->cell_count += pattern->slots[s].length;
+        problem->count_offset[s + 1] = problem->count_offset[s] + pattern->slots[s].length * (SOLVER_LETTERS + 1) + 1;
+        solvable = solvable && slot_lexicon(problem, s)->word_count > 0;
+    }
+    if (!build_arcs(problem)) {
+        free(problem);
+        return -1;
+    }
+
+    // Every word of the right length, then arc consistency over the whole grid
+    SolverSearch root;
+    if (solvable && search_init(&root, problem, NULL)) {
+        root.nodes = 1;
+        atomic_store(&problem->budget_used, 1);
+        if (propagate(&root)) {
+            int slot = choose_slot(&root);
+            if (slot < 0) {
+                record_fill(&root);
+            } else {
+                // Split the first choice's candidates into ranges for the workers
+                const SolverLexicon* lexicon = slot_lexicon(problem, slot);
+                int* candidates = malloc(sizeof(int) * (size_t)lexicon->word_count);
+                int candidate_count = 0;
+                const uint64_t* domain = slot_domain(&root, slot);
+                for (int i = 0; candidates && i < lexicon->word_count; i++) {
+                    if (domain[i / 64] & (1ull << (i % 64))) {
+                        candidates[candidate_count++] = i;
+                    }
+                }
+                if (candidates) {
+                    SolverRoot split = {problem, &root, slot, candidates};
+                    int ranges = (jobs_worker_count() + 1) * SOLVER_JOBS_PER_WORKER;
+                    int grain = (candidate_count + ranges - 1) / ranges;
+                    jobs_parallel_for(candidate_count, grain > 0 ? grain : 1, search_root_range, &split);
+                } else {
+                    atomic_store(&problem->out_of_memory, 1);
+                }
+                free(candidates);
+            }
+        }
+        search_free(&root);
+    } else if (solvable) {
+        search_free(&root);
+    }
+
+    int fill_count = atomic_load(&problem->fill_count);
+    out_result->fill_count = fill_count < limit ? fill_count : limit;
+    out_result->nodes = atomic_load(&problem->nodes);
+    int failed = atomic_load(&problem->out_of_memory);
+    // Running out after the limit was reached still decided the count
+    int undecided = atomic_load(&problem->out_of_budget) && fill_count < limit;
+    free(problem);
+    return failed ? -1 : undecided ? CROSSWORD_SOLVER_UNKNOWN : out_result->fill_count;
+}
+
+// ============= COMPONENTS =============
+
+static int component_root(int* parent, int slot) {
+    while (parent[slot] != slot) {
+        parent[slot] = parent[parent[slot]];
+        slot = parent[slot];
+    }
+    return slot;
+}
+
+// Groups slots that share cells, directly or through other slots. Returns the
+// number of components; component[s] is slot s's.
+static int find_components(const CrosswordPattern* pattern, int* component) {
+    int parent[CROSSWORD_SOLVER_MAX_SLOTS];
+    int owner[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID];
+    memset(owner, -1, sizeof(owner));
+    for (int s = 0; s < pattern->slot_count; s++) {
+        parent[s] = s;
+        const CrosswordWord* slot = &pattern->slots[s];
+        for (int p = 0; p < slot->length; p++) {
+            int x = slot->start_x + (slot->direction == 0 ? p : 0);
+            int y = slot->start_y + (slot->direction == 0 ? 0 : p);
+            if (owner[x][y] >= 0) {
+                parent[component_root(parent, s)] = component_root(parent, owner[x][y]);
+            }
+            owner[x][y] = s;
+        }
+    }
+
+    int count = 0;
+    int numbered[CROSSWORD_SOLVER_MAX_SLOTS];
+    for (int s = 0; s < pattern->slot_count; s++) {
+        numbered[s] = -1;
+    }
+    for (int s = 0; s < pattern->slot_count; s++) {
+        int root = component_root(parent, s);
+        if (numbered[root] < 0) {
+            numbered[root] = count++;
+        }
+        component[s] = numbered[root];
+    }
+    return count;
+}
+
+// 1 if a fill found for one component uses a word found for another
+static int components_share_words(const CrosswordPattern* pattern, const int* component, const int* fill_count,
+                                  const CrosswordSolveResult* fills) {
+    for (int s = 0; s < pattern->slot_count; s++) {
+        for (int t = 0; t < s; t++) {
+            if (component[s] == component[t] || pattern->slots[s].length != pattern->slots[t].length) {
+                continue;
+            }
+            for (int f = 0; f < fill_count[component[s]]; f++) {
+                for (int g = 0; g < fill_count[component[t]]; g++) {
+                    if (fills->fills[f][s] == fills->fills[g][t]) {
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// Budget left after `used` nodes: 0 if it is spent, and no budget stays none
+static int budget_left(uint64_t node_budget, uint64_t used, uint64_t* out_left) {
+    *out_left = node_budget > used ? node_budget - used : 0;
+    return node_budget == 0 || *out_left > 0;
+}
+
+int crossword_solver_count(const CrosswordSolver* solver, const CrosswordPattern* pattern, int limit,
+                           CrosswordSolveResult* out_result) {
+    return crossword_solver_count_within(solver, pattern, limit, 0, out_result);
+}
+
+int crossword_solver_count_within(const CrosswordSolver* solver, const CrosswordPattern* pattern, int limit,
+                                  uint64_t node_budget, CrosswordSolveResult* out_result) {
+    memset(out_result, 0, sizeof(*out_result));
+    if (limit < 1 || limit > CROSSWORD_SOLVER_MAX_FILLS || pattern->slot_count < 0 ||
+        pattern->slot_count > CROSSWORD_SOLVER_MAX_SLOTS || pattern->width > CROSSWORD_SOLVER_MAX_GRID ||
+        pattern->height > CROSSWORD_SOLVER_MAX_GRID) {
+        return -1;
+    }
+    for (int s = 0; s < pattern->slot_count; s++) {
+        const CrosswordWord* slot = &pattern->slots[s];
+        int end_x = slot->start_x + (slot->direction == 0 ? slot->length : 1);
+        int end_y = slot->start_y + (slot->direction == 0 ? 1 : slot->length);
+        if (slot->length < 1 || slot->start_x < 0 || slot->start_y < 0 ||
+            end_x > pattern->width || end_y > pattern->height) {
+            return -1;
+        }
+    }
+
+    int component[CROSSWORD_SOLVER_MAX_SLOTS];
+    int component_count = find_components(pattern, component);
+    if (component_count <= 1) {
+        return count_connected(solver, pattern, limit, node_budget, out_result);
+    }
+
+    // Count each component alone, so a dead end in one is not searched again
+    // under every choice made in another. Fills collect per original slot.
+    CrosswordPattern* part = malloc(sizeof(CrosswordPattern));
+    CrosswordSolveResult* part_result = malloc(sizeof(CrosswordSolveResult));
+    CrosswordSolveResult* found = calloc(1, sizeof(CrosswordSolveResult));
+    int fill_count[CROSSWORD_SOLVER_MAX_SLOTS] = {0};
+    int status = part && part_result && found ? 1 : -1;
+    int ambiguous = -1;
+    for (int c = 0; status > 0 && c < component_count; c++) {
+        *part = (CrosswordPattern){pattern->width, pattern->height, 0, {{0}}};
+        int slots[CROSSWORD_SOLVER_MAX_SLOTS];
+        for (int s = 0; s < pattern->slot_count; s++) {
+            if (component[s] == c) {
+                slots[part->slot_count] = s;
+                part->slots[part->slot_count++] = pattern->slots[s];
+            }
+        }
+        uint64_t left;
+        if (!budget_left(node_budget, out_result->nodes, &left)) {
+            status = CROSSWORD_SOLVER_UNKNOWN;
+            break;
+        }
+        int count = count_connected(solver, part, limit, left, part_result);
+        out_result->nodes += part_result->nodes;
+        if (count <= 0) {
+            status = count;
+            break;
+        }
+        fill_count[c] = count;
+        if (count > 1 && ambiguous < 0) {
+            ambiguous = c;
+        }
+        for (int f = 0; f < count; f++) {
+            for (int i = 0; i < part->slot_count; i++) {
+                found->fills[f][slots[i]] = part_result->fills[f][i];
+            }
+        }
+    }
+
+    if (status > 0 && components_share_words(pattern, component, fill_count, found)) {
+        // Two components might want the same word: count them together instead
+        uint64_t nodes = out_result->nodes;
+        uint64_t left;
+        status = budget_left(node_budget, nodes, &left) ?
+                 count_connected(solver, pattern, limit, left, out_result) : CROSSWORD_SOLVER_UNKNOWN;
+        out_result->nodes += nodes;
+    } else if (status > 0) {
+        // Every combination of component fills is a fill; the first of each,
+        // then the second of one that has two
+        out_result->fill_count = ambiguous >= 0 ? limit : 1;
+        for (int f = 0; f < out_result->fill_count; f++) {
+            for (int s = 0; s < pattern->slot_count; s++) {
+                out_result->fills[f][s] = found->fills[component[s] == ambiguous ? f : 0][s];
+            }
+        }
+        status = out_result->fill_count;
+    }
+    free(part);
+    free(part_result);
+    free(found);
+    return status;
+}
+
+int crossword_verify_level(const CrosswordLevel* level, CrosswordSolveResult* out_result) {
+    CrosswordSolveResult result = {0};
+    CrosswordPattern pattern = {0};
+    CrosswordSolver* solver = crossword_solver_create(NULL, 0);
+    int unique = solver && level->word_count > 0 && crossword_pattern_from_level(level, &pattern) &&
+                 crossword_solver_count(solver, &pattern, CROSSWORD_SOLVER_MAX_FILLS, &result) == 1;
+    for (int s = 0; unique && s < pattern.slot_count; s++) {
+        unique = result.fills[0][s] == crossword_word_id(level, s);
+    }
+    crossword_solver_destroy(solver);
+    if (out_result) {
+        *out_result = result;
+    }
+    return unique;
+}
@@ -0,0 +1,80 @@
+#ifndef CROSSWORD_SOLVER_H
+#define CROSSWORD_SOLVER_H
+
+#include "types.h"
+
+// Crossword fill counter: proves a grid's letter pattern admits only its
+// intended solution
+//
+// A pattern is a set of slots (CrosswordWord runs) on a grid of up to 15x15.
+// Each slot's domain is a bitset over the dictionary words of its length. For
+// every length the solver keeps a letter-position index: one bitset per
+// (position, letter) of the words with that letter there, so "words of slot B
+// that fit the letters slot A still allows at the crossing" is a few ANDs and
+// ORs per 64 words. Domains are kept arc consistent after every choice with
+// per-cell support counts (AC-4 style): each crossed cell counts, per letter,
+// the slot's words with that letter there. Striking a word decrements its
+// counts, and only a count reaching zero makes the crossing slot look at the
+// index, so a node costs about as much as it removes.
+//
+// The search branches on the slot with the fewest candidates. Domain changes
+// are written in place and logged on a trail, so backtracking undoes exactly
+// what a branch changed, as dancing links does for exact cover, instead of
+// copying every domain per node. A tried word is struck from its slot before
+// the next one is tried. Counting stops at the caller's limit (2 answers
+// "unique or not"). Groups of slots that share no cell are counted one at a
+// time and the counts multiplied. The candidates of the first branching slot
+// are split across the job system, each range searching its own copy of the
+// domains.
+//
+// A fill uses distinct words, like a printed crossword.
+
+#define CROSSWORD_SOLVER_MAX_GRID 15
+#define CROSSWORD_SOLVER_MAX_SLOTS 160        // Runs of 2+ cells in a 15x15 grid fit
+#define CROSSWORD_SOLVER_MAX_FILLS 2          // Fills kept in a result
+#define CROSSWORD_SOLVER_UNKNOWN (-2)         // The node budget ran out first
+
+typedef struct CrosswordSolver CrosswordSolver;
+
+typedef struct {
+    int width;
+    int height;
+    int slot_count;
+    CrosswordWord slots[CROSSWORD_SOLVER_MAX_SLOTS];
+} CrosswordPattern;
+
+typedef struct {
+    int fill_count;                           // Fills found, stopping at the limit
+    uint64_t nodes;                           // Search nodes visited, over all threads
+    PackedWord fills[CROSSWORD_SOLVER_MAX_FILLS][CROSSWORD_SOLVER_MAX_SLOTS];  // Per slot
+} CrosswordSolveResult;
+
+// Builds the letter-position indices for a set of dictionaries (one per word
+// length; lengths without one have no fills). NULL uses the game's word lists.
+CrosswordSolver* crossword_solver_create(const WordDictionary* const* dictionaries, int dictionary_count);
+void crossword_solver_destroy(CrosswordSolver* solver);
+
+// Slots are the level's words
+int crossword_pattern_from_level(const CrosswordLevel* level, CrosswordPattern* out_pattern);
+// Slots are the maximal runs of two or more letter cells (mask[x][y] != 0)
+int crossword_pattern_from_mask(int width, int height, const uint8_t mask[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID],
+                                CrosswordPattern* out_pattern);
+
+// Counts fills of the pattern up to `limit` (at most CROSSWORD_SOLVER_MAX_FILLS),
+// keeping the ones found. Returns the count, or -1 on bad input or no memory.
+int crossword_solver_count(const CrosswordSolver* solver, const CrosswordPattern* pattern, int limit,
+                           CrosswordSolveResult* out_result);
+// Same, but gives up after node_budget search nodes (0: no budget) and then
+// returns CROSSWORD_SOLVER_UNKNOWN unless `limit` fills were already found.
+// A node costs about as many count updates as it strikes words, which still
+// grows with the word lists: a 15x15 grid with a thousand decoys per length
+// takes a few thousand nodes and seconds, so interactive callers should set a
+// budget.
+int crossword_solver_count_within(const CrosswordSolver* solver, const CrosswordPattern* pattern, int limit,
+                                  uint64_t node_budget, CrosswordSolveResult* out_result);
+
+// 1 if the level's solution is the only fill its word cells admit with the
+// game's word lists. out_result (may be NULL) gets the fills found.
+int crossword_verify_level(const CrosswordLevel* level, CrosswordSolveResult* out_result);
+
+#endif
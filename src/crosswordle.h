@@ -0,0 +1,47 @@
+#ifndef CROSSWORDLE_H
+#define CROSSWORDLE_H
+
+#include "types.h"
+
+// Stable C API of the crosswordle_core library.
+//
+// The core has no raylib dependency: a client fills a GameInput each frame,
+// ticks the game and reads results back through the query functions. The
+// window front end, headless tools, benchmarks and tests all drive the same
+// pipeline. GameState itself may change between versions; clients that need
+// only the queries below are insulated from that.
+
+#define CROSSWORDLE_API_VERSION 2
+
+typedef struct CrosswordleGame CrosswordleGame;
+
+int crosswordle_api_version(void);
+
+// Game lifetime. create returns NULL if allocation fails.
+CrosswordleGame* crosswordle_create(void);
+void crosswordle_destroy(CrosswordleGame* game);
+
+// Input helpers: an empty frame, then one call per key pressed this frame
+// (all of them are applied, in order) and one for a mouse click
+GameInput crosswordle_input(float frame_time, int screen_width, int screen_height);
+double crosswordle_clock(void);    // Monotonic seconds, the time base for GameInput.time
+void crosswordle_input_press(GameInput* input, int key);
+void crosswordle_input_click(GameInput* input, int x, int y);
+
+// Runs one frame of game logic
+void crosswordle_tick(CrosswordleGame* game, const GameInput* input);
+
+// Queries
+const GameState* crosswordle_state(const CrosswordleGame* game);   // Full state, for renderers
+GameViewState crosswordle_view(const CrosswordleGame* game);
+int crosswordle_current_level(const CrosswordleGame* game);
+int crosswordle_word_length(const CrosswordleGame* game);
+int crosswordle_guess_count(const CrosswordleGame* game);          // Guesses made this level
+int crosswordle_level_complete(const CrosswordleGame* game);
+// Copies the feedback of the latest guess this level; returns its length (0 if none)
+int crosswordle_last_feedback(const CrosswordleGame* game, LetterState* out_states);
+int crosswordle_token_count(const CrosswordleGame* game, char letter);
+int crosswordle_token_total(const CrosswordleGame* game);
+int crosswordle_crossword_complete(const CrosswordleGame* game);
+
+#endif
@@ -0,0 +1,306 @@
+#include "systems.h"
+#include "daily.h"
+#include "worddb.h"
+
+// Daily challenge. Each day maps to a word per length and a crossword through
+// a seeded hash of the day number, so every client and server computes the
+// same puzzle with no coordination and no stored state. The word is one hash
+// and an index; the crossword takes a few binary searches over the sorted
+// dictionary. Nothing scans a word list. A mapped calendar file (daily.h)
+// turns both into a single array lookup.
+
+#define DAILY_SEED 0xC2055D0A11E5EEDull
+#define DAILY_CROSSWORD_ATTEMPTS 256
+#define DAILY_CROSSWORD_STREAM 64             // Hash streams below are the per-length words
+
+// Daily crossword shape: every crossing is the first letter of the later
+// word, so each word after the first is drawn from one sorted run of the
+// dictionary (words starting with a given letter)
+typedef struct {
+    int x;
+    int y;
+    int direction;
+    int parent;                               // Word the first letter comes from, -1 for none
+    int parent_index;                         // Letter of the parent it shares
+} DailySlot;
+
+static const DailySlot DAILY_SHAPE[DAILY_CROSSWORD_WORDS] = {
+    {1, 0, 0, 1, 0},                          // Across, row 0; starts on the down word's first letter
+    {1, 0, 1, -1, 0},                         // Down, column 1; drawn first
+    {1, 3, 0, 1, 3},                          // Across, row 3; starts on the down word's fourth letter
+    {5, 3, 1, 2, 4},                          // Down, column 5; starts on the row-3 word's last letter
+};
+static const int DAILY_DRAW_ORDER[DAILY_CROSSWORD_WORDS] = {1, 0, 2, 3};
+
+static const DailyCalendarHeader* daily_calendar = NULL;
+static const DailyCalendarEntry* daily_entries = NULL;
+static void* daily_mapping = NULL;
+static size_t daily_mapping_size = 0;
+
+// ============= DATES =============
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar
+int daily_day_number(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int year_of_era = year - era * 400;
+    int day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+void daily_date_from_day(int day_number, int* out_year, int* out_month, int* out_day) {
+    int shifted = day_number + 719468;
+    int era = (shifted >= 0 ? shifted : shifted - 146096) / 146097;
+    int day_of_era = shifted - era * 146097;
+    int year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int month_index = (5 * day_of_year + 2) / 153;
+    *out_day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    *out_month = month_index < 10 ? month_index + 3 : month_index - 9;
+    *out_year = year_of_era + era * 400 + (*out_month <= 2);
+}
+
+// ============= SEEDED SELECTION =============
+
+// splitmix64 of the seed, the day and an independent stream per draw
+static uint64_t daily_hash(int day, uint64_t stream) {
+    uint64_t x = DAILY_SEED + (uint64_t)(uint32_t)day * 0x9E3779B97F4A7C15ull + stream * 0xD1B54A32D192ED03ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static PackedWord compute_daily_word(int word_length, int day) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    return dictionary->words[daily_hash(day, (uint64_t)word_length) % (uint64_t)dictionary->count];
+}
+
+static int packed_letter(PackedWord word, int word_length, int index) {
+    return (int)((word >> (PACKED_LETTER_BITS * (word_length - 1 - index))) & PACKED_LETTER_MASK);
+}
+
+// First index whose word is >= value
+static int lower_bound(const WordDictionary* dictionary, PackedWord value) {
+    int low = 0;
+    int high = dictionary->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (dictionary->words[mid] < value) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// Words starting with `letter` (1-26) are one sorted run; picks one by hash,
+// among the run's `members` (a category bitmap, NULL for every word) if given
+static int pick_word_starting_with(const WordDictionary* dictionary, const uint64_t* members, int letter,
+                                   uint64_t hash, PackedWord* out_word) {
+    int shift = PACKED_LETTER_BITS * (dictionary->word_length - 1);
+    int first = lower_bound(dictionary, (PackedWord)letter << shift);
+    int end = lower_bound(dictionary, (PackedWord)(letter + 1) << shift);
+    int count = members ? word_bitmap_count(members, first, end) : end - first;
+    if (count == 0) {
+        return 0;
+    }
+    int pick = (int)(hash % (uint64_t)count);
+    *out_word = dictionary->words[members ? word_bitmap_select(members, first, end, pick) : first + pick];
+    return 1;
+}
+
+// Fills the shape's words in DAILY_SHAPE order; 0 if no attempt fit (tiny lists).
+// With `members` (member_count words of a category bitmap) every word is one.
+static int compute_daily_crossword(int day, const uint64_t* members, int member_count, PackedWord* out_words) {
+    const WordDictionary* dictionary = get_word_dictionary(DEFAULT_WORD_LENGTH);
+    for (int attempt = 0; attempt < DAILY_CROSSWORD_ATTEMPTS; attempt++) {
+        uint64_t stream = DAILY_CROSSWORD_STREAM + (uint64_t)attempt * DAILY_CROSSWORD_WORDS;
+        int placed = 0;
+        for (; placed < DAILY_CROSSWORD_WORDS; placed++) {
+            int slot = DAILY_DRAW_ORDER[placed];
+            uint64_t hash = daily_hash(day, stream + (uint64_t)placed);
+            const DailySlot* shape = &DAILY_SHAPE[slot];
+            if (shape->parent < 0) {
+                int pick = (int)(hash % (uint64_t)(members ? member_count : dictionary->count));
+                out_words[slot] = dictionary->words[members ? word_bitmap_select(members, 0, dictionary->count, pick) : pick];
+                continue;
+            }
+            int letter = packed_letter(out_words[shape->parent], DEFAULT_WORD_LENGTH, shape->parent_index);
+            if (!pick_word_starting_with(dictionary, members, letter, hash, &out_words[slot])) {
+                break;
+            }
+            int repeated = 0;
+            for (int other = 0; other < placed; other++) {
+                repeated |= out_words[DAILY_DRAW_ORDER[other]] == out_words[slot];
+            }
+            if (repeated) {
+                break;
+            }
+        }
+        if (placed == DAILY_CROSSWORD_WORDS) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// ============= CALENDAR =============
+
+static const DailyCalendarEntry* calendar_entry(int day) {
+    if (!daily_calendar || day < daily_calendar->first_day ||
+        (int64_t)day - daily_calendar->first_day >= (int64_t)daily_calendar->day_count) {
+        return NULL;
+    }
+    // Only valid for the word lists it was built from
+    for (int i = 0; i < DAILY_LENGTH_COUNT; i++) {
+        if (daily_calendar->dictionary_hashes[i] != get_word_dictionary(MIN_WORD_LENGTH + i)->hash) {
+            return NULL;
+        }
+    }
+    return &daily_entries[day - daily_calendar->first_day];
+}
+
+// Maps a calendar file for O(1) daily lookups. Returns 1 on success.
+int load_daily_calendar(const char* path) {
+    size_t size = 0;
+    void* view = word_db_map_file(path, &size);
+    if (!view) {
+        return 0;
+    }
+    const DailyCalendarHeader* header = (const DailyCalendarHeader*)view;
+    int valid = size >= sizeof(DailyCalendarHeader) &&
+                header->magic == DAILY_CALENDAR_MAGIC &&
+                header->version == DAILY_CALENDAR_VERSION &&
+                header->file_size == size &&
+                header->entries_offset % 8 == 0 &&
+                word_db_section_fits(header->entries_offset, header->day_count, sizeof(DailyCalendarEntry), size);
+    if (!valid) {
+        word_db_unmap_file(view, size);
+        return 0;
+    }
+
+    unload_daily_calendar();
+    daily_mapping = view;
+    daily_mapping_size = size;
+    daily_calendar = header;
+    daily_entries = (const DailyCalendarEntry*)((const uint8_t*)view + header->entries_offset);
+    return 1;
+}
+
+void unload_daily_calendar(void) {
+    if (daily_mapping) {
+        word_db_unmap_file(daily_mapping, daily_mapping_size);
+    }
+    daily_mapping = NULL;
+    daily_mapping_size = 0;
+    daily_calendar = NULL;
+    daily_entries = NULL;
+}
+
+int daily_calendar_write(const char* path, int first_day, int day_count) {
+    if (day_count < 0) {
+        return 0;
+    }
+    DailyCalendarHeader header = {0};
+    header.magic = DAILY_CALENDAR_MAGIC;
+    header.version = DAILY_CALENDAR_VERSION;
+    header.first_day = first_day;
+    header.day_count = (uint32_t)day_count;
+    for (int i = 0; i < DAILY_LENGTH_COUNT; i++) {
+        header.dictionary_hashes[i] = get_word_dictionary(MIN_WORD_LENGTH + i)->hash;
+    }
+    header.entries_offset = sizeof(DailyCalendarHeader);
+    header.file_size = header.entries_offset + (uint64_t)day_count * sizeof(DailyCalendarEntry);
+
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (int d = 0; ok && d < day_count; d++) {
+        DailyCalendarEntry entry = {0};
+        for (int i = 0; i < DAILY_LENGTH_COUNT; i++) {
+            entry.words[i] = compute_daily_word(MIN_WORD_LENGTH + i, first_day + d);
+        }
+        if (!compute_daily_crossword(first_day + d, NULL, 0, entry.crossword_words)) {
+            memset(entry.crossword_words, 0, sizeof(entry.crossword_words));
+        }
+        ok = fwrite(&entry, sizeof(entry), 1, file) == 1;
+    }
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+// ============= ENTRY POINTS =============
+
+void get_daily_word(int word_length, int day, char* out_word) {
+    const DailyCalendarEntry* entry = calendar_entry(day);
+    PackedWord word = entry ? entry->words[word_length - MIN_WORD_LENGTH] : compute_daily_word(word_length, day);
+    get_word_kernels(word_length)->unpack(word, out_word);
+}
+
+// Lays out the shape's words; the level 1 puzzle if they were not found
+static CrosswordLevel daily_shape_level(const PackedWord* words, int found) {
+    CrosswordLevel crossword_level = get_crossword_level(1);
+    if (!found) {
+        return crossword_level;
+    }
+
+    memset(crossword_level.solution, 0, sizeof(crossword_level.solution));
+    memset(crossword_level.word_mask, 0, sizeof(crossword_level.word_mask));
+    crossword_level.word_count = DAILY_CROSSWORD_WORDS;
+    const WordKernels* kernels = get_word_kernels(DEFAULT_WORD_LENGTH);
+    for (int w = 0; w < DAILY_CROSSWORD_WORDS; w++) {
+        const DailySlot* shape = &DAILY_SHAPE[w];
+        char letters[MAX_WORD_LENGTH + 1];
+        kernels->unpack(words[w], letters);
+        crossword_level.words[w].start_x = shape->x;
+        crossword_level.words[w].start_y = shape->y;
+        crossword_level.words[w].direction = shape->direction;
+        crossword_level.words[w].length = DEFAULT_WORD_LENGTH;
+        for (int i = 0; i < DEFAULT_WORD_LENGTH; i++) {
+            int x = shape->x + (shape->direction == 0 ? i : 0);
+            int y = shape->y + (shape->direction == 1 ? i : 0);
+            crossword_level.solution[x][y] = letters[i];
+            crossword_level.word_mask[x][y] = 1;
+        }
+    }
+    return crossword_level;
+}
+
+// The day's crossword; falls back to the level 1 puzzle if the word list is
+// too small to fill the shape
+CrosswordLevel get_daily_crossword_level(int day) {
+    PackedWord words[DAILY_CROSSWORD_WORDS];
+    const DailyCalendarEntry* entry = calendar_entry(day);
+    int found;
+    if (entry) {
+        memcpy(words, entry->crossword_words, sizeof(words));
+        found = words[0] != 0;
+    } else {
+        found = compute_daily_crossword(day, NULL, 0, words);
+    }
+
+    CrosswordLevel crossword_level = daily_shape_level(words, found);
+    crossword_level.day = day;
+    return crossword_level;
+}
+
+// A crossword in the daily shape whose words all come from `categories`
+// (word_category_filter), drawn from `seed` the way a day's are. Falls back
+// to the level 1 puzzle if the categories are too small to fill it.
+CrosswordLevel get_themed_crossword_level(uint32_t categories, int seed) {
+    PackedWord words[DAILY_CROSSWORD_WORDS];
+    int chunk_count = word_category_chunks(DEFAULT_WORD_LENGTH);
+    uint64_t* members = malloc(sizeof(uint64_t) * (size_t)(chunk_count > 0 ? chunk_count : 1));
+    int member_count = members ? word_category_filter(DEFAULT_WORD_LENGTH, categories, NULL, members) : -1;
+    int found = member_count > 0 && compute_daily_crossword(seed, members, member_count, words);
+    free(members);
+    CrosswordLevel crossword_level = daily_shape_level(words, found);
+    crossword_level.categories = found ? categories : 0;
+    return crossword_level;
+}
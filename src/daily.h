@@ -0,0 +1,42 @@
+#ifndef DAILY_H
+#define DAILY_H
+
+#include <stdint.h>
+
+// Daily challenge calendar file (.cwcal)
+//
+// Layout (little-endian, 8-byte aligned):
+//   DailyCalendarHeader
+//   DailyCalendarEntry entries[day_count]   entry i is day first_day + i
+//
+// Entries hold exactly what the seeded selection in daily.c computes for each
+// day, so a mapped calendar answers in O(1) and a missing or stale one only
+// costs the computation. A calendar is used only if it was built against the
+// word lists loaded: the header keeps each list's hash (WordDictionary.hash).
+
+#define DAILY_CALENDAR_MAGIC 0x4C414357u      // "WCAL"
+#define DAILY_CALENDAR_VERSION 2u
+#define DAILY_LENGTH_COUNT 4                  // Word lengths 4..7
+#define DAILY_CROSSWORD_WORDS 4
+#define DAILY_CALENDAR_DEFAULT_DAYS 366
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    int32_t first_day;                        // Days since 1970-01-01
+    uint32_t day_count;
+    uint64_t dictionary_hashes[DAILY_LENGTH_COUNT];
+    uint64_t entries_offset;
+    uint64_t file_size;
+} DailyCalendarHeader;
+
+typedef struct {
+    uint64_t words[DAILY_LENGTH_COUNT];                 // Daily word per length (.cwdb packing)
+    uint64_t crossword_words[DAILY_CROSSWORD_WORDS];    // Daily crossword, in placement order
+} DailyCalendarEntry;
+
+// Writes a calendar of day_count days starting at first_day from the word
+// lists currently loaded. Returns 1 on success.
+int daily_calendar_write(const char* path, int first_day, int day_count);
+
+#endif
@@ -1,10 +1,12 @@
 #include "systems.h"
+#include "worddb.h"
 #include <math.h>
 
 GameState create_game_state(const char* target_word) {
     GameState state = {0};
     
     strcpy(state.core.target_word, target_word);
+    state.core.word_length = DEFAULT_WORD_LENGTH;
     state.core.current_level = 1;
     state.core.guesses_this_level = 0;
     state.core.total_lifetime_guesses = 0;
@@ -17,6 +19,8 @@ GameState create_game_state(const char* target_word) {
     state.input.should_submit = 0;
     
     state.history.level_guess_count = 0;
+    guess_constraints_reset(&state.history.constraints);
+    keyboard_state_reset(&state.history.keyboard);
     
     state.stats.levels_completed = 0;
     state.stats.current_level_streak = 1;
@@ -25,10 +29,7 @@ GameState create_game_state(const char* target_word) {
     state.stats.average_guesses_per_level = 0.0f;
     state.stats.best_level_score = 999;  // Initialize to high number
     
-    // Initialize letter bag
-    for (int i = 0; i < 26; i++) {
-        state.stats.letter_counts[i] = 0;
-    }
+    // Letter bag starts empty (ledger zeroed with the rest of the state)
     state.stats.show_letter_bag = 0;
     
     state.settings.sound_enabled = 1;
@@ -43,7 +44,7 @@ GameState create_game_state(const char* target_word) {
     state.ui.animate_letters = 0;
     
     // Initialize new animation timers and states
-    for (int i = 0; i < WORD_LENGTH; i++) {
+    for (int i = 0; i < MAX_WORD_LENGTH; i++) {
         state.ui.letter_pop_timers[i] = 0.0f;
     }
     state.ui.cursor_pulse_timer = 0.0f;
@@ -63,7 +64,7 @@ GameState create_game_state(const char* target_word) {
         state.ui.particles[i] = (Vector2){0, 0};
         state.ui.particle_velocities[i] = (Vector2){0, 0};
         state.ui.particle_lifetimes[i] = 0.0f;
-        state.ui.particle_colors[i] = WHITE;
+        state.ui.particle_colors[i] = WORDLE_WHITE;
     }
     
     state.system.frame_time = 0.0;
@@ -72,6 +73,8 @@ GameState create_game_state(const char* target_word) {
     state.system.target_camera_offset_y = 0.0f;
     state.system.user_has_scrolled = 0;
     state.system.auto_center_paused = 0;
+    state.system.screen_width = DEFAULT_SCREEN_WIDTH;
+    state.system.screen_height = DEFAULT_SCREEN_HEIGHT;
     
     state.current_view = VIEW_HOME_SCREEN;
     
@@ -84,6 +87,7 @@ GameState create_game_state(const char* target_word) {
         }
     }
     state.crossword.current_level = get_crossword_level(1);
+    crossword_token_need_reset(&state.crossword);
     
     // Initialize cursor to first word (Word 1)
     state.crossword.current_word_index = 0;  // Start with Word 1
@@ -96,76 +100,82 @@ GameState create_game_state(const char* target_word) {
     return state;
 }
 
-GameState input_system(GameState state) {
-    state.system.last_key_pressed = GetKeyPressed();
-    state.system.space_pressed = IsKeyPressed(KEY_SPACE);
-    state.system.enter_pressed = (state.system.last_key_pressed == KEY_ENTER);
-    state.system.backspace_pressed = (state.system.last_key_pressed == KEY_BACKSPACE);
-    state.system.letter_pressed = (state.system.last_key_pressed >= KEY_A && state.system.last_key_pressed <= KEY_Z);
-    state.system.pressed_letter = state.system.letter_pressed ? (char)state.system.last_key_pressed : 0;
-    
-    state.system.number_key_pressed = (state.system.last_key_pressed >= KEY_ONE && state.system.last_key_pressed <= KEY_NINE);
-    state.system.pressed_number = state.system.number_key_pressed ? (state.system.last_key_pressed - KEY_ONE + 1) : 0;
-    
-    // Scroll input
-    state.system.scroll_wheel_move = (int)GetMouseWheelMove();
-    state.system.up_arrow_pressed = IsKeyPressed(KEY_UP);
-    state.system.down_arrow_pressed = IsKeyPressed(KEY_DOWN);
-    state.system.tab_pressed = IsKeyPressed(KEY_TAB);
-    state.system.shift_pressed = IsKeyPressed(KEY_LEFT_SHIFT) || IsKeyPressed(KEY_RIGHT_SHIFT);
-    
-    state.system.frame_time = GetFrameTime();
-    
-    // Handle scrolling (only in Wordle view)
-    if ((state.system.scroll_wheel_move != 0 || state.system.up_arrow_pressed || state.system.down_arrow_pressed) && state.current_view == VIEW_WORDLE) {
-        float scroll_amount = 0.0f;
-        
-        if (state.system.scroll_wheel_move > 0 || state.system.up_arrow_pressed) {
-            scroll_amount = 60.0f;  // Scroll up (positive offset to see older guesses)
-        } else if (state.system.scroll_wheel_move < 0 || state.system.down_arrow_pressed) {
-            scroll_amount = -60.0f;  // Scroll down (negative offset toward current input)
-        }
-        
-        state.system.camera_offset_y += scroll_amount;
-        
-        // Calculate dynamic scroll bounds based on current game state
-        int total_rows = state.history.level_guess_count + 1;  // completed guesses + current input
-        int screen_height = GetScreenHeight();
-        
-        // Use actual row height from layout calculation
-        int available_width = GetScreenWidth() - 100;
-        int cell_size = available_width / (WORD_LENGTH + (WORD_LENGTH - 1) * 0.12f);
-        if (cell_size < 50) cell_size = 50;
-        if (cell_size > 100) cell_size = 100;
-        int cell_spacing = (int)(cell_size * 0.12f);
-        int actual_row_height = cell_size + cell_spacing;
-        
-        // To center attempt 1 (row 0):
-        // We want: board_start_y + 0 * row_height = screen_height/2 - cell_size/2
-        // From calculate_layout: board_start_y = desired_input_y - input_row_y + camera_offset_y
-        // Where: desired_input_y = screen_height/2 - cell_size/2 (center of screen)
-        // And: input_row_y = current_input_row * row_height
-        // So: camera_offset_y = (screen_height/2 - cell_size/2) - (desired_input_y - input_row_y)
-        // Simplifying: camera_offset_y = input_row_y = level_guess_count * row_height
-        float max_scroll_up = state.history.level_guess_count * actual_row_height;
-        
-        // Allow scrolling down until input row is centered on screen
-        // Input row centered is the natural state (camera_offset_y = 0)
-        float max_scroll_down = 0.0f;
-        
-        // Apply bounds
-        if (state.system.camera_offset_y > max_scroll_up) {
-            state.system.camera_offset_y = max_scroll_up;
+// Scrolls the Wordle board one step up (+1) or down (-1) and pauses auto-centering
+static void scroll_camera(GameState* state, int direction) {
+    float scroll_amount = direction > 0 ? 60.0f : -60.0f;  // Up shows older guesses
+    state->system.camera_offset_y += scroll_amount;
+    
+    // Use actual row height from layout calculation
+    int available_width = state->system.screen_width - 100;
+    int cell_size = available_width / get_word_kernels(state->core.word_length)->layout_width_units;
+    if (cell_size < 50) cell_size = 50;
+    if (cell_size > 100) cell_size = 100;
+    int cell_spacing = (int)(cell_size * 0.12f);
+    int actual_row_height = cell_size + cell_spacing;
+    
+    // To center attempt 1 (row 0):
+    // We want: board_start_y + 0 * row_height = screen_height/2 - cell_size/2
+    // From calculate_layout: board_start_y = desired_input_y - input_row_y + camera_offset_y
+    // Where: desired_input_y = screen_height/2 - cell_size/2 (center of screen)
+    // And: input_row_y = current_input_row * row_height
+    // So: camera_offset_y = (screen_height/2 - cell_size/2) - (desired_input_y - input_row_y)
+    // Simplifying: camera_offset_y = input_row_y = level_guess_count * row_height
+    float max_scroll_up = state->history.level_guess_count * actual_row_height;
+    
+    // Allow scrolling down until input row is centered on screen
+    // Input row centered is the natural state (camera_offset_y = 0)
+    float max_scroll_down = 0.0f;
+    
+    // Apply bounds
+    if (state->system.camera_offset_y > max_scroll_up) {
+        state->system.camera_offset_y = max_scroll_up;
+    }
+    if (state->system.camera_offset_y < max_scroll_down) {
+        state->system.camera_offset_y = max_scroll_down;
+    }
+    
+    // User has manually scrolled - pause auto-centering
+    state->system.user_has_scrolled = 1;
+    state->system.auto_center_paused = 1;
+    // Set target to current position to prevent camera interpolation from fighting
+    state->system.target_camera_offset_y = state->system.camera_offset_y;
+}
+
+// Once per frame: queues every key read this frame (and a click on the
+// on-screen keyboard) as action events, then handles the per-frame inputs
+GameState input_system(GameState state, const GameInput* input) {
+    state.system.latency_mark_count = 0;  // The front end closed last tick's marks
+    state.system.leaderboard_result_count = 0;  // ... and filed last tick's results
+    state.system.level_record_ready = 0;        // ... and logged last tick's level
+    state.system.profile_step = 0;              // ... and switched profiles
+    state.system.profile_create = 0;
+    
+    InputEventRing* events = &state.system.events;
+    events->dropped += (uint32_t)input->keys_dropped;
+    for (int i = 0; i < input->key_count; i++) {
+        InputEvent event = input_event_for_key(input->keys[i], input->time);
+        if (event.action != GAME_ACTION_NONE) {
+            input_event_push(events, event);
         }
-        if (state.system.camera_offset_y < max_scroll_down) {
-            state.system.camera_offset_y = max_scroll_down;
+    }
+    if (input->buttons & GAME_BUTTON_CLICK) {
+        KeyboardLayout keyboard = calculate_keyboard_layout(state.current_view, input->screen_width, input->screen_height);
+        InputEvent event = input_event_for_key(keyboard_key_at(&keyboard, input->mouse_x, input->mouse_y), input->time);
+        if (event.action != GAME_ACTION_NONE) {
+            input_event_push(events, event);
         }
-        
-        // User has manually scrolled - pause auto-centering
-        state.system.user_has_scrolled = 1;
-        state.system.auto_center_paused = 1;
-        // Set target to current position to prevent camera interpolation from fighting
-        state.system.target_camera_offset_y = state.system.camera_offset_y;
+    }
+    
+    state.system.frame_time = input->frame_time;
+    state.system.clock = input->time;
+    state.system.screen_width = input->screen_width;
+    state.system.screen_height = input->screen_height;
+    state.system.today = input->day;
+    
+    // Mouse wheel scrolling (only in Wordle view)
+    state.system.scroll_wheel_move = (int)input->wheel_move;
+    if (state.system.scroll_wheel_move != 0 && state.current_view == VIEW_WORDLE) {
+        scroll_camera(&state, state.system.scroll_wheel_move > 0 ? 1 : -1);
     }
     
     // Smooth camera interpolation toward target (only when not paused)
@@ -174,27 +184,66 @@ GameState input_system(GameState state) {
         state.system.camera_offset_y += (state.system.target_camera_offset_y - state.system.camera_offset_y) * camera_lerp_speed * state.system.frame_time;
     }
     
-    if (state.system.number_key_pressed) {
-        switch (state.system.pressed_number) {
-            case 1:
-                state.system.debug_mode = !state.system.debug_mode;
-                break;
-            case 2:
-                state.stats.show_letter_bag = !state.stats.show_letter_bag;
-                break;
-            case 3:
-                // Testing feature: Award 10 tokens of each letter
-                for (int i = 0; i < 26; i++) {
-                    state.stats.letter_counts[i] += 10;
-                }
-                break;
-            case 4:
-                state.settings.hard_mode = !state.settings.hard_mode;
-                break;
-            case 5:
-                state.settings.color_blind_mode = !state.settings.color_blind_mode;
-                break;
+    return state;
+}
+
+// Takes the next queued event (if any) and exposes it to this pass of the
+// gameplay systems; settings toggles are applied here directly
+GameState input_action_system(GameState state) {
+    InputEvent event = {0};
+    input_event_pop(&state.system.events, &event);
+    GameAction action = (GameAction)event.action;
+    
+    state.system.action = action;
+    state.system.action_time = event.time;
+    state.system.last_key_pressed = event.key;
+    state.system.letter_pressed = (action == GAME_ACTION_LETTER);
+    state.system.pressed_letter = state.system.letter_pressed ? event.letter : 0;
+    state.system.enter_pressed = (action == GAME_ACTION_SUBMIT);
+    state.system.backspace_pressed = (action == GAME_ACTION_DELETE);
+    state.system.space_pressed = (action == GAME_ACTION_CONTINUE);
+    state.system.tab_pressed = (action == GAME_ACTION_SWITCH_VIEW);
+    state.system.shift_pressed = (action == GAME_ACTION_TOGGLE_DIRECTION);
+    state.system.left_arrow_pressed = (action == GAME_ACTION_PREVIOUS);
+    state.system.right_arrow_pressed = (action == GAME_ACTION_NEXT);
+    state.system.up_arrow_pressed = (action == GAME_ACTION_UP);
+    state.system.down_arrow_pressed = (action == GAME_ACTION_DOWN);
+    
+    // Up/Down scroll the Wordle board
+    if ((state.system.up_arrow_pressed || state.system.down_arrow_pressed) && state.current_view == VIEW_WORDLE) {
+        scroll_camera(&state, state.system.up_arrow_pressed ? 1 : -1);
+    }
+    
+    switch (action) {
+        case GAME_ACTION_DEBUG:
+            state.system.debug_mode = !state.system.debug_mode;
+            break;
+        case GAME_ACTION_LETTER_BAG:
+            state.stats.show_letter_bag = !state.stats.show_letter_bag;
+            break;
+        case GAME_ACTION_TEST_TOKENS: {
+            // Testing feature: Award 10 tokens of each letter
+            TokenTransaction grant = token_transaction(TOKEN_TX_GRANT);
+            for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+                token_transaction_add(&grant, (char)('A' + i), 10);
+            }
+            token_ledger_commit(&state.stats.tokens, &grant);
+            break;
         }
+        case GAME_ACTION_HARD_MODE:
+            state.settings.hard_mode = !state.settings.hard_mode;
+            break;
+        case GAME_ACTION_COLOR_BLIND:
+            state.settings.color_blind_mode = !state.settings.color_blind_mode;
+            break;
+        case GAME_ACTION_PROFILER:
+            state.system.show_profiler = !state.system.show_profiler;
+            break;
+        case GAME_ACTION_STATS:
+            state.system.show_stats = !state.system.show_stats;
+            break;
+        default:
+            break;
     }
     
     return state;
@@ -206,14 +255,16 @@ GameState word_editing_system(GameState state) {
         return state;
     }
     
-    if (state.system.letter_pressed && state.input.current_letter_pos < WORD_LENGTH) {
+    if (state.system.letter_pressed && state.input.current_letter_pos < state.core.word_length) {
         int letter_index = state.input.current_letter_pos;
         state.input.current_word[state.input.current_letter_pos] = toupper(state.system.pressed_letter);
         state.input.current_letter_pos++;
         state.input.current_word[state.input.current_letter_pos] = '\0';
+        state.input.hard_mode_violation.kind = GUESS_VIOLATION_NONE;
         
         // Trigger letter pop animation
         trigger_letter_pop(&state, letter_index);
+        latency_mark(&state);
         
         // User started typing - reactivate auto-centering
         if (state.system.user_has_scrolled) {
@@ -226,6 +277,8 @@ GameState word_editing_system(GameState state) {
     if (state.system.backspace_pressed && state.input.current_letter_pos > 0) {
         state.input.current_letter_pos--;
         state.input.current_word[state.input.current_letter_pos] = '\0';
+        state.input.hard_mode_violation.kind = GUESS_VIOLATION_NONE;
+        latency_mark(&state);
         
         // User started typing (backspace counts as typing) - reactivate auto-centering
         if (state.system.user_has_scrolled) {
@@ -235,14 +288,14 @@ GameState word_editing_system(GameState state) {
         }
     }
     
-    state.input.word_complete = (state.input.current_letter_pos == WORD_LENGTH);
+    state.input.word_complete = (state.input.current_letter_pos == state.core.word_length);
     state.input.should_submit = (state.system.enter_pressed && state.input.word_complete);
     
     return state;
 }
 
 int is_letter_in_target_word(char letter, const char* target_word) {
-    for (int i = 0; i < WORD_LENGTH; i++) {
+    for (int i = 0; i < MAX_WORD_LENGTH && target_word[i] != '\0'; i++) {
         if (target_word[i] == letter) {
             return 1;
         }
@@ -356,17 +409,38 @@ GameState word_validation_system(GameState state) {
         return state;
     }
     
+    // Hard mode refuses guesses that ignore revealed letters; the word stays for editing
+    if (state.settings.hard_mode) {
+        GuessViolation violation = guess_constraints_check(&state.history.constraints, state.input.current_word,
+                                                           state.core.word_length);
+        state.input.hard_mode_violation = violation;
+        if (violation.kind != GUESS_VIOLATION_NONE) {
+            state.input.should_submit = 0;
+            return state;
+        }
+    }
+    
     // Store the current guess for result display
     strcpy(state.history.current_guess, state.input.current_word);
     
-    // Calculate letter states for the current guess
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        state.history.current_guess_states[i] = 
-            calculate_letter_state(
-                state.input.current_word[i], 
-                i, 
-                state.core.target_word
-            );
+    // Calculate letter states for the current guess (fixed-length kernel for this mode)
+    get_word_kernels(state.core.word_length)->score_guess(
+        state.input.current_word,
+        state.core.target_word,
+        state.history.current_guess_states
+    );
+    
+    // The scored row (or the start of its reveal) is what the player sees next
+    latency_mark(&state);
+    
+    // Level times and speed mode splits use the submit key's timestamp, before any reveal animation
+    int solved = get_word_kernels(state.core.word_length)->words_match(state.input.current_word, state.core.target_word);
+    if (solved) {
+        state.stats.level_solved_time = state.system.action_time;
+    }
+    if (state.speed.active) {
+        speed_mode_record_guess(&state.speed, state.system.action_time, state.core.current_level,
+                                state.core.guesses_this_level + 1, solved);
     }
     
     // Start letter reveal animation if animations are enabled
@@ -388,8 +462,25 @@ GameState word_validation_system(GameState state) {
     return state;
 }
 
+// Leaves a finished result for the front end to file in the leaderboard store
+static void add_leaderboard_result(GameState* state, LeaderboardMetric metric, uint32_t value) {
+    if (state->system.leaderboard_result_count >= LEADERBOARD_MAX_RESULTS) {
+        return;
+    }
+    LeaderboardResult* result = &state->system.leaderboard_results[state->system.leaderboard_result_count++];
+    result->mode = state->core.daily_day ? LEADERBOARD_MODE_DAILY
+                 : state->speed.active ? LEADERBOARD_MODE_SPEED : LEADERBOARD_MODE_WORDLE;
+    result->metric = (uint8_t)metric;
+    result->word_length = (uint8_t)state->core.word_length;
+    result->level = (uint16_t)state->core.current_level;
+    result->value = value;
+    result->day = state->system.today;
+}
+
 // Helper function to complete word validation (called after animation or immediately)
 void complete_word_validation(GameState* state) {
+    const WordKernels* kernels = get_word_kernels(state->core.word_length);
+    
     // Update counters
     state->core.guesses_this_level++;
     state->core.total_lifetime_guesses++;
@@ -398,19 +489,25 @@ void complete_word_validation(GameState* state) {
     // Add this guess to level history
     if (state->history.level_guess_count < MAX_RECENT_GUESSES) {
         strcpy(state->history.level_guesses[state->history.level_guess_count], state->history.current_guess);
-        for (int i = 0; i < WORD_LENGTH; i++) {
+        for (int i = 0; i < kernels->length; i++) {
             state->history.level_letter_states[state->history.level_guess_count][i] = state->history.current_guess_states[i];
         }
         state->history.level_guess_count++;
     }
+    guess_constraints_update(&state->history.constraints, state->history.current_guess,
+                             state->history.current_guess_states, kernels->length);
+    keyboard_state_update(&state->history.keyboard, state->history.current_guess,
+                          state->history.current_guess_states, kernels->length);
+    stats_history_record_guess(&state->stats.history, state->history.current_guess,
+                               state->history.current_guess_states, kernels->length);
     
     // Check if level is complete
-    if (check_word_match(state->history.current_guess, state->core.target_word)) {
+    if (kernels->words_match(state->history.current_guess, state->core.target_word)) {
         // Award a random letter token from the solved word (only happens once per level)
-        int random_letter_index = rand() % WORD_LENGTH;
-        char awarded_letter = state->core.target_word[random_letter_index];
-        int letter_array_index = awarded_letter - 'A';  // Convert A-Z to 0-25
-        state->stats.letter_counts[letter_array_index]++;
+        int random_letter_index = rand() % kernels->length;
+        TokenTransaction award = token_transaction(TOKEN_TX_AWARD);
+        token_transaction_add(&award, state->core.target_word[random_letter_index], 1);
+        token_ledger_commit(&state->stats.tokens, &award);
         
         // Update statistics (only happens once per level completion)
         state->stats.levels_completed++;
@@ -430,6 +527,26 @@ void complete_word_validation(GameState* state) {
                 (float)state->stats.total_guesses / (float)state->stats.levels_completed;
         }
         
+        // One history record per solved level: aggregates now, the log after the tick
+        LevelHistoryRecord* record = &state->system.level_record;
+        double level_seconds = state->stats.level_solved_time - state->stats.level_start_time;
+        memset(record, 0, sizeof(*record));
+        record->word = word_db_pack_word(state->core.target_word, kernels->length);
+        record->level = (uint32_t)state->core.current_level;
+        record->time_ms = level_seconds > 0.0 ? (uint32_t)(level_seconds * 1000.0 + 0.5) : 0;
+        record->guesses = (uint16_t)state->core.guesses_this_level;
+        record->word_length = (uint8_t)kernels->length;
+        record->token = state->core.target_word[random_letter_index];
+        record->day = state->system.today;
+        stats_history_record_level(&state->stats.history, record);
+        state->system.level_record_ready = 1;
+        
+        add_leaderboard_result(state, LEADERBOARD_FEWEST_GUESSES, (uint32_t)state->core.guesses_this_level);
+        if (state->speed.active) {
+            uint32_t level_us = speed_mode_level_us(&state->speed, state->speed.level_end);
+            add_leaderboard_result(state, LEADERBOARD_FASTEST_TIME, (level_us + 500) / 1000);
+        }
+        
         state->core.level_complete = 1;
         state->core.play_state = GAME_STATE_LEVEL_COMPLETE;
         
@@ -492,7 +609,7 @@ GameState crossword_input_system(GameState state) {
     }
     
     // Left/Right arrow keys cycle through words
-    if (IsKeyPressed(KEY_LEFT)) {
+    if (state.system.left_arrow_pressed) {
         // Previous word (cycle backwards)
         state.crossword.current_word_index--;
         if (state.crossword.current_word_index < 0) {
@@ -514,7 +631,7 @@ GameState crossword_input_system(GameState state) {
             state.crossword.cursor_y = current_word->start_y;
         }
     }
-    if (IsKeyPressed(KEY_RIGHT)) {
+    if (state.system.right_arrow_pressed) {
         // Next word (cycle forwards)
         state.crossword.current_word_index++;
         if (state.crossword.current_word_index >= state.crossword.current_level.word_count) {
@@ -592,20 +709,19 @@ GameState crossword_input_system(GameState state) {
             }
             
             char letter = state.system.pressed_letter;
-            int letter_index = letter - 'A';
             
-            // Check if player has this letter token
-            if (state.stats.letter_counts[letter_index] > 0) {
-                // Remove any existing letter at cursor position and return it to bag
-                char existing_letter = state.crossword.grid[state.crossword.cursor_x][state.crossword.cursor_y];
-                if (existing_letter != '\0') {
-                    int existing_index = existing_letter - 'A';
-                    state.stats.letter_counts[existing_index]++;
-                }
-                
-                // Place new letter and remove from bag
-                state.crossword.grid[state.crossword.cursor_x][state.crossword.cursor_y] = letter;
-                state.stats.letter_counts[letter_index]--;
+            // Take the new letter from the bag and return any letter it replaces,
+            // as one transaction (rejected if the player has no such token)
+            TokenTransaction place = token_transaction(TOKEN_TX_PLACE);
+            char existing_letter = state.crossword.grid[state.crossword.cursor_x][state.crossword.cursor_y];
+            if (existing_letter != '\0') {
+                token_transaction_add(&place, existing_letter, 1);
+            }
+            token_transaction_add(&place, letter, -1);
+            
+            if (token_ledger_commit(&state.stats.tokens, &place)) {
+                crossword_set_cell(&state.crossword, state.crossword.cursor_x, state.crossword.cursor_y, letter);
+                latency_mark(&state);
                 
                 // Auto-advance cursor within current word, skipping green cells
                 CrosswordWord* word = &state.crossword.current_level.words[state.crossword.current_word_index];
@@ -662,19 +778,22 @@ GameState crossword_input_system(GameState state) {
                     return state;
                 }
                 
-                // Remove letter at current position
-                int existing_index = existing_letter - 'A';
-                state.stats.letter_counts[existing_index]++;
-                state.crossword.grid[state.crossword.cursor_x][state.crossword.cursor_y] = '\0';
+                // Remove letter at current position and return it to the bag
+                TokenTransaction clear = token_transaction(TOKEN_TX_CLEAR);
+                token_transaction_add(&clear, existing_letter, 1);
+                token_ledger_commit(&state.stats.tokens, &clear);
+                crossword_set_cell(&state.crossword, state.crossword.cursor_x, state.crossword.cursor_y, '\0');
+                latency_mark(&state);
             } else {
                 // No letter at current position, search backwards for deletable letter
                 int prev_x, prev_y;
                 if (find_previous_editable_cell_with_letter(state, state.crossword.cursor_x, state.crossword.cursor_y, &prev_x, &prev_y)) {
                     // Found a deletable letter, remove it and move cursor there
-                    char prev_letter = state.crossword.grid[prev_x][prev_y];
-                    int prev_index = prev_letter - 'A';
-                    state.stats.letter_counts[prev_index]++;
-                    state.crossword.grid[prev_x][prev_y] = '\0';
+                    TokenTransaction clear = token_transaction(TOKEN_TX_CLEAR);
+                    token_transaction_add(&clear, state.crossword.grid[prev_x][prev_y], 1);
+                    token_ledger_commit(&state.stats.tokens, &clear);
+                    crossword_set_cell(&state.crossword, prev_x, prev_y, '\0');
+                    latency_mark(&state);
                     
                     // Move cursor to the deleted position
                     state.crossword.cursor_x = prev_x;
@@ -688,13 +807,18 @@ GameState crossword_input_system(GameState state) {
     // Enter key to validate current word
     if (state.system.enter_pressed) {
         state.crossword.should_validate = 1;
+        latency_mark(&state);
     }
     
     return state;
 }
 
+// Level `level` of a loaded puzzle pack if it has one, else the built-in level
 CrosswordLevel get_crossword_level(int level) {
     CrosswordLevel crossword_level = {0};
+    if (level >= 1 && puzzle_pack_level(level - 1, &crossword_level)) {
+        return crossword_level;
+    }
     crossword_level.level = level;
     
     // Initialize all cells as blocked (0) and empty
@@ -760,8 +884,8 @@ GameState crossword_word_validation_system(GameState state) {
     state.crossword.should_validate = 0;
     
     // Extract current word based on cursor position and direction
-    char current_word[WORD_LENGTH + 1] = {0};
-    char solution_word[WORD_LENGTH + 1] = {0};
+    char current_word[MAX_WORD_LENGTH + 1] = {0};
+    char solution_word[MAX_WORD_LENGTH + 1] = {0};
     int word_start_x = state.crossword.cursor_x;
     int word_start_y = state.crossword.cursor_y;
     
@@ -781,8 +905,9 @@ GameState crossword_word_validation_system(GameState state) {
     }
     
     // Extract the word and solution
+    int cell_count = 0;
     int word_length = 0;
-    for (int i = 0; i < WORD_LENGTH; i++) {
+    for (int i = 0; i < MAX_WORD_LENGTH; i++) {
         int check_x = word_start_x + (state.crossword.cursor_direction == 0 ? i : 0);
         int check_y = word_start_y + (state.crossword.cursor_direction == 1 ? i : 0);
         
@@ -791,6 +916,7 @@ GameState crossword_word_validation_system(GameState state) {
             state.crossword.current_level.word_mask[check_x][check_y]) {
             current_word[i] = state.crossword.grid[check_x][check_y];
             solution_word[i] = state.crossword.current_level.solution[check_x][check_y];
+            cell_count++;
             if (current_word[i] != '\0') {
                 word_length++;
             }
@@ -799,11 +925,13 @@ GameState crossword_word_validation_system(GameState state) {
         }
     }
     
-    // Only validate if word is complete (5 letters)
-    if (word_length == WORD_LENGTH) {
+    // Only validate if every cell of the word is filled
+    if (word_length == cell_count && is_supported_word_length(cell_count)) {
+        const WordKernels* kernels = get_word_kernels(cell_count);
+        
         // Check if all letters are filled
         int all_filled = 1;
-        for (int i = 0; i < WORD_LENGTH; i++) {
+        for (int i = 0; i < kernels->length; i++) {
             if (current_word[i] == '\0') {
                 all_filled = 0;
                 break;
@@ -812,16 +940,17 @@ GameState crossword_word_validation_system(GameState state) {
         
         if (all_filled) {
             // Validate word using existing Wordle logic
-            int word_correct = check_word_match(current_word, solution_word);
+            int word_correct = kernels->words_match(current_word, solution_word);
             
             // Calculate and store letter states for visual feedback
-            for (int i = 0; i < WORD_LENGTH; i++) {
+            LetterState word_states[MAX_WORD_LENGTH];
+            kernels->score_guess(current_word, solution_word, word_states);
+            for (int i = 0; i < kernels->length; i++) {
                 int pos_x = word_start_x + (state.crossword.cursor_direction == 0 ? i : 0);
                 int pos_y = word_start_y + (state.crossword.cursor_direction == 1 ? i : 0);
                 
                 if (pos_x < 9 && pos_y < 9) {
-                    LetterState letter_state = calculate_letter_state(current_word[i], i, solution_word);
-                    state.crossword.letter_states[pos_x][pos_y] = letter_state;
+                    state.crossword.letter_states[pos_x][pos_y] = word_states[i];
                     state.crossword.word_validated[pos_x][pos_y] = 1;
                 }
             }
@@ -831,7 +960,7 @@ GameState crossword_word_validation_system(GameState state) {
             
             if (word_correct) {
                 // Word is correct - mark completion and provide feedback
-                printf("Word '%s' is correct!\n", current_word);
+                GAME_LOG_INFO(LOG_EVENT_CROSSWORD_WORD_CORRECT, state.crossword.current_word_index, kernels->length, current_word);
                 
                 // Check if entire crossword is completed
                 int all_words_correct = 1;
@@ -848,7 +977,7 @@ GameState crossword_word_validation_system(GameState state) {
                 }
                 
                 if (all_words_correct) {
-                    printf("Congratulations! Crossword puzzle completed!\n");
+                    GAME_LOG_INFO(LOG_EVENT_CROSSWORD_COMPLETED, state.crossword.current_level.level, 0, NULL);
                     state.crossword.puzzle_completed = 1;
                     state.current_view = VIEW_CROSSWORD_COMPLETE;
                 } else {
@@ -864,8 +993,12 @@ GameState crossword_word_validation_system(GameState state) {
                     }
                 }
             } else {
-                // Word is incorrect - provide letter-by-letter feedback
-                printf("Word '%s' is incorrect. Expected '%s'\n", current_word, solution_word);
+                // Word is incorrect - log how close it was (never the solution itself)
+                int letters_in_place = 0;
+                for (int i = 0; i < kernels->length; i++) {
+                    letters_in_place += (current_word[i] == solution_word[i]);
+                }
+                GAME_LOG_INFO(LOG_EVENT_CROSSWORD_WORD_INCORRECT, state.crossword.current_word_index, letters_in_place, current_word);
                 
                 // Position cursor at first editable cell of current word for retry
                 int retry_x, retry_y;
@@ -890,9 +1023,16 @@ GameState new_level_system(GameState state) {
     state.core.guesses_this_level = 0;
     state.core.level_complete = 0;
     state.core.play_state = GAME_STATE_INPUT;
+    state.core.daily_day = 0;  // The daily word is one level; play continues endless
+    state.stats.level_start_time = state.system.action_time;
+    if (state.speed.active) {
+        speed_mode_level_start(&state.speed, state.system.action_time);
+    }
     
     // Clear level history for new level
     state.history.level_guess_count = 0;
+    guess_constraints_reset(&state.history.constraints);
+    keyboard_state_reset(&state.history.keyboard);
     
     // Reset camera to center on the first (and only) row
     state.system.camera_offset_y = 0.0f;
@@ -901,18 +1041,85 @@ GameState new_level_system(GameState state) {
     return state;
 }
 
+// Switches the crossword to `level` with an empty grid, refunding every placed
+// letter in one transaction
+static void crossword_start_level(GameState* state, CrosswordLevel level) {
+    TokenTransaction refund = token_transaction(TOKEN_TX_REFUND);
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 9; y++) {
+            if (state->crossword.grid[x][y] != '\0') {
+                token_transaction_add(&refund, state->crossword.grid[x][y], 1);
+            }
+            state->crossword.grid[x][y] = '\0';
+            state->crossword.letter_states[x][y] = LETTER_UNKNOWN;
+            state->crossword.word_validated[x][y] = 0;
+        }
+    }
+    token_ledger_commit(&state->stats.tokens, &refund);
+    state->crossword.current_level = level;
+    crossword_token_need_reset(&state->crossword);
+    
+    // Reset to first word
+    state->crossword.current_word_index = 0;
+    state->crossword.cursor_x = level.words[0].start_x;
+    state->crossword.cursor_y = level.words[0].start_y;
+    state->crossword.cursor_direction = level.words[0].direction;
+    state->crossword.should_validate = 0;
+    state->crossword.puzzle_completed = 0;
+}
+
 GameState home_screen_input_system(GameState state) {
     if (state.current_view != VIEW_HOME_SCREEN) {
         return state;
     }
     
-    // Enter key starts the game
-    if (state.system.enter_pressed) {
+    // Left/Right arrows select the word length mode
+    if (state.system.left_arrow_pressed && state.core.word_length > MIN_WORD_LENGTH) {
+        state.core.word_length--;
+    }
+    if (state.system.right_arrow_pressed && state.core.word_length < MAX_WORD_LENGTH) {
+        state.core.word_length++;
+    }
+    
+    // Up/Down pick the player profile and N adds one; the front end switches
+    // profiles after the tick, since that can load one from disk
+    if (state.system.up_arrow_pressed || state.system.down_arrow_pressed) {
+        state.system.profile_step += state.system.up_arrow_pressed ? -1 : 1;
+    }
+    if (state.system.letter_pressed && state.system.pressed_letter == 'N') {
+        state.system.profile_create = 1;
+    }
+    
+    // T steps through the loaded themes, one category at a time, then back to
+    // every word. The crossword switches to the theme's puzzle (or level 1)
+    if (state.system.letter_pressed && state.system.pressed_letter == 'T' && word_category_count() > 0) {
+        int next = state.core.theme != 0 ? __builtin_ctz(state.core.theme) + 1 : 0;
+        state.core.theme = next < word_category_count() ? 1u << next : 0;
+        crossword_start_level(&state, state.core.theme != 0
+                                          ? get_themed_crossword_level(state.core.theme, state.system.today)
+                                          : get_crossword_level(1));
+    }
+    
+    // Enter key starts the game; D starts today's daily challenge instead and
+    // S a timed speed run
+    int start_daily = state.system.letter_pressed && state.system.pressed_letter == 'D' && state.system.today > 0;
+    int start_speed = state.system.letter_pressed && state.system.pressed_letter == 'S';
+    if (state.system.enter_pressed || start_daily || start_speed) {
         // Initialize the first Wordle game
-        strcpy(state.core.target_word, get_random_word());
+        if (start_daily) {
+            get_daily_word(state.core.word_length, state.system.today, state.core.target_word);
+            state.core.daily_day = state.system.today;
+            if (state.crossword.current_level.day != state.system.today) {
+                crossword_start_level(&state, get_daily_crossword_level(state.system.today));
+            }
+        } else {
+            get_themed_word_for_level(state.core.word_length, 1, state.core.theme, state.core.target_word);
+            state.core.daily_day = 0;
+        }
         state.core.current_level = 1;
         state.core.guesses_this_level = 0;
         state.core.total_lifetime_guesses = 0;
+        state.stats.level_start_time = state.system.action_time;
         state.core.play_state = GAME_STATE_INPUT;
         state.core.level_complete = 0;
         
@@ -924,6 +1131,16 @@ GameState home_screen_input_system(GameState state) {
         
         // Reset history
         state.history.level_guess_count = 0;
+        guess_constraints_reset(&state.history.constraints);
+        keyboard_state_reset(&state.history.keyboard);
+        memset(&state.input.hard_mode_violation, 0, sizeof(state.input.hard_mode_violation));
+        
+        // The speed run's clock starts with the key that started it
+        if (start_speed) {
+            speed_mode_start(&state.speed, state.system.action_time);
+        } else {
+            state.speed.active = 0;
+        }
         
         // Switch to Wordle view
         state.current_view = VIEW_WORDLE;
@@ -945,21 +1162,16 @@ GameState crossword_completion_input_system(GameState state) {
     
     // Space key returns to home screen
     if (state.system.space_pressed) {
-        // Reset crossword state for new game
-        for (int x = 0; x < 9; x++) {
-            for (int y = 0; y < 9; y++) {
-                state.crossword.grid[x][y] = '\0';
-                state.crossword.letter_states[x][y] = LETTER_UNKNOWN;
-                state.crossword.word_validated[x][y] = 0;
+        // Reset crossword state for new game: the next level if there is one
+        // (a puzzle pack's), else the same puzzle again
+        CrosswordLevel next = state.crossword.current_level;
+        if (next.day == 0 && next.categories == 0) {
+            CrosswordLevel following = get_crossword_level(next.level + 1);
+            if (following.word_count > 0) {
+                next = following;
             }
         }
-        // Reset to first word
-        state.crossword.current_word_index = 0;
-        state.crossword.cursor_x = state.crossword.current_level.words[0].start_x;
-        state.crossword.cursor_y = state.crossword.current_level.words[0].start_y;
-        state.crossword.cursor_direction = state.crossword.current_level.words[0].direction;
-        state.crossword.should_validate = 0;
-        state.crossword.puzzle_completed = 0;
+        crossword_start_level(&state, next);
         
         // Return to home screen
         state.current_view = VIEW_HOME_SCREEN;
@@ -983,7 +1195,7 @@ GameState animation_update_system(GameState state) {
     float frame_time = (float)state.system.frame_time;
     
     // Update letter pop animations
-    for (int i = 0; i < WORD_LENGTH; i++) {
+    for (int i = 0; i < MAX_WORD_LENGTH; i++) {
         if (state.ui.letter_pop_timers[i] > 0.0f) {
             state.ui.letter_pop_timers[i] -= frame_time;
             if (state.ui.letter_pop_timers[i] < 0.0f) {
@@ -1053,7 +1265,7 @@ float easeOutElastic(float t) {
 }
 
 void trigger_letter_pop(GameState* state, int letter_index) {
-    if (!state->settings.animations_enabled || letter_index < 0 || letter_index >= WORD_LENGTH) {
+    if (!state->settings.animations_enabled || letter_index < 0 || letter_index >= MAX_WORD_LENGTH) {
         return;
     }
     state->ui.letter_pop_timers[letter_index] = LETTER_POP_DURATION;
@@ -1067,7 +1279,7 @@ void trigger_word_celebration(GameState* state) {
     state->ui.word_complete_timer = WORD_COMPLETE_DURATION;
     
     // Spawn celebration particles at center of screen
-    Vector2 center = {(float)GetScreenWidth() / 2.0f, (float)GetScreenHeight() / 2.0f};
+    Vector2 center = {(float)state->system.screen_width / 2.0f, (float)state->system.screen_height / 2.0f};
     spawn_particles(state, center, WORDLE_GREEN, 20);
 }
 
@@ -1079,7 +1291,7 @@ void trigger_level_celebration(GameState* state) {
     state->ui.level_complete_timer = LEVEL_COMPLETE_DURATION;
     
     // Spawn more particles for level completion
-    Vector2 center = {(float)GetScreenWidth() / 2.0f, (float)GetScreenHeight() / 2.0f};
+    Vector2 center = {(float)state->system.screen_width / 2.0f, (float)state->system.screen_height / 2.0f};
     spawn_particles(state, center, WORDLE_YELLOW, 30);
     spawn_particles(state, center, WORDLE_GREEN, 20);
 }
@@ -0,0 +1,86 @@
+#include "systems.h"
+
+// Hard mode: revealed greens must stay in place and revealed letters must be
+// reused. The constraint record is folded forward one guess at a time, so a
+// check costs one pass over the guess plus a few mask operations however long
+// the level's history gets.
+
+void guess_constraints_reset(GuessConstraints* constraints) {
+    memset(constraints, 0, sizeof(*constraints));
+}
+
+void guess_constraints_update(GuessConstraints* constraints, const char* guess, const LetterState* states, int word_length) {
+    uint32_t found_mask = 0;
+
+    for (int i = 0; i < word_length; i++) {
+        int letter = guess[i] - 'A';
+        if (states[i] == LETTER_CORRECT) {
+            constraints->fixed[i] = (uint8_t)(letter + 1);
+        }
+        if (states[i] == LETTER_CORRECT || states[i] == LETTER_WRONG_POS) {
+            found_mask |= 1u << letter;
+        }
+    }
+
+    // The scorer marks every copy of a target letter, so repeated yellows say
+    // nothing about how many copies there are. Only distinct green positions
+    // prove more than one. Grey letters are not tracked: hard mode lets a
+    // guess reuse them.
+    uint8_t greens[TOKEN_LETTER_COUNT] = {0};
+    for (int i = 0; i < word_length; i++) {
+        if (constraints->fixed[i] != 0) {
+            greens[constraints->fixed[i] - 1]++;
+        }
+    }
+    for (int letter = 0; letter < TOKEN_LETTER_COUNT; letter++) {
+        if (found_mask & (1u << letter)) {
+            uint8_t proven = greens[letter] > 0 ? greens[letter] : 1;
+            if (proven > constraints->min_count[letter]) {
+                constraints->min_count[letter] = proven;
+            }
+            constraints->required_mask |= 1u << letter;
+        }
+    }
+}
+
+static char lowest_letter(uint32_t mask) {
+    int letter = 0;
+    while (!(mask & 1u)) {
+        mask >>= 1;
+        letter++;
+    }
+    return (char)('A' + letter);
+}
+
+// The first rule the guess breaks, or GUESS_VIOLATION_NONE
+GuessViolation guess_constraints_check(const GuessConstraints* constraints, const char* guess, int word_length) {
+    GuessViolation violation = {GUESS_VIOLATION_NONE, 0, 0};
+    uint8_t counts[TOKEN_LETTER_COUNT] = {0};
+    uint32_t guess_mask = 0;
+
+    for (int i = 0; i < word_length; i++) {
+        int letter = guess[i] - 'A';
+        if (constraints->fixed[i] != 0 && constraints->fixed[i] != letter + 1) {
+            violation.kind = GUESS_VIOLATION_FIXED;
+            violation.letter = (char)('A' - 1 + constraints->fixed[i]);
+            violation.position = i;
+            return violation;
+        }
+        guess_mask |= 1u << letter;
+        counts[letter]++;
+    }
+
+    uint32_t missing = constraints->required_mask & ~guess_mask;
+    // Letters revealed more than once must be reused that often too
+    for (uint32_t repeated = constraints->required_mask & guess_mask; repeated != 0; repeated &= repeated - 1) {
+        int letter = lowest_letter(repeated) - 'A';
+        if (counts[letter] < constraints->min_count[letter]) {
+            missing |= 1u << letter;
+        }
+    }
+    if (missing != 0) {
+        violation.kind = GUESS_VIOLATION_REQUIRED;
+        violation.letter = lowest_letter(missing);
+    }
+    return violation;
+}
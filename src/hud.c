@@ -0,0 +1,367 @@
+#include "systems.h"
+
+// Small append-only text builder; keeps HUD string assembly free of libc formatting
+typedef struct {
+    char* buffer;
+    int capacity;
+    int length;
+} TextBuilder;
+
+static TextBuilder text_builder(char* buffer, int capacity) {
+    TextBuilder builder = {buffer, capacity, 0};
+    buffer[0] = '\0';
+    return builder;
+}
+
+static void text_append(TextBuilder* builder, const char* text) {
+    while (*text != '\0' && builder->length < builder->capacity - 1) {
+        builder->buffer[builder->length++] = *text++;
+    }
+    builder->buffer[builder->length] = '\0';
+}
+
+static void text_append_char(TextBuilder* builder, char c) {
+    if (builder->length < builder->capacity - 1) {
+        builder->buffer[builder->length++] = c;
+        builder->buffer[builder->length] = '\0';
+    }
+}
+
+// Writes the decimal form of value into buffer (at least 12 bytes), returns its length
+int format_int(char* buffer, int value) {
+    char digits[11];
+    int digit_count = 0;
+    int length = 0;
+
+    // Work in unsigned space so INT_MIN does not overflow on negation
+    unsigned int magnitude = (value < 0) ? 0u - (unsigned int)value : (unsigned int)value;
+
+    do {
+        digits[digit_count++] = (char)('0' + magnitude % 10u);
+        magnitude /= 10u;
+    } while (magnitude != 0u);
+
+    if (value < 0) {
+        buffer[length++] = '-';
+    }
+    while (digit_count > 0) {
+        buffer[length++] = digits[--digit_count];
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
+
+// Returns 1 if the counter's text changed
+int hud_counter_update(HudCounter* counter, int value) {
+    if (counter->valid && counter->value == value) {
+        return 0;
+    }
+    counter->value = value;
+    counter->valid = 1;
+    counter->length = format_int(counter->text, value);
+    return 1;
+}
+
+// "12.3" from a count of tenths
+static void append_tenths(TextBuilder* builder, int tenths) {
+    char text[16];
+    int whole_length = format_int(text, tenths / 10);
+    text[whole_length] = '.';
+    text[whole_length + 1] = (char)('0' + tenths % 10);
+    text[whole_length + 2] = '\0';
+    text_append(builder, text);
+}
+
+// "yyyy-mm-dd"
+static void append_date(TextBuilder* builder, int day_number) {
+    int year, month, day;
+    daily_date_from_day(day_number, &year, &month, &day);
+    char text[16];
+    int length = format_int(text, year);
+    text[length++] = '-';
+    text[length++] = (char)('0' + month / 10);
+    text[length++] = (char)('0' + month % 10);
+    text[length++] = '-';
+    text[length++] = (char)('0' + day / 10);
+    text[length++] = (char)('0' + day % 10);
+    text[length] = '\0';
+    text_append(builder, text);
+}
+
+static void rebuild_letter_bag_text(HudState* hud, const TokenLedger* tokens, const int16_t* crossword_need) {
+    char count_text[12];
+    TextBuilder wordle_bag = text_builder(hud->letter_bag_text, sizeof(hud->letter_bag_text));
+    text_append(&wordle_bag, "Letter Bag: ");
+    
+    // Crossword entries cover held letters plus letters the puzzle still needs,
+    // so the renderer can grey out the ones the bag cannot cover
+    hud->crossword_bag_short_mask = token_ledger_shortfall(tokens, crossword_need);
+    hud->crossword_bag_entry_count = 0;
+
+    int any_letters = 0;
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        int count = tokens->balance[i];
+        if (count > 0) {
+            format_int(count_text, count);
+            text_append_char(&wordle_bag, (char)('A' + i));
+            text_append_char(&wordle_bag, ':');
+            text_append(&wordle_bag, count_text);
+            text_append_char(&wordle_bag, ' ');
+            any_letters = 1;
+        }
+        if (count > 0 || crossword_need[i] > 0) {
+            int entry = hud->crossword_bag_entry_count++;
+            TextBuilder entry_text = text_builder(hud->crossword_bag_entries[entry], sizeof(hud->crossword_bag_entries[entry]));
+            format_int(count_text, count);
+            text_append_char(&entry_text, (char)('A' + i));
+            text_append_char(&entry_text, ':');
+            text_append(&entry_text, count_text);
+            text_append_char(&entry_text, ' ');
+            hud->crossword_bag_entry_letter[entry] = (char)i;
+        }
+    }
+
+    if (!any_letters) {
+        text_append(&wordle_bag, "No letters collected yet");
+    }
+    
+    TextBuilder crossword_bag = text_builder(hud->crossword_bag_text, sizeof(hud->crossword_bag_text));
+    text_append(&crossword_bag, any_letters ? "Available Letters: " : "None - play Wordle to earn letters! ");
+}
+
+static void rebuild_stats_text(HudState* hud, const StatsAggregates* history) {
+    char number[12];
+    TextBuilder builder = text_builder(hud->stats_levels_text, sizeof(hud->stats_levels_text));
+    text_append(&builder, "Levels solved: ");
+    format_int(number, (int)history->levels);
+    text_append(&builder, number);
+    text_append(&builder, " | Time played: ");
+    format_int(number, (int)(history->total_time_ms / 60000u));
+    text_append(&builder, number);
+    text_append(&builder, " min");
+    
+    builder = text_builder(hud->stats_average_text, sizeof(hud->stats_average_text));
+    text_append(&builder, "Average guesses - last 10: ");
+    append_tenths(&builder, stats_history_average_tenths(history, STATS_WINDOW_SHORT));
+    text_append(&builder, " | last 100: ");
+    append_tenths(&builder, stats_history_average_tenths(history, STATS_WINDOW_LONG));
+    text_append(&builder, " | all: ");
+    append_tenths(&builder, stats_history_average_tenths(history, 0));
+    
+    builder = text_builder(hud->stats_percentile_text, sizeof(hud->stats_percentile_text));
+    text_append(&builder, "Guesses p50 ");
+    format_int(number, stats_history_guess_percentile(history, 0.50));
+    text_append(&builder, number);
+    text_append(&builder, " p90 ");
+    format_int(number, stats_history_guess_percentile(history, 0.90));
+    text_append(&builder, number);
+    text_append(&builder, " | Time p50 ");
+    format_int(number, stats_history_time_percentile_seconds(history, 0.50));
+    text_append(&builder, number);
+    text_append(&builder, "s p90 ");
+    format_int(number, stats_history_time_percentile_seconds(history, 0.90));
+    text_append(&builder, number);
+    text_append(&builder, "s");
+}
+
+GameState hud_update_system(GameState state) {
+    HudState* hud = &state.ui.hud;
+    TextBuilder builder;
+
+    // Wordle top bar
+    int level_changed = hud_counter_update(&hud->current_level, state.core.current_level);
+    int daily_changed = hud_counter_update(&hud->daily_day, state.core.daily_day);
+    if (daily_changed && state.core.daily_day != 0) {
+        builder = text_builder(hud->level_title, sizeof(hud->level_title));
+        text_append(&builder, "DAILY - ");
+        append_date(&builder, state.core.daily_day);
+        
+        builder = text_builder(hud->level_complete_text, sizeof(hud->level_complete_text));
+        text_append(&builder, "DAILY COMPLETE!");
+    } else if ((level_changed || daily_changed) && state.core.daily_day == 0) {
+        builder = text_builder(hud->level_title, sizeof(hud->level_title));
+        text_append(&builder, "WORDLE - LEVEL ");
+        text_append(&builder, hud->current_level.text);
+
+        builder = text_builder(hud->level_complete_text, sizeof(hud->level_complete_text));
+        text_append(&builder, "LEVEL ");
+        text_append(&builder, hud->current_level.text);
+        text_append(&builder, " COMPLETE!");
+    }
+
+    int guess_changed = hud_counter_update(&hud->guess_number, state.core.guesses_this_level + 1);
+    int total_changed = hud_counter_update(&hud->total_guesses, state.core.total_lifetime_guesses);
+    if (guess_changed || total_changed) {
+        builder = text_builder(hud->level_stats, sizeof(hud->level_stats));
+        text_append(&builder, "Guess ");
+        text_append(&builder, hud->guess_number.text);
+        text_append(&builder, " this level | ");
+        text_append(&builder, hud->total_guesses.text);
+        text_append(&builder, " total guesses");
+    }
+
+    if (strcmp(hud->debug_target, state.core.target_word) != 0 || hud->debug_message[0] == '\0') {
+        strcpy(hud->debug_target, state.core.target_word);
+        builder = text_builder(hud->debug_message, sizeof(hud->debug_message));
+        text_append(&builder, "DEBUG: Answer is ");
+        text_append(&builder, state.core.target_word);
+    }
+
+    // Level complete bar
+    int solved_changed = hud_counter_update(&hud->solved_guesses, state.core.guesses_this_level);
+    if (solved_changed || level_changed) {
+        char next_level_text[12];
+        format_int(next_level_text, state.core.current_level + 1);
+
+        builder = text_builder(hud->level_score, sizeof(hud->level_score));
+        text_append(&builder, "Solved in ");
+        text_append(&builder, hud->solved_guesses.text);
+        text_append(&builder, " guesses! Press SPACE for Level ");
+        text_append(&builder, next_level_text);
+    }
+
+    // Lifetime stats bar
+    int best_score = (state.stats.best_level_score < 999) ? state.stats.best_level_score : 0;
+    int average_tenths = (int)(state.stats.average_guesses_per_level * 10.0f + 0.5f);
+    int completed_changed = hud_counter_update(&hud->levels_completed, state.stats.levels_completed);
+    int best_changed = hud_counter_update(&hud->best_score, best_score);
+    int average_changed = hud_counter_update(&hud->average_tenths, average_tenths);
+    if (completed_changed || best_changed || average_changed) {
+        builder = text_builder(hud->lifetime_stats, sizeof(hud->lifetime_stats));
+        text_append(&builder, "Levels completed: ");
+        text_append(&builder, hud->levels_completed.text);
+        text_append(&builder, " | Best: ");
+        text_append(&builder, hud->best_score.text);
+        text_append(&builder, " guesses | Average: ");
+        append_tenths(&builder, average_tenths);
+        text_append(&builder, " guesses");
+    }
+
+    // Home screen profile line
+    if (strcmp(hud->profile_shown, state.system.profile_name) != 0) {
+        strcpy(hud->profile_shown, state.system.profile_name);
+        builder = text_builder(hud->profile_text, sizeof(hud->profile_text));
+        text_append(&builder, "Player: ");
+        text_append(&builder, state.system.profile_name);
+        text_append(&builder, "  (UP/DOWN to switch, N for new)");
+    }
+
+    // Home screen theme line, shown once categories are loaded
+    if (hud_counter_update(&hud->theme, (int)state.core.theme)) {
+        builder = text_builder(hud->theme_text, sizeof(hud->theme_text));
+        if (word_category_count() > 0) {
+            const char* name = state.core.theme != 0 ? word_category_name(__builtin_ctz(state.core.theme)) : NULL;
+            text_append(&builder, "Theme: ");
+            text_append(&builder, name ? name : "all words");
+            text_append(&builder, "  (T to change)");
+        }
+    }
+    
+    // Statistics screen
+    if (!hud->stats_valid || hud->stats_version != state.stats.history.version) {
+        hud->stats_version = state.stats.history.version;
+        hud->stats_valid = 1;
+        rebuild_stats_text(hud, &state.stats.history);
+    }
+    
+    // Letter bag and token total
+    if (!hud->bag_valid || hud->bag_version != state.stats.tokens.version ||
+        hud->bag_need_version != state.crossword.token_need_version) {
+        hud->bag_version = state.stats.tokens.version;
+        hud->bag_need_version = state.crossword.token_need_version;
+        hud->bag_valid = 1;
+        rebuild_letter_bag_text(hud, &state.stats.tokens, state.crossword.token_need);
+    }
+
+    if (hud_counter_update(&hud->tokens_remaining, token_ledger_total(&state.stats.tokens))) {
+        builder = text_builder(hud->tokens_remaining_text, sizeof(hud->tokens_remaining_text));
+        text_append(&builder, "Letter tokens remaining: ");
+        text_append(&builder, hud->tokens_remaining.text);
+    }
+
+    // Word length mode text
+    if (hud_counter_update(&hud->word_length, state.core.word_length)) {
+        builder = text_builder(hud->instruction, sizeof(hud->instruction));
+        text_append(&builder, "Type a ");
+        text_append(&builder, hud->word_length.text);
+        text_append(&builder, "-letter word and press ENTER");
+
+        builder = text_builder(hud->mode_text, sizeof(hud->mode_text));
+        text_append(&builder, (state.core.word_length > MIN_WORD_LENGTH) ? "< " : "  ");
+        text_append(&builder, hud->word_length.text);
+        text_append(&builder, (state.core.word_length < MAX_WORD_LENGTH) ? " LETTERS >" : " LETTERS  ");
+    }
+
+    // Hard mode refusal
+    GuessViolation violation = state.input.hard_mode_violation;
+    if (violation.kind != hud->hard_mode_shown.kind || violation.letter != hud->hard_mode_shown.letter ||
+        violation.position != hud->hard_mode_shown.position) {
+        hud->hard_mode_shown = violation;
+        builder = text_builder(hud->hard_mode_text, sizeof(hud->hard_mode_text));
+        if (violation.kind == GUESS_VIOLATION_FIXED) {
+            static const char* ORDINALS[MAX_WORD_LENGTH] = {"1st", "2nd", "3rd", "4th", "5th", "6th", "7th"};
+            text_append(&builder, "Hard mode: ");
+            text_append(&builder, ORDINALS[violation.position]);
+            text_append(&builder, " letter must be ");
+            text_append_char(&builder, violation.letter);
+        } else if (violation.kind == GUESS_VIOLATION_REQUIRED) {
+            text_append(&builder, "Hard mode: guess must contain ");
+            text_append_char(&builder, violation.letter);
+        }
+    }
+    
+    // Speed mode: the timers tick every frame but their text only changes with
+    // the tenths shown; the splits line changes once per guess
+    if (state.speed.active) {
+        int level_tenths = (int)(speed_mode_level_us(&state.speed, state.system.clock) / 100000u);
+        int run_tenths = (int)(speed_mode_run_us(&state.speed, state.system.clock) / 100000u);
+        int level_timer_changed = hud_counter_update(&hud->speed_level_tenths, level_tenths);
+        int run_timer_changed = hud_counter_update(&hud->speed_run_tenths, run_tenths);
+        if (level_timer_changed || run_timer_changed) {
+            builder = text_builder(hud->speed_timer_text, sizeof(hud->speed_timer_text));
+            text_append(&builder, "LEVEL ");
+            append_tenths(&builder, level_tenths);
+            text_append(&builder, "s | RUN ");
+            append_tenths(&builder, run_tenths);
+            text_append(&builder, "s");
+        }
+        
+        if (hud->speed_splits_version != state.speed.version) {
+            hud->speed_splits_version = state.speed.version;
+            builder = text_builder(hud->speed_splits_text, sizeof(hud->speed_splits_text));
+            text_append(&builder, "Splits:");
+            uint32_t available = speed_split_available(&state.speed);
+            uint32_t first = available > 5 ? available - 5 : 0;
+            for (uint32_t i = first; i < available; i++) {
+                const SpeedSplit* split = speed_split_at(&state.speed, i);
+                text_append_char(&builder, ' ');
+                append_tenths(&builder, (int)(split->guess_us / 100000u));
+            }
+            if (available == 0) {
+                text_append(&builder, " -");
+            }
+        }
+    }
+    
+    // Crossword word indicator
+    int word_changed = hud_counter_update(&hud->word_number, state.crossword.current_word_index + 1);
+    if (word_changed || hud->word_indicator_direction != state.crossword.cursor_direction) {
+        hud->word_indicator_direction = state.crossword.cursor_direction;
+        builder = text_builder(hud->word_indicator, sizeof(hud->word_indicator));
+        text_append(&builder, "Word ");
+        text_append(&builder, hud->word_number.text);
+        text_append(&builder, (state.crossword.cursor_direction == 0) ? " - ACROSS" : " - DOWN");
+    }
+
+    // Clue for the current word, looked up once per word rather than per frame
+    uint64_t clue_word = crossword_word_id(&state.crossword.current_level, state.crossword.current_word_index);
+    uint32_t clue_database = clue_database_version();
+    if (hud->clue_word != clue_word || hud->clue_database != clue_database) {
+        hud->clue_word = clue_word;
+        hud->clue_database = clue_database;
+        hud->crossword_clue = clue_find(clue_word);
+    }
+    
+    return state;
+}
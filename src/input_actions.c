@@ -0,0 +1,209 @@
+#include "systems.h"
+
+// Input action map. Each frame the platform hands over its whole key queue;
+// every key is looked up in the binding table and queued as an action event
+// in a fixed ring, and game_tick applies the events one at a time. Nothing
+// downstream of input_system looks at key codes.
+//
+// Binding files are plain text, one binding per line, '#' starts a comment:
+//
+//   <key> <action>
+//
+// <key> is a single character (A, 7, ...), a name (SPACE, ENTER, TAB,
+// BACKSPACE, LEFT, RIGHT, UP, DOWN, LEFT_SHIFT, RIGHT_SHIFT, F2, F3) or a decimal
+// key code. <action> is one of the names in ACTION_NAMES, letter_X to type
+// the letter X, or none to unbind the key. Keys a file does not mention keep
+// their default binding.
+
+typedef struct {
+    uint8_t action;         // GameAction
+    char letter;            // GAME_ACTION_LETTER only
+} InputBinding;
+
+#define LETTER_BINDING(c) [c] = {GAME_ACTION_LETTER, c}
+
+static const InputBinding DEFAULT_BINDINGS[GAME_KEY_CODE_LIMIT] = {
+    LETTER_BINDING('A'), LETTER_BINDING('B'), LETTER_BINDING('C'), LETTER_BINDING('D'),
+    LETTER_BINDING('E'), LETTER_BINDING('F'), LETTER_BINDING('G'), LETTER_BINDING('H'),
+    LETTER_BINDING('I'), LETTER_BINDING('J'), LETTER_BINDING('K'), LETTER_BINDING('L'),
+    LETTER_BINDING('M'), LETTER_BINDING('N'), LETTER_BINDING('O'), LETTER_BINDING('P'),
+    LETTER_BINDING('Q'), LETTER_BINDING('R'), LETTER_BINDING('S'), LETTER_BINDING('T'),
+    LETTER_BINDING('U'), LETTER_BINDING('V'), LETTER_BINDING('W'), LETTER_BINDING('X'),
+    LETTER_BINDING('Y'), LETTER_BINDING('Z'),
+    [GAME_KEY_ENTER] = {GAME_ACTION_SUBMIT, 0},
+    [GAME_KEY_BACKSPACE] = {GAME_ACTION_DELETE, 0},
+    [GAME_KEY_SPACE] = {GAME_ACTION_CONTINUE, 0},
+    [GAME_KEY_TAB] = {GAME_ACTION_SWITCH_VIEW, 0},
+    [GAME_KEY_LEFT_SHIFT] = {GAME_ACTION_TOGGLE_DIRECTION, 0},
+    [GAME_KEY_RIGHT_SHIFT] = {GAME_ACTION_TOGGLE_DIRECTION, 0},
+    [GAME_KEY_LEFT] = {GAME_ACTION_PREVIOUS, 0},
+    [GAME_KEY_RIGHT] = {GAME_ACTION_NEXT, 0},
+    [GAME_KEY_UP] = {GAME_ACTION_UP, 0},
+    [GAME_KEY_DOWN] = {GAME_ACTION_DOWN, 0},
+    [GAME_KEY_ONE] = {GAME_ACTION_DEBUG, 0},
+    [GAME_KEY_ONE + 1] = {GAME_ACTION_LETTER_BAG, 0},
+    [GAME_KEY_ONE + 2] = {GAME_ACTION_TEST_TOKENS, 0},
+    [GAME_KEY_ONE + 3] = {GAME_ACTION_HARD_MODE, 0},
+    [GAME_KEY_ONE + 4] = {GAME_ACTION_COLOR_BLIND, 0},
+    [GAME_KEY_F2] = {GAME_ACTION_STATS, 0},
+    [GAME_KEY_F3] = {GAME_ACTION_PROFILER, 0},
+};
+
+// Loaded files are applied all-or-nothing into this table
+static InputBinding loaded_bindings[GAME_KEY_CODE_LIMIT];
+static const InputBinding* bindings = DEFAULT_BINDINGS;
+
+static const char* const ACTION_NAMES[GAME_ACTION_COUNT] = {
+    [GAME_ACTION_NONE] = "none",
+    [GAME_ACTION_SUBMIT] = "submit",
+    [GAME_ACTION_DELETE] = "delete",
+    [GAME_ACTION_CONTINUE] = "continue",
+    [GAME_ACTION_SWITCH_VIEW] = "switch_view",
+    [GAME_ACTION_TOGGLE_DIRECTION] = "toggle_direction",
+    [GAME_ACTION_PREVIOUS] = "previous",
+    [GAME_ACTION_NEXT] = "next",
+    [GAME_ACTION_UP] = "up",
+    [GAME_ACTION_DOWN] = "down",
+    [GAME_ACTION_DEBUG] = "debug",
+    [GAME_ACTION_LETTER_BAG] = "letter_bag",
+    [GAME_ACTION_TEST_TOKENS] = "test_tokens",
+    [GAME_ACTION_HARD_MODE] = "hard_mode",
+    [GAME_ACTION_COLOR_BLIND] = "color_blind",
+    [GAME_ACTION_PROFILER] = "profiler",
+    [GAME_ACTION_STATS] = "stats",
+};
+
+static const struct {
+    const char* name;
+    int key;
+} KEY_NAMES[] = {
+    {"SPACE", GAME_KEY_SPACE}, {"ENTER", GAME_KEY_ENTER}, {"TAB", GAME_KEY_TAB},
+    {"BACKSPACE", GAME_KEY_BACKSPACE}, {"LEFT", GAME_KEY_LEFT}, {"RIGHT", GAME_KEY_RIGHT},
+    {"UP", GAME_KEY_UP}, {"DOWN", GAME_KEY_DOWN},
+    {"LEFT_SHIFT", GAME_KEY_LEFT_SHIFT}, {"RIGHT_SHIFT", GAME_KEY_RIGHT_SHIFT},
+    {"F2", GAME_KEY_F2}, {"F3", GAME_KEY_F3},
+};
+
+// ============= BINDINGS =============
+
+const char* input_action_name(GameAction action) {
+    if (action == GAME_ACTION_LETTER) {
+        return "letter";
+    }
+    return action >= 0 && action < GAME_ACTION_COUNT && ACTION_NAMES[action] ? ACTION_NAMES[action] : "unknown";
+}
+
+InputEvent input_event_for_key(int key, double time) {
+    InputEvent event = {time, (uint16_t)key, GAME_ACTION_NONE, 0};
+    if (key > 0 && key < GAME_KEY_CODE_LIMIT) {
+        event.action = bindings[key].action;
+        event.letter = bindings[key].letter;
+    }
+    return event;
+}
+
+// Key code for a binding-file key token, -1 if it names no bindable key
+static int parse_key(const char* token) {
+    if (token[1] == '\0') {
+        int key = toupper((unsigned char)token[0]);
+        return key > ' ' && key < 127 ? key : -1;
+    }
+    for (size_t i = 0; i < sizeof(KEY_NAMES) / sizeof(KEY_NAMES[0]); i++) {
+        if (strcmp(token, KEY_NAMES[i].name) == 0) {
+            return KEY_NAMES[i].key;
+        }
+    }
+    char* end = NULL;
+    long key = strtol(token, &end, 10);
+    return *end == '\0' && key > 0 && key < GAME_KEY_CODE_LIMIT ? (int)key : -1;
+}
+
+static int parse_action(const char* token, InputBinding* out_binding) {
+    if (strncmp(token, "letter_", 7) == 0 && isalpha((unsigned char)token[7]) && token[8] == '\0') {
+        out_binding->action = GAME_ACTION_LETTER;
+        out_binding->letter = (char)toupper((unsigned char)token[7]);
+        return 1;
+    }
+    for (int action = 0; action < GAME_ACTION_COUNT; action++) {
+        if (ACTION_NAMES[action] && strcmp(token, ACTION_NAMES[action]) == 0) {
+            out_binding->action = (uint8_t)action;
+            out_binding->letter = 0;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Applies a binding file over the defaults. Returns 1 on success; a missing
+// file or any malformed line leaves the current bindings untouched.
+int load_input_bindings(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    static InputBinding parsed[GAME_KEY_CODE_LIMIT];
+    memcpy(parsed, DEFAULT_BINDINGS, sizeof(parsed));
+
+    char line[128];
+    int valid = 1;
+    while (valid && fgets(line, sizeof(line), file)) {
+        char* comment = strchr(line, '#');
+        if (comment) {
+            *comment = '\0';
+        }
+        char key_token[32];
+        char action_token[32];
+        char extra[2];
+        int fields = sscanf(line, "%31s %31s %1s", key_token, action_token, extra);
+        if (fields <= 0) {
+            continue;                           // Blank or comment-only line
+        }
+        int key = fields == 2 ? parse_key(key_token) : -1;
+        valid = key >= 0 && parse_action(action_token, &parsed[key]);
+    }
+    fclose(file);
+    if (!valid) {
+        return 0;
+    }
+
+    memcpy(loaded_bindings, parsed, sizeof(loaded_bindings));
+    bindings = loaded_bindings;
+    return 1;
+}
+
+void reset_input_bindings(void) {
+    bindings = DEFAULT_BINDINGS;
+}
+
+// ============= EVENT RING =============
+
+uint32_t input_event_count(const InputEventRing* ring) {
+    return ring->tail - ring->head;
+}
+
+// Queues an event; a full ring drops it and counts the drop. Returns 1 if queued.
+int input_event_push(InputEventRing* ring, InputEvent event) {
+    uint32_t depth = input_event_count(ring);
+    if (depth == INPUT_EVENT_RING_SIZE) {
+        ring->dropped++;
+        return 0;
+    }
+    ring->events[ring->tail & (INPUT_EVENT_RING_SIZE - 1)] = event;
+    ring->tail++;
+    ring->queued++;
+    if (depth + 1 > ring->max_depth) {
+        ring->max_depth = depth + 1;
+    }
+    return 1;
+}
+
+int input_event_pop(InputEventRing* ring, InputEvent* out_event) {
+    if (ring->head == ring->tail) {
+        return 0;
+    }
+    *out_event = ring->events[ring->head & (INPUT_EVENT_RING_SIZE - 1)];
+    ring->head++;
+    ring->consumed++;
+    ring->last_event_time = out_event->time;
+    return 1;
+}
@@ -0,0 +1,558 @@
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include "systems.h"
+#include "crosswordle.h"
+#include "jobs.h"
+
+#ifdef _WIN32
+#include <windows.h>
+static int core_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+#else
+#include <unistd.h>
+static int core_count(void) {
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? (int)cores : 1;
+}
+#endif
+
+// Work-stealing job pool. Deques are Chase-Lev (fixed size, C11 atomics as in
+// Le et al., "Correct and Efficient Work-Stealing for Weak Memory Models").
+// A job's continuations form a lock-free list whose head word also holds the
+// job's generation: finishing swaps in CLOSED, so a continuation either joins
+// the list before that and is queued by the finisher, or sees CLOSED (or a
+// newer generation) and queues itself.
+
+#define JOB_NONE 0xFFFFFFFFu            // Empty deque / no job
+#define JOB_LIST_END 0xFFFFFFFFu        // Continuation list terminator
+#define JOB_LIST_CLOSED 0xFFFFFFFEu     // Parent finished: queue continuations directly
+#define JOB_IDLE_SPINS 64               // Empty polls before a worker sleeps
+
+typedef struct {
+    _Atomic uint32_t generation;        // Bumped when the job finishes; never 0
+    _Atomic uint32_t busy;              // Slot allocated
+    _Atomic uint64_t continuations;     // generation << 32 | first waiting continuation
+    uint32_t next;                      // Next continuation of the same parent
+    JobFunction function;
+    _Alignas(max_align_t) unsigned char data[JOB_DATA_SIZE];
+} Job;
+
+typedef struct {
+    _Atomic int64_t top;                // Thieves take here
+    _Atomic int64_t bottom;             // The owner pushes and pops here
+    _Atomic uint32_t slots[JOB_DEQUE_SIZE];
+} JobDeque;
+
+typedef struct {
+    pthread_t thread;
+    JobDeque deque;
+    _Atomic uint64_t busy_ns;           // Time spent running jobs
+    _Atomic uint32_t jobs_run;
+    _Atomic uint32_t jobs_stolen;
+    uint64_t sampled_busy_ns;           // busy_ns at the last jobs_sample_utilization
+} JobWorker;
+
+typedef struct {
+    JobFunction function;
+    _Alignas(max_align_t) unsigned char data[JOB_DATA_SIZE];
+} MainCallback;
+
+static struct {
+    Job jobs[JOB_CAPACITY];
+    JobWorker workers[JOB_MAX_WORKERS];
+    int worker_count;                   // 0: jobs run inline
+    int started;                        // Threads to join
+    _Atomic int running;
+    _Atomic uint32_t next_slot;         // Where the next allocation starts looking
+    _Atomic int in_flight;              // Allocated jobs not yet finished
+    _Atomic int sleepers;
+
+    // Jobs from threads outside the pool. There are never more than
+    // JOB_CAPACITY jobs, so the ring cannot overflow.
+    uint32_t inject[JOB_CAPACITY];
+    uint32_t inject_head;
+    _Atomic uint32_t inject_count;
+
+    double sampled_at;
+} pool;
+
+static pthread_mutex_t inject_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t sleep_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake_workers = PTHREAD_COND_INITIALIZER;
+
+static pthread_mutex_t main_queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static MainCallback main_queue[JOB_MAIN_QUEUE_SIZE];
+static uint32_t main_queue_head;
+static uint32_t main_queue_count;
+
+static _Thread_local int current_worker = -1;
+static _Thread_local int run_depth = 0;
+
+// ============= DEQUES =============
+
+static int deque_push(JobDeque* deque, uint32_t index) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    if (bottom - top >= JOB_DEQUE_SIZE) {
+        return 0;
+    }
+    atomic_store_explicit(&deque->slots[bottom & (JOB_DEQUE_SIZE - 1)], index, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    return 1;
+}
+
+static uint32_t deque_pop(JobDeque* deque) {
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return JOB_NONE;
+    }
+    uint32_t index = atomic_load_explicit(&deque->slots[bottom & (JOB_DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (top == bottom) {
+        // Last job: race the thieves for it
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            index = JOB_NONE;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+    return index;
+}
+
+static uint32_t deque_steal(JobDeque* deque) {
+    int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+    if (top >= bottom) {
+        return JOB_NONE;
+    }
+    uint32_t index = atomic_load_explicit(&deque->slots[top & (JOB_DEQUE_SIZE - 1)], memory_order_relaxed);
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return JOB_NONE;
+    }
+    return index;
+}
+
+// ============= SCHEDULING =============
+
+static int work_available(void) {
+    if (atomic_load(&pool.inject_count) > 0) {
+        return 1;
+    }
+    for (int w = 0; w < pool.worker_count; w++) {
+        JobDeque* deque = &pool.workers[w].deque;
+        if (atomic_load(&deque->bottom) > atomic_load(&deque->top)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void schedule_job(uint32_t index) {
+    int self = current_worker;
+    if (self < 0 || !deque_push(&pool.workers[self].deque, index)) {
+        pthread_mutex_lock(&inject_mutex);
+        uint32_t count = atomic_load_explicit(&pool.inject_count, memory_order_relaxed);
+        pool.inject[(pool.inject_head + count) % JOB_CAPACITY] = index;
+        atomic_store_explicit(&pool.inject_count, count + 1, memory_order_relaxed);
+        pthread_mutex_unlock(&inject_mutex);
+    }
+    // Pairs with the sleeper count a worker raises before its last look for
+    // work: either it sees this job or this sees it asleep
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&pool.sleepers) > 0) {
+        pthread_mutex_lock(&sleep_mutex);
+        pthread_cond_signal(&wake_workers);
+        pthread_mutex_unlock(&sleep_mutex);
+    }
+}
+
+static uint32_t find_job(int self, int* out_stolen) {
+    *out_stolen = 0;
+    if (self >= 0) {
+        uint32_t index = deque_pop(&pool.workers[self].deque);
+        if (index != JOB_NONE) {
+            return index;
+        }
+    }
+    if (atomic_load_explicit(&pool.inject_count, memory_order_relaxed) > 0) {
+        uint32_t index = JOB_NONE;
+        pthread_mutex_lock(&inject_mutex);
+        uint32_t count = atomic_load_explicit(&pool.inject_count, memory_order_relaxed);
+        if (count > 0) {
+            index = pool.inject[pool.inject_head];
+            pool.inject_head = (pool.inject_head + 1) % JOB_CAPACITY;
+            atomic_store_explicit(&pool.inject_count, count - 1, memory_order_relaxed);
+        }
+        pthread_mutex_unlock(&inject_mutex);
+        if (index != JOB_NONE) {
+            return index;
+        }
+    }
+    // Steal, starting with the next worker so thieves spread out
+    for (int k = 1; k <= pool.worker_count; k++) {
+        int victim = (self + k + pool.worker_count) % pool.worker_count;
+        if (victim == self) {
+            continue;
+        }
+        uint32_t index = deque_steal(&pool.workers[victim].deque);
+        if (index != JOB_NONE) {
+            *out_stolen = 1;
+            return index;
+        }
+    }
+    return JOB_NONE;
+}
+
+static void finish_job(uint32_t index) {
+    Job* job = &pool.jobs[index];
+    uint32_t generation = atomic_load_explicit(&job->generation, memory_order_relaxed);
+    uint64_t list = atomic_exchange_explicit(&job->continuations,
+                                             (uint64_t)generation << 32 | JOB_LIST_CLOSED, memory_order_acq_rel);
+    atomic_store_explicit(&job->generation, generation + 1 == 0 ? 1 : generation + 1, memory_order_release);
+    atomic_store_explicit(&job->busy, 0, memory_order_release);
+    atomic_fetch_sub(&pool.in_flight, 1);
+
+    for (uint32_t next = (uint32_t)list; next != JOB_LIST_END;) {
+        uint32_t continuation = next;
+        next = pool.jobs[continuation].next;    // Read before it can run and be reused
+        schedule_job(continuation);
+    }
+}
+
+static void run_job(int self, uint32_t index, int stolen) {
+    Job* job = &pool.jobs[index];
+    double start = crosswordle_clock();
+    run_depth++;
+    job->function(job->data);
+    run_depth--;
+    finish_job(index);
+
+    if (self >= 0) {
+        JobWorker* worker = &pool.workers[self];
+        // Jobs run while waiting inside another job are already in its time
+        if (run_depth == 0) {
+            atomic_fetch_add_explicit(&worker->busy_ns, (uint64_t)((crosswordle_clock() - start) * 1e9),
+                                      memory_order_relaxed);
+        }
+        atomic_fetch_add_explicit(&worker->jobs_run, 1, memory_order_relaxed);
+        if (stolen) {
+            atomic_fetch_add_explicit(&worker->jobs_stolen, 1, memory_order_relaxed);
+        }
+    }
+}
+
+// Runs one queued job on the calling thread; returns 0 if there was none
+static int help_once(void) {
+    int stolen;
+    uint32_t index = find_job(current_worker, &stolen);
+    if (index == JOB_NONE) {
+        return 0;
+    }
+    run_job(current_worker, index, stolen);
+    return 1;
+}
+
+static void* worker_main(void* arg) {
+    int self = (int)(intptr_t)arg;
+    current_worker = self;
+    int idle_polls = 0;
+    while (atomic_load_explicit(&pool.running, memory_order_acquire)) {
+        if (help_once()) {
+            idle_polls = 0;
+        } else if (++idle_polls < JOB_IDLE_SPINS) {
+            sched_yield();
+        } else {
+            idle_polls = 0;
+            atomic_fetch_add(&pool.sleepers, 1);
+            pthread_mutex_lock(&sleep_mutex);
+            while (atomic_load(&pool.running) && !work_available()) {
+                pthread_cond_wait(&wake_workers, &sleep_mutex);
+            }
+            pthread_mutex_unlock(&sleep_mutex);
+            atomic_fetch_sub(&pool.sleepers, 1);
+        }
+    }
+    return NULL;
+}
+
+// ============= POOL =============
+
+int jobs_init(int worker_count) {
+    jobs_shutdown();
+    if (worker_count <= 0) {
+        worker_count = core_count() - 1;
+    }
+    if (worker_count > JOB_MAX_WORKERS) {
+        worker_count = JOB_MAX_WORKERS;
+    }
+    if (worker_count <= 0) {
+        return 0;
+    }
+
+    for (int i = 0; i < JOB_CAPACITY; i++) {
+        atomic_store(&pool.jobs[i].generation, 1);
+        atomic_store(&pool.jobs[i].busy, 0);
+    }
+    for (int w = 0; w < JOB_MAX_WORKERS; w++) {
+        JobWorker* worker = &pool.workers[w];
+        atomic_store(&worker->deque.top, 0);
+        atomic_store(&worker->deque.bottom, 0);
+        atomic_store(&worker->busy_ns, 0);
+        atomic_store(&worker->jobs_run, 0);
+        atomic_store(&worker->jobs_stolen, 0);
+        worker->sampled_busy_ns = 0;
+    }
+    atomic_store(&pool.next_slot, 0);
+    atomic_store(&pool.in_flight, 0);
+    atomic_store(&pool.sleepers, 0);
+    atomic_store(&pool.inject_count, 0);
+    pool.inject_head = 0;
+    pool.sampled_at = crosswordle_clock();
+    atomic_store(&pool.running, 1);
+
+    // Workers that failed to start keep empty deques; only workers push to them
+    pool.worker_count = worker_count;
+    pool.started = 0;
+    for (int w = 0; w < worker_count; w++) {
+        if (pthread_create(&pool.workers[w].thread, NULL, worker_main, (void*)(intptr_t)w) != 0) {
+            break;
+        }
+        pool.started++;
+    }
+    if (pool.started == 0) {
+        atomic_store(&pool.running, 0);
+        pool.worker_count = 0;
+    }
+    return pool.started;
+}
+
+void jobs_shutdown(void) {
+    if (pool.worker_count == 0) {
+        return;
+    }
+    while (atomic_load(&pool.in_flight) > 0) {
+        if (!help_once()) {
+            sched_yield();
+        }
+    }
+    atomic_store(&pool.running, 0);
+    pthread_mutex_lock(&sleep_mutex);
+    pthread_cond_broadcast(&wake_workers);
+    pthread_mutex_unlock(&sleep_mutex);
+    for (int w = 0; w < pool.started; w++) {
+        pthread_join(pool.workers[w].thread, NULL);
+    }
+    pool.worker_count = 0;
+    pool.started = 0;
+}
+
+int jobs_worker_count(void) {
+    return pool.worker_count;
+}
+
+// ============= JOBS =============
+
+static void run_inline(JobFunction function, const void* data, size_t size) {
+    _Alignas(max_align_t) unsigned char copy[JOB_DATA_SIZE];
+    if (size <= JOB_DATA_SIZE) {
+        memcpy(copy, data, size);
+        function(copy);
+        return;
+    }
+    // Too big for a slot: still a private copy, so the job may write to it
+    void* heap_copy = malloc(size);
+    if (heap_copy) {
+        memcpy(heap_copy, data, size);
+    }
+    function(heap_copy ? heap_copy : (void*)data);
+    free(heap_copy);
+}
+
+// Claims a free slot and fills it; JOB_NONE if there are no workers or no slot
+static uint32_t allocate_job(JobFunction function, const void* data, size_t size) {
+    if (pool.worker_count == 0) {
+        return JOB_NONE;
+    }
+    for (int attempt = 0; attempt < JOB_CAPACITY; attempt++) {
+        uint32_t index = atomic_fetch_add_explicit(&pool.next_slot, 1, memory_order_relaxed) % JOB_CAPACITY;
+        Job* job = &pool.jobs[index];
+        uint32_t idle = 0;
+        if (atomic_compare_exchange_strong_explicit(&job->busy, &idle, 1, memory_order_acquire, memory_order_relaxed)) {
+            uint32_t generation = atomic_load_explicit(&job->generation, memory_order_relaxed);
+            atomic_store_explicit(&job->continuations, (uint64_t)generation << 32 | JOB_LIST_END,
+                                  memory_order_relaxed);
+            job->next = JOB_LIST_END;
+            job->function = function;
+            memcpy(job->data, data, size);
+            atomic_fetch_add(&pool.in_flight, 1);
+            return index;
+        }
+    }
+    return JOB_NONE;
+}
+
+static JobHandle handle_for(uint32_t index) {
+    JobHandle handle = {index, atomic_load_explicit(&pool.jobs[index].generation, memory_order_relaxed)};
+    return handle;
+}
+
+JobHandle jobs_submit(JobFunction function, const void* data, size_t size) {
+    JobHandle done = {0, 0};
+    // Arguments too big for a slot run inline, like a job with no free slot
+    uint32_t index = size <= JOB_DATA_SIZE ? allocate_job(function, data, size) : JOB_NONE;
+    if (index == JOB_NONE) {
+        run_inline(function, data, size);
+        return done;
+    }
+    JobHandle handle = handle_for(index);
+    schedule_job(index);
+    return handle;
+}
+
+JobHandle jobs_then(JobHandle parent, JobFunction function, const void* data, size_t size) {
+    JobHandle done = {0, 0};
+    uint32_t index = size <= JOB_DATA_SIZE ? allocate_job(function, data, size) : JOB_NONE;
+    if (index == JOB_NONE) {
+        jobs_wait(parent);
+        run_inline(function, data, size);
+        return done;
+    }
+    JobHandle handle = handle_for(index);
+
+    if (parent.generation == 0 || parent.index >= JOB_CAPACITY) {
+        schedule_job(index);
+        return handle;
+    }
+    _Atomic uint64_t* list = &pool.jobs[parent.index].continuations;
+    uint64_t head = atomic_load_explicit(list, memory_order_acquire);
+    for (;;) {
+        uint32_t first = (uint32_t)head;
+        if ((uint32_t)(head >> 32) != parent.generation || first == JOB_LIST_CLOSED) {
+            schedule_job(index);    // Parent already finished
+            break;
+        }
+        pool.jobs[index].next = first;
+        if (atomic_compare_exchange_weak_explicit(list, &head, (uint64_t)parent.generation << 32 | index,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            break;
+        }
+    }
+    return handle;
+}
+
+int jobs_done(JobHandle job) {
+    return job.generation == 0 || job.index >= JOB_CAPACITY ||
+           atomic_load_explicit(&pool.jobs[job.index].generation, memory_order_acquire) != job.generation;
+}
+
+void jobs_wait(JobHandle job) {
+    while (!jobs_done(job)) {
+        if (!help_once()) {
+            sched_yield();
+        }
+    }
+}
+
+typedef struct {
+    JobRangeFunction body;
+    void* context;
+    int begin;
+    int end;
+    _Atomic int* remaining;
+} RangeJob;
+
+static void run_range(void* data) {
+    RangeJob* range = data;
+    range->body(range->context, range->begin, range->end);
+    atomic_fetch_sub_explicit(range->remaining, 1, memory_order_release);
+}
+
+void jobs_parallel_for(int count, int grain, JobRangeFunction body, void* context) {
+    if (grain < 1) {
+        grain = 1;
+    }
+    if (pool.worker_count == 0 || count <= grain) {
+        if (count > 0) {
+            body(context, 0, count);
+        }
+        return;
+    }
+    _Atomic int remaining = (count + grain - 1) / grain;
+    for (int begin = 0; begin < count; begin += grain) {
+        RangeJob range = {body, context, begin, begin + grain < count ? begin + grain : count, &remaining};
+        jobs_submit(run_range, &range, sizeof(range));
+    }
+    // The caller works through the chunks too
+    while (atomic_load_explicit(&remaining, memory_order_acquire) > 0) {
+        if (!help_once()) {
+            sched_yield();
+        }
+    }
+}
+
+// ============= MAIN-THREAD QUEUE =============
+
+int jobs_post_main(JobFunction function, const void* data, size_t size) {
+    if (size > JOB_DATA_SIZE) {
+        return 0;
+    }
+    pthread_mutex_lock(&main_queue_mutex);
+    int ok = main_queue_count < JOB_MAIN_QUEUE_SIZE;
+    if (ok) {
+        MainCallback* callback = &main_queue[(main_queue_head + main_queue_count) % JOB_MAIN_QUEUE_SIZE];
+        callback->function = function;
+        memcpy(callback->data, data, size);
+        main_queue_count++;
+    }
+    pthread_mutex_unlock(&main_queue_mutex);
+    return ok;
+}
+
+int jobs_drain_main(void) {
+    static MainCallback batch[JOB_MAIN_QUEUE_SIZE];
+    pthread_mutex_lock(&main_queue_mutex);
+    int count = (int)main_queue_count;
+    for (int i = 0; i < count; i++) {
+        batch[i] = main_queue[(main_queue_head + (uint32_t)i) % JOB_MAIN_QUEUE_SIZE];
+    }
+    main_queue_head = (main_queue_head + main_queue_count) % JOB_MAIN_QUEUE_SIZE;
+    main_queue_count = 0;
+    pthread_mutex_unlock(&main_queue_mutex);
+
+    // Outside the lock, so callbacks may post again (for the next drain)
+    for (int i = 0; i < count; i++) {
+        batch[i].function(batch[i].data);
+    }
+    return count;
+}
+
+// ============= UTILIZATION =============
+
+void jobs_sample_utilization(JobsUtilization* out) {
+    memset(out, 0, sizeof(*out));
+    double now = crosswordle_clock();
+    double elapsed_ns = (now - pool.sampled_at) * 1e9;
+    pool.sampled_at = now;
+    out->worker_count = pool.worker_count;
+    for (int w = 0; w < pool.worker_count; w++) {
+        JobWorker* worker = &pool.workers[w];
+        uint64_t busy = atomic_load_explicit(&worker->busy_ns, memory_order_relaxed);
+        double percent = elapsed_ns > 0.0 ? (double)(busy - worker->sampled_busy_ns) * 100.0 / elapsed_ns : 0.0;
+        worker->sampled_busy_ns = busy;
+        // A job's time lands when it ends, so one that spans samples can read over 100%
+        out->busy_percent[w] = (uint8_t)(percent < 100.0 ? percent + 0.5 : 100.0);
+        out->jobs_run[w] = atomic_load_explicit(&worker->jobs_run, memory_order_relaxed);
+        out->jobs_stolen[w] = atomic_load_explicit(&worker->jobs_stolen, memory_order_relaxed);
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "types.h"
+#include <stddef.h>
+
+// Job system: one pool of worker threads for background work
+//
+// Each worker owns a deque of jobs: it pushes and pops at the bottom, idle
+// workers steal from the top. Threads outside the pool (the window and update
+// threads, tools) submit through a shared injection queue. A job is a function
+// plus up to JOB_DATA_SIZE bytes of arguments, copied into a fixed pool, so
+// submitting never allocates. Jobs are named by JobHandle; a handle stays
+// valid after its job finishes (it just reports done) because every slot
+// carries a generation that the handle must match.
+//
+// A continuation is a job that is queued when its parent finishes. Work that
+// has to touch front-end state posts a callback to the main-thread queue,
+// which the front end drains once per frame.
+//
+// Without jobs_init (tests, tools, single-core machines) there are no workers
+// and every job runs inline on the submitting thread.
+
+#define JOB_CAPACITY 4096               // Jobs queued, running or awaiting their parent
+#define JOB_DEQUE_SIZE 1024             // Per worker; must be a power of two
+#define JOB_DATA_SIZE 64                // Argument bytes copied with each job
+#define JOB_MAIN_QUEUE_SIZE 256         // Callbacks waiting for the main thread
+
+typedef void (*JobFunction)(void* data);
+typedef void (*JobRangeFunction)(void* context, int begin, int end);
+
+typedef struct {
+    uint32_t index;
+    uint32_t generation;    // 0 for a job that ran inline: always done
+} JobHandle;
+
+// Starts worker_count workers (0: one per core but one, capped at
+// JOB_MAX_WORKERS). Returns the number started.
+int jobs_init(int worker_count);
+// Runs every queued job to completion, then stops the workers
+void jobs_shutdown(void);
+int jobs_worker_count(void);
+
+// Queues a job. data (size bytes) is copied. A job with more than
+// JOB_DATA_SIZE bytes of data, or submitted when no slot is free, runs inline
+// before the call returns, and its handle is already done.
+JobHandle jobs_submit(JobFunction function, const void* data, size_t size);
+// Queues a job once `parent` has finished (at once if it already has)
+JobHandle jobs_then(JobHandle parent, JobFunction function, const void* data, size_t size);
+int jobs_done(JobHandle job);
+// Runs other jobs until `job` is done
+void jobs_wait(JobHandle job);
+// Calls body over [0, count) in chunks of at most `grain`, spread over the
+// workers, and returns once every chunk has run
+void jobs_parallel_for(int count, int grain, JobRangeFunction body, void* context);
+
+// Queues a callback for jobs_drain_main. Returns 0 if the queue is full or
+// data is over JOB_DATA_SIZE bytes.
+int jobs_post_main(JobFunction function, const void* data, size_t size);
+// Runs the queued callbacks on the calling thread; returns how many ran
+int jobs_drain_main(void);
+
+// Per-worker utilization since the previous call
+void jobs_sample_utilization(JobsUtilization* out);
+
+#endif
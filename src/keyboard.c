@@ -0,0 +1,32 @@
+#include "systems.h"
+
+// On-screen keyboard letter states. The table only changes when a guess
+// completes, so drawing the keyboard costs a lookup per key and the renderer
+// can cache the panel until the version moves.
+
+// Later reveals never downgrade a letter: green beats yellow beats grey
+static int letter_state_rank(LetterState state) {
+    switch (state) {
+        case LETTER_CORRECT: return 3;
+        case LETTER_WRONG_POS: return 2;
+        case LETTER_NOT_IN_WORD: return 1;
+        default: return 0;
+    }
+}
+
+void keyboard_state_reset(KeyboardState* keyboard) {
+    memset(keyboard->letters, 0, sizeof(keyboard->letters));
+    keyboard->version++;
+}
+
+void keyboard_state_update(KeyboardState* keyboard, const char* guess, const LetterState* states, int word_length) {
+    int changed = 0;
+    for (int i = 0; i < word_length; i++) {
+        LetterState* letter = &keyboard->letters[guess[i] - 'A'];
+        if (letter_state_rank(states[i]) > letter_state_rank(*letter)) {
+            *letter = states[i];
+            changed = 1;
+        }
+    }
+    keyboard->version += changed;
+}
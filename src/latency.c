@@ -0,0 +1,88 @@
+#include "systems.h"
+
+// Input-to-photon latency. The timestamp taken when the platform read a key
+// rides on its InputEvent into SystemState.action_time; the system that makes
+// the action visible (a letter typed, a cell filled, a guess revealed) leaves a
+// LatencyMark, and the front end closes the marks after EndDrawing returns for
+// the frame that draws them. Samples land in fixed per-action histograms, so
+// recording is O(1) and the overlay and dump never sort.
+
+// Marks the action being applied as made visible this tick
+void latency_mark(GameState* state) {
+    if (state->system.action == GAME_ACTION_NONE || state->system.latency_mark_count >= LATENCY_MAX_MARKS) {
+        return;
+    }
+    LatencyMark* mark = &state->system.latency_marks[state->system.latency_mark_count++];
+    mark->time = state->system.action_time;
+    mark->action = (uint8_t)state->system.action;
+}
+
+void latency_record(LatencyHistograms* histograms, GameAction action, double seconds) {
+    if (action <= GAME_ACTION_NONE || action >= GAME_ACTION_COUNT) {
+        return;
+    }
+    double ms = seconds > 0.0 ? seconds * 1000.0 : 0.0;
+    int bucket = (int)(ms / LATENCY_BUCKET_MS);
+    if (bucket >= LATENCY_BUCKET_COUNT) {
+        bucket = LATENCY_BUCKET_COUNT - 1;
+    }
+    histograms->buckets[action][bucket]++;
+    histograms->count[action]++;
+    histograms->total_ms[action] += ms;
+    if (ms > histograms->max_ms[action]) {
+        histograms->max_ms[action] = ms;
+    }
+    histograms->version++;
+}
+
+// Upper edge (ms) of the bucket holding the given fraction of samples; the
+// overflow bucket reports the largest sample instead
+double latency_percentile(const LatencyHistograms* histograms, GameAction action, double fraction) {
+    uint32_t count = histograms->count[action];
+    if (count == 0) {
+        return 0.0;
+    }
+    uint32_t rank = (uint32_t)(fraction * (double)count + 0.5);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < LATENCY_BUCKET_COUNT - 1; bucket++) {
+        seen += histograms->buckets[action][bucket];
+        if (seen >= rank) {
+            return (bucket + 1) * LATENCY_BUCKET_MS;
+        }
+    }
+    return histograms->max_ms[action];
+}
+
+// CSV stats dump: one row per action with samples, summary columns then the
+// raw bucket counts. Returns 1 on success.
+int latency_write_stats(const LatencyHistograms* histograms, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return 0;
+    }
+    fprintf(file, "action,count,mean_ms,p50_ms,p95_ms,p99_ms,max_ms");
+    for (int bucket = 0; bucket < LATENCY_BUCKET_COUNT; bucket++) {
+        fprintf(file, ",lt_%d_ms", (int)((bucket + 1) * LATENCY_BUCKET_MS));
+    }
+    fputc('\n', file);
+
+    for (int action = GAME_ACTION_NONE + 1; action < GAME_ACTION_COUNT; action++) {
+        uint32_t count = histograms->count[action];
+        if (count == 0) {
+            continue;
+        }
+        fprintf(file, "%s,%u,%.3f,%.1f,%.1f,%.1f,%.3f", input_action_name((GameAction)action), count,
+                histograms->total_ms[action] / count,
+                latency_percentile(histograms, (GameAction)action, 0.50),
+                latency_percentile(histograms, (GameAction)action, 0.95),
+                latency_percentile(histograms, (GameAction)action, 0.99),
+                histograms->max_ms[action]);
+        for (int bucket = 0; bucket < LATENCY_BUCKET_COUNT; bucket++) {
+            fprintf(file, ",%u", histograms->buckets[action][bucket]);
+        }
+        fputc('\n', file);
+    }
+    return fclose(file) == 0;
+}
@@ -0,0 +1,161 @@
+#include "systems.h"
+
+// Board layout is pure arithmetic on the state (screen size comes from the last
+// input), so it lives in the core library and is shared by rendering and tools.
+
+LayoutConfig calculate_layout(GameState state) {
+    LayoutConfig layout = {0};
+    
+    layout.screen_width = state.system.screen_width;
+    layout.screen_height = state.system.screen_height;
+    
+    int available_width = layout.screen_width - 100;
+    int word_length = state.core.word_length;
+    
+    // Calculate cell size based on available width (width units are a per-length constant)
+    layout.cell_size = available_width / get_word_kernels(word_length)->layout_width_units;
+    
+    if (layout.cell_size < MIN_CELL_SIZE) layout.cell_size = MIN_CELL_SIZE;
+    if (layout.cell_size > MAX_CELL_SIZE) layout.cell_size = MAX_CELL_SIZE;
+    
+    layout.cell_spacing = (int)(layout.cell_size * CELL_SPACING_RATIO);
+    layout.row_height = layout.cell_size + layout.cell_spacing;
+    
+    // Calculate dynamic row count: completed guesses + 1 input row
+    layout.total_rows = state.history.level_guess_count + 1;
+    layout.current_input_row = state.history.level_guess_count;  // 0-indexed
+    
+    layout.board_width = word_length * layout.cell_size + (word_length - 1) * layout.cell_spacing;
+    layout.board_height = layout.total_rows * layout.row_height - layout.cell_spacing;  // Remove spacing after last row
+    
+    layout.board_start_x = (layout.screen_width - layout.board_width) / 2;
+    
+    // Calculate board_start_y with camera offset to center current input row
+    int input_row_y = layout.current_input_row * layout.row_height;
+    int desired_input_y = (layout.screen_height - layout.cell_size) / 2;  // Center of screen
+    layout.board_start_y = desired_input_y - input_row_y + (int)state.system.camera_offset_y;
+    
+    return layout;
+}
+
+// ============= ON-SCREEN KEYBOARD =============
+
+static const char KEYBOARD_LETTERS[] = "QWERTYUIOPASDFGHJKLZXCVBNM";
+
+// Panel sits centered above the view's bottom bar
+KeyboardLayout calculate_keyboard_layout(GameViewState view, int screen_width, int screen_height) {
+    KeyboardLayout layout = {0};
+    if (view != VIEW_WORDLE && view != VIEW_CROSSWORD) {
+        return layout;
+    }
+    
+    layout.key_spacing = KEYBOARD_KEY_SPACING;
+    layout.key_width = screen_width / 20;
+    if (layout.key_width < 24) layout.key_width = 24;
+    if (layout.key_width > 44) layout.key_width = 44;
+    layout.key_height = screen_height / 22;
+    if (layout.key_height < 22) layout.key_height = 22;
+    if (layout.key_height > 40) layout.key_height = 40;
+    
+    layout.width = 10 * (layout.key_width + layout.key_spacing) - layout.key_spacing;
+    layout.height = 3 * layout.key_height + 2 * layout.key_spacing;
+    int margin_bottom = view == VIEW_WORDLE ? BOARD_MARGIN_BOTTOM : KEYBOARD_CROSSWORD_MARGIN_BOTTOM;
+    layout.x = (screen_width - layout.width) / 2;
+    layout.y = screen_height - margin_bottom - layout.height;
+    return layout;
+}
+
+// Keys 0-9 and 10-18 are the top two letter rows (the second indented half a
+// key); 19 is ENTER, 20-26 the bottom letters and 27 BACKSPACE
+KeyboardKeyRect keyboard_key(const KeyboardLayout* layout, int index) {
+    int unit = layout->key_width + layout->key_spacing;
+    int wide_offset = unit * 3 / 2;
+    KeyboardKeyRect key = {0, 0, 0, layout->key_width, layout->key_height};
+    
+    if (index < 10) {
+        key.x = index * unit;
+    } else if (index < 19) {
+        key.x = unit / 2 + (index - 10) * unit;
+        key.y = layout->key_height + layout->key_spacing;
+    } else {
+        key.y = 2 * (layout->key_height + layout->key_spacing);
+        if (index == 19 || index == 27) {
+            key.key = index == 19 ? GAME_KEY_ENTER : GAME_KEY_BACKSPACE;
+            key.x = index == 19 ? 0 : wide_offset + 7 * unit;
+            key.width = wide_offset - layout->key_spacing;
+            return key;
+        }
+        key.x = wide_offset + (index - 20) * unit;
+        index--;
+    }
+    key.key = GAME_KEY_A + (KEYBOARD_LETTERS[index] - 'A');
+    return key;
+}
+
+// GameKey under a screen position, GAME_KEY_NONE for gaps and misses
+int keyboard_key_at(const KeyboardLayout* layout, int x, int y) {
+    x -= layout->x;
+    y -= layout->y;
+    if (x < 0 || y < 0 || x >= layout->width || y >= layout->height) {
+        return GAME_KEY_NONE;
+    }
+    for (int i = 0; i < KEYBOARD_KEY_COUNT; i++) {
+        KeyboardKeyRect key = keyboard_key(layout, i);
+        if (x >= key.x && x < key.x + key.width && y >= key.y && y < key.y + key.height) {
+            return key.key;
+        }
+    }
+    return GAME_KEY_NONE;
+}
+
+// ============= TEXT WRAPPING =============
+
+// Greedy word wrap: each line takes as many whole words as fit in max_width,
+// and a word wider than a line on its own is split between letters. Spaces at
+// a break are dropped. Returns the number of lines, at most max_lines; text
+// past the last line is left out.
+int text_wrap(const char* text, int max_width, TextMeasureFunction measure, void* context,
+              TextLine* lines, int max_lines) {
+    int line_count = 0;
+    int position = 0;
+    int length = (int)strlen(text);
+    while (line_count < max_lines) {
+        while (position < length && text[position] == ' ') {
+            position++;
+        }
+        if (position >= length) {
+            break;
+        }
+        
+        // Extend word by word while the line still fits
+        int end = position;
+        while (end < length) {
+            int word_end = end;
+            while (word_end < length && text[word_end] == ' ') {
+                word_end++;
+            }
+            while (word_end < length && text[word_end] != ' ') {
+                word_end++;
+            }
+            if (measure(context, text + position, word_end - position) > max_width) {
+                break;
+            }
+            end = word_end;
+        }
+        
+        // Not even the first word fits: take as many letters as do, at least one
+        if (end == position) {
+            end = position + 1;
+            while (end < length && text[end] != ' ' &&
+                   measure(context, text + position, end + 1 - position) <= max_width) {
+                end++;
+            }
+        }
+        
+        lines[line_count].start = position;
+        lines[line_count].length = end - position;
+        line_count++;
+        position = end;
+    }
+    return line_count;
+}
@@ -0,0 +1,647 @@
+#define _FILE_OFFSET_BITS 64                  // 64-bit off_t for fseeko past 2 GiB
+
+#include "leaderboard.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Leaderboard store. The game thread only appends to a pending batch; the
+// writer thread takes the whole batch, sorts it and applies it leaf by leaf,
+// so records landing in the same leaf read and write its page once.
+//
+// A batch never overwrites a page the header on disk refers to. A leaf it
+// changes is written to a free page (or a new one past the end), the new
+// index goes to free space too, and only after both are synced is the header
+// rewritten to point at them. The pages the old header used become free once
+// the new one is down. A crash mid-batch leaves the old header and everything
+// it refers to intact, so the store reopens as it was before that batch.
+
+_Static_assert(sizeof(LeaderboardRecord) == 32, "LeaderboardRecord is a fixed 32-byte record");
+_Static_assert(sizeof(LeaderboardPage) <= LEADERBOARD_PAGE_SIZE, "LeaderboardPage must fit a page");
+_Static_assert(sizeof(LeaderboardFileHeader) <= LEADERBOARD_PAGE_SIZE, "header must fit page 0");
+
+typedef struct {
+    uint32_t board;
+    uint32_t score;
+    uint32_t sequence;
+} LeaderboardKey;
+
+typedef struct {
+    // Writer side, guarded by file_mutex
+    FILE* file;
+    LeaderboardFileHeader header;
+    LeaderboardIndexEntry* index;
+    uint32_t index_capacity;
+    uint32_t index_pages;           // Size of the index region the header on disk points at
+    uint32_t* free_pages;           // Pages the header does not use, ascending
+    uint32_t free_next;             // Free pages before this one are taken by the batch
+    uint32_t free_capacity;
+    uint32_t* freed;                // Pages the batch replaced; free after its commit
+    uint32_t freed_count;
+    uint32_t freed_capacity;
+    uint8_t* fresh;                 // Per page: written by this batch, safe to rewrite
+    uint32_t fresh_capacity;
+    uint32_t failed_batches;        // Batches dropped on a write error
+    int broken;                     // The store could not be reread after one
+    pthread_mutex_t file_mutex;
+
+    // Submit side, guarded by mutex
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;            // Writer: records pending or closing
+    pthread_cond_t idle;            // Submitters and flush: batch taken or written
+    LeaderboardRecord pending[LEADERBOARD_BATCH_CAPACITY];
+    uint32_t pending_count;
+    uint32_t next_sequence;
+    int writing;
+    int running;
+    int threaded;                   // 0 if the writer thread could not start
+    pthread_t writer;
+    int open;
+} LeaderboardStore;
+
+static LeaderboardStore store;
+
+uint32_t leaderboard_board(uint32_t profile, LeaderboardMode mode, LeaderboardMetric metric) {
+    return (profile & 0xFFFFu) << 16 | ((uint32_t)mode & 0xFFu) << 8 | ((uint32_t)metric & 0xFFu);
+}
+
+uint32_t leaderboard_score(LeaderboardMetric metric, uint32_t value) {
+    return metric == LEADERBOARD_LONGEST_STREAK ? UINT32_MAX - value : value;
+}
+
+// ============= KEYS AND PAGES =============
+
+static LeaderboardKey record_key(const LeaderboardRecord* record) {
+    return (LeaderboardKey){record->board, record->score, record->sequence};
+}
+
+static LeaderboardKey entry_key(const LeaderboardIndexEntry* entry) {
+    return (LeaderboardKey){entry->board, entry->score, entry->sequence};
+}
+
+static int compare_keys(LeaderboardKey a, LeaderboardKey b) {
+    if (a.board != b.board) return a.board < b.board ? -1 : 1;
+    if (a.score != b.score) return a.score < b.score ? -1 : 1;
+    if (a.sequence != b.sequence) return a.sequence < b.sequence ? -1 : 1;
+    return 0;
+}
+
+static int compare_records(const void* a, const void* b) {
+    return compare_keys(record_key(a), record_key(b));
+}
+
+// Index position of the leaf a key belongs in: the last leaf whose first key
+// is not above it (the first leaf for keys below every leaf)
+static uint32_t find_leaf(LeaderboardKey key) {
+    uint32_t low = 0;
+    uint32_t high = store.header.index_count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (compare_keys(entry_key(&store.index[mid]), key) <= 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low > 0 ? low - 1 : 0;
+}
+
+// First record position in a leaf not below the key
+static uint32_t find_position(const LeaderboardPage* page, LeaderboardKey key) {
+    uint32_t low = 0;
+    uint32_t high = page->count;
+    while (low < high) {
+        uint32_t mid = low + (high - low) / 2;
+        if (compare_keys(record_key(&page->records[mid]), key) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+static int seek_to(uint64_t offset) {
+    return fseeko(store.file, (off_t)offset, SEEK_SET) == 0;
+}
+
+static int read_page(uint32_t page, LeaderboardPage* out_page) {
+    return seek_to((uint64_t)page * LEADERBOARD_PAGE_SIZE) &&
+           fread(out_page, sizeof(*out_page), 1, store.file) == 1 &&
+           out_page->count <= LEADERBOARD_PAGE_RECORDS;
+}
+
+static int write_page(uint32_t page, const LeaderboardPage* leaf) {
+    return seek_to((uint64_t)page * LEADERBOARD_PAGE_SIZE) &&
+           fwrite(leaf, sizeof(*leaf), 1, store.file) == 1;
+}
+
+// Adds a leaf entry at index position `at`
+static int index_insert(uint32_t at, const LeaderboardRecord* first, uint32_t page) {
+    if (store.header.index_count == store.index_capacity) {
+        uint32_t capacity = store.index_capacity ? store.index_capacity * 2 : 64;
+        LeaderboardIndexEntry* index = realloc(store.index, capacity * sizeof(LeaderboardIndexEntry));
+        if (!index) {
+            return 0;
+        }
+        store.index = index;
+        store.index_capacity = capacity;
+    }
+    memmove(&store.index[at + 1], &store.index[at],
+            (store.header.index_count - at) * sizeof(LeaderboardIndexEntry));
+    store.index[at] = (LeaderboardIndexEntry){first->board, first->score, first->sequence, page};
+    store.header.index_count++;
+    return 1;
+}
+
+// ============= PAGE ALLOCATION =============
+
+static int grow_array(void** array, uint32_t* capacity, uint32_t needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 1;
+    }
+    uint32_t grown = *capacity ? *capacity : 64;
+    while (grown < needed) {
+        grown *= 2;
+    }
+    void* resized = realloc(*array, grown * element_size);
+    if (!resized) {
+        return 0;
+    }
+    *array = resized;
+    *capacity = grown;
+    return 1;
+}
+
+// Pages holding the index entries and the free list that follows them
+static uint32_t index_region_pages(uint32_t index_count, uint32_t free_count) {
+    uint64_t bytes = (uint64_t)index_count * sizeof(LeaderboardIndexEntry) + (uint64_t)free_count * sizeof(uint32_t);
+    return (uint32_t)((bytes + LEADERBOARD_PAGE_SIZE - 1) / LEADERBOARD_PAGE_SIZE);
+}
+
+static int is_fresh(uint32_t page) {
+    return page < store.fresh_capacity && store.fresh[page];
+}
+
+// A page for this batch to write: a free one, else one past the end
+static int allocate_page(uint32_t* out_page) {
+    uint32_t page = store.free_next < store.header.free_count ? store.free_pages[store.free_next] : store.header.page_count;
+    uint32_t old_capacity = store.fresh_capacity;
+    if (!grow_array((void**)&store.fresh, &store.fresh_capacity, page + 1, 1)) {
+        return 0;
+    }
+    memset(store.fresh + old_capacity, 0, store.fresh_capacity - old_capacity);
+    if (store.free_next < store.header.free_count) {
+        store.free_next++;
+    } else {
+        store.header.page_count++;
+    }
+    store.fresh[page] = 1;
+    *out_page = page;
+    return 1;
+}
+
+// Writes the leaf at index position `leaf`, moving it to a fresh page first
+// if its page is one the header on disk still refers to
+static int write_leaf(uint32_t leaf, const LeaderboardPage* page) {
+    uint32_t target = store.index[leaf].page;
+    if (!is_fresh(target)) {
+        if (!grow_array((void**)&store.freed, &store.freed_capacity, store.freed_count + 1, sizeof(uint32_t)) ||
+            !allocate_page(&target)) {
+            return 0;
+        }
+        store.freed[store.freed_count++] = store.index[leaf].page;
+        store.index[leaf].page = target;
+    }
+    return write_page(target, page);
+}
+
+static int compare_pages(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+static int sync_file(void) {
+    return fflush(store.file) == 0 && fsync(fileno(store.file)) == 0;
+}
+
+// Writes the index and free list to pages the header on disk does not use,
+// syncs them, then rewrites and syncs the header. The pages the old header
+// used for its index and replaced leaves are free from then on.
+static int commit_batch(void) {
+    LeaderboardFileHeader* header = &store.header;
+    uint32_t old_start = (uint32_t)(header->index_offset / LEADERBOARD_PAGE_SIZE);
+    uint32_t old_pages = store.index_pages;
+    uint32_t unused = header->free_count - store.free_next;
+    uint32_t* unused_pages = store.free_pages + store.free_next;
+    uint32_t free_total = unused + store.freed_count + old_pages;
+    uint32_t region_pages = index_region_pages(header->index_count, free_total);
+
+    // The first run of free pages long enough, else the end of the file. The
+    // region's own pages leave the free list, so it is only taken from there
+    // if that does not leave it a page too big.
+    uint32_t region_start = header->page_count;
+    uint32_t run_at = unused;
+    int from_free = region_pages > 0 && region_pages <= unused &&
+                    index_region_pages(header->index_count, free_total - region_pages) == region_pages;
+    for (uint32_t i = 0, run = 0; from_free && i < unused; i++) {
+        run = i > 0 && unused_pages[i] == unused_pages[i - 1] + 1 ? run + 1 : 1;
+        if (run == region_pages) {
+            run_at = i + 1 - run;
+            region_start = unused_pages[run_at];
+            break;
+        }
+    }
+    if (run_at == unused) {
+        header->page_count += region_pages;
+    }
+
+    // The new free list: unused free pages outside the region, replaced
+    // leaves and the old index region
+    uint32_t free_count = 0;
+    uint32_t needed = free_total;
+    uint32_t* free_pages = malloc((needed > 0 ? needed : 1) * sizeof(uint32_t));
+    if (!free_pages) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < unused; i++) {
+        if (run_at == unused || i < run_at || i >= run_at + region_pages) {
+            free_pages[free_count++] = unused_pages[i];
+        }
+    }
+    for (uint32_t i = 0; i < store.freed_count; i++) {
+        free_pages[free_count++] = store.freed[i];
+    }
+    for (uint32_t i = 0; i < old_pages; i++) {
+        free_pages[free_count++] = old_start + i;
+    }
+    qsort(free_pages, free_count, sizeof(uint32_t), compare_pages);
+
+    header->index_offset = (uint64_t)region_start * LEADERBOARD_PAGE_SIZE;
+    header->free_count = free_count;
+    int ok = seek_to(header->index_offset) &&
+             fwrite(store.index, sizeof(LeaderboardIndexEntry), header->index_count, store.file) == header->index_count &&
+             fwrite(free_pages, sizeof(uint32_t), free_count, store.file) == free_count &&
+             sync_file() &&
+             seek_to(0) &&
+             fwrite(header, sizeof(*header), 1, store.file) == 1 &&
+             sync_file();
+
+    free(store.free_pages);
+    store.free_pages = free_pages;
+    store.free_capacity = needed > 0 ? needed : 1;
+    store.index_pages = region_pages;
+    store.free_next = 0;
+    store.freed_count = 0;
+    return ok;
+}
+
+// Reads the header, index and free list from disk, replacing what is in
+// memory. Used on open and to drop a batch that failed part way.
+static int load_index(void) {
+    LeaderboardFileHeader* header = &store.header;
+    int valid = seek_to(0) &&
+                fread(header, sizeof(*header), 1, store.file) == 1 &&
+                header->magic == LEADERBOARD_MAGIC &&
+                (header->version == LEADERBOARD_VERSION || header->version == 1) &&
+                header->page_size == LEADERBOARD_PAGE_SIZE &&
+                header->record_size == sizeof(LeaderboardRecord) &&
+                header->page_count >= 1 &&
+                header->index_offset % LEADERBOARD_PAGE_SIZE == 0 &&
+                header->index_offset >= LEADERBOARD_PAGE_SIZE;
+    if (valid && header->version == 1) {
+        // Version 1 kept the index just past the last leaf, outside
+        // page_count, and had no free list
+        valid = header->free_count == 0 && header->index_offset == (uint64_t)header->page_count * LEADERBOARD_PAGE_SIZE;
+        header->page_count += index_region_pages(header->index_count, 0);
+        header->version = LEADERBOARD_VERSION;
+    }
+    uint64_t region_start = header->index_offset / LEADERBOARD_PAGE_SIZE;
+    valid = valid && header->index_count < header->page_count && header->free_count < header->page_count &&
+            region_start + index_region_pages(header->index_count, header->free_count) <= header->page_count;
+    if (!valid ||
+        !grow_array((void**)&store.index, &store.index_capacity, header->index_count, sizeof(LeaderboardIndexEntry)) ||
+        !grow_array((void**)&store.free_pages, &store.free_capacity, header->free_count, sizeof(uint32_t))) {
+        return 0;
+    }
+    if (!seek_to(header->index_offset) ||
+        fread(store.index, sizeof(LeaderboardIndexEntry), header->index_count, store.file) != header->index_count ||
+        fread(store.free_pages, sizeof(uint32_t), header->free_count, store.file) != header->free_count) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < header->index_count; i++) {
+        if (store.index[i].page == 0 || store.index[i].page >= header->page_count) {
+            return 0;
+        }
+    }
+    for (uint32_t i = 0; i < header->free_count; i++) {
+        if (store.free_pages[i] == 0 || store.free_pages[i] >= header->page_count) {
+            return 0;
+        }
+    }
+    store.index_pages = index_region_pages(header->index_count, header->free_count);
+    store.free_next = 0;
+    store.freed_count = 0;
+    return 1;
+}
+
+// ============= BATCH WRITES =============
+
+// Inserts a batch in key order, keeping one leaf page loaded at a time.
+// Called with file_mutex held.
+static int apply_batch(LeaderboardRecord* batch, uint32_t count, uint32_t next_sequence) {
+    static LeaderboardPage page;
+    static LeaderboardPage right;
+    qsort(batch, count, sizeof(LeaderboardRecord), compare_records);
+    memset(store.fresh, 0, store.fresh_capacity);
+    store.free_next = 0;
+    store.freed_count = 0;
+
+    uint32_t leaf = UINT32_MAX;     // Index position of the loaded leaf
+    for (uint32_t i = 0; i < count; i++) {
+        const LeaderboardRecord* record = &batch[i];
+        LeaderboardKey key = record_key(record);
+        if (store.header.index_count == 0) {
+            uint32_t first_page;
+            if (!allocate_page(&first_page) || !index_insert(0, record, first_page)) {
+                return 0;
+            }
+            page.count = 0;
+            leaf = 0;
+        }
+
+        uint32_t target = find_leaf(key);
+        if (target != leaf) {
+            if (leaf != UINT32_MAX && !write_leaf(leaf, &page)) {
+                return 0;
+            }
+            if (!read_page(store.index[target].page, &page)) {
+                return 0;
+            }
+            leaf = target;
+        }
+
+        uint32_t position = find_position(&page, key);
+        if (page.count == LEADERBOARD_PAGE_RECORDS) {
+            // Appending past the last leaf starts a new one, so records that
+            // arrive in key order fill whole pages; anything else splits evenly
+            uint32_t keep = leaf + 1 == store.header.index_count && position == page.count ? page.count : page.count / 2;
+            right.count = page.count - keep;
+            memcpy(right.records, &page.records[keep], right.count * sizeof(LeaderboardRecord));
+            page.count = keep;
+
+            uint32_t right_page;
+            const LeaderboardRecord* right_first = right.count > 0 ? &right.records[0] : record;
+            if (!allocate_page(&right_page) || !index_insert(leaf + 1, right_first, right_page)) {
+                return 0;
+            }
+            if (position >= keep) {
+                if (!write_leaf(leaf, &page)) {
+                    return 0;
+                }
+                page = right;
+                position -= keep;
+                leaf++;
+            } else if (!write_page(right_page, &right)) {
+                return 0;
+            }
+        }
+
+        memmove(&page.records[position + 1], &page.records[position],
+                (page.count - position) * sizeof(LeaderboardRecord));
+        page.records[position] = *record;
+        page.count++;
+        if (position == 0) {
+            store.index[leaf] = (LeaderboardIndexEntry){record->board, record->score, record->sequence,
+                                                        store.index[leaf].page};
+        }
+        store.header.record_count++;
+    }
+
+    if (leaf != UINT32_MAX && !write_leaf(leaf, &page)) {
+        return 0;
+    }
+    store.header.next_sequence = next_sequence;
+    return commit_batch();
+}
+
+// Takes the pending batch and writes it. Called with mutex held; releases it
+// while writing so submits never wait on the disk.
+static void write_pending_locked(void) {
+    static LeaderboardRecord batch[LEADERBOARD_BATCH_CAPACITY];
+    while (store.writing) {
+        pthread_cond_wait(&store.idle, &store.mutex);
+    }
+    uint32_t count = store.pending_count;
+    uint32_t next_sequence = store.next_sequence;
+    memcpy(batch, store.pending, count * sizeof(LeaderboardRecord));
+    store.pending_count = 0;
+    store.writing = 1;
+    pthread_cond_broadcast(&store.idle);
+    pthread_mutex_unlock(&store.mutex);
+
+    pthread_mutex_lock(&store.file_mutex);
+    if (store.broken || !apply_batch(batch, count, next_sequence)) {
+        // The header on disk is still the last good one: go back to it
+        store.failed_batches++;
+        fprintf(stderr, "leaderboard: could not write %u records; they were dropped\n", count);
+        if (!store.broken && !load_index()) {
+            fprintf(stderr, "leaderboard: could not reread the store; no more records will be written\n");
+            store.header.index_count = 0;
+            store.broken = 1;
+        }
+    }
+    pthread_mutex_unlock(&store.file_mutex);
+
+    pthread_mutex_lock(&store.mutex);
+    store.writing = 0;
+    pthread_cond_broadcast(&store.idle);
+}
+
+static void* leaderboard_writer_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&store.mutex);
+    for (;;) {
+        while (store.running && store.pending_count == 0) {
+            pthread_cond_wait(&store.wake, &store.mutex);
+        }
+        if (store.pending_count > 0) {
+            write_pending_locked();
+        } else {
+            break;                  // Closing with nothing left to write
+        }
+    }
+    pthread_mutex_unlock(&store.mutex);
+    return NULL;
+}
+
+// ============= OPEN / CLOSE =============
+
+static int load_store(const char* path) {
+    store.file = fopen(path, "r+b");
+    if (!store.file) {
+        store.file = fopen(path, "w+b");
+        if (!store.file) {
+            return 0;
+        }
+    }
+
+    if (fseeko(store.file, 0, SEEK_END) != 0) {
+        return 0;
+    }
+    if (ftello(store.file) == 0) {
+        // New (empty) file
+        LeaderboardFileHeader* header = &store.header;
+        memset(header, 0, sizeof(*header));
+        header->magic = LEADERBOARD_MAGIC;
+        header->version = LEADERBOARD_VERSION;
+        header->page_size = LEADERBOARD_PAGE_SIZE;
+        header->record_size = sizeof(LeaderboardRecord);
+        header->page_count = 1;
+        header->index_offset = LEADERBOARD_PAGE_SIZE;
+        return seek_to(0) && fwrite(header, sizeof(*header), 1, store.file) == 1 && sync_file();
+    }
+    return load_index();
+}
+
+int leaderboard_open(const char* path) {
+    if (store.open) {
+        return 0;
+    }
+    memset(&store, 0, sizeof(store));
+    if (!load_store(path)) {
+        if (store.file) {
+            fclose(store.file);
+        }
+        free(store.index);
+        free(store.free_pages);
+        memset(&store, 0, sizeof(store));
+        return 0;
+    }
+
+    pthread_mutex_init(&store.file_mutex, NULL);
+    pthread_mutex_init(&store.mutex, NULL);
+    pthread_cond_init(&store.wake, NULL);
+    pthread_cond_init(&store.idle, NULL);
+    store.next_sequence = store.header.next_sequence;
+    store.running = 1;
+    // No writer thread: submits write their record before returning
+    store.threaded = pthread_create(&store.writer, NULL, leaderboard_writer_main, NULL) == 0;
+    store.open = 1;
+    return 1;
+}
+
+void leaderboard_close(void) {
+    if (!store.open) {
+        return;
+    }
+    pthread_mutex_lock(&store.mutex);
+    store.running = 0;
+    pthread_cond_signal(&store.wake);
+    pthread_mutex_unlock(&store.mutex);
+    if (store.threaded) {
+        pthread_join(store.writer, NULL);
+    }
+
+    fclose(store.file);
+    free(store.index);
+    free(store.free_pages);
+    free(store.freed);
+    free(store.fresh);
+    pthread_mutex_destroy(&store.file_mutex);
+    pthread_mutex_destroy(&store.mutex);
+    pthread_cond_destroy(&store.wake);
+    pthread_cond_destroy(&store.idle);
+    memset(&store, 0, sizeof(store));
+}
+
+// ============= SUBMIT / QUERY =============
+
+void leaderboard_submit(LeaderboardRecord record) {
+    if (!store.open) {
+        return;
+    }
+    record.score = leaderboard_score((LeaderboardMetric)(record.board & 0xFFu), record.value);
+    if (record.recorded_at == 0) {
+        record.recorded_at = (int64_t)time(NULL);
+    }
+
+    pthread_mutex_lock(&store.mutex);
+    while (store.pending_count == LEADERBOARD_BATCH_CAPACITY) {
+        pthread_cond_wait(&store.idle, &store.mutex);
+    }
+    record.sequence = store.next_sequence++;
+    store.pending[store.pending_count++] = record;
+    if (store.threaded) {
+        pthread_cond_signal(&store.wake);
+    } else {
+        write_pending_locked();
+    }
+    pthread_mutex_unlock(&store.mutex);
+}
+
+void leaderboard_submit_result(uint32_t profile, const LeaderboardResult* result) {
+    LeaderboardRecord record = {0};
+    record.board = leaderboard_board(profile, (LeaderboardMode)result->mode, (LeaderboardMetric)result->metric);
+    record.value = result->value;
+    record.level = result->level;
+    record.word_length = result->word_length;
+    record.day = result->day;
+    leaderboard_submit(record);
+}
+
+int leaderboard_flush(void) {
+    if (!store.open) {
+        return 0;
+    }
+    pthread_mutex_lock(&store.mutex);
+    while (store.pending_count > 0 || store.writing) {
+        pthread_cond_wait(&store.idle, &store.mutex);
+    }
+    pthread_mutex_unlock(&store.mutex);
+    pthread_mutex_lock(&store.file_mutex);
+    int ok = store.failed_batches == 0;
+    pthread_mutex_unlock(&store.file_mutex);
+    return ok;
+}
+
+int leaderboard_top(uint32_t board, LeaderboardRecord* out_records, int max_records) {
+    if (!store.open) {
+        return 0;
+    }
+    LeaderboardPage page;
+    LeaderboardKey first = {board, 0, 0};
+    int found = 0;
+
+    pthread_mutex_lock(&store.file_mutex);
+    uint32_t leaf = find_leaf(first);
+    for (; found < max_records && leaf < store.header.index_count; leaf++) {
+        if (store.index[leaf].board > board || !read_page(store.index[leaf].page, &page)) {
+            break;
+        }
+        uint32_t i = find_position(&page, first);
+        for (; i < page.count && found < max_records && page.records[i].board == board; i++) {
+            out_records[found++] = page.records[i];
+        }
+        if (i < page.count) {
+            break;                  // Reached the next board, or max_records
+        }
+    }
+    pthread_mutex_unlock(&store.file_mutex);
+    return found;
+}
+
+uint64_t leaderboard_record_count(void) {
+    if (!store.open) {
+        return 0;
+    }
+    pthread_mutex_lock(&store.file_mutex);
+    uint64_t count = store.header.record_count;
+    pthread_mutex_unlock(&store.file_mutex);
+    return count;
+}
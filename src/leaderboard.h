@@ -0,0 +1,96 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "types.h"
+
+// Local leaderboard store (.cwlb)
+//
+// Layout (little-endian, LEADERBOARD_PAGE_SIZE pages):
+//   page 0      LeaderboardFileHeader
+//   pages 1..   leaf pages: LeaderboardPageHeader + sorted LeaderboardRecords,
+//               free pages, and the index region:
+//   index       LeaderboardIndexEntry[index_count] then uint32_t
+//               free_pages[free_count] (ascending), from index_offset, which
+//               is page-aligned
+//
+// Records are ordered by (board, score, sequence) across the leaves, and the
+// index holds the first key of every leaf in the same order: a two-level
+// B+-tree whose root is the index. Opening reads the header and the index
+// (one entry per leaf), never the records, so an insert or a top-k query
+// costs a binary search of the index plus the leaf pages it touches.
+//
+// Writes are copy-on-write: a batch puts changed leaves and the new index on
+// pages the current header does not use, syncs them, then rewrites the
+// header. Replaced pages join the free list for later batches.
+
+#define LEADERBOARD_MAGIC 0x424C5743u         // "CWLB"
+#define LEADERBOARD_VERSION 2u               // Version 1 files (no free list) still open
+#define LEADERBOARD_PAGE_SIZE 4096
+#define LEADERBOARD_PAGE_RECORDS 127          // (4096 - 8) / 32
+#define LEADERBOARD_BATCH_CAPACITY 1024       // Pending records before submit waits
+#define LEADERBOARD_DEFAULT_PROFILE 0
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t page_size;
+    uint32_t record_size;
+    uint32_t page_count;                      // Every page in the file: header, leaves, free and index
+    uint32_t index_count;                     // One entry per leaf page
+    uint64_t index_offset;
+    uint64_t record_count;
+    uint32_t next_sequence;
+    uint32_t free_count;                      // Pages no leaf or index uses (0 in version 1)
+} LeaderboardFileHeader;
+
+typedef struct {
+    uint32_t board;                           // leaderboard_board()
+    uint32_t score;                           // Lower ranks first (see leaderboard_score)
+    uint32_t sequence;                        // Insertion order: ties rank oldest first
+    uint32_t value;                           // Guesses, milliseconds or levels, as reported
+    int64_t recorded_at;                      // Unix seconds
+    uint16_t level;
+    uint8_t word_length;
+    uint8_t reserved;
+    int32_t day;                              // Days since 1970-01-01, 0 if unknown
+} LeaderboardRecord;
+
+typedef struct {
+    uint32_t count;
+    uint32_t reserved;
+    LeaderboardRecord records[LEADERBOARD_PAGE_RECORDS];
+} LeaderboardPage;
+
+typedef struct {
+    uint32_t board;                           // First key of the leaf
+    uint32_t score;
+    uint32_t sequence;
+    uint32_t page;
+} LeaderboardIndexEntry;
+
+uint32_t leaderboard_board(uint32_t profile, LeaderboardMode mode, LeaderboardMetric metric);
+uint32_t leaderboard_score(LeaderboardMetric metric, uint32_t value);
+
+// Opens or creates the store and starts its writer thread. Returns 1 on
+// success; with no store open, submits are ignored and queries find nothing.
+int leaderboard_open(const char* path);
+// Writes everything still pending, then closes the file
+void leaderboard_close(void);
+
+// Queues a record for the writer thread, which applies pending records as one
+// sorted batch. board and value must be set; score and sequence are assigned
+// here, and recorded_at if it is 0. Only waits if LEADERBOARD_BATCH_CAPACITY
+// records are already pending.
+void leaderboard_submit(LeaderboardRecord record);
+void leaderboard_submit_result(uint32_t profile, const LeaderboardResult* result);
+// Waits until every submitted record is written. Returns 0 if any batch since
+// the store was opened failed to write (its records are dropped and reported
+// on stderr; the store keeps its last good state).
+int leaderboard_flush(void);
+
+// Best `max_records` records of a board, best first. Records still pending
+// are not seen. Returns the number written.
+int leaderboard_top(uint32_t board, LeaderboardRecord* out_records, int max_records);
+uint64_t leaderboard_record_count(void);
+
+#endif
@@ -0,0 +1,160 @@
+#include "log.h"
+
+#if GAME_LOG_ENABLED
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// Single-producer (game thread) / single-consumer (flusher thread) ring
+typedef struct {
+    GameLogRecord records[GAME_LOG_RING_SIZE];
+    _Atomic uint32_t write_index;
+    _Atomic uint32_t read_index;
+    _Atomic uint32_t dropped;
+    _Atomic int running;
+    GameLogLevel min_level;
+    double start_time;
+    pthread_t flusher;
+    int initialized;
+} GameLogRing;
+
+static GameLogRing log_ring;
+
+static const char* LOG_LEVEL_NAMES[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+static double log_clock_seconds(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Formatting happens here, on the flusher thread only
+static void log_format_record(FILE* out, const GameLogRecord* record) {
+    fprintf(out, "[%9.3f] %-5s ", record->timestamp, LOG_LEVEL_NAMES[record->level]);
+
+    switch (record->event) {
+        case LOG_EVENT_CROSSWORD_WORD_CORRECT:
+            fprintf(out, "crossword word %d '%s' is correct\n", record->args[0] + 1, record->text);
+            break;
+        case LOG_EVENT_CROSSWORD_WORD_INCORRECT:
+            fprintf(out, "crossword word %d '%s' is incorrect (%d/%d letters in place)\n",
+                    record->args[0] + 1, record->text, record->args[1], (int)strlen(record->text));
+            break;
+        case LOG_EVENT_CROSSWORD_COMPLETED:
+            fprintf(out, "crossword level %d completed\n", record->args[0]);
+            break;
+        case LOG_EVENT_WORD_REPEAT_WINDOW_CUT:
+            fprintf(out, "word repeat window %d cut to %d\n", record->args[0], record->args[1]);
+            break;
+        default:
+            fprintf(out, "event %u (%d, %d)\n", record->event, record->args[0], record->args[1]);
+            break;
+    }
+}
+
+static void log_drain(void) {
+    uint32_t read = atomic_load_explicit(&log_ring.read_index, memory_order_relaxed);
+    uint32_t write = atomic_load_explicit(&log_ring.write_index, memory_order_acquire);
+
+    if (read == write) {
+        return;
+    }
+
+    while (read != write) {
+        log_format_record(stdout, &log_ring.records[read & (GAME_LOG_RING_SIZE - 1)]);
+        read++;
+    }
+    atomic_store_explicit(&log_ring.read_index, read, memory_order_release);
+
+    uint32_t dropped = atomic_exchange_explicit(&log_ring.dropped, 0, memory_order_relaxed);
+    if (dropped > 0) {
+        fprintf(stdout, "[log] %u records dropped (ring full)\n", dropped);
+    }
+    fflush(stdout);
+}
+
+static void* log_flusher_main(void* arg) {
+    (void)arg;
+    struct timespec interval = {0, GAME_LOG_FLUSH_INTERVAL_MS * 1000000L};
+
+    while (atomic_load_explicit(&log_ring.running, memory_order_acquire)) {
+        log_drain();
+        nanosleep(&interval, NULL);
+    }
+    return NULL;
+}
+
+void game_log_init(GameLogLevel min_level) {
+    if (log_ring.initialized) {
+        return;
+    }
+
+    log_ring.min_level = min_level;
+    log_ring.start_time = log_clock_seconds();
+    atomic_store(&log_ring.write_index, 0);
+    atomic_store(&log_ring.read_index, 0);
+    atomic_store(&log_ring.dropped, 0);
+    atomic_store(&log_ring.running, 1);
+
+    if (pthread_create(&log_ring.flusher, NULL, log_flusher_main, NULL) != 0) {
+        // No flusher thread: records are still accepted and drained at shutdown
+        atomic_store(&log_ring.running, 0);
+        log_ring.initialized = 2;
+        return;
+    }
+    log_ring.initialized = 1;
+}
+
+void game_log_shutdown(void) {
+    if (!log_ring.initialized) {
+        return;
+    }
+
+    if (log_ring.initialized == 1) {
+        atomic_store_explicit(&log_ring.running, 0, memory_order_release);
+        pthread_join(log_ring.flusher, NULL);
+    }
+    log_drain();
+    log_ring.initialized = 0;
+}
+
+void game_log_write(GameLogLevel level, GameLogEvent event, int32_t arg0, int32_t arg1, const char* text) {
+    if (!log_ring.initialized || level < log_ring.min_level) {
+        return;
+    }
+
+    uint32_t write = atomic_load_explicit(&log_ring.write_index, memory_order_relaxed);
+    uint32_t read = atomic_load_explicit(&log_ring.read_index, memory_order_acquire);
+
+    if (write - read >= GAME_LOG_RING_SIZE) {
+        // Never block the game thread: count the loss and move on
+        atomic_fetch_add_explicit(&log_ring.dropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    GameLogRecord* record = &log_ring.records[write & (GAME_LOG_RING_SIZE - 1)];
+    record->timestamp = log_clock_seconds() - log_ring.start_time;
+    record->event = (uint16_t)event;
+    record->level = (uint8_t)level;
+    record->args[0] = arg0;
+    record->args[1] = arg1;
+
+    int i = 0;
+    if (text) {
+        for (; i < GAME_LOG_TEXT_SIZE - 1 && text[i] != '\0'; i++) {
+            record->text[i] = text[i];
+        }
+    }
+    record->text[i] = '\0';
+
+    atomic_store_explicit(&log_ring.write_index, write + 1, memory_order_release);
+}
+
+uint32_t game_log_dropped_count(void) {
+    return atomic_load_explicit(&log_ring.dropped, memory_order_relaxed);
+}
+
+#endif
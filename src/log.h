@@ -0,0 +1,70 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+
+// Structured, ring-buffered game log.
+//
+// Call sites record an event id plus a couple of integer arguments and a short
+// word payload; nothing is formatted on the game thread. A background flusher
+// thread drains the ring and turns records into text. In release builds
+// (NDEBUG) every GAME_LOG_* macro compiles to nothing.
+
+#if !defined(NDEBUG) && !defined(GAME_LOG_DISABLED)
+#define GAME_LOG_ENABLED 1
+#else
+#define GAME_LOG_ENABLED 0
+#endif
+
+#define GAME_LOG_RING_SIZE 256               // Must be a power of two
+#define GAME_LOG_TEXT_SIZE 8                 // Short payload (fits a word)
+#define GAME_LOG_FLUSH_INTERVAL_MS 50        // Flusher thread wake-up period
+
+// Prefixed to avoid clashing with raylib's TraceLogLevel (LOG_INFO, ...)
+typedef enum {
+    GAME_LOG_LEVEL_DEBUG = 0,
+    GAME_LOG_LEVEL_INFO = 1,
+    GAME_LOG_LEVEL_WARN = 2,
+    GAME_LOG_LEVEL_ERROR = 3
+} GameLogLevel;
+
+typedef enum {
+    LOG_EVENT_CROSSWORD_WORD_CORRECT = 0,
+    LOG_EVENT_CROSSWORD_WORD_INCORRECT,
+    LOG_EVENT_CROSSWORD_COMPLETED,
+    LOG_EVENT_WORD_REPEAT_WINDOW_CUT,
+    LOG_EVENT_COUNT
+} GameLogEvent;
+
+typedef struct {
+    double timestamp;                        // Seconds since game_log_init
+    uint16_t event;                          // GameLogEvent
+    uint8_t level;                           // GameLogLevel
+    int32_t args[2];
+    char text[GAME_LOG_TEXT_SIZE];
+} GameLogRecord;
+
+#if GAME_LOG_ENABLED
+
+void game_log_init(GameLogLevel min_level);
+void game_log_shutdown(void);
+void game_log_write(GameLogLevel level, GameLogEvent event, int32_t arg0, int32_t arg1, const char* text);
+uint32_t game_log_dropped_count(void);
+
+#define GAME_LOG(level, event, arg0, arg1, text) game_log_write((level), (event), (arg0), (arg1), (text))
+
+#else
+
+#define game_log_init(min_level) ((void)0)
+#define game_log_shutdown() ((void)0)
+#define game_log_dropped_count() 0u
+#define GAME_LOG(level, event, arg0, arg1, text) ((void)0)
+
+#endif
+
+#define GAME_LOG_DEBUG(event, arg0, arg1, text) GAME_LOG(GAME_LOG_LEVEL_DEBUG, event, arg0, arg1, text)
+#define GAME_LOG_INFO(event, arg0, arg1, text) GAME_LOG(GAME_LOG_LEVEL_INFO, event, arg0, arg1, text)
+#define GAME_LOG_WARN(event, arg0, arg1, text) GAME_LOG(GAME_LOG_LEVEL_WARN, event, arg0, arg1, text)
+#define GAME_LOG_ERROR(event, arg0, arg1, text) GAME_LOG(GAME_LOG_LEVEL_ERROR, event, arg0, arg1, text)
+
+#endif
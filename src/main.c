@@ -1,45 +1,303 @@
+#include <pthread.h>
+#include "raylib.h"
 #include "systems.h"
+#include "crosswordle.h"
+#include "speed_mode.h"
+#include "leaderboard.h"
+#include "stats_history.h"
+#include "profile.h"
+#include "render_snapshot.h"
+#include "jobs.h"
 
-int main(void) {
+// Translates this frame's raylib input into the core library's GameInput
+static GameInput read_input(void) {
+    GameInput input = {0};
+    // raylib queues keys without timestamps, so every key drained below shares
+    // this reading; a stalled frame delays the time its keys are stamped with
+    input.time = crosswordle_clock();
+    
+    // Drain the whole key queue; the game applies every key in order
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+        crosswordle_input_press(&input, key);
+    }
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) input.buttons |= GAME_BUTTON_CLICK;
+    Vector2 mouse = GetMousePosition();
+    input.mouse_x = (int)mouse.x;
+    input.mouse_y = (int)mouse.y;
+    input.wheel_move = GetMouseWheelMove();
+    input.frame_time = GetFrameTime();
+    input.screen_width = GetScreenWidth();
+    input.screen_height = GetScreenHeight();
+    
+    // Today's local date picks the daily challenge
+    time_t now = time(NULL);
+    struct tm* local = localtime(&now);
+    input.day = local ? daily_day_number(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday) : 0;
+    return input;
+}
+
+// Each profile keeps its own statistics log, whose header holds its aggregates
+static void open_profile_history(GameState* state) {
+    if (profile_store_count() == 0) {
+        return;
+    }
+    char path[300];
+    profile_store_path(state->system.profile_index, ".cwst", path, sizeof(path));
+    StatsAggregates saved;
+    uint32_t version = state->stats.history.version + 1;
+    if (stats_log_open(path, &saved)) {
+        state->stats.history = saved;
+        state->stats.history.version = version;
+    } else {
+        fprintf(stderr, "stats history %s unavailable; levels will not be logged\n", path);
+    }
+}
+
+// Closes what main opened, in reverse: the stores, the job system, the window
+// and the loaded data
+static void close_services(void) {
+    leaderboard_close();
+    stats_log_close();
+    profile_store_close();
+    jobs_shutdown();
+    jobs_drain_main();
+    
+    render_shutdown();
+    CloseWindow();
+    unload_clue_database();
+    unload_puzzle_pack();
+    unload_word_categories();
+    unload_daily_calendar();
+    unload_word_databases();
+    game_log_shutdown();
+}
+
+// ============= UPDATE THREAD =============
+//
+// The window thread only reads input and draws: raylib needs both on the
+// thread that owns the window. Ticks and the file I/O that follows them run on
+// the update thread, which publishes a render snapshot after every tick. A slow
+// frame no longer holds up a tick, and a tick stuck on disk (switching to a
+// profile that is not cached, appending to a log) no longer holds up a frame.
+
+#define UPDATE_INPUT_QUEUE_SIZE 8       // Frames of input waiting to be ticked
+#define UPDATE_WAIT_SECONDS 0.002       // How long a frame waits for its own tick
+#define JOBS_SAMPLE_SECONDS 0.5         // Job worker utilization window on the profiler
+
+static struct {
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t wake;                // Update thread: input queued or closing
+    pthread_cond_t space;               // Window thread: a queue slot freed
+    GameInput queue[UPDATE_INPUT_QUEUE_SIZE];
+    uint64_t queued;                    // Inputs pushed so far
+    uint64_t taken;                     // ... and taken by the update thread
+    int closing;
+    GameState state;                    // Owned by the update thread until it is joined
+    RenderSnapshotBuffer snapshots;
+} update;
+
+// The front end's side of a tick: file what the systems left in SystemState
+static void apply_tick_results(GameState* state) {
+    for (int i = 0; i < state->system.leaderboard_result_count; i++) {
+        leaderboard_submit_result((uint32_t)state->system.profile_index, &state->system.leaderboard_results[i]);
+    }
+    if (state->system.level_record_ready) {
+        stats_log_append(&state->system.level_record, &state->stats.history);
+    }
+    if (profile_apply_requests(state)) {
+        open_profile_history(state);
+    }
+}
+
+static void* update_thread_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&update.mutex);
+    for (;;) {
+        while (update.taken == update.queued && !update.closing) {
+            pthread_cond_wait(&update.wake, &update.mutex);
+        }
+        if (update.taken == update.queued) {
+            break;
+        }
+        GameInput input = update.queue[update.taken % UPDATE_INPUT_QUEUE_SIZE];
+        update.taken++;
+        pthread_cond_signal(&update.space);
+        pthread_mutex_unlock(&update.mutex);
+        
+        update.state = game_tick(update.state, &input);
+        apply_tick_results(&update.state);
+        render_snapshot_publish(&update.snapshots, &update.state);
+        
+        pthread_mutex_lock(&update.mutex);
+    }
+    pthread_mutex_unlock(&update.mutex);
+    return NULL;
+}
+
+static int update_thread_start(const GameState* state) {
+    update.state = *state;
+    render_snapshot_init(&update.snapshots, state);
+    update.queued = update.taken = 0;
+    update.closing = 0;
+    pthread_mutex_init(&update.mutex, NULL);
+    pthread_cond_init(&update.wake, NULL);
+    pthread_cond_init(&update.space, NULL);
+    return pthread_create(&update.thread, NULL, update_thread_main, NULL) == 0;
+}
+
+// Queues one frame of input; returns the snapshot sequence its tick will publish
+static uint64_t update_thread_push(const GameInput* input) {
+    pthread_mutex_lock(&update.mutex);
+    while (update.queued - update.taken == UPDATE_INPUT_QUEUE_SIZE) {
+        pthread_cond_wait(&update.space, &update.mutex);
+    }
+    update.queue[update.queued % UPDATE_INPUT_QUEUE_SIZE] = *input;
+    uint64_t sequence = ++update.queued;
+    pthread_cond_signal(&update.wake);
+    pthread_mutex_unlock(&update.mutex);
+    return sequence;
+}
+
+// Ticks whatever is still queued, then stops; update.state is final after this
+static void update_thread_stop(void) {
+    pthread_mutex_lock(&update.mutex);
+    update.closing = 1;
+    pthread_cond_signal(&update.wake);
+    pthread_mutex_unlock(&update.mutex);
+    pthread_join(update.thread, NULL);
+    pthread_cond_destroy(&update.space);
+    pthread_cond_destroy(&update.wake);
+    pthread_mutex_destroy(&update.mutex);
+}
+
+int main(int argc, char** argv) {
+    const char* latency_stats_path = NULL;
+    const char* speed_results_path = NULL;
+    const char* leaderboard_path = "leaderboard.cwlb";
+    const char* profiles_directory = "profiles";
+    const char* profile_name = NULL;
+    int immediate_render = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--latency-stats") == 0 && i + 1 < argc) {
+            latency_stats_path = argv[++i];
+        } else if (strcmp(argv[i], "--speed-results") == 0 && i + 1 < argc) {
+            speed_results_path = argv[++i];
+        } else if (strcmp(argv[i], "--leaderboard") == 0 && i + 1 < argc) {
+            leaderboard_path = argv[++i];
+        } else if (strcmp(argv[i], "--profiles") == 0 && i + 1 < argc) {
+            profiles_directory = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_name = argv[++i];
+        } else if (strcmp(argv[i], "--immediate-render") == 0) {
+            immediate_render = 1;
+        } else {
+            fprintf(stderr, "usage: crosswordle [--latency-stats PATH] [--speed-results BASE] [--leaderboard PATH]\n"
+                            "                   [--profiles DIR] [--profile NAME] [--immediate-render]\n");
+            return 2;
+        }
+    }
+    
     InitWindow(DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT, "Wordle");
-    SetTargetFPS(60);
+    // The 60 FPS limiter sleeps between presenting a frame and polling input,
+    // so a key pressed during the sleep waits for it. Immediate render drops
+    // the sleep: every key is ticked, drawn and presented in the next loop.
+    SetTargetFPS(immediate_render ? 0 : 60);
     SetWindowState(FLAG_WINDOW_RESIZABLE);
     SetWindowMinSize(400, 300);
+    game_log_init(GAME_LOG_LEVEL_INFO);
+    jobs_init(0);
+    
+    // Optional packed word lists override the built-in ones
+    load_word_databases("data");
+    load_word_categories("data/categories");
+    load_daily_calendar("data/daily.cwcal");
+    load_clue_database("data/clues.cwcl");
+    load_puzzle_pack("data/puzzles.cwpk");
+    load_input_bindings("data/bindings.txt");
+    if (!leaderboard_open(leaderboard_path)) {
+        fprintf(stderr, "leaderboard %s unavailable; results will not be kept\n", leaderboard_path);
+    }
     
     GameState state = create_game_state("");
+    if (profile_store_open(profiles_directory)) {
+        int index = profile_name ? profile_store_find(profile_name) : 0;
+        if (index < 0) {
+            index = profile_store_create(profile_name);
+        }
+        profile_load(&state, index >= 0 ? index : 0);
+    } else {
+        fprintf(stderr, "profiles %s unavailable; progress will not be kept\n", profiles_directory);
+    }
+    open_profile_history(&state);
+    static LatencyHistograms latency;
+    if (!update_thread_start(&state)) {
+        fprintf(stderr, "could not start the update thread\n");
+        close_services();
+        return 1;
+    }
+    uint64_t presented = 0;
+    JobsUtilization workers = {0};
+    double workers_sampled = 0.0;
     
     while (!WindowShouldClose()) {
-        state = input_system(state);
-        state = view_switching_system(state);
+        // Finished background work reports back on this thread
+        jobs_drain_main();
+        GameInput input = read_input();
+        uint64_t sequence = update_thread_push(&input);
+        // The tick normally lands within microseconds and this frame shows it;
+        // if it is held up, the frame goes out with the newest snapshot instead
+        render_snapshot_wait(&update.snapshots, sequence, UPDATE_WAIT_SECONDS);
+        const RenderSnapshot* snapshot = render_snapshot_acquire(&update.snapshots);
         
-        if (state.current_view == VIEW_HOME_SCREEN) {
-            state = home_screen_input_system(state);
-        } else if (state.current_view == VIEW_WORDLE) {
-            state = word_editing_system(state);
-            state = word_validation_system(state);
-            state = result_display_system(state);
-            state = level_progression_system(state);
-            
-            // Handle new level setup
-            if (state.core.play_state == GAME_STATE_INPUT_READY) {
-                strcpy(state.core.target_word, get_random_word());
-                state = new_level_system(state);
+        BeginDrawing();
+        render_system(snapshot->state);
+        if (snapshot->state.system.show_profiler) {
+            if (input.time - workers_sampled >= JOBS_SAMPLE_SECONDS) {
+                jobs_sample_utilization(&workers);
+                workers_sampled = input.time;
             }
-        } else if (state.current_view == VIEW_CROSSWORD) {
-            state = crossword_input_system(state);
-            state = crossword_word_validation_system(state);
-        } else if (state.current_view == VIEW_CROSSWORD_COMPLETE) {
-            state = crossword_completion_input_system(state);
+            profiler_overlay_render(&latency, &workers);
         }
-        
-        // Update animations for all views
-        state = animation_update_system(state);
-        
-        BeginDrawing();
-        render_system(state);
         EndDrawing();
+        
+        // The frame showing this snapshot's actions is out: close their latency
+        // marks, once per snapshot however many frames show it
+        if (snapshot->sequence != presented) {
+            render_snapshot_close_marks(snapshot, presented, &latency, crosswordle_clock());
+            presented = snapshot->sequence;
+        }
     }
+    update_thread_stop();
+    state = update.state;
     
-    CloseWindow();
+    if (latency_stats_path && !latency_write_stats(&latency, latency_stats_path)) {
+        fprintf(stderr, "could not write latency stats to %s\n", latency_stats_path);
+    }
+    
+    // Speed run splits as BASE.cwspd (binary) and BASE.csv
+    if (speed_results_path && state.speed.split_count > 0) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s.cwspd", speed_results_path);
+        int ok = speed_mode_write_binary(&state, path);
+        snprintf(path, sizeof(path), "%s.csv", speed_results_path);
+        if (!ok || !speed_mode_write_csv(&state, path)) {
+            fprintf(stderr, "could not write speed results to %s.*\n", speed_results_path);
+        }
+    }
+    
+    // The session's streak goes on the board once, when it ends
+    if (state.stats.levels_completed > 0) {
+        LeaderboardResult streak = {0};
+        streak.mode = LEADERBOARD_MODE_WORDLE;
+        streak.metric = LEADERBOARD_LONGEST_STREAK;
+        streak.word_length = (uint8_t)state.core.word_length;
+        streak.level = (uint16_t)state.core.current_level;
+        streak.value = (uint32_t)state.stats.max_level_streak;
+        streak.day = state.system.today;
+        leaderboard_submit_result((uint32_t)state.system.profile_index, &streak);
+    }
+    profile_store_put(state.system.profile_index, &state);
+    close_services();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,24 @@
+#ifndef PLATFORM_TYPES_H
+#define PLATFORM_TYPES_H
+
+// Plain-data types the game state shares with raylib. The core library is built
+// without raylib, so it declares layout-identical copies here; front-end files
+// include raylib.h first and its definitions are used instead.
+
+#ifndef RAYLIB_H
+
+typedef struct Vector2 {
+    float x;
+    float y;
+} Vector2;
+
+typedef struct Color {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+} Color;
+
+#endif
+
+#endif
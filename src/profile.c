@@ -0,0 +1,321 @@
+#include "systems.h"
+#include "profile.h"
+#include "jobs.h"
+
+#ifdef _WIN32
+#include <direct.h>
+#define make_directory(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define make_directory(path) mkdir(path, 0755)
+#endif
+
+// Player profile store. Names are kept for every profile; data only for the
+// PROFILE_CACHE_SLOTS most recently used ones. A cache hit is a copy of a few
+// kilobytes between the slot and GameState, which is what makes switching on
+// the home screen instant.
+
+typedef struct {
+    int index;                  // Profile in this slot, -1 if empty
+    int dirty;                  // Changed since it was loaded or written
+    uint64_t last_used;
+    ProfileData data;
+} ProfileSlot;
+
+static struct {
+    int open;
+    char directory[256];
+    int count;
+    char names[PROFILE_MAX][PROFILE_NAME_SIZE];
+    ProfileSlot slots[PROFILE_CACHE_SLOTS];
+    uint64_t clock;             // Bumped per access, orders the slots for LRU
+    uint32_t disk_loads;
+    JobHandle writes[PROFILE_MAX];  // Background write-back of each evicted profile
+} profiles;
+
+// ============= FILES =============
+
+void profile_store_path(int index, const char* extension, char* out_path, int size) {
+    snprintf(out_path, (size_t)size, "%s/profile_%d%s", profiles.directory, index, extension);
+}
+
+static int write_names(void) {
+    char path[300];
+    snprintf(path, sizeof(path), "%s/profiles.txt", profiles.directory);
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return 0;
+    }
+    for (int i = 0; i < profiles.count; i++) {
+        fprintf(file, "%s\n", profiles.names[i]);
+    }
+    return fclose(file) == 0;
+}
+
+static int write_profile(const ProfileData* data, int index) {
+    char path[300];
+    profile_store_path(index, ".cwpf", path, sizeof(path));
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return 0;
+    }
+    int ok = fwrite(data, sizeof(*data), 1, file) == 1;
+    return fclose(file) == 0 && ok;
+}
+
+// An evicted profile is written by a job, so the switch that evicted it
+// does not wait for the disk
+typedef struct {
+    char path[300];
+    char name[PROFILE_NAME_SIZE];
+    ProfileData data;
+} ProfileWrite;
+
+typedef struct {
+    char name[PROFILE_NAME_SIZE];
+} ProfileWriteFailure;
+
+static void report_write_failure(void* data) {
+    const ProfileWriteFailure* failure = data;
+    fprintf(stderr, "could not save profile %s\n", failure->name);
+}
+
+static void write_profile_job(void* data) {
+    ProfileWrite* write = *(ProfileWrite**)data;
+    FILE* file = fopen(write->path, "wb");
+    int ok = file && fwrite(&write->data, sizeof(write->data), 1, file) == 1;
+    if (file && fclose(file) != 0) {
+        ok = 0;
+    }
+    if (!ok) {
+        ProfileWriteFailure failure;
+        strcpy(failure.name, write->name);
+        jobs_post_main(report_write_failure, &failure, sizeof(failure));
+    }
+    free(write);
+}
+
+static void write_profile_later(const ProfileData* data, int index) {
+    ProfileWrite* write = malloc(sizeof(*write));
+    if (!write) {
+        write_profile(data, index);
+        return;
+    }
+    profile_store_path(index, ".cwpf", write->path, sizeof(write->path));
+    strcpy(write->name, profiles.names[index]);
+    write->data = *data;
+    profiles.writes[index] = jobs_submit(write_profile_job, &write, sizeof(write));
+}
+
+// A profile that has never been saved starts from a new game's defaults
+static void fresh_profile(ProfileData* data, int index) {
+    GameState defaults = create_game_state("");
+    memset(data, 0, sizeof(*data));
+    data->word_length = defaults.core.word_length;
+    data->settings = defaults.settings;
+    data->stats = defaults.stats;
+    data->crossword = defaults.crossword;
+    strcpy(data->name, profiles.names[index]);
+}
+
+static void read_profile(ProfileData* data, int index) {
+    jobs_wait(profiles.writes[index]);    // Its last write-back must land first
+    char path[300];
+    profile_store_path(index, ".cwpf", path, sizeof(path));
+    FILE* file = fopen(path, "rb");
+    int ok = file && fread(data, sizeof(*data), 1, file) == 1 &&
+             data->magic == PROFILE_MAGIC && data->version == PROFILE_VERSION && data->size == sizeof(*data);
+    if (file) {
+        fclose(file);
+    }
+    if (!ok) {
+        fresh_profile(data, index);
+    }
+    data->magic = PROFILE_MAGIC;
+    data->version = PROFILE_VERSION;
+    data->size = sizeof(*data);
+    strcpy(data->name, profiles.names[index]);
+    profiles.disk_loads++;
+}
+
+// ============= STORE =============
+
+static int add_name(const char* name) {
+    if (profiles.count == PROFILE_MAX) {
+        return -1;
+    }
+    char* slot = profiles.names[profiles.count];
+    int length = 0;
+    for (; name[length] && name[length] != '\n' && name[length] != '\r' && length < PROFILE_NAME_SIZE - 1; length++) {
+        slot[length] = name[length];
+    }
+    slot[length] = '\0';
+    if (length == 0) {
+        return -1;
+    }
+    return profiles.count++;
+}
+
+int profile_store_open(const char* directory) {
+    profile_store_close();
+    snprintf(profiles.directory, sizeof(profiles.directory), "%s", directory);
+    for (int s = 0; s < PROFILE_CACHE_SLOTS; s++) {
+        profiles.slots[s].index = -1;
+    }
+    make_directory(directory);  // Fails harmlessly if it exists
+
+    char path[300];
+    snprintf(path, sizeof(path), "%s/profiles.txt", directory);
+    FILE* file = fopen(path, "r");
+    if (file) {
+        char line[128];
+        while (fgets(line, sizeof(line), file)) {
+            add_name(line);
+        }
+        fclose(file);
+    }
+    if (profiles.count == 0 && (add_name("Player 1") < 0 || !write_names())) {
+        profiles.count = 0;
+        return 0;
+    }
+    profiles.open = 1;
+    return profiles.count;
+}
+
+void profile_store_close(void) {
+    for (int i = 0; i < profiles.count; i++) {
+        jobs_wait(profiles.writes[i]);
+    }
+    if (profiles.open) {
+        for (int s = 0; s < PROFILE_CACHE_SLOTS; s++) {
+            if (profiles.slots[s].index >= 0 && profiles.slots[s].dirty) {
+                write_profile(&profiles.slots[s].data, profiles.slots[s].index);
+            }
+        }
+    }
+    memset(&profiles, 0, sizeof(profiles));
+}
+
+int profile_store_count(void) {
+    return profiles.count;
+}
+
+const char* profile_store_name(int index) {
+    return index >= 0 && index < profiles.count ? profiles.names[index] : "";
+}
+
+int profile_store_find(const char* name) {
+    for (int i = 0; i < profiles.count; i++) {
+        if (strncmp(profiles.names[i], name, PROFILE_NAME_SIZE - 1) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int profile_store_create(const char* name) {
+    if (!profiles.open) {
+        return -1;
+    }
+    int index = add_name(name);
+    if (index >= 0 && !write_names()) {
+        profiles.count--;
+        return -1;
+    }
+    return index;
+}
+
+static ProfileSlot* cached_slot(int index) {
+    if (!profiles.open || index < 0 || index >= profiles.count) {
+        return NULL;
+    }
+    ProfileSlot* victim = &profiles.slots[0];
+    for (int s = 0; s < PROFILE_CACHE_SLOTS; s++) {
+        ProfileSlot* slot = &profiles.slots[s];
+        if (slot->index == index) {
+            slot->last_used = ++profiles.clock;
+            return slot;
+        }
+        if (victim->index >= 0 && (slot->index < 0 || slot->last_used < victim->last_used)) {
+            victim = slot;
+        }
+    }
+
+    if (victim->index >= 0 && victim->dirty) {
+        write_profile_later(&victim->data, victim->index);
+    }
+    read_profile(&victim->data, index);
+    victim->index = index;
+    victim->dirty = 0;
+    victim->last_used = ++profiles.clock;
+    return victim;
+}
+
+const ProfileData* profile_store_get(int index) {
+    ProfileSlot* slot = cached_slot(index);
+    return slot ? &slot->data : NULL;
+}
+
+void profile_store_put(int index, const GameState* state) {
+    ProfileSlot* slot = cached_slot(index);
+    if (!slot) {
+        return;
+    }
+    slot->data.word_length = state->core.word_length;
+    slot->data.settings = state->settings;
+    slot->data.stats = state->stats;
+    slot->data.crossword = state->crossword;
+    slot->dirty = 1;
+}
+
+uint32_t profile_store_disk_loads(void) {
+    return profiles.disk_loads;
+}
+
+// ============= SWITCHING =============
+
+int profile_load(GameState* state, int index) {
+    const ProfileData* data = profile_store_get(index);
+    if (!data) {
+        return 0;
+    }
+    // Caches keyed on these versions must see a change even if the incoming
+    // profile happens to hold the same numbers
+    uint32_t token_version = state->stats.tokens.version + 1;
+    uint32_t history_version = state->stats.history.version + 1;
+    uint32_t need_version = state->crossword.token_need_version + 1;
+
+    state->core.word_length = data->word_length;
+    state->settings = data->settings;
+    state->stats = data->stats;
+    state->crossword = data->crossword;
+    state->stats.tokens.version = token_version;
+    state->stats.history.version = history_version;
+    state->crossword.token_need_version = need_version;
+
+    state->system.profile_index = index;
+    strcpy(state->system.profile_name, data->name);
+    return 1;
+}
+
+int profile_switch(GameState* state, int index) {
+    if (index == state->system.profile_index) {
+        return 1;
+    }
+    profile_store_put(state->system.profile_index, state);
+    return profile_load(state, index);
+}
+
+int profile_apply_requests(GameState* state) {
+    int count = profile_store_count();
+    int index = state->system.profile_index;
+    if (state->system.profile_create) {
+        char name[PROFILE_NAME_SIZE];
+        snprintf(name, sizeof(name), "Player %d", count + 1);
+        int created = profile_store_create(name);
+        index = created >= 0 ? created : index;
+    } else if (state->system.profile_step != 0 && count > 0) {
+        index = ((index + state->system.profile_step) % count + count) % count;
+    }
+    return index != state->system.profile_index && profile_switch(state, index);
+}
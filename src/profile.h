@@ -0,0 +1,63 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "types.h"
+
+// Player profile files (.cwpf)
+//
+// A profile is the per-player part of GameState: settings, statistics (with
+// the token ledger and history aggregates), crossword progress and the word
+// length last played. Everything else a game reads (word lists, crossword
+// levels, the feedback matrix and word selectors) is process-wide, built once
+// and handed out as const pointers; profiles never copy it.
+//
+// <directory>/profiles.txt lists the names, one per line. Profile i lives in
+// <directory>/profile_<i>.cwpf, its statistics log in profile_<i>.cwst.
+// Opening the store reads only the names. A profile's data is loaded on first
+// use into a small LRU cache and written back when it is evicted or the store
+// closes, so switching between recently used profiles touches no files.
+
+#define PROFILE_MAGIC 0x46505743u             // "CWPF"
+#define PROFILE_VERSION 1u
+#define PROFILE_MAX 256
+#define PROFILE_CACHE_SLOTS 8
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;                            // sizeof(ProfileData): layout check
+    int32_t word_length;
+    char name[PROFILE_NAME_SIZE];
+    GameSettingsState settings;
+    GameStatsState stats;
+    CrosswordState crossword;
+} ProfileData;
+
+// Reads the profile names, creating the directory and a first profile if
+// needed. Returns the number of profiles, 0 on failure.
+int profile_store_open(const char* directory);
+// Writes back every changed profile
+void profile_store_close(void);
+int profile_store_count(void);
+const char* profile_store_name(int index);
+// Index of the named profile, or -1
+int profile_store_find(const char* name);
+// Adds a fresh profile; returns its index, or -1 if the store is full
+int profile_store_create(const char* name);
+// Writes "<directory>/profile_<index><extension>" into out_path
+void profile_store_path(int index, const char* extension, char* out_path, int size);
+// Profile data, from the cache or loaded (evicting the least recently used)
+const ProfileData* profile_store_get(int index);
+// Copies the per-player parts of state into the profile's cached data
+void profile_store_put(int index, const GameState* state);
+uint32_t profile_store_disk_loads(void);
+
+// Makes `index` the state's profile. profile_switch first saves the state
+// into its current profile; profile_load does not. Returns 1 on success.
+int profile_load(GameState* state, int index);
+int profile_switch(GameState* state, int index);
+// Carries out the home screen's profile_step / profile_create requests.
+// Returns 1 if the state moved to another profile.
+int profile_apply_requests(GameState* state);
+
+#endif
@@ -0,0 +1,397 @@
+#include "systems.h"
+#include "puzzle_pack.h"
+#include "worddb.h"
+
+// Curated crossword packs. Like the clue database, the mapped file is the only
+// copy: the offset index finds a puzzle's record, and the record is decoded
+// and checked when the puzzle is asked for, never before, so opening a pack of
+// any size touches one page and a damaged record fails only its own puzzle.
+
+#define PUZZLE_PACK_GRID 9                    // CrosswordLevel grids are 9x9
+#define PUZZLE_PACK_LETTER_BITS 5
+
+static void* pack_mapping = NULL;
+static size_t pack_mapping_size = 0;
+static const PuzzlePackHeader* pack_header = NULL;
+static const uint32_t* pack_offsets = NULL;
+static const uint8_t* pack_records = NULL;
+static const char* pack_strings = NULL;
+
+// Maps a puzzle pack. Returns 1 on success.
+int load_puzzle_pack(const char* path) {
+    size_t size = 0;
+    void* view = word_db_map_file(path, &size);
+    if (!view) {
+        return 0;
+    }
+    const PuzzlePackHeader* header = (const PuzzlePackHeader*)view;
+    int valid = size >= sizeof(PuzzlePackHeader) &&
+                header->magic == PUZZLE_PACK_MAGIC &&
+                header->version == PUZZLE_PACK_VERSION &&
+                header->file_size == size &&
+                header->offsets_offset % 8 == 0 &&
+                word_db_section_fits(header->strings_offset, header->strings_size, 1, size) &&
+                word_db_section_fits(header->records_offset, header->records_size, 1, header->strings_offset) &&
+                word_db_section_fits(header->offsets_offset, (uint64_t)header->puzzle_count + 1, sizeof(uint32_t),
+                                     header->records_offset) &&
+                header->records_size <= UINT32_MAX &&
+                header->strings_size <= UINT32_MAX &&
+                (header->strings_size == 0 ||
+                 ((const char*)view)[header->strings_offset + header->strings_size - 1] == '\0');
+    if (!valid) {
+        word_db_unmap_file(view, size);
+        return 0;
+    }
+
+    unload_puzzle_pack();
+    pack_mapping = view;
+    pack_mapping_size = size;
+    pack_header = header;
+    pack_offsets = (const uint32_t*)((const uint8_t*)view + header->offsets_offset);
+    pack_records = (const uint8_t*)view + header->records_offset;
+    pack_strings = (const char*)view + header->strings_offset;
+    return 1;
+}
+
+void unload_puzzle_pack(void) {
+    if (pack_mapping) {
+        word_db_unmap_file(pack_mapping, pack_mapping_size);
+    }
+    pack_mapping = NULL;
+    pack_mapping_size = 0;
+    pack_header = NULL;
+    pack_offsets = NULL;
+    pack_records = NULL;
+    pack_strings = NULL;
+}
+
+int puzzle_pack_count(void) {
+    return pack_header ? (int)pack_header->puzzle_count : 0;
+}
+
+// ============= RECORDS =============
+
+// A record's sections, located and bounds-checked
+typedef struct {
+    int width;
+    int height;
+    int word_count;
+    int run_count;
+    const uint8_t* runs;
+    const uint8_t* words;
+    const uint8_t* clues;
+    const uint8_t* letters;
+    int letters_size;
+} PuzzleRecord;
+
+static int record_find(int index, PuzzleRecord* out_record) {
+    if (!pack_header || index < 0 || (uint32_t)index >= pack_header->puzzle_count) {
+        return 0;
+    }
+    uint32_t begin = pack_offsets[index];
+    uint32_t end = pack_offsets[index + 1];
+    if (begin > end || end > pack_header->records_size || end - begin < 4) {
+        return 0;
+    }
+    const uint8_t* record = pack_records + begin;
+    int size = (int)(end - begin);
+    out_record->width = record[0];
+    out_record->height = record[1];
+    out_record->word_count = record[2];
+    out_record->run_count = record[3];
+    out_record->runs = record + 4;
+    out_record->words = out_record->runs + out_record->run_count;
+    out_record->clues = out_record->words + out_record->word_count * 2;
+    out_record->letters = out_record->clues + out_record->word_count * 4;
+    out_record->letters_size = size - (int)(out_record->letters - record);
+    return out_record->width >= 1 && out_record->width <= PUZZLE_PACK_GRID &&
+           out_record->height >= 1 && out_record->height <= PUZZLE_PACK_GRID &&
+           out_record->word_count >= 1 && out_record->word_count <= PUZZLE_PACK_MAX_WORDS &&
+           out_record->letters_size >= 0;
+}
+
+static uint32_t read_u32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+// Decodes puzzle `index` (0-based) of the loaded pack as level index + 1.
+// Returns 0, leaving out_level untouched, if there is no such puzzle or its
+// record is damaged.
+int puzzle_pack_level(int index, CrosswordLevel* out_level) {
+    PuzzleRecord record;
+    if (!record_find(index, &record)) {
+        return 0;
+    }
+
+    CrosswordLevel level = {0};
+    level.level = index + 1;
+    level.word_count = record.word_count;
+
+    // Mask runs, row by row
+    int cell = 0;
+    int cell_count = record.width * record.height;
+    int word_cells = 0;
+    for (int r = 0; r < record.run_count; r++) {
+        int run = record.runs[r];
+        if (cell + run > cell_count) {
+            return 0;
+        }
+        for (int i = 0; i < run && r % 2 == 1; i++) {
+            level.word_mask[(cell + i) % record.width][(cell + i) / record.width] = 1;
+        }
+        word_cells += r % 2 == 1 ? run : 0;
+        cell += run;
+    }
+    if (cell != cell_count || record.letters_size != (word_cells * PUZZLE_PACK_LETTER_BITS + 7) / 8) {
+        return 0;
+    }
+
+    // Letters, in the same order, from a little-endian bit stream
+    uint32_t bits = 0;
+    int bit_count = 0;
+    int byte = 0;
+    for (int y = 0; y < record.height; y++) {
+        for (int x = 0; x < record.width; x++) {
+            if (!level.word_mask[x][y]) {
+                continue;
+            }
+            if (bit_count < PUZZLE_PACK_LETTER_BITS) {
+                bits |= (uint32_t)record.letters[byte++] << bit_count;
+                bit_count += 8;
+            }
+            int letter = (int)(bits & PACKED_LETTER_MASK);
+            bits >>= PUZZLE_PACK_LETTER_BITS;
+            bit_count -= PUZZLE_PACK_LETTER_BITS;
+            if (letter < 1 || letter > 26) {
+                return 0;
+            }
+            level.solution[x][y] = (char)('A' + letter - 1);
+        }
+    }
+
+    // Words must lie on the mask
+    for (int w = 0; w < record.word_count; w++) {
+        const uint8_t* entry = record.words + w * 2;
+        CrosswordWord* word = &level.words[w];
+        word->start_x = entry[0] >> 4;
+        word->start_y = entry[0] & 15;
+        word->direction = entry[1] >> 7;
+        word->length = entry[1] & 127;
+        if (word->length < MIN_WORD_LENGTH || word->length > MAX_WORD_LENGTH) {
+            return 0;
+        }
+        for (int i = 0; i < word->length; i++) {
+            int x = word->start_x + (word->direction == 0 ? i : 0);
+            int y = word->start_y + (word->direction == 0 ? 0 : i);
+            if (x >= record.width || y >= record.height || !level.word_mask[x][y]) {
+                return 0;
+            }
+        }
+    }
+
+    *out_level = level;
+    return 1;
+}
+
+// Clue the pack gives word `word_index` of puzzle `index`, or NULL. Valid
+// until the pack is unloaded.
+const char* puzzle_pack_clue(int index, int word_index) {
+    PuzzleRecord record;
+    if (!record_find(index, &record) || word_index < 0 || word_index >= record.word_count) {
+        return NULL;
+    }
+    uint32_t reference = read_u32(record.clues + word_index * 4);
+    if (reference == 0 || reference > pack_header->strings_size) {
+        return NULL;
+    }
+    return pack_strings + reference - 1;
+}
+
+// ============= WRITER =============
+
+typedef struct {
+    uint8_t* bytes;
+    size_t size;
+    size_t capacity;
+} PackBuffer;
+
+static int buffer_append(PackBuffer* buffer, const void* bytes, size_t size) {
+    if (buffer->size + size > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+        while (capacity < buffer->size + size) {
+            capacity *= 2;
+        }
+        uint8_t* grown = realloc(buffer->bytes, capacity);
+        if (!grown) {
+            return 0;
+        }
+        buffer->bytes = grown;
+        buffer->capacity = capacity;
+    }
+    if (size > 0) {
+        memcpy(buffer->bytes + buffer->size, bytes, size);
+    }
+    buffer->size += size;
+    return 1;
+}
+
+static int buffer_append_byte(PackBuffer* buffer, int value) {
+    uint8_t byte = (uint8_t)value;
+    return buffer_append(buffer, &byte, 1);
+}
+
+// Appends one puzzle's record; clue texts go to `strings`
+static int encode_puzzle(const PuzzleSource* puzzle, PackBuffer* records, PackBuffer* strings) {
+    const CrosswordLevel* level = &puzzle->level;
+    if (level->word_count < 1 || level->word_count > PUZZLE_PACK_MAX_WORDS) {
+        return 0;
+    }
+
+    // The grid is cut to the mask's extent
+    int width = 1;
+    int height = 1;
+    for (int x = 0; x < PUZZLE_PACK_GRID; x++) {
+        for (int y = 0; y < PUZZLE_PACK_GRID; y++) {
+            if (level->word_mask[x][y]) {
+                if (level->solution[x][y] < 'A' || level->solution[x][y] > 'Z') {
+                    return 0;
+                }
+                width = x + 1 > width ? x + 1 : width;
+                height = y + 1 > height ? y + 1 : height;
+            }
+        }
+    }
+    for (int w = 0; w < level->word_count; w++) {
+        const CrosswordWord* word = &level->words[w];
+        if (word->length < MIN_WORD_LENGTH || word->length > MAX_WORD_LENGTH ||
+            word->start_x < 0 || word->start_y < 0 || (word->direction != 0 && word->direction != 1)) {
+            return 0;
+        }
+        for (int i = 0; i < word->length; i++) {
+            int x = word->start_x + (word->direction == 0 ? i : 0);
+            int y = word->start_y + (word->direction == 0 ? 0 : i);
+            if (x >= PUZZLE_PACK_GRID || y >= PUZZLE_PACK_GRID || !level->word_mask[x][y]) {
+                return 0;
+            }
+        }
+    }
+
+    // Mask runs: alternate blocked and word cells, splitting runs over 255
+    uint8_t runs[PUZZLE_PACK_GRID * PUZZLE_PACK_GRID * 2 + 2];
+    int run_count = 0;
+    int run = 0;
+    int in_word = 0;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int is_word = level->word_mask[x][y] != 0;
+            if (is_word != in_word || run == 255) {
+                runs[run_count++] = (uint8_t)run;
+                if (is_word == in_word) {
+                    runs[run_count++] = 0;
+                }
+                in_word = is_word;
+                run = 0;
+            }
+            run++;
+        }
+    }
+    runs[run_count++] = (uint8_t)run;
+    if (run_count > 255) {
+        return 0;
+    }
+
+    size_t start = records->size;
+    int ok = buffer_append_byte(records, width) && buffer_append_byte(records, height) &&
+             buffer_append_byte(records, level->word_count) && buffer_append_byte(records, run_count) &&
+             buffer_append(records, runs, (size_t)run_count);
+    for (int w = 0; ok && w < level->word_count; w++) {
+        const CrosswordWord* word = &level->words[w];
+        ok = buffer_append_byte(records, word->start_x << 4 | word->start_y) &&
+             buffer_append_byte(records, word->direction << 7 | word->length);
+    }
+    for (int w = 0; ok && w < level->word_count; w++) {
+        const char* clue = puzzle->clues[w];
+        uint32_t reference = 0;
+        if (clue && clue[0] != '\0') {
+            reference = (uint32_t)strings->size + 1;
+            ok = buffer_append(strings, clue, strlen(clue) + 1);
+        }
+        uint8_t bytes[4] = {(uint8_t)reference, (uint8_t)(reference >> 8), (uint8_t)(reference >> 16), (uint8_t)(reference >> 24)};
+        ok = ok && buffer_append(records, bytes, sizeof(bytes));
+    }
+
+    uint32_t bits = 0;
+    int bit_count = 0;
+    for (int y = 0; ok && y < height; y++) {
+        for (int x = 0; ok && x < width; x++) {
+            if (!level->word_mask[x][y]) {
+                continue;
+            }
+            bits |= (uint32_t)(level->solution[x][y] - 'A' + 1) << bit_count;
+            bit_count += PUZZLE_PACK_LETTER_BITS;
+            while (ok && bit_count >= 8) {
+                ok = buffer_append_byte(records, (int)(bits & 0xFF));
+                bits >>= 8;
+                bit_count -= 8;
+            }
+        }
+    }
+    if (ok && bit_count > 0) {
+        ok = buffer_append_byte(records, (int)bits);
+    }
+    return ok && records->size - start <= PUZZLE_PACK_MAX_RECORD && strings->size <= UINT32_MAX - 1;
+}
+
+static uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+int puzzle_pack_write(const char* path, const PuzzleSource* puzzles, int puzzle_count) {
+    if (puzzle_count < 0) {
+        return 0;
+    }
+    uint32_t* offsets = malloc(sizeof(uint32_t) * ((size_t)puzzle_count + 1));
+    PackBuffer records = {0};
+    PackBuffer strings = {0};
+    int ok = offsets != NULL;
+    for (int i = 0; ok && i < puzzle_count; i++) {
+        offsets[i] = (uint32_t)records.size;
+        ok = encode_puzzle(&puzzles[i], &records, &strings) && records.size <= UINT32_MAX;
+    }
+    if (ok) {
+        offsets[puzzle_count] = (uint32_t)records.size;
+    }
+
+    FILE* file = ok ? fopen(path, "wb") : NULL;
+    if (file) {
+        PuzzlePackHeader header = {0};
+        header.magic = PUZZLE_PACK_MAGIC;
+        header.version = PUZZLE_PACK_VERSION;
+        header.puzzle_count = (uint32_t)puzzle_count;
+        header.offsets_offset = sizeof(PuzzlePackHeader);
+        header.records_offset = align8(header.offsets_offset + ((uint64_t)puzzle_count + 1) * sizeof(uint32_t));
+        header.records_size = records.size;
+        header.strings_offset = align8(header.records_offset + records.size);
+        header.strings_size = strings.size;
+        header.file_size = header.strings_offset + strings.size;
+
+        static const uint8_t padding[8] = {0};
+        uint64_t offsets_end = header.offsets_offset + ((uint64_t)puzzle_count + 1) * sizeof(uint32_t);
+        ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+             fwrite(offsets, sizeof(uint32_t), (size_t)puzzle_count + 1, file) == (size_t)puzzle_count + 1 &&
+             fwrite(padding, 1, header.records_offset - offsets_end, file) == header.records_offset - offsets_end &&
+             (records.size == 0 || fwrite(records.bytes, records.size, 1, file) == 1) &&
+             fwrite(padding, 1, header.strings_offset - header.records_offset - records.size, file) ==
+                 header.strings_offset - header.records_offset - records.size &&
+             (strings.size == 0 || fwrite(strings.bytes, strings.size, 1, file) == 1);
+        if (fclose(file) != 0) {
+            ok = 0;
+        }
+    } else {
+        ok = 0;
+    }
+    free(offsets);
+    free(records.bytes);
+    free(strings.bytes);
+    return ok;
+}
@@ -0,0 +1,59 @@
+#ifndef PUZZLE_PACK_H
+#define PUZZLE_PACK_H
+
+#include "types.h"
+
+// Crossword puzzle pack file (.cwpk)
+//
+// Layout (little-endian, 8-byte aligned sections):
+//   PuzzlePackHeader
+//   uint32_t offsets[puzzle_count + 1]   record i is [offsets[i], offsets[i + 1])
+//                                        of the record section
+//   uint8_t records[records_size]        one compact record per puzzle
+//   char strings[strings_size]           clue texts, each NUL-terminated
+//
+// A record, byte by byte:
+//   width, height, word_count, run_count
+//   runs[run_count]          mask run lengths, row by row, alternating blocked
+//                            and word cells and starting with blocked; a run
+//                            longer than 255 continues after a zero-length run
+//   words[word_count][2]     start_x << 4 | start_y, direction << 7 | length
+//   clues[word_count][4]     clue reference: text offset + 1, 0 for none
+//   letters                  the word cells' letters in mask order, 5 bits each
+//                            (A = 1), first letter in the low bits
+//
+// A record is about 50 bytes, so 10k puzzles take half a megabyte plus their
+// clues. The pack is mapped, not read: opening checks the header, and
+// puzzle_pack_level() decodes one record into a CrosswordLevel only when that
+// puzzle is played, so the cost of a level does not grow with the pack.
+
+#define PUZZLE_PACK_MAGIC 0x4B505743u         // "CWPK"
+#define PUZZLE_PACK_VERSION 1u
+#define PUZZLE_PACK_MAX_WORDS 10              // CrosswordLevel.words
+#define PUZZLE_PACK_MAX_RECORD 512            // Bytes; a full 9x9 grid of 10 words needs about 150
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t puzzle_count;
+    uint32_t reserved;
+    uint64_t offsets_offset;
+    uint64_t records_offset;
+    uint64_t records_size;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+    uint64_t file_size;
+} PuzzlePackHeader;
+
+// One puzzle handed to puzzle_pack_write: a level and a clue per word (NULL
+// or "" for none)
+typedef struct {
+    CrosswordLevel level;
+    const char* clues[PUZZLE_PACK_MAX_WORDS];
+} PuzzleSource;
+
+// Writes a pack of the puzzles in order. Fails on a puzzle whose words do
+// not lie on its mask or hold letters outside A-Z. Returns 1 on success.
+int puzzle_pack_write(const char* path, const PuzzleSource* puzzles, int puzzle_count);
+
+#endif
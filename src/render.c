@@ -1,40 +1,8 @@
+#include "raylib.h"
 #include "systems.h"
+#include "clues.h"
 #include <math.h>
 
-LayoutConfig calculate_layout(GameState state) {
-    LayoutConfig layout = {0};
-    
-    layout.screen_width = GetScreenWidth();
-    layout.screen_height = GetScreenHeight();
-    
-    int available_width = layout.screen_width - 100;
-    
-    // Calculate cell size based on available width
-    layout.cell_size = available_width / (WORD_LENGTH + (WORD_LENGTH - 1) * CELL_SPACING_RATIO);
-    
-    if (layout.cell_size < MIN_CELL_SIZE) layout.cell_size = MIN_CELL_SIZE;
-    if (layout.cell_size > MAX_CELL_SIZE) layout.cell_size = MAX_CELL_SIZE;
-    
-    layout.cell_spacing = (int)(layout.cell_size * CELL_SPACING_RATIO);
-    layout.row_height = layout.cell_size + layout.cell_spacing;
-    
-    // Calculate dynamic row count: completed guesses + 1 input row
-    layout.total_rows = state.history.level_guess_count + 1;
-    layout.current_input_row = state.history.level_guess_count;  // 0-indexed
-    
-    layout.board_width = WORD_LENGTH * layout.cell_size + (WORD_LENGTH - 1) * layout.cell_spacing;
-    layout.board_height = layout.total_rows * layout.row_height - layout.cell_spacing;  // Remove spacing after last row
-    
-    layout.board_start_x = (layout.screen_width - layout.board_width) / 2;
-    
-    // Calculate board_start_y with camera offset to center current input row
-    int input_row_y = layout.current_input_row * layout.row_height;
-    int desired_input_y = (layout.screen_height - layout.cell_size) / 2;  // Center of screen
-    layout.board_start_y = desired_input_y - input_row_y + (int)state.system.camera_offset_y;
-    
-    return layout;
-}
-
 Color get_color_for_letter_state(LetterState state) {
     if (state == LETTER_CORRECT) return WORDLE_GREEN;
     if (state == LETTER_WRONG_POS) return WORDLE_YELLOW;
@@ -54,7 +22,7 @@ void board_render_system(GameState state) {
             continue;
         }
         
-        for (int col = 0; col < WORD_LENGTH; col++) {
+        for (int col = 0; col < state.core.word_length; col++) {
             int cell_x = layout.board_start_x + col * (layout.cell_size + layout.cell_spacing);
             int cell_y = row_y;
             
@@ -165,7 +133,7 @@ void board_render_system(GameState state) {
             if (row == layout.current_input_row && 
                 state.core.play_state == GAME_STATE_INPUT && 
                 col == state.input.current_letter_pos &&
-                state.input.current_letter_pos < WORD_LENGTH) {
+                state.input.current_letter_pos < state.core.word_length) {
                 
                 // Add pulsing border effect for cursor
                 float pulse = (sin(state.ui.cursor_pulse_timer) + 1.0f) / 2.0f; // 0 to 1
@@ -222,9 +190,8 @@ void board_render_system(GameState state) {
 void ui_render_system(GameState state) {
     LayoutConfig layout = calculate_layout(state);
     
-    // Calculate top bar content and dimensions
-    char level_title[50];
-    sprintf(level_title, "WORDLE - LEVEL %d", state.core.current_level);
+    // Calculate top bar content and dimensions (text is pre-built by hud_update_system)
+    const char* level_title = state.ui.hud.level_title;
     int title_font_size = (int)(layout.screen_width * 0.05f);
     if (title_font_size < 24) title_font_size = 24;
     if (title_font_size > 48) title_font_size = 48;
@@ -236,9 +203,8 @@ void ui_render_system(GameState state) {
     // Calculate debug info if present
     int debug_font_size = 0;
     int debug_y = 0;
-    char debug_message[50] = "";
+    const char* debug_message = state.ui.hud.debug_message;
     if (state.system.debug_mode) {
-        sprintf(debug_message, "DEBUG: Answer is %s", state.core.target_word);
         debug_font_size = (int)(layout.screen_width * 0.035f);
         if (debug_font_size < 20) debug_font_size = 20;
         if (debug_font_size > 28) debug_font_size = 28;
@@ -246,9 +212,7 @@ void ui_render_system(GameState state) {
     }
     
     // Calculate level stats
-    char level_stats[100];
-    sprintf(level_stats, "Guess %d this level | %d total guesses", 
-            state.core.guesses_this_level + 1, state.core.total_lifetime_guesses);
+    const char* level_stats = state.ui.hud.level_stats;
     int stats_font_size = (int)(layout.screen_width * 0.028f);
     if (stats_font_size < 18) stats_font_size = 18;
     if (stats_font_size > 24) stats_font_size = 24;
@@ -275,6 +239,13 @@ void ui_render_system(GameState state) {
     
     DrawText(level_stats, stats_x, stats_y, stats_font_size, WORDLE_DARK_GRAY);
     
+    // Speed mode timers, below the top bar on the left
+    if (state.speed.active) {
+        int speed_y = top_bar_height + 10;
+        DrawText(state.ui.hud.speed_timer_text, 20, speed_y, stats_font_size, WORDLE_WHITE);
+        DrawText(state.ui.hud.speed_splits_text, 20, speed_y + stats_font_size + 5, stats_font_size, WORDLE_GRAY);
+    }
+    
     // Game state specific messages
     if (state.core.play_state == GAME_STATE_LEVEL_COMPLETE) {
         const char* success_message = "LEVEL COMPLETE!";
@@ -282,9 +253,7 @@ void ui_render_system(GameState state) {
         if (success_font_size < 20) success_font_size = 20;
         if (success_font_size > 36) success_font_size = 36;
         
-        char level_score[100];
-        sprintf(level_score, "Solved in %d guesses! Press SPACE for Level %d", 
-                state.core.guesses_this_level, state.core.current_level + 1);
+        const char* level_score = state.ui.hud.level_score;
         int score_font_size = (int)(layout.screen_width * 0.032f);
         if (score_font_size < 20) score_font_size = 20;
         if (score_font_size > 28) score_font_size = 28;
@@ -310,7 +279,7 @@ void ui_render_system(GameState state) {
         
     } else {
         // Calculate bottom bar content and dimensions
-        const char* instruction = "Type a 5-letter word and press ENTER";
+        const char* instruction = state.ui.hud.instruction;
         int instruction_font_size = (int)(layout.screen_width * 0.030f);
         if (instruction_font_size < 20) instruction_font_size = 20;
         if (instruction_font_size > 28) instruction_font_size = 28;
@@ -321,34 +290,15 @@ void ui_render_system(GameState state) {
         if (debug_instruction_font_size > 22) debug_instruction_font_size = 22;
         
         // Lifetime stats
-        char lifetime_stats[150];
-        sprintf(lifetime_stats, "Levels completed: %d | Best: %d guesses | Average: %.1f guesses", 
-                state.stats.levels_completed, 
-                (state.stats.best_level_score < 999) ? state.stats.best_level_score : 0,
-                state.stats.average_guesses_per_level);
+        const char* lifetime_stats = state.ui.hud.lifetime_stats;
         int lifetime_font_size = (int)(layout.screen_width * 0.024f);
         if (lifetime_font_size < 16) lifetime_font_size = 16;
         if (lifetime_font_size > 22) lifetime_font_size = 22;
         
         // Letter bag text
-        char letter_bag_text[300] = "";
+        const char* letter_bag_text = state.ui.hud.letter_bag_text;
         int bag_font_size = 0;
         if (state.stats.show_letter_bag) {
-            strcpy(letter_bag_text, "Letter Bag: ");
-            int bag_start_len = strlen(letter_bag_text);
-            
-            for (int i = 0; i < 26; i++) {
-                if (state.stats.letter_counts[i] > 0) {
-                    char letter_entry[10];
-                    sprintf(letter_entry, "%c:%d ", 'A' + i, state.stats.letter_counts[i]);
-                    strcat(letter_bag_text, letter_entry);
-                }
-            }
-            
-            if (strlen(letter_bag_text) == bag_start_len) {
-                strcat(letter_bag_text, "No letters collected yet");
-            }
-            
             bag_font_size = (int)(layout.screen_width * 0.022f);
             if (bag_font_size < 16) bag_font_size = 16;
             if (bag_font_size > 20) bag_font_size = 20;
@@ -390,10 +340,15 @@ void ui_render_system(GameState state) {
         DrawText(debug_instruction, debug_instruction_x, current_y, debug_instruction_font_size, WORDLE_DARK_GRAY);
         current_y += debug_instruction_font_size + line_spacing;
         
-        // Main instruction
+        // Main instruction, or why hard mode refused the guess
+        Color instruction_color = WORDLE_BLACK;
+        if (state.input.hard_mode_violation.kind != GUESS_VIOLATION_NONE) {
+            instruction = state.ui.hud.hard_mode_text;
+            instruction_color = (Color){200, 40, 40, 255};  // Dark red
+        }
         int instruction_width = MeasureText(instruction, instruction_font_size);
         int instruction_x = (layout.screen_width - instruction_width) / 2;
-        DrawText(instruction, instruction_x, current_y, instruction_font_size, WORDLE_BLACK);
+        DrawText(instruction, instruction_x, current_y, instruction_font_size, instruction_color);
     }
     
     // Render celebration particles
@@ -438,8 +393,7 @@ void ui_render_system(GameState state) {
     
     // Render level completion celebration text
     if (state.ui.celebrating_level && state.ui.level_complete_timer > 0.0f) {
-        char level_text[50];
-        sprintf(level_text, "LEVEL %d COMPLETE!", state.core.current_level);
+        const char* level_text = state.ui.hud.level_complete_text;
         int level_font_size = 36;
         int text_width = MeasureText(level_text, level_font_size);
         int text_x = (GetScreenWidth() - text_width) / 2;
@@ -462,6 +416,119 @@ void ui_render_system(GameState state) {
     }
 }
 
+// Clue panel cache: a clue is wrapped once per clue, panel width and font
+// size, not measured every frame. The lines are copied out of the mapped clue
+// database back to back, each NUL-terminated for DrawText.
+#define CLUE_LAYOUT_CACHE_SIZE 16
+#define CLUE_PANEL_MAX_LINES 4
+
+typedef struct {
+    uint32_t clue;                            // 0 for an empty slot
+    int width;
+    int font_size;
+    uint32_t last_used;
+    int line_count;
+    int line_offset[CLUE_PANEL_MAX_LINES];
+    char text[CLUE_MAX_LENGTH + CLUE_PANEL_MAX_LINES + 1];
+} ClueLayout;
+
+typedef struct {
+    int font_size;
+    char scratch[CLUE_MAX_LENGTH + 1];
+} ClueMeasure;
+
+static ClueLayout clue_layouts[CLUE_LAYOUT_CACHE_SIZE];
+static uint32_t clue_layout_clock = 0;
+
+static int measure_clue_span(void* context, const char* text, int length) {
+    ClueMeasure* measure = context;
+    if (length > CLUE_MAX_LENGTH) {
+        length = CLUE_MAX_LENGTH;
+    }
+    memcpy(measure->scratch, text, (size_t)length);
+    measure->scratch[length] = '\0';
+    return MeasureText(measure->scratch, measure->font_size);
+}
+
+static const ClueLayout* clue_layout(uint32_t clue, int width, int font_size) {
+    clue_layout_clock++;
+    ClueLayout* oldest = &clue_layouts[0];
+    for (int i = 0; i < CLUE_LAYOUT_CACHE_SIZE; i++) {
+        ClueLayout* layout = &clue_layouts[i];
+        if (layout->clue == clue && layout->width == width && layout->font_size == font_size) {
+            layout->last_used = clue_layout_clock;
+            return layout;
+        }
+        if (layout->last_used < oldest->last_used) {
+            oldest = layout;
+        }
+    }
+    
+    const char* text = clue_text(clue);
+    if (!text) {
+        return NULL;
+    }
+    char source[CLUE_MAX_LENGTH + 1];
+    size_t length = strlen(text);
+    if (length > CLUE_MAX_LENGTH) {
+        length = CLUE_MAX_LENGTH;
+    }
+    memcpy(source, text, length);
+    source[length] = '\0';
+    ClueMeasure measure;
+    measure.font_size = font_size;
+    TextLine lines[CLUE_PANEL_MAX_LINES];
+    int line_count = text_wrap(source, width, measure_clue_span, &measure, lines, CLUE_PANEL_MAX_LINES);
+    
+    ClueLayout* layout = oldest;
+    layout->clue = clue;
+    layout->width = width;
+    layout->font_size = font_size;
+    layout->last_used = clue_layout_clock;
+    layout->line_count = line_count;
+    int offset = 0;
+    for (int i = 0; i < line_count; i++) {
+        layout->line_offset[i] = offset;
+        memcpy(layout->text + offset, source + lines[i].start, (size_t)lines[i].length);
+        offset += lines[i].length;
+        layout->text[offset++] = '\0';
+    }
+    return layout;
+}
+
+// Current word's clue, centered in the band between top and bottom
+static void draw_clue_panel(GameState state, int top, int bottom) {
+    uint32_t clue = state.ui.hud.crossword_clue;
+    int screen_width = GetScreenWidth();
+    int font_size = (int)(screen_width * 0.022f);
+    if (font_size < 16) font_size = 16;
+    if (font_size > 20) font_size = 20;
+    int line_height = font_size + 4;
+    int max_lines = (bottom - top - 16) / line_height;
+    if (clue == 0 || max_lines <= 0) {
+        return;
+    }
+    
+    int panel_width = screen_width - 80;
+    if (panel_width > 640) panel_width = 640;
+    const ClueLayout* layout = clue_layout(clue, panel_width - 24, font_size);
+    if (!layout || layout->line_count == 0) {
+        return;
+    }
+    
+    int line_count = layout->line_count < max_lines ? layout->line_count : max_lines;
+    int panel_height = line_count * line_height + 12;
+    int panel_x = (screen_width - panel_width) / 2;
+    int panel_y = top + (bottom - top - panel_height) / 2;
+    DrawRectangle(panel_x, panel_y, panel_width, panel_height, WORDLE_WHITE);
+    DrawRectangleLinesEx((Rectangle){panel_x, panel_y, panel_width, panel_height}, 2, WORDLE_BORDER);
+    for (int i = 0; i < line_count; i++) {
+        const char* line = layout->text + layout->line_offset[i];
+        int line_x = (screen_width - MeasureText(line, font_size)) / 2;
+        DrawText(line, line_x, panel_y + 6 + i * line_height, font_size, WORDLE_BLACK);
+    }
+}
+
 void crossword_render_system(GameState state) {
     int screen_width = GetScreenWidth();
     
@@ -485,7 +552,8 @@ void crossword_render_system(GameState state) {
     // Calculate grid layout
     int grid_size = 9;
     int screen_height = GetScreenHeight();
-    int available_size = (screen_width < screen_height - 200) ? screen_width - 100 : screen_height - 300;
+    KeyboardLayout keyboard = calculate_keyboard_layout(VIEW_CROSSWORD, screen_width, screen_height);
+    int available_size = (screen_width < screen_height - 200) ? screen_width - 100 : screen_height - 300 - keyboard.height;
     int cell_size = available_size / grid_size;
     if (cell_size > 60) cell_size = 60;
     if (cell_size < 30) cell_size = 30;
@@ -632,11 +700,7 @@ void crossword_render_system(GameState state) {
     
     
     // Word and direction indicator - positioned below grid center
-    const char* direction_text = (state.crossword.cursor_direction == 0) ? "ACROSS" : "DOWN";
-    char word_indicator[50];
-    sprintf(word_indicator, "Word %d - %s", 
-            state.crossword.current_word_index + 1, 
-            direction_text);
+    const char* word_indicator = state.ui.hud.word_indicator;
     
     int word_font_size = (int)(screen_width * 0.030f);
     if (word_font_size < 20) word_font_size = 20;
@@ -647,31 +711,20 @@ void crossword_render_system(GameState state) {
     int word_y = grid_start_y + grid_height + 20;  // Below the grid
     DrawText(word_indicator, word_x, word_y, word_font_size, (Color){200, 140, 0, 255});  // Dark yellow
     
+    // Clue panel between the indicator and the keyboard
+    int clue_bottom = keyboard.width > 0 ? keyboard.y : screen_height - 100;
+    draw_clue_panel(state, word_y + word_font_size + 4, clue_bottom - 4);
+    
     // Calculate bottom bar content and dimensions
     const char* instructions = "Left/Right: select word | Up/Down: navigate within word | Letters: place letters | Enter: validate word | Tab: return to Wordle";
     int inst_font_size = (int)(screen_width * 0.024f);
     if (inst_font_size < 16) inst_font_size = 16;
     if (inst_font_size > 22) inst_font_size = 22;
     
-    // Letter bag text
-    char letter_bag_text[300] = "";
+    // Letter bag: label followed by one entry per held or needed letter
+    const HudState* hud = &state.ui.hud;
     int bag_font_size = 0;
     if (state.stats.show_letter_bag) {
-        strcpy(letter_bag_text, "Available Letters: ");
-        int bag_start_len = strlen(letter_bag_text);
-        
-        for (int i = 0; i < 26; i++) {
-            if (state.stats.letter_counts[i] > 0) {
-                char letter_entry[10];
-                sprintf(letter_entry, "%c:%d ", 'A' + i, state.stats.letter_counts[i]);
-                strcat(letter_bag_text, letter_entry);
-            }
-        }
-        
-        if (strlen(letter_bag_text) == bag_start_len) {
-            strcat(letter_bag_text, "None - play Wordle to earn letters!");
-        }
-        
         bag_font_size = (int)(screen_width * 0.022f);
         if (bag_font_size < 16) bag_font_size = 16;
         if (bag_font_size > 20) bag_font_size = 20;
@@ -694,9 +747,24 @@ void crossword_render_system(GameState state) {
     
     // Letter bag (if shown) - at top of bottom bar
     if (state.stats.show_letter_bag) {
-        int bag_width = MeasureText(letter_bag_text, bag_font_size);
+        int label_width = MeasureText(hud->crossword_bag_text, bag_font_size);
+        int entry_widths[TOKEN_LETTER_COUNT];
+        int bag_width = label_width;
+        for (int i = 0; i < hud->crossword_bag_entry_count; i++) {
+            entry_widths[i] = MeasureText(hud->crossword_bag_entries[i], bag_font_size);
+            bag_width += entry_widths[i];
+        }
+        
         int bag_x = (screen_width - bag_width) / 2;
-        DrawText(letter_bag_text, bag_x, current_y, bag_font_size, (Color){200, 140, 0, 255});  // Dark yellow
+        DrawText(hud->crossword_bag_text, bag_x, current_y, bag_font_size, (Color){200, 140, 0, 255});  // Dark yellow
+        bag_x += label_width;
+        for (int i = 0; i < hud->crossword_bag_entry_count; i++) {
+            // Grey out letters the bag cannot cover for the rest of the puzzle
+            int short_of_letter = (hud->crossword_bag_short_mask >> hud->crossword_bag_entry_letter[i]) & 1u;
+            Color entry_color = short_of_letter ? WORDLE_GRAY : (Color){200, 140, 0, 255};
+            DrawText(hud->crossword_bag_entries[i], bag_x, current_y, bag_font_size, entry_color);
+            bag_x += entry_widths[i];
+        }
         current_y += bag_font_size + line_spacing;
     }
     
@@ -744,6 +812,15 @@ void home_screen_render_system(GameState state) {
     
     DrawText(subtitle, subtitle_x, subtitle_y, subtitle_font_size, WORDLE_GRAY);
     
+    // Word length mode selector
+    const char* mode_text = state.ui.hud.mode_text;
+    int mode_font_size = subtitle_font_size;
+    int mode_width = MeasureText(mode_text, mode_font_size);
+    int mode_x = (screen_width - mode_width) / 2;
+    int mode_y = subtitle_y + subtitle_font_size + 20;
+    
+    DrawText(mode_text, mode_x, mode_y, mode_font_size, WORDLE_WHITE);
+    
     // Start instruction
     const char* start_text = "Press ENTER to start";
     int start_font_size = (int)(screen_width * 0.04f);
@@ -765,6 +842,26 @@ void home_screen_render_system(GameState state) {
     
     DrawText(start_text, start_x, start_y, start_font_size, start_color);
     
+    // Daily challenge and speed run hint
+    const char* daily_text = "Press D for today's daily challenge, S for a timed speed run";
+    int daily_width = MeasureText(daily_text, subtitle_font_size);
+    DrawText(daily_text, (screen_width - daily_width) / 2, start_y + start_font_size + 20, subtitle_font_size, WORDLE_GRAY);
+    
+    // Player profile
+    if (state.system.profile_name[0] != '\0') {
+        int profile_width = MeasureText(state.ui.hud.profile_text, subtitle_font_size);
+        DrawText(state.ui.hud.profile_text, (screen_width - profile_width) / 2, mode_y + mode_font_size + 16,
+                 subtitle_font_size, WORDLE_WHITE);
+    }
+    
+    // Word theme
+    if (state.ui.hud.theme_text[0] != '\0') {
+        int theme_width = MeasureText(state.ui.hud.theme_text, subtitle_font_size);
+        DrawText(state.ui.hud.theme_text, (screen_width - theme_width) / 2,
+                 start_y + start_font_size + 32 + subtitle_font_size,
+                 subtitle_font_size, WORDLE_GRAY);
+    }
+    
     // Version or credits at bottom
     const char* credits = "Built with Raylib";
     int credits_font_size = 14;
@@ -804,13 +901,7 @@ void crossword_completion_render_system(GameState state) {
     DrawText(congrats, congrats_x, congrats_y, congrats_font_size, WORDLE_WHITE);
     
     // Statistics (letters used, etc.)
-    int total_letters_used = 0;
-    for (int i = 0; i < 26; i++) {
-        total_letters_used += state.stats.letter_counts[i];
-    }
-    
-    char stats_text[100];
-    sprintf(stats_text, "Letter tokens remaining: %d", total_letters_used);
+    const char* stats_text = state.ui.hud.tokens_remaining_text;
     int stats_font_size = (int)(screen_width * 0.025f);
     if (stats_font_size < 16) stats_font_size = 16;
     if (stats_font_size > 24) stats_font_size = 24;
@@ -855,6 +946,253 @@ void crossword_completion_render_system(GameState state) {
     }
 }
 
+// On-screen keyboard cache: the panel is drawn into a texture and re-rendered
+// only when what it shows (letter colors or token counts), the view or the
+// panel size changes
+static RenderTexture2D keyboard_texture;
+static int keyboard_texture_loaded = 0;
+static int keyboard_texture_width = 0;
+static int keyboard_texture_height = 0;
+static GameViewState keyboard_texture_view = VIEW_HOME_SCREEN;
+static uint32_t keyboard_texture_version = 0;
+
+static void draw_keyboard_panel(GameState state, const KeyboardLayout* layout) {
+    const Color key_color = (Color){211, 214, 218, 255};  // Light gray, untried letters
+    int letter_font_size = (int)(layout->key_height * 0.55f);
+    int label_font_size = (int)(layout->key_height * 0.4f);
+    int count_font_size = (int)(layout->key_height * 0.35f);
+    
+    for (int i = 0; i < KEYBOARD_KEY_COUNT; i++) {
+        KeyboardKeyRect key = keyboard_key(layout, i);
+        Rectangle rect = {key.x, key.y, key.width, key.height};
+        
+        if (key.key == GAME_KEY_ENTER || key.key == GAME_KEY_BACKSPACE) {
+            const char* label = key.key == GAME_KEY_ENTER ? "ENTER" : "DEL";
+            DrawRectangleRec(rect, key_color);
+            int label_width = MeasureText(label, label_font_size);
+            DrawText(label, key.x + (key.width - label_width) / 2, key.y + (key.height - label_font_size) / 2,
+                     label_font_size, WORDLE_BLACK);
+            continue;
+        }
+        
+        char letter = (char)key.key;
+        char letter_string[2] = {letter, '\0'};
+        Color background = key_color;
+        Color text_color = WORDLE_BLACK;
+        if (state.current_view == VIEW_CROSSWORD) {
+            // Crossword: tokens held per letter, greyed out when none are left
+            int count = token_ledger_count(&state.stats.tokens, letter);
+            background = count > 0 ? WORDLE_WHITE : key_color;
+            text_color = count > 0 ? WORDLE_BLACK : WORDLE_GRAY;
+            char count_text[12];
+            format_int(count_text, count);
+            int count_width = MeasureText(count_text, count_font_size);
+            DrawRectangleRec(rect, background);
+            DrawText(count_text, key.x + key.width - count_width - 2, key.y + 2, count_font_size, (Color){200, 140, 0, 255});  // Dark yellow
+        } else {
+            LetterState letter_state = state.history.keyboard.letters[letter - 'A'];
+            if (letter_state != LETTER_UNKNOWN) {
+                background = get_color_for_letter_state(letter_state);
+                text_color = WORDLE_WHITE;
+            }
+            DrawRectangleRec(rect, background);
+        }
+        
+        int letter_width = MeasureText(letter_string, letter_font_size);
+        DrawText(letter_string, key.x + (key.width - letter_width) / 2, key.y + (key.height - letter_font_size) / 2,
+                 letter_font_size, text_color);
+    }
+}
+
+void keyboard_render_system(GameState state) {
+    KeyboardLayout layout = calculate_keyboard_layout(state.current_view, state.system.screen_width, state.system.screen_height);
+    if (layout.width <= 0 || layout.height <= 0) {
+        return;
+    }
+    uint32_t version = state.current_view == VIEW_CROSSWORD ? state.stats.tokens.version : state.history.keyboard.version;
+    
+    if (!keyboard_texture_loaded || keyboard_texture_width != layout.width || keyboard_texture_height != layout.height) {
+        if (keyboard_texture_loaded) {
+            UnloadRenderTexture(keyboard_texture);
+        }
+        keyboard_texture = LoadRenderTexture(layout.width, layout.height);
+        keyboard_texture_loaded = 1;
+        keyboard_texture_width = layout.width;
+        keyboard_texture_height = layout.height;
+        keyboard_texture_version = version - 1;  // Force a redraw
+    }
+    
+    if (keyboard_texture_version != version || keyboard_texture_view != state.current_view) {
+        BeginTextureMode(keyboard_texture);
+        ClearBackground((Color){0, 0, 0, 0});
+        draw_keyboard_panel(state, &layout);
+        EndTextureMode();
+        keyboard_texture_version = version;
+        keyboard_texture_view = state.current_view;
+    }
+    
+    // Render textures are stored bottom-up, so draw with a flipped source
+    Rectangle source = {0, 0, layout.width, -layout.height};
+    DrawTextureRec(keyboard_texture.texture, source, (Vector2){layout.x, layout.y}, WORDLE_WHITE);
+}
+
+// Latency overlay: per-action input-to-photon percentiles and a 1 ms
+// histogram, for every action with samples
+void profiler_overlay_render(const LatencyHistograms* histograms, const JobsUtilization* workers) {
+    const int font_size = 16;
+    const int row_height = 24;
+    const int columns[] = {10, 130, 190, 250, 310, 370};   // Name, count, p50, p95, p99, max
+    const char* headers[] = {"INPUT->PHOTON ms", "n", "p50", "p95", "p99", "max"};
+    const char* worker_headers[] = {"JOB WORKERS", "busy%", "jobs", "stolen"};
+    int bars_x = 430;
+    int bar_width = 2;
+    
+    int rows = 0;
+    for (int action = GAME_ACTION_NONE + 1; action < GAME_ACTION_COUNT; action++) {
+        rows += histograms->count[action] > 0;
+    }
+    if (workers->worker_count > 0) {
+        rows += workers->worker_count + 1;
+    }
+    int panel_width = bars_x + LATENCY_BUCKET_COUNT * bar_width + 10;
+    int panel_height = (rows + 1) * row_height + 10;
+    DrawRectangle(0, 0, panel_width, panel_height, (Color){0, 0, 0, 200});
+    
+    for (int c = 0; c < 6; c++) {
+        DrawText(headers[c], columns[c], 8, font_size, WORDLE_YELLOW);
+    }
+    
+    int y = 8 + row_height;
+    for (int action = GAME_ACTION_NONE + 1; action < GAME_ACTION_COUNT; action++) {
+        uint32_t count = histograms->count[action];
+        if (count == 0) {
+            continue;
+        }
+        int values[5] = {
+            (int)count,
+            (int)latency_percentile(histograms, (GameAction)action, 0.50),
+            (int)latency_percentile(histograms, (GameAction)action, 0.95),
+            (int)latency_percentile(histograms, (GameAction)action, 0.99),
+            (int)(histograms->max_ms[action] + 0.5),
+        };
+        DrawText(input_action_name((GameAction)action), columns[0], y, font_size, WORDLE_WHITE);
+        for (int c = 0; c < 5; c++) {
+            char text[12];
+            format_int(text, values[c]);
+            DrawText(text, columns[c + 1], y, font_size, WORDLE_WHITE);
+        }
+        
+        // Histogram, scaled to the fullest bucket
+        uint32_t peak = 1;
+        for (int bucket = 0; bucket < LATENCY_BUCKET_COUNT; bucket++) {
+            if (histograms->buckets[action][bucket] > peak) peak = histograms->buckets[action][bucket];
+        }
+        for (int bucket = 0; bucket < LATENCY_BUCKET_COUNT; bucket++) {
+            int height = (int)((int64_t)histograms->buckets[action][bucket] * font_size / peak);
+            if (height > 0) {
+                DrawRectangle(bars_x + bucket * bar_width, y + font_size - height, bar_width, height, WORDLE_GREEN);
+            }
+        }
+        y += row_height;
+    }
+    
+    // One row per job worker, with its busy share as a bar
+    if (workers->worker_count == 0) {
+        return;
+    }
+    for (int c = 0; c < 4; c++) {
+        DrawText(worker_headers[c], columns[c], y, font_size, WORDLE_YELLOW);
+    }
+    y += row_height;
+    for (int w = 0; w < workers->worker_count; w++) {
+        char text[12];
+        format_int(text, w);
+        DrawText(text, columns[0], y, font_size, WORDLE_WHITE);
+        int values[3] = {workers->busy_percent[w], (int)workers->jobs_run[w], (int)workers->jobs_stolen[w]};
+        for (int c = 0; c < 3; c++) {
+            format_int(text, values[c]);
+            DrawText(text, columns[c + 1], y, font_size, WORDLE_WHITE);
+        }
+        int width = workers->busy_percent[w] * LATENCY_BUCKET_COUNT * bar_width / 100;
+        if (width > 0) {
+            DrawRectangle(bars_x, y + 2, width, font_size - 4, WORDLE_GREEN);
+        }
+        y += row_height;
+    }
+}
+
+// Letter heatmap cell: the letter's correct/present/absent colors mixed by how
+// often each came back for it
+static Color letter_accuracy_color(const uint32_t results[3]) {
+    uint32_t total = results[0] + results[1] + results[2];
+    if (total == 0) {
+        return WORDLE_DARK_GRAY;
+    }
+    const Color colors[3] = {WORDLE_GREEN, WORDLE_YELLOW, WORDLE_GRAY};
+    uint32_t r = 0, g = 0, b = 0;
+    for (int i = 0; i < 3; i++) {
+        r += colors[i].r * results[i];
+        g += colors[i].g * results[i];
+        b += colors[i].b * results[i];
+    }
+    return (Color){(unsigned char)(r / total), (unsigned char)(g / total), (unsigned char)(b / total), 255};
+}
+
+// Statistics screen: text from the HUD cache, bars and heatmap straight from
+// the aggregates; nothing here reads the history log
+void stats_screen_render(GameState state) {
+    const StatsAggregates* history = &state.stats.history;
+    const HudState* hud = &state.ui.hud;
+    const int font_size = 18;
+    int width = 620;
+    int height = 420;
+    int x = (state.system.screen_width - width) / 2;
+    int y = (state.system.screen_height - height) / 2;
+    DrawRectangle(x, y, width, height, (Color){0, 0, 0, 220});
+    DrawRectangleLinesEx((Rectangle){(float)x, (float)y, (float)width, (float)height}, 2.0f, WORDLE_BORDER);
+    
+    DrawText("STATISTICS", x + 20, y + 16, 28, WORDLE_WHITE);
+    DrawText("F2 to close", x + width - 120, y + 24, 16, WORDLE_GRAY);
+    DrawText(hud->stats_levels_text, x + 20, y + 60, font_size, WORDLE_WHITE);
+    DrawText(hud->stats_average_text, x + 20, y + 88, font_size, WORDLE_WHITE);
+    DrawText(hud->stats_percentile_text, x + 20, y + 116, font_size, WORDLE_WHITE);
+    
+    // Guesses-per-level distribution, scaled to the fullest bucket
+    int bars_y = y + 250;
+    int bar_width = (width - 40) / STATS_GUESS_BUCKETS;
+    uint32_t peak = 1;
+    for (int bucket = 0; bucket < STATS_GUESS_BUCKETS; bucket++) {
+        if (history->guess_histogram[bucket] > peak) peak = history->guess_histogram[bucket];
+    }
+    DrawText("Guesses per level", x + 20, y + 150, 16, WORDLE_YELLOW);
+    for (int bucket = 0; bucket < STATS_GUESS_BUCKETS; bucket++) {
+        int bar_height = (int)((int64_t)history->guess_histogram[bucket] * 70 / peak);
+        if (bar_height > 0) {
+            DrawRectangle(x + 20 + bucket * bar_width, bars_y - bar_height, bar_width - 2, bar_height, WORDLE_GREEN);
+        }
+    }
+    DrawText("1", x + 20, bars_y + 4, 14, WORDLE_GRAY);
+    DrawText("32+", x + 20 + (STATS_GUESS_BUCKETS - 1) * bar_width - 8, bars_y + 4, 14, WORDLE_GRAY);
+    
+    // Per-letter accuracy heatmap
+    DrawText("Letter accuracy", x + 20, y + 280, 16, WORDLE_YELLOW);
+    int cell = 40;
+    for (int letter = 0; letter < TOKEN_LETTER_COUNT; letter++) {
+        int cell_x = x + 20 + (letter % 13) * (cell + 4);
+        int cell_y = y + 306 + (letter / 13) * (cell + 4);
+        char label[2] = {(char)('A' + letter), '\0'};
+        DrawRectangle(cell_x, cell_y, cell, cell, letter_accuracy_color(history->letter_results[letter]));
+        DrawText(label, cell_x + (cell - MeasureText(label, 20)) / 2, cell_y + 10, 20, WORDLE_WHITE);
+    }
+}
+
+void render_shutdown(void) {
+    if (keyboard_texture_loaded) {
+        UnloadRenderTexture(keyboard_texture);
+        keyboard_texture_loaded = 0;
+    }
+}
+
 void render_system(GameState state) {
     ClearBackground(WORDLE_BG);
     
@@ -862,10 +1200,16 @@ void render_system(GameState state) {
         home_screen_render_system(state);
     } else if (state.current_view == VIEW_WORDLE) {
         board_render_system(state);
+        keyboard_render_system(state);
         ui_render_system(state);
     } else if (state.current_view == VIEW_CROSSWORD) {
         crossword_render_system(state);
+        keyboard_render_system(state);
     } else if (state.current_view == VIEW_CROSSWORD_COMPLETE) {
         crossword_completion_render_system(state);
     }
+    
+    if (state.system.show_stats) {
+        stats_screen_render(state);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <sched.h>
+#include "systems.h"
+#include "crosswordle.h"
+#include "render_snapshot.h"
+
+// Triple buffer handover. `middle` holds the index of the slot in transit
+// plus a flag saying the producer put it there and the consumer has not taken
+// it yet. The producer swaps its freshly written slot in; the consumer swaps
+// its old slot in only when the flag is set. The acq_rel exchanges order the
+// slot contents with the handover in both directions.
+
+#define RENDER_SNAPSHOT_FRESH 0x4u
+#define RENDER_SNAPSHOT_INDEX 0x3u
+
+_Static_assert(RENDER_SNAPSHOT_MAX_MARKS >= LATENCY_MAX_MARKS, "one tick's marks must fit the marks awaiting a frame");
+
+void render_snapshot_init(RenderSnapshotBuffer* buffer, const GameState* state) {
+    for (int i = 0; i < 3; i++) {
+        buffer->slots[i].sequence = 0;
+        buffer->slots[i].state = *state;
+        buffer->slots[i].mark_count = 0;
+    }
+    atomic_store(&buffer->middle, 1u);
+    atomic_store(&buffer->latest_sequence, 0);
+    atomic_store(&buffer->acquired_sequence, 0);
+    buffer->back = 2;
+    buffer->published = 0;
+    buffer->pending_count = 0;
+    buffer->front = 0;
+}
+
+uint64_t render_snapshot_publish(RenderSnapshotBuffer* buffer, const GameState* state) {
+    uint64_t sequence = buffer->published + 1;
+
+    // Marks the renderer has taken a snapshot for are done; this tick's join
+    // whatever is still waiting for a frame
+    uint64_t acquired = atomic_load_explicit(&buffer->acquired_sequence, memory_order_acquire);
+    int kept = 0;
+    for (int i = 0; i < buffer->pending_count; i++) {
+        if (buffer->pending_sequence[i] > acquired) {
+            buffer->pending[kept] = buffer->pending[i];
+            buffer->pending_sequence[kept] = buffer->pending_sequence[i];
+            kept++;
+        }
+    }
+    for (int i = 0; i < state->system.latency_mark_count; i++) {
+        if (kept == RENDER_SNAPSHOT_MAX_MARKS) {
+            memmove(buffer->pending, buffer->pending + 1, sizeof(LatencyMark) * (RENDER_SNAPSHOT_MAX_MARKS - 1));
+            memmove(buffer->pending_sequence, buffer->pending_sequence + 1,
+                    sizeof(uint64_t) * (RENDER_SNAPSHOT_MAX_MARKS - 1));
+            kept--;
+        }
+        buffer->pending[kept] = state->system.latency_marks[i];
+        buffer->pending_sequence[kept] = sequence;
+        kept++;
+    }
+    buffer->pending_count = kept;
+
+    RenderSnapshot* slot = &buffer->slots[buffer->back];
+    slot->sequence = sequence;
+    slot->state = *state;
+    slot->mark_count = kept;
+    memcpy(slot->marks, buffer->pending, sizeof(LatencyMark) * (size_t)kept);
+    memcpy(slot->mark_sequence, buffer->pending_sequence, sizeof(uint64_t) * (size_t)kept);
+
+    uint32_t previous = atomic_exchange_explicit(&buffer->middle, buffer->back | RENDER_SNAPSHOT_FRESH,
+                                                 memory_order_acq_rel);
+    buffer->back = previous & RENDER_SNAPSHOT_INDEX;
+    buffer->published = sequence;
+    atomic_store_explicit(&buffer->latest_sequence, sequence, memory_order_release);
+    return sequence;
+}
+
+const RenderSnapshot* render_snapshot_acquire(RenderSnapshotBuffer* buffer) {
+    if (atomic_load_explicit(&buffer->middle, memory_order_relaxed) & RENDER_SNAPSHOT_FRESH) {
+        uint32_t previous = atomic_exchange_explicit(&buffer->middle, buffer->front, memory_order_acq_rel);
+        buffer->front = previous & RENDER_SNAPSHOT_INDEX;
+        atomic_store_explicit(&buffer->acquired_sequence, buffer->slots[buffer->front].sequence,
+                              memory_order_release);
+    }
+    return &buffer->slots[buffer->front];
+}
+
+void render_snapshot_close_marks(const RenderSnapshot* snapshot, uint64_t presented,
+                                 LatencyHistograms* histograms, double present_time) {
+    for (int i = 0; i < snapshot->mark_count; i++) {
+        if (snapshot->mark_sequence[i] > presented) {
+            const LatencyMark* mark = &snapshot->marks[i];
+            latency_record(histograms, (GameAction)mark->action, present_time - mark->time);
+        }
+    }
+}
+
+// A tick takes microseconds, so a short yield loop beats sleeping on a
+// condition variable the producer would then have to signal every tick
+int render_snapshot_wait(RenderSnapshotBuffer* buffer, uint64_t sequence, double timeout) {
+    double deadline = crosswordle_clock() + timeout;
+    while (atomic_load_explicit(&buffer->latest_sequence, memory_order_acquire) < sequence) {
+        if (crosswordle_clock() >= deadline) {
+            return 0;
+        }
+        sched_yield();
+    }
+    return 1;
+}
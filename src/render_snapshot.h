@@ -0,0 +1,57 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <stdatomic.h>
+#include "types.h"
+
+// Render snapshots: a lock-free triple buffer of GameState
+//
+// One thread ticks the game and publishes a copy of the state after every
+// tick; another renders the newest copy. Each side owns one slot and the
+// third is handed over with a single atomic exchange, so neither side ever
+// waits for the other and a snapshot never changes while it is drawn. If the
+// renderer falls behind, snapshots it never saw are replaced by newer ones.
+// Latency marks stay with the producer until the renderer has taken a snapshot
+// as new as them, so every action is still measured on the first frame that
+// shows it.
+
+#define RENDER_SNAPSHOT_MAX_MARKS 64    // Marks awaiting a frame; past this the oldest are dropped
+
+typedef struct {
+    uint64_t sequence;      // Publish count: 1 for the first tick, 0 for the initial state
+    GameState state;
+    int mark_count;         // Marks not yet taken by the renderer when this was published
+    LatencyMark marks[RENDER_SNAPSHOT_MAX_MARKS];
+    uint64_t mark_sequence[RENDER_SNAPSHOT_MAX_MARKS];  // Snapshot whose tick made each mark
+} RenderSnapshot;
+
+typedef struct {
+    RenderSnapshot slots[3];
+    _Atomic uint32_t middle;            // Slot being handed over, | RENDER_SNAPSHOT_FRESH if unread
+    _Atomic uint64_t latest_sequence;   // Sequence of the newest published snapshot
+    _Atomic uint64_t acquired_sequence; // Sequence of the renderer's current snapshot
+    // Producer side
+    uint32_t back;
+    uint64_t published;
+    int pending_count;
+    LatencyMark pending[RENDER_SNAPSHOT_MAX_MARKS];
+    uint64_t pending_sequence[RENDER_SNAPSHOT_MAX_MARKS];
+    // Consumer side
+    uint32_t front;
+} RenderSnapshotBuffer;
+
+// Every slot starts as a copy of `state` (sequence 0)
+void render_snapshot_init(RenderSnapshotBuffer* buffer, const GameState* state);
+// Producer: copies state into a snapshot and makes it the newest. Returns its sequence.
+uint64_t render_snapshot_publish(RenderSnapshotBuffer* buffer, const GameState* state);
+// Consumer: the newest snapshot; it stays valid and unchanged until the next acquire
+const RenderSnapshot* render_snapshot_acquire(RenderSnapshotBuffer* buffer);
+// Consumer: waits up to timeout seconds for `sequence` to be published.
+// Returns 1 if it was.
+int render_snapshot_wait(RenderSnapshotBuffer* buffer, uint64_t sequence, double timeout);
+// Consumer: once a frame showing `snapshot` is presented, records the marks
+// it shows first; `presented` is the sequence of the snapshot shown before it
+void render_snapshot_close_marks(const RenderSnapshot* snapshot, uint64_t presented,
+                                 LatencyHistograms* histograms, double present_time);
+
+#endif
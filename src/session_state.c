@@ -0,0 +1,462 @@
+#include "systems.h"
+
+// Packed per-session state.
+//
+// SessionState keeps the play-relevant part of a GameState in 248 bytes so a
+// host can hold a million idle sessions in memory:
+//   - words as 5 bits per letter, first letter lowest (length-independent)
+//   - the level's guesses as a bit stream of records: 5 bits per letter, then
+//     the guess's feedback_code (7-12 bits for 4-7 letters)
+//   - token balances as bytes
+//   - crossword progress as bit planes over the puzzle's word cells, taken in
+//     the same x-then-y order the systems scan the grid
+// Derived fields are recomputed on unpack: word_validated (a cell is validated
+// once it has a letter state), token_need, the hard-mode constraints (from the
+// recorded guesses), the revealed guess's letter states and the HUD.
+// Presentation state (timers, particles, camera) starts fresh, and the token
+// ledger restarts with the balances as its opening earnings.
+
+// flags
+#define SESSION_WORD_LENGTH_SHIFT 0            // 3 bits
+#define SESSION_PLAY_STATE_SHIFT 3             // 2 bits, GamePlayState
+#define SESSION_LEVEL_COMPLETE_SHIFT 5
+#define SESSION_VIEW_SHIFT 6                   // 2 bits, GameViewState
+#define SESSION_SOUND_SHIFT 8
+#define SESSION_ANIMATIONS_SHIFT 9
+#define SESSION_HARD_MODE_SHIFT 10
+#define SESSION_COLOR_BLIND_SHIFT 11
+#define SESSION_SHOW_BAG_SHIFT 12
+#define SESSION_WORD_LETTERS_SHIFT 13          // 3 bits, letters in `word`
+#define SESSION_WORD_PENDING_SHIFT 16          // `word` is the guess being revealed
+#define SESSION_WORD_COMPLETE_SHIFT 17
+#define SESSION_SHOULD_SUBMIT_SHIFT 18
+#define SESSION_GUESS_COUNT_SHIFT 19           // 5 bits, records in `history`
+#define SESSION_HISTORY_LENGTH_SHIFT 24        // 3 bits, letters per record
+#define SESSION_DAILY_SHIFT 27                 // Target is the daily word of the crossword's day
+
+// crossword_level: the level number, or the day of a daily puzzle
+#define SESSION_DAILY_CROSSWORD 0x8000u
+
+// crossword_flags
+#define SESSION_CURSOR_X_SHIFT 0               // 4 bits
+#define SESSION_CURSOR_Y_SHIFT 4               // 4 bits
+#define SESSION_DIRECTION_SHIFT 8
+#define SESSION_WORD_INDEX_SHIFT 9             // 4 bits
+#define SESSION_COMPLETED_SHIFT 13
+#define SESSION_SHOULD_VALIDATE_SHIFT 14
+
+_Static_assert(sizeof(SessionState) < 256, "SessionState must stay under 256 bytes");
+
+// Bits of a feedback_code for each word length (ceil(log2(3^length)))
+static const int FEEDBACK_CODE_BITS[MAX_WORD_LENGTH + 1] = {0, 2, 4, 5, 7, 8, 10, 12};
+
+static uint32_t get_field(uint32_t flags, int shift, int bits) {
+    return (flags >> shift) & ((1u << bits) - 1u);
+}
+
+static uint32_t put_field(uint32_t value, int shift) {
+    return value << shift;
+}
+
+static int record_bits(int word_length) {
+    return word_length * PACKED_LETTER_BITS + FEEDBACK_CODE_BITS[word_length];
+}
+
+static void put_bits(uint8_t* buffer, int bit, uint32_t value, int count) {
+    for (int i = 0; i < count; i++, bit++) {
+        if ((value >> i) & 1u) {
+            buffer[bit >> 3] |= (uint8_t)(1u << (bit & 7));
+        }
+    }
+}
+
+static uint32_t get_bits(const uint8_t* buffer, int bit, int count) {
+    uint32_t value = 0;
+    for (int i = 0; i < count; i++, bit++) {
+        value |= (uint32_t)((buffer[bit >> 3] >> (bit & 7)) & 1u) << i;
+    }
+    return value;
+}
+
+// Packs up to MAX_WORD_LENGTH letters A-Z; returns the count, or -1 if the word
+// holds anything else
+static int pack_letters(const char* word, uint64_t* out_packed) {
+    uint64_t packed = 0;
+    int count = 0;
+    for (; word[count] != '\0'; count++) {
+        if (count == MAX_WORD_LENGTH || word[count] < 'A' || word[count] > 'Z') {
+            return -1;
+        }
+        packed |= (uint64_t)(word[count] - 'A' + 1) << (PACKED_LETTER_BITS * count);
+    }
+    *out_packed = packed;
+    return count;
+}
+
+static int unpack_letters(uint64_t packed, char* out_word) {
+    int count = 0;
+    while (count < MAX_WORD_LENGTH && (packed & PACKED_LETTER_MASK) != 0) {
+        out_word[count++] = (char)('A' - 1 + (packed & PACKED_LETTER_MASK));
+        packed >>= PACKED_LETTER_BITS;
+    }
+    out_word[count] = '\0';
+    return count;
+}
+
+static void decode_feedback(uint32_t code, int word_length, LetterState* out_states) {
+    for (int i = 0; i < word_length; i++) {
+        out_states[i] = (LetterState)(LETTER_CORRECT + code % 3);
+        code /= 3;
+    }
+}
+
+static void write_record(SessionState* session, int index, int word_length, const char* word, const LetterState* states) {
+    int bit = index * record_bits(word_length);
+    for (int i = 0; i < word_length; i++) {
+        put_bits(session->history, bit, (uint32_t)(word[i] - 'A' + 1), PACKED_LETTER_BITS);
+        bit += PACKED_LETTER_BITS;
+    }
+    put_bits(session->history, bit, feedback_code(states, word_length), FEEDBACK_CODE_BITS[word_length]);
+}
+
+static void read_record(const SessionState* session, int index, int word_length, char* out_word, LetterState* out_states) {
+    int bit = index * record_bits(word_length);
+    for (int i = 0; i < word_length; i++) {
+        out_word[i] = (char)('A' - 1 + get_bits(session->history, bit, PACKED_LETTER_BITS));
+        bit += PACKED_LETTER_BITS;
+    }
+    out_word[word_length] = '\0';
+    decode_feedback(get_bits(session->history, bit, FEEDBACK_CODE_BITS[word_length]), word_length, out_states);
+}
+
+static int fits_u16(int value) {
+    return value >= 0 && value <= UINT16_MAX;
+}
+
+// Packs the play-relevant state. Returns 0 (and leaves out_session unspecified)
+// if a value does not fit the packed ranges, e.g. more than 255 of one token,
+// or the play is themed: themes are the loaded categories, not session data.
+int session_state_pack(const GameState* state, SessionState* out_session) {
+    SessionState session;
+    memset(&session, 0, sizeof(session));
+    const CoreGameState* core = &state->core;
+    const GameStatsState* stats = &state->stats;
+    const CrosswordState* crossword = &state->crossword;
+
+    if (!is_supported_word_length(core->word_length) || !fits_u16(core->current_level) ||
+        !fits_u16(core->guesses_this_level) || !fits_u16(stats->levels_completed) ||
+        !fits_u16(stats->current_level_streak) || !fits_u16(stats->max_level_streak) ||
+        !fits_u16(stats->best_level_score) ||
+        crossword->current_level.level < 0 || crossword->current_level.level >= (int)SESSION_DAILY_CROSSWORD ||
+        crossword->current_level.day < 0 || crossword->current_level.day >= (int)SESSION_DAILY_CROSSWORD ||
+        (core->daily_day != 0 && core->daily_day != crossword->current_level.day) ||
+        core->theme != 0 || crossword->current_level.categories != 0 ||
+        core->total_lifetime_guesses < 0 || stats->total_guesses < 0 ||
+        pack_letters(core->target_word, &session.target) < 0) {
+        return 0;
+    }
+
+    // The guess being revealed and the typed input never coexist: submitting
+    // clears the input
+    int pending = core->play_state == GAME_STATE_SHOWING_RESULT;
+    int word_letters = pack_letters(pending ? state->history.current_guess : state->input.current_word, &session.word);
+    if (word_letters < 0) {
+        return 0;
+    }
+
+    int guess_count = state->history.level_guess_count;
+    int history_length = guess_count > 0 ? (int)strlen(state->history.level_guesses[0]) : core->word_length;
+    if (guess_count < 0 || guess_count > MAX_RECENT_GUESSES || !is_supported_word_length(history_length)) {
+        return 0;
+    }
+    for (int g = 0; g < guess_count; g++) {
+        uint64_t unused;
+        if (pack_letters(state->history.level_guesses[g], &unused) != history_length) {
+            return 0;
+        }
+        write_record(&session, g, history_length, state->history.level_guesses[g], state->history.level_letter_states[g]);
+    }
+
+    session.flags =
+        put_field((uint32_t)core->word_length, SESSION_WORD_LENGTH_SHIFT) |
+        put_field((uint32_t)core->play_state, SESSION_PLAY_STATE_SHIFT) |
+        put_field(core->level_complete != 0, SESSION_LEVEL_COMPLETE_SHIFT) |
+        put_field((uint32_t)state->current_view, SESSION_VIEW_SHIFT) |
+        put_field(state->settings.sound_enabled != 0, SESSION_SOUND_SHIFT) |
+        put_field(state->settings.animations_enabled != 0, SESSION_ANIMATIONS_SHIFT) |
+        put_field(state->settings.hard_mode != 0, SESSION_HARD_MODE_SHIFT) |
+        put_field(state->settings.color_blind_mode != 0, SESSION_COLOR_BLIND_SHIFT) |
+        put_field(stats->show_letter_bag != 0, SESSION_SHOW_BAG_SHIFT) |
+        put_field((uint32_t)word_letters, SESSION_WORD_LETTERS_SHIFT) |
+        put_field((uint32_t)pending, SESSION_WORD_PENDING_SHIFT) |
+        put_field(state->input.word_complete != 0, SESSION_WORD_COMPLETE_SHIFT) |
+        put_field(state->input.should_submit != 0, SESSION_SHOULD_SUBMIT_SHIFT) |
+        put_field((uint32_t)guess_count, SESSION_GUESS_COUNT_SHIFT) |
+        put_field((uint32_t)history_length, SESSION_HISTORY_LENGTH_SHIFT) |
+        put_field(core->daily_day != 0, SESSION_DAILY_SHIFT);
+
+    session.total_lifetime_guesses = (uint32_t)core->total_lifetime_guesses;
+    session.total_guesses = (uint32_t)stats->total_guesses;
+    session.average_guesses_per_level = stats->average_guesses_per_level;
+    session.level = (uint16_t)core->current_level;
+    session.guesses_this_level = (uint16_t)core->guesses_this_level;
+    session.levels_completed = (uint16_t)stats->levels_completed;
+    session.current_level_streak = (uint16_t)stats->current_level_streak;
+    session.max_level_streak = (uint16_t)stats->max_level_streak;
+    session.best_level_score = (uint16_t)stats->best_level_score;
+
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        int balance = stats->tokens.balance[i];
+        if (balance < 0 || balance > UINT8_MAX) {
+            return 0;
+        }
+        session.tokens[i] = (uint8_t)balance;
+    }
+
+    session.crossword_level = crossword->current_level.day
+        ? (uint16_t)(SESSION_DAILY_CROSSWORD | (uint32_t)crossword->current_level.day)
+        : (uint16_t)crossword->current_level.level;
+    session.crossword_flags = (uint16_t)(
+        put_field((uint32_t)crossword->cursor_x, SESSION_CURSOR_X_SHIFT) |
+        put_field((uint32_t)crossword->cursor_y, SESSION_CURSOR_Y_SHIFT) |
+        put_field(crossword->cursor_direction != 0, SESSION_DIRECTION_SHIFT) |
+        put_field((uint32_t)crossword->current_word_index, SESSION_WORD_INDEX_SHIFT) |
+        put_field(crossword->puzzle_completed != 0, SESSION_COMPLETED_SHIFT) |
+        put_field(crossword->should_validate != 0, SESSION_SHOULD_VALIDATE_SHIFT));
+
+    int cell = 0;
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 9; y++) {
+            if (!crossword->current_level.word_mask[x][y]) {
+                continue;
+            }
+            char letter = crossword->grid[x][y];
+            if (cell == SESSION_MAX_CROSSWORD_CELLS || (letter != '\0' && (letter < 'A' || letter > 'Z'))) {
+                return 0;
+            }
+            uint32_t letter_value = letter ? (uint32_t)(letter - 'A' + 1) : 0;
+            uint32_t state_value = (uint32_t)crossword->letter_states[x][y];
+            for (int plane = 0; plane < 5; plane++) {
+                session.cell_letters[plane] |= (uint64_t)((letter_value >> plane) & 1u) << cell;
+            }
+            for (int plane = 0; plane < 2; plane++) {
+                session.cell_states[plane] |= (uint64_t)((state_value >> plane) & 1u) << cell;
+            }
+            cell++;
+        }
+    }
+
+    *out_session = session;
+    return 1;
+}
+
+GameState session_state_unpack(const SessionState* session) {
+    GameState state = create_game_state("");
+    uint32_t flags = session->flags;
+
+    unpack_letters(session->target, state.core.target_word);
+    state.core.word_length = (int)get_field(flags, SESSION_WORD_LENGTH_SHIFT, 3);
+    state.core.current_level = session->level;
+    state.core.guesses_this_level = session->guesses_this_level;
+    state.core.total_lifetime_guesses = (int)session->total_lifetime_guesses;
+    state.core.play_state = (GamePlayState)get_field(flags, SESSION_PLAY_STATE_SHIFT, 2);
+    state.core.level_complete = (int)get_field(flags, SESSION_LEVEL_COMPLETE_SHIFT, 1);
+    state.current_view = (GameViewState)get_field(flags, SESSION_VIEW_SHIFT, 2);
+
+    state.settings.sound_enabled = (int)get_field(flags, SESSION_SOUND_SHIFT, 1);
+    state.settings.animations_enabled = (int)get_field(flags, SESSION_ANIMATIONS_SHIFT, 1);
+    state.settings.hard_mode = (int)get_field(flags, SESSION_HARD_MODE_SHIFT, 1);
+    state.settings.color_blind_mode = (int)get_field(flags, SESSION_COLOR_BLIND_SHIFT, 1);
+
+    state.stats.levels_completed = session->levels_completed;
+    state.stats.current_level_streak = session->current_level_streak;
+    state.stats.max_level_streak = session->max_level_streak;
+    state.stats.total_guesses = (int)session->total_guesses;
+    state.stats.average_guesses_per_level = session->average_guesses_per_level;
+    state.stats.best_level_score = session->best_level_score;
+    state.stats.show_letter_bag = (int)get_field(flags, SESSION_SHOW_BAG_SHIFT, 1);
+
+    // Balances come back as the ledger's opening earnings
+    TokenTransaction opening = token_transaction(TOKEN_TX_GRANT);
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        token_transaction_add(&opening, (char)('A' + i), session->tokens[i]);
+    }
+    token_ledger_commit(&state.stats.tokens, &opening);
+
+    int guess_count = (int)get_field(flags, SESSION_GUESS_COUNT_SHIFT, 5);
+    int history_length = (int)get_field(flags, SESSION_HISTORY_LENGTH_SHIFT, 3);
+    for (int g = 0; g < guess_count; g++) {
+        read_record(session, g, history_length, state.history.level_guesses[g], state.history.level_letter_states[g]);
+        guess_constraints_update(&state.history.constraints, state.history.level_guesses[g],
+                                 state.history.level_letter_states[g], history_length);
+        keyboard_state_update(&state.history.keyboard, state.history.level_guesses[g],
+                              state.history.level_letter_states[g], history_length);
+    }
+    state.history.level_guess_count = guess_count;
+
+    char word[MAX_WORD_LENGTH + 1];
+    int word_letters = unpack_letters(session->word, word);
+    if (get_field(flags, SESSION_WORD_PENDING_SHIFT, 1)) {
+        // Replay the reveal of the submitted guess
+        strcpy(state.history.current_guess, word);
+        get_word_kernels(state.core.word_length)->score_guess(word, state.core.target_word, state.history.current_guess_states);
+        if (state.settings.animations_enabled) {
+            state.ui.letter_revealing = 1;
+            state.ui.letter_reveal_timer = 0.0f;
+        } else {
+            complete_word_validation(&state);
+        }
+    } else {
+        strcpy(state.input.current_word, word);
+        state.input.current_letter_pos = word_letters;
+        if (guess_count > 0) {
+            strcpy(state.history.current_guess, state.history.level_guesses[guess_count - 1]);
+            memcpy(state.history.current_guess_states, state.history.level_letter_states[guess_count - 1],
+                   sizeof(state.history.current_guess_states));
+        }
+    }
+    state.input.word_complete = (int)get_field(flags, SESSION_WORD_COMPLETE_SHIFT, 1);
+    state.input.should_submit = (int)get_field(flags, SESSION_SHOULD_SUBMIT_SHIFT, 1);
+
+    CrosswordState* crossword = &state.crossword;
+    uint32_t crossword_flags = session->crossword_flags;
+    if (session->crossword_level & SESSION_DAILY_CROSSWORD) {
+        crossword->current_level = get_daily_crossword_level(session->crossword_level & ~SESSION_DAILY_CROSSWORD);
+    } else {
+        crossword->current_level = get_crossword_level(session->crossword_level);
+    }
+    if (get_field(flags, SESSION_DAILY_SHIFT, 1)) {
+        state.core.daily_day = crossword->current_level.day;
+    }
+    crossword->cursor_x = (int)get_field(crossword_flags, SESSION_CURSOR_X_SHIFT, 4);
+    crossword->cursor_y = (int)get_field(crossword_flags, SESSION_CURSOR_Y_SHIFT, 4);
+    crossword->cursor_direction = (int)get_field(crossword_flags, SESSION_DIRECTION_SHIFT, 1);
+    crossword->current_word_index = (int)get_field(crossword_flags, SESSION_WORD_INDEX_SHIFT, 4);
+    crossword->puzzle_completed = (int)get_field(crossword_flags, SESSION_COMPLETED_SHIFT, 1);
+    crossword->should_validate = (int)get_field(crossword_flags, SESSION_SHOULD_VALIDATE_SHIFT, 1);
+
+    int cell = 0;
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 9; y++) {
+            if (!crossword->current_level.word_mask[x][y] || cell == SESSION_MAX_CROSSWORD_CELLS) {
+                continue;
+            }
+            uint32_t letter_value = 0;
+            uint32_t state_value = 0;
+            for (int plane = 0; plane < 5; plane++) {
+                letter_value |= (uint32_t)((session->cell_letters[plane] >> cell) & 1u) << plane;
+            }
+            for (int plane = 0; plane < 2; plane++) {
+                state_value |= (uint32_t)((session->cell_states[plane] >> cell) & 1u) << plane;
+            }
+            crossword->grid[x][y] = letter_value ? (char)('A' - 1 + letter_value) : '\0';
+            crossword->letter_states[x][y] = (LetterState)state_value;
+            crossword->word_validated[x][y] = state_value != LETTER_UNKNOWN;
+            cell++;
+        }
+    }
+    crossword_token_need_reset(crossword);
+    return state;
+}
+
+// ============= HEADLESS PLAY ON PACKED STATE =============
+
+// A new game in the Wordle view at level 1, as if started from the home screen
+void session_state_init(SessionState* session, int word_length, const char* target) {
+    GameState state = create_game_state(target);
+    state.core.word_length = word_length;
+    state.current_view = VIEW_WORDLE;
+    session_state_pack(&state, session);
+}
+
+int session_state_word_length(const SessionState* session) {
+    return (int)get_field(session->flags, SESSION_WORD_LENGTH_SHIFT, 3);
+}
+
+GamePlayState session_state_play_state(const SessionState* session) {
+    return (GamePlayState)get_field(session->flags, SESSION_PLAY_STATE_SHIFT, 2);
+}
+
+void session_state_target(const SessionState* session, char* out_word) {
+    unpack_letters(session->target, out_word);
+}
+
+static void set_field(uint32_t* flags, int shift, int bits, uint32_t value) {
+    uint32_t mask = ((1u << bits) - 1u) << shift;
+    *flags = (*flags & ~mask) | ((value << shift) & mask);
+}
+
+static uint16_t saturating_increment(uint16_t value) {
+    return value < UINT16_MAX ? (uint16_t)(value + 1) : value;
+}
+
+// Submits a guess of the session's length, with the same bookkeeping as
+// complete_word_validation. award_index picks the letter awarded on a solve
+// (the game uses rand()). Returns 1 if solved, 0 if not, -1 if the session is
+// not waiting for a guess.
+int session_state_guess(SessionState* session, const char* guess, LetterState* out_states, int award_index) {
+    if (session_state_play_state(session) != GAME_STATE_INPUT) {
+        return -1;
+    }
+    int word_length = session_state_word_length(session);
+    const WordKernels* kernels = get_word_kernels(word_length);
+    char target[MAX_WORD_LENGTH + 1];
+    unpack_letters(session->target, target);
+    kernels->score_guess(guess, target, out_states);
+
+    session->guesses_this_level = saturating_increment(session->guesses_this_level);
+    session->total_lifetime_guesses++;
+    session->total_guesses++;
+
+    int guess_count = (int)get_field(session->flags, SESSION_GUESS_COUNT_SHIFT, 5);
+    if (guess_count < MAX_RECENT_GUESSES) {
+        if (guess_count == 0) {
+            memset(session->history, 0, sizeof(session->history));
+            set_field(&session->flags, SESSION_HISTORY_LENGTH_SHIFT, 3, (uint32_t)word_length);
+        }
+        write_record(session, guess_count, word_length, guess, out_states);
+        set_field(&session->flags, SESSION_GUESS_COUNT_SHIFT, 5, (uint32_t)guess_count + 1);
+    }
+
+    // Submitting clears the input
+    session->word = 0;
+    set_field(&session->flags, SESSION_WORD_LETTERS_SHIFT, 3, 0);
+    set_field(&session->flags, SESSION_WORD_COMPLETE_SHIFT, 1, 0);
+    set_field(&session->flags, SESSION_SHOULD_SUBMIT_SHIFT, 1, 0);
+
+    if (!kernels->words_match(guess, target)) {
+        return 0;
+    }
+
+    uint8_t* tokens = &session->tokens[target[award_index % word_length] - 'A'];
+    if (*tokens < UINT8_MAX) {
+        (*tokens)++;
+    }
+    session->levels_completed = saturating_increment(session->levels_completed);
+    session->current_level_streak = saturating_increment(session->current_level_streak);
+    if (session->current_level_streak > session->max_level_streak) {
+        session->max_level_streak = session->current_level_streak;
+    }
+    if (session->guesses_this_level < session->best_level_score) {
+        session->best_level_score = session->guesses_this_level;
+    }
+    session->average_guesses_per_level = (float)session->total_guesses / (float)session->levels_completed;
+    set_field(&session->flags, SESSION_LEVEL_COMPLETE_SHIFT, 1, 1);
+    set_field(&session->flags, SESSION_PLAY_STATE_SHIFT, 2, GAME_STATE_LEVEL_COMPLETE);
+    return 1;
+}
+
+// Moves a solved session to the next level with a new target, as
+// new_level_system does. Returns 0 if the level is not complete.
+int session_state_next_level(SessionState* session, const char* target) {
+    if (session_state_play_state(session) != GAME_STATE_LEVEL_COMPLETE) {
+        return 0;
+    }
+    pack_letters(target, &session->target);
+    session->level = saturating_increment(session->level);
+    session->guesses_this_level = 0;
+    set_field(&session->flags, SESSION_LEVEL_COMPLETE_SHIFT, 1, 0);
+    set_field(&session->flags, SESSION_PLAY_STATE_SHIFT, 2, GAME_STATE_INPUT);
+    set_field(&session->flags, SESSION_GUESS_COUNT_SHIFT, 5, 0);
+    return 1;
+}
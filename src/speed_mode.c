@@ -0,0 +1,125 @@
+#include "systems.h"
+#include "speed_mode.h"
+
+// Timed speed mode. Every split is the difference of two readings of the
+// platform's monotonic clock (InputEvent.time), so timers cannot drift the way
+// summing frame_time would. The clock is read once per frame, when that frame's
+// queued keys are drained: raylib does not timestamp key events, so a key
+// pressed during a stalled frame is timed from when the stall ended, and the
+// stall counts toward its split. The run clock only runs while a level is being
+// played; the time between solving a level and starting the next is left out.
+// Splits go into a fixed ring; the HUD only reformats its timers when a
+// displayed tenth changes.
+
+static uint32_t elapsed_us(double from, double to) {
+    double us = (to - from) * 1000000.0;
+    if (us <= 0.0) {
+        return 0;
+    }
+    return us >= 4294967295.0 ? UINT32_MAX : (uint32_t)(us + 0.5);
+}
+
+void speed_mode_start(SpeedModeState* speed, double now) {
+    uint32_t version = speed->version;
+    memset(speed, 0, sizeof(*speed));
+    speed->active = 1;
+    speed->run_start = now;
+    speed->level_start = now;
+    speed->last_split = now;
+    speed->version = version + 1;
+}
+
+void speed_mode_level_start(SpeedModeState* speed, double now) {
+    if (speed->level_end > 0.0 && now > speed->level_end) {
+        speed->intermission += now - speed->level_end;
+    }
+    speed->level_start = now;
+    speed->last_split = now;
+    speed->level_end = 0.0;
+}
+
+void speed_mode_record_guess(SpeedModeState* speed, double now, int level, int guess, int solved) {
+    SpeedSplit* split = &speed->splits[speed->split_count & (SPEED_SPLIT_RING_SIZE - 1)];
+    split->guess_us = elapsed_us(speed->last_split, now);
+    split->level_us = elapsed_us(speed->level_start, now);
+    split->level = (uint16_t)level;
+    split->guess = (uint8_t)(guess < 255 ? guess : 255);
+    split->flags = solved ? SPEED_SPLIT_SOLVED : 0;
+    speed->split_count++;
+    speed->last_split = now;
+    if (solved) {
+        speed->level_end = now;
+    }
+    speed->last_split_run_us = speed_mode_run_us(speed, now);
+    speed->version++;
+}
+
+uint32_t speed_split_available(const SpeedModeState* speed) {
+    return speed->split_count < SPEED_SPLIT_RING_SIZE ? speed->split_count : SPEED_SPLIT_RING_SIZE;
+}
+
+// index 0 is the oldest split still in the ring
+const SpeedSplit* speed_split_at(const SpeedModeState* speed, uint32_t index) {
+    uint32_t first = speed->split_count - speed_split_available(speed);
+    return &speed->splits[(first + index) & (SPEED_SPLIT_RING_SIZE - 1)];
+}
+
+// Live timers in microseconds: a solved level stops both clocks until the
+// next level starts
+uint32_t speed_mode_level_us(const SpeedModeState* speed, double now) {
+    return elapsed_us(speed->level_start, speed->level_end > 0.0 ? speed->level_end : now);
+}
+
+uint64_t speed_mode_run_us(const SpeedModeState* speed, double now) {
+    double end = speed->level_end > 0.0 && speed->level_end < now ? speed->level_end : now;
+    double played = end - speed->run_start - speed->intermission;
+    return played > 0.0 ? (uint64_t)(played * 1000000.0 + 0.5) : 0;
+}
+
+// ============= EXPORT =============
+
+static SpeedResultsHeader results_header(const GameState* state) {
+    const SpeedModeState* speed = &state->speed;
+    SpeedResultsHeader header = {0};
+    header.magic = SPEED_RESULTS_MAGIC;
+    header.version = SPEED_RESULTS_VERSION;
+    header.split_count = speed_split_available(speed);
+    header.split_total = speed->split_count;
+    header.run_us = speed->last_split_run_us;
+    header.word_length = (uint32_t)state->core.word_length;
+    for (uint32_t i = 0; i < header.split_count; i++) {
+        header.levels_solved += (speed_split_at(speed, i)->flags & SPEED_SPLIT_SOLVED) != 0;
+    }
+    return header;
+}
+
+int speed_mode_write_binary(const GameState* state, const char* path) {
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return 0;
+    }
+    SpeedResultsHeader header = results_header(state);
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    for (uint32_t i = 0; ok && i < header.split_count; i++) {
+        ok = fwrite(speed_split_at(&state->speed, i), sizeof(SpeedSplit), 1, file) == 1;
+    }
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
+
+int speed_mode_write_csv(const GameState* state, const char* path) {
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        return 0;
+    }
+    SpeedResultsHeader header = results_header(state);
+    fprintf(file, "level,guess,guess_ms,level_ms,solved\n");
+    for (uint32_t i = 0; i < header.split_count; i++) {
+        const SpeedSplit* split = speed_split_at(&state->speed, i);
+        fprintf(file, "%u,%u,%.3f,%.3f,%d\n", split->level, split->guess, split->guess_us / 1000.0,
+                split->level_us / 1000.0, (split->flags & SPEED_SPLIT_SOLVED) != 0);
+    }
+    return fclose(file) == 0;
+}
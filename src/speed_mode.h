@@ -0,0 +1,32 @@
+#ifndef SPEED_MODE_H
+#define SPEED_MODE_H
+
+#include "types.h"
+
+// Speed mode results file (.cwspd)
+//
+// Layout (little-endian):
+//   SpeedResultsHeader
+//   SpeedSplit splits[split_count]   oldest first
+//
+// Only the splits still in the ring are written; split_total says how many
+// the run recorded, so a reader can tell when the oldest were overwritten.
+
+#define SPEED_RESULTS_MAGIC 0x44505357u       // "WSPD"
+#define SPEED_RESULTS_VERSION 1u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t split_count;                     // Splits in this file
+    uint32_t split_total;                     // Splits the run recorded
+    uint64_t run_us;                          // Played time, run start to the last split
+    uint32_t levels_solved;
+    uint32_t word_length;
+} SpeedResultsHeader;
+
+// Writes the run's splits. Returns 1 on success.
+int speed_mode_write_binary(const GameState* state, const char* path);
+int speed_mode_write_csv(const GameState* state, const char* path);
+
+#endif
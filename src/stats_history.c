@@ -0,0 +1,184 @@
+#include "systems.h"
+#include "stats_history.h"
+
+// Statistics history. complete_word_validation feeds every guess and every
+// solved level into StatsAggregates, each in O(1): the rolling windows keep
+// running sums and subtract the level leaving the window, and percentiles
+// come from fixed histograms rather than the raw history. The front end
+// appends each solved level to the columnar log.
+
+// ============= AGGREGATES =============
+
+void stats_history_record_guess(StatsAggregates* aggregates, const char* guess, const LetterState* states, int length) {
+    for (int i = 0; i < length; i++) {
+        int letter = guess[i] - 'A';
+        if (letter >= 0 && letter < TOKEN_LETTER_COUNT && states[i] >= LETTER_CORRECT && states[i] <= LETTER_NOT_IN_WORD) {
+            aggregates->letter_results[letter][states[i] - LETTER_CORRECT]++;
+        }
+    }
+    aggregates->version++;
+}
+
+void stats_history_record_level(StatsAggregates* aggregates, const LevelHistoryRecord* record) {
+    uint32_t n = aggregates->levels;
+    if (n >= STATS_WINDOW_SHORT) {
+        aggregates->short_sum -= aggregates->recent_guesses[(n - STATS_WINDOW_SHORT) % STATS_WINDOW_LONG];
+    }
+    if (n >= STATS_WINDOW_LONG) {
+        aggregates->long_sum -= aggregates->recent_guesses[n % STATS_WINDOW_LONG];
+    }
+    aggregates->recent_guesses[n % STATS_WINDOW_LONG] = record->guesses;
+    aggregates->short_sum += record->guesses;
+    aggregates->long_sum += record->guesses;
+    aggregates->total_guesses += record->guesses;
+    aggregates->total_time_ms += record->time_ms;
+
+    int guess_bucket = record->guesses < STATS_GUESS_BUCKETS ? record->guesses : STATS_GUESS_BUCKETS;
+    aggregates->guess_histogram[guess_bucket > 0 ? guess_bucket - 1 : 0]++;
+    uint32_t time_bucket = record->time_ms / STATS_TIME_BUCKET_MS;
+    aggregates->time_histogram[time_bucket < STATS_TIME_BUCKETS ? time_bucket : STATS_TIME_BUCKETS - 1]++;
+
+    aggregates->levels++;
+    aggregates->version++;
+}
+
+// Average guesses per level over the last `window` levels (0 for all of
+// them), in tenths; only STATS_WINDOW_SHORT and STATS_WINDOW_LONG are kept
+int stats_history_average_tenths(const StatsAggregates* aggregates, int window) {
+    uint64_t sum = aggregates->total_guesses;
+    uint32_t count = aggregates->levels;
+    if (window == STATS_WINDOW_SHORT || window == STATS_WINDOW_LONG) {
+        sum = window == STATS_WINDOW_SHORT ? aggregates->short_sum : aggregates->long_sum;
+        count = count < (uint32_t)window ? count : (uint32_t)window;
+    }
+    return count > 0 ? (int)((sum * 10 + count / 2) / count) : 0;
+}
+
+// Bucket index holding the given fraction of the samples
+static int histogram_percentile(const uint32_t* histogram, int bucket_count, uint32_t total, double fraction) {
+    uint32_t rank = (uint32_t)(fraction * (double)total + 0.5);
+    if (rank < 1) rank = 1;
+    uint32_t seen = 0;
+    for (int bucket = 0; bucket < bucket_count - 1; bucket++) {
+        seen += histogram[bucket];
+        if (seen >= rank) {
+            return bucket;
+        }
+    }
+    return bucket_count - 1;
+}
+
+// Guesses (the last bucket reports STATS_GUESS_BUCKETS for "that many or more")
+int stats_history_guess_percentile(const StatsAggregates* aggregates, double fraction) {
+    if (aggregates->levels == 0) {
+        return 0;
+    }
+    return histogram_percentile(aggregates->guess_histogram, STATS_GUESS_BUCKETS, aggregates->levels, fraction) + 1;
+}
+
+// Upper edge of the time bucket, in seconds
+int stats_history_time_percentile_seconds(const StatsAggregates* aggregates, double fraction) {
+    if (aggregates->levels == 0) {
+        return 0;
+    }
+    int bucket = histogram_percentile(aggregates->time_histogram, STATS_TIME_BUCKETS, aggregates->levels, fraction);
+    return (bucket + 1) * (STATS_TIME_BUCKET_MS / 1000);
+}
+
+// ============= LOG =============
+
+static struct {
+    FILE* file;
+    StatsLogHeader header;
+    StatsLogBlock block;        // Last block, as on disk
+} stats_log;
+
+static long block_offset(uint32_t block) {
+    return (long)(stats_log.header.blocks_offset + (uint64_t)block * sizeof(StatsLogBlock));
+}
+
+int stats_log_read_block(uint32_t block, StatsLogBlock* out_block) {
+    return stats_log.file && block < stats_log.header.block_count &&
+           fseek(stats_log.file, block_offset(block), SEEK_SET) == 0 &&
+           fread(out_block, sizeof(*out_block), 1, stats_log.file) == 1 &&
+           out_block->count <= STATS_LOG_BLOCK_LEVELS;
+}
+
+static int write_header(void) {
+    return fseek(stats_log.file, 0, SEEK_SET) == 0 &&
+           fwrite(&stats_log.header, sizeof(stats_log.header), 1, stats_log.file) == 1;
+}
+
+int stats_log_open(const char* path, StatsAggregates* out_aggregates) {
+    stats_log_close();
+    stats_log.file = fopen(path, "r+b");
+    if (!stats_log.file) {
+        stats_log.file = fopen(path, "w+b");
+    }
+    if (!stats_log.file || fseek(stats_log.file, 0, SEEK_END) != 0) {
+        stats_log_close();
+        return 0;
+    }
+
+    StatsLogHeader* header = &stats_log.header;
+    int ok;
+    if (ftell(stats_log.file) == 0) {
+        header->magic = STATS_LOG_MAGIC;
+        header->version = STATS_LOG_VERSION;
+        header->block_levels = STATS_LOG_BLOCK_LEVELS;
+        header->blocks_offset = sizeof(StatsLogHeader);
+        ok = write_header() && fflush(stats_log.file) == 0;
+    } else {
+        ok = fseek(stats_log.file, 0, SEEK_SET) == 0 &&
+             fread(header, sizeof(*header), 1, stats_log.file) == 1 &&
+             header->magic == STATS_LOG_MAGIC &&
+             header->version == STATS_LOG_VERSION &&
+             header->block_levels == STATS_LOG_BLOCK_LEVELS &&
+             header->blocks_offset == sizeof(StatsLogHeader) &&
+             header->level_count <= (uint64_t)header->block_count * STATS_LOG_BLOCK_LEVELS &&
+             (header->block_count == 0 || stats_log_read_block(header->block_count - 1, &stats_log.block));
+    }
+    if (!ok) {
+        stats_log_close();
+        return 0;
+    }
+    *out_aggregates = header->aggregates;
+    return 1;
+}
+
+int stats_log_append(const LevelHistoryRecord* record, const StatsAggregates* aggregates) {
+    if (!stats_log.file) {
+        return 0;
+    }
+    StatsLogBlock* block = &stats_log.block;
+    if (stats_log.header.block_count == 0 || block->count == STATS_LOG_BLOCK_LEVELS) {
+        memset(block, 0, sizeof(*block));
+        stats_log.header.block_count++;
+    }
+    uint32_t i = block->count++;
+    block->word[i] = record->word;
+    block->level[i] = record->level;
+    block->time_ms[i] = record->time_ms;
+    block->day[i] = record->day;
+    block->guesses[i] = record->guesses;
+    block->word_length[i] = record->word_length;
+    block->token[i] = record->token;
+
+    stats_log.header.level_count++;
+    stats_log.header.aggregates = *aggregates;
+    int ok = fseek(stats_log.file, block_offset(stats_log.header.block_count - 1), SEEK_SET) == 0 &&
+             fwrite(block, sizeof(*block), 1, stats_log.file) == 1 &&
+             write_header();
+    return fflush(stats_log.file) == 0 && ok;
+}
+
+uint64_t stats_log_level_count(void) {
+    return stats_log.file ? stats_log.header.level_count : 0;
+}
+
+void stats_log_close(void) {
+    if (stats_log.file) {
+        fclose(stats_log.file);
+    }
+    memset(&stats_log, 0, sizeof(stats_log));
+}
@@ -0,0 +1,53 @@
+#ifndef STATS_HISTORY_H
+#define STATS_HISTORY_H
+
+#include "types.h"
+
+// Statistics history log (.cwst)
+//
+// Layout (little-endian):
+//   StatsLogHeader                     includes the aggregates as of the last append
+//   StatsLogBlock blocks[block_count]  STATS_LOG_BLOCK_LEVELS levels each, stored
+//                                      column by column; the last may be partial
+//
+// Appends rewrite only the last block and the header. Opening reads only the
+// header (and the partial last block), so the aggregates come back without a
+// pass over the levels.
+
+#define STATS_LOG_MAGIC 0x54535743u           // "CWST"
+#define STATS_LOG_VERSION 1u
+#define STATS_LOG_BLOCK_LEVELS 256
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t block_levels;
+    uint32_t block_count;
+    uint64_t level_count;
+    uint64_t blocks_offset;
+    StatsAggregates aggregates;
+} StatsLogHeader;
+
+typedef struct {
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t word[STATS_LOG_BLOCK_LEVELS];
+    uint32_t level[STATS_LOG_BLOCK_LEVELS];
+    uint32_t time_ms[STATS_LOG_BLOCK_LEVELS];
+    int32_t day[STATS_LOG_BLOCK_LEVELS];
+    uint16_t guesses[STATS_LOG_BLOCK_LEVELS];
+    uint8_t word_length[STATS_LOG_BLOCK_LEVELS];
+    char token[STATS_LOG_BLOCK_LEVELS];
+} StatsLogBlock;
+
+// Opens or creates the log and copies the saved aggregates into
+// out_aggregates (zeroed for a new log). Returns 1 on success.
+int stats_log_open(const char* path, StatsAggregates* out_aggregates);
+// Appends one level and saves the aggregates that include it. Returns 1 on success.
+int stats_log_append(const LevelHistoryRecord* record, const StatsAggregates* aggregates);
+uint64_t stats_log_level_count(void);
+// Reads back one block; returns 1 on success
+int stats_log_read_block(uint32_t block, StatsLogBlock* out_block);
+void stats_log_close(void);
+
+#endif
@@ -2,6 +2,7 @@
 #define SYSTEMS_H
 
 #include "types.h"
+#include "log.h"
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
@@ -10,7 +11,9 @@
 
 // Game System Function Declarations
 GameState create_game_state(const char* target_word);
-GameState input_system(GameState state);
+GameState game_tick(GameState state, const GameInput* input);
+GameState input_system(GameState state, const GameInput* input);
+GameState input_action_system(GameState state);
 GameState word_editing_system(GameState state);
 GameState word_validation_system(GameState state);
 GameState level_progression_system(GameState state);
@@ -30,11 +33,62 @@ int is_letter_in_target_word(char letter, const char* target_word);
 LetterState calculate_letter_state(char guess_letter, int position, const char* target_word);
 int check_word_match(const char* word1, const char* word2);
 
+// Hard Mode Function Declarations
+void guess_constraints_reset(GuessConstraints* constraints);
+void guess_constraints_update(GuessConstraints* constraints, const char* guess, const LetterState* states, int word_length);
+GuessViolation guess_constraints_check(const GuessConstraints* constraints, const char* guess, int word_length);
+
+// Input Action Function Declarations
+InputEvent input_event_for_key(int key, double time);
+const char* input_action_name(GameAction action);
+int load_input_bindings(const char* path);
+void reset_input_bindings(void);
+uint32_t input_event_count(const InputEventRing* ring);
+int input_event_push(InputEventRing* ring, InputEvent event);
+int input_event_pop(InputEventRing* ring, InputEvent* out_event);
+
+// Speed Mode Function Declarations
+void speed_mode_start(SpeedModeState* speed, double now);
+void speed_mode_level_start(SpeedModeState* speed, double now);
+void speed_mode_record_guess(SpeedModeState* speed, double now, int level, int guess, int solved);
+uint32_t speed_split_available(const SpeedModeState* speed);
+const SpeedSplit* speed_split_at(const SpeedModeState* speed, uint32_t index);
+uint32_t speed_mode_level_us(const SpeedModeState* speed, double now);
+uint64_t speed_mode_run_us(const SpeedModeState* speed, double now);
+
+// Stats History Function Declarations
+void stats_history_record_guess(StatsAggregates* aggregates, const char* guess, const LetterState* states, int length);
+void stats_history_record_level(StatsAggregates* aggregates, const LevelHistoryRecord* record);
+int stats_history_average_tenths(const StatsAggregates* aggregates, int window);
+int stats_history_guess_percentile(const StatsAggregates* aggregates, double fraction);
+int stats_history_time_percentile_seconds(const StatsAggregates* aggregates, double fraction);
+
+// Latency Function Declarations
+void latency_mark(GameState* state);
+void latency_record(LatencyHistograms* histograms, GameAction action, double seconds);
+double latency_percentile(const LatencyHistograms* histograms, GameAction action, double fraction);
+int latency_write_stats(const LatencyHistograms* histograms, const char* path);
+
+// On-Screen Keyboard Function Declarations
+void keyboard_state_reset(KeyboardState* keyboard);
+void keyboard_state_update(KeyboardState* keyboard, const char* guess, const LetterState* states, int word_length);
+
 // Crossword Helper Function Declarations
 int find_first_editable_cell_in_word(GameState state, int word_index, int* out_x, int* out_y);
 int find_next_incomplete_word(GameState state);
 int find_previous_editable_cell_with_letter(GameState state, int current_x, int current_y, int* out_x, int* out_y);
 
+// Token Ledger Function Declarations
+TokenTransaction token_transaction(TokenTransactionKind kind);
+void token_transaction_add(TokenTransaction* transaction, char letter, int amount);
+int token_ledger_commit(TokenLedger* ledger, const TokenTransaction* transaction);
+int token_ledger_count(const TokenLedger* ledger, char letter);
+int token_ledger_total(const TokenLedger* ledger);
+uint32_t token_ledger_shortfall(const TokenLedger* ledger, const int16_t* need);
+int token_ledger_can_afford(const TokenLedger* ledger, const int16_t* need);
+void crossword_token_need_reset(CrosswordState* crossword);
+void crossword_set_cell(CrosswordState* crossword, int x, int y, char letter);
+
 // Animation System Function Declarations
 GameState animation_update_system(GameState state);
 float easeInOutQuad(float t);
@@ -47,8 +101,20 @@ void spawn_particles(GameState* state, Vector2 position, Color color, int count)
 void update_particles(GameState* state, float frame_time);
 void complete_word_validation(GameState* state);
 
-// Rendering System Function Declarations
+// HUD Text Function Declarations
+int format_int(char* buffer, int value);
+int hud_counter_update(HudCounter* counter, int value);
+GameState hud_update_system(GameState state);
+
+// Layout Function Declarations
 LayoutConfig calculate_layout(GameState state);
+KeyboardLayout calculate_keyboard_layout(GameViewState view, int screen_width, int screen_height);
+KeyboardKeyRect keyboard_key(const KeyboardLayout* layout, int index);
+int keyboard_key_at(const KeyboardLayout* layout, int x, int y);
+int text_wrap(const char* text, int max_width, TextMeasureFunction measure, void* context,
+              TextLine* lines, int max_lines);
+
+// Rendering System Function Declarations (front end only, needs raylib)
 Color get_color_for_letter_state(LetterState state);
 void board_render_system(GameState state);
 void ui_render_system(GameState state);
@@ -56,9 +122,90 @@ void render_system(GameState state);
 void crossword_render_system(GameState state);
 void home_screen_render_system(GameState state);
 void crossword_completion_render_system(GameState state);
+void keyboard_render_system(GameState state);
+void profiler_overlay_render(const LatencyHistograms* histograms, const JobsUtilization* workers);
+void stats_screen_render(GameState state);
+void render_shutdown(void);
 
 // Word System Function Declarations
 void initialize_random_seed(void);
-const char* get_random_word(void);
+void get_random_word(int word_length, char* out_word);
+const WordDictionary* get_word_dictionary(int word_length);
+int dictionary_find(const WordDictionary* dictionary, PackedWord word);
+int is_dictionary_word(const char* word, int word_length);
+int load_word_database(const char* path);
+int load_word_databases(const char* directory);
+void unload_word_databases(void);
+int get_random_category_word(int word_length, uint32_t categories, const uint64_t* seen, char* out_word);
+
+// Word Category Function Declarations
+int load_word_category(const char* directory, const char* name);
+int load_word_categories(const char* directory);
+void unload_word_categories(void);
+int word_category_count(void);
+const char* word_category_name(int category);
+int word_category_find(const char* name);
+int word_category_chunks(int word_length);
+int word_category_filter(int word_length, uint32_t categories, const uint64_t* exclude, uint64_t* out_bits);
+int word_bitmap_count(const uint64_t* bits, int begin, int end);
+int word_bitmap_select(const uint64_t* bits, int begin, int end, int k);
+
+// Daily Challenge Function Declarations
+int daily_day_number(int year, int month, int day);
+void daily_date_from_day(int day_number, int* out_year, int* out_month, int* out_day);
+void get_daily_word(int word_length, int day, char* out_word);
+CrosswordLevel get_daily_crossword_level(int day);
+CrosswordLevel get_themed_crossword_level(uint32_t categories, int seed);
+int load_daily_calendar(const char* path);
+void unload_daily_calendar(void);
+
+// Crossword Clue Function Declarations
+int load_clue_database(const char* path);
+void unload_clue_database(void);
+uint32_t clue_database_version(void);
+int clue_database_count(void);
+uint32_t clue_find(uint64_t word);
+const char* clue_text(uint32_t clue);
+uint64_t crossword_word_id(const CrosswordLevel* level, int word_index);
+
+// Puzzle Pack Function Declarations
+int load_puzzle_pack(const char* path);
+void unload_puzzle_pack(void);
+int puzzle_pack_count(void);
+int puzzle_pack_level(int index, CrosswordLevel* out_level);
+const char* puzzle_pack_clue(int index, int word_index);
+
+// Word Selection Function Declarations
+void get_word_for_level(int word_length, int level, char* out_word);
+void get_themed_word_for_level(int word_length, int level, uint32_t theme, char* out_word);
+int get_word_difficulty(int word_length, const char* word);
+int difficulty_bucket_for_level(int level);
+// Draws never repeat a word within the last `window` draws of that length. The
+// window is cut (and a warning logged) to half the smallest difficulty bucket,
+// so a level's tier always has words left to draw.
+void set_word_repeat_window(int window);
+// Window in effect for word_length after that cut
+int get_word_repeat_window(int word_length);
+void prepare_word_selectors(void);
+int draw_word_index_for_level(int word_length, int level, uint64_t* rng_state);
+
+// Wordle Solver Function Declarations
+uint16_t feedback_code(const LetterState* states, int word_length);
+uint16_t* build_feedback_matrix(const WordDictionary* dictionary);
+int solver_guess_count(const WordDictionary* dictionary, const uint16_t* feedback_matrix, int target, int* scratch);
+
+// Word Kernel Function Declarations
+int is_supported_word_length(int word_length);
+const WordKernels* get_word_kernels(int word_length);
+
+// Session State Function Declarations
+int session_state_pack(const GameState* state, SessionState* out_session);
+GameState session_state_unpack(const SessionState* session);
+void session_state_init(SessionState* session, int word_length, const char* target);
+int session_state_word_length(const SessionState* session);
+GamePlayState session_state_play_state(const SessionState* session);
+void session_state_target(const SessionState* session, char* out_word);
+int session_state_guess(SessionState* session, const char* guess, LetterState* out_states, int award_index);
+int session_state_next_level(SessionState* session, const char* target);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "systems.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define TOKEN_LEDGER_SSE2 1
+#endif
+
+// Letter-token ledger. Balances are 26 int16 lanes (padded to 32) so balance
+// checks are a handful of vector compares instead of a loop over letters.
+// Every change goes through a transaction that is applied all-or-nothing.
+
+#define TOKEN_VECTORS (TOKEN_LANES / 8)
+
+// Bit i set where balance[i] + delta[i] would go negative or overflow int16
+static uint32_t invalid_lanes(const int16_t* balance, const int16_t* delta) {
+#ifdef TOKEN_LEDGER_SSE2
+    uint32_t mask = 0;
+    __m128i zero = _mm_setzero_si128();
+    for (int v = 0; v < TOKEN_VECTORS; v++) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&balance[v * 8]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&delta[v * 8]);
+        __m128i saturated = _mm_adds_epi16(a, b);
+        __m128i wrapped = _mm_add_epi16(a, b);
+        __m128i bad = _mm_or_si128(_mm_cmplt_epi16(saturated, zero),
+                                   _mm_xor_si128(_mm_cmpeq_epi16(saturated, wrapped), _mm_set1_epi16(-1)));
+        // One bit per 16-bit lane
+        __m128i packed = _mm_packs_epi16(bad, zero);
+        mask |= (uint32_t)(_mm_movemask_epi8(packed) & 0xFF) << (v * 8);
+    }
+    return mask;
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < TOKEN_LANES; i++) {
+        int next = balance[i] + delta[i];
+        if (next < 0 || next > INT16_MAX) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+// Bit i set where balance[i] < need[i]
+static uint32_t short_lanes(const int16_t* balance, const int16_t* need) {
+#ifdef TOKEN_LEDGER_SSE2
+    uint32_t mask = 0;
+    __m128i zero = _mm_setzero_si128();
+    for (int v = 0; v < TOKEN_VECTORS; v++) {
+        __m128i a = _mm_loadu_si128((const __m128i*)&balance[v * 8]);
+        __m128i b = _mm_loadu_si128((const __m128i*)&need[v * 8]);
+        __m128i packed = _mm_packs_epi16(_mm_cmplt_epi16(a, b), zero);
+        mask |= (uint32_t)(_mm_movemask_epi8(packed) & 0xFF) << (v * 8);
+    }
+    return mask;
+#else
+    uint32_t mask = 0;
+    for (int i = 0; i < TOKEN_LANES; i++) {
+        if (balance[i] < need[i]) {
+            mask |= 1u << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+TokenTransaction token_transaction(TokenTransactionKind kind) {
+    TokenTransaction transaction = {0};
+    transaction.kind = kind;
+    return transaction;
+}
+
+void token_transaction_add(TokenTransaction* transaction, char letter, int amount) {
+    int index = letter - 'A';
+    if (index >= 0 && index < TOKEN_LETTER_COUNT) {
+        transaction->delta[index] = (int16_t)(transaction->delta[index] + amount);
+    }
+}
+
+// Applies every lane of the transaction or none of them. Returns 1 if applied,
+// 0 if any letter would go negative (or overflow).
+int token_ledger_commit(TokenLedger* ledger, const TokenTransaction* transaction) {
+    if (invalid_lanes(ledger->balance, transaction->delta) != 0) {
+        ledger->rejected_transactions++;
+        return 0;
+    }
+
+    int is_income = transaction->kind == TOKEN_TX_AWARD || transaction->kind == TOKEN_TX_GRANT;
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        int delta = transaction->delta[i];
+        if (delta == 0) {
+            continue;
+        }
+        ledger->balance[i] = (int16_t)(ledger->balance[i] + delta);
+        if (delta < 0) {
+            ledger->total_spent -= delta;
+            ledger->spent_by_letter[i] += (uint32_t)-delta;
+        } else if (is_income) {
+            ledger->total_earned += delta;
+            ledger->earned_by_letter[i] += (uint32_t)delta;
+        } else {
+            ledger->total_refunded += delta;
+            ledger->refunded_by_letter[i] += (uint32_t)delta;
+        }
+    }
+    ledger->transactions_by_kind[transaction->kind]++;
+    ledger->version++;
+    return 1;
+}
+
+int token_ledger_count(const TokenLedger* ledger, char letter) {
+    int index = letter - 'A';
+    return (index >= 0 && index < TOKEN_LETTER_COUNT) ? ledger->balance[index] : 0;
+}
+
+int token_ledger_total(const TokenLedger* ledger) {
+    int total = 0;
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        total += ledger->balance[i];
+    }
+    return total;
+}
+
+// Letters (bit 0 = A) the bag holds fewer of than `need`
+uint32_t token_ledger_shortfall(const TokenLedger* ledger, const int16_t* need) {
+    return short_lanes(ledger->balance, need);
+}
+
+int token_ledger_can_afford(const TokenLedger* ledger, const int16_t* need) {
+    return short_lanes(ledger->balance, need) == 0;
+}
+
+// ============= CROSSWORD TOKEN NEEDS =============
+
+// A cell needs its solution letter unless it already holds it; a wrong letter
+// in the cell is returned to the bag when replaced, so it offsets that letter's need
+static void add_cell_need(CrosswordState* crossword, int x, int y, char letter, int sign) {
+    char solution = crossword->current_level.solution[x][y];
+    if (!crossword->current_level.word_mask[x][y] || solution == '\0' || letter == solution) {
+        return;
+    }
+    crossword->token_need[solution - 'A'] = (int16_t)(crossword->token_need[solution - 'A'] + sign);
+    if (letter != '\0') {
+        crossword->token_need[letter - 'A'] = (int16_t)(crossword->token_need[letter - 'A'] - sign);
+    }
+}
+
+// Recomputes token_need from the whole grid; used when a puzzle is loaded or reset
+void crossword_token_need_reset(CrosswordState* crossword) {
+    memset(crossword->token_need, 0, sizeof(crossword->token_need));
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 9; y++) {
+            add_cell_need(crossword, x, y, crossword->grid[x][y], 1);
+        }
+    }
+    crossword->token_need_version++;
+}
+
+// Writes a grid cell and updates token_need in O(1)
+void crossword_set_cell(CrosswordState* crossword, int x, int y, char letter) {
+    add_cell_need(crossword, x, y, crossword->grid[x][y], -1);
+    crossword->grid[x][y] = letter;
+    add_cell_need(crossword, x, y, letter, 1);
+    crossword->token_need_version++;
+}
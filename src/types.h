@@ -1,11 +1,152 @@
 #ifndef TYPES_H
 #define TYPES_H
 
-#include "raylib.h"
+#include "platform_types.h"
 #include "constants.h"
+#include <stdint.h>
 
 // Game Constants
-#define WORD_LENGTH 5
+#define MIN_WORD_LENGTH 4
+#define MAX_WORD_LENGTH 7
+#define DEFAULT_WORD_LENGTH 5
+#define WORD_LENGTH_MODE_COUNT (MAX_WORD_LENGTH - MIN_WORD_LENGTH + 1)
+
+// Packed words: 5 bits per letter (A=1 ... Z=26), first letter in the highest bits,
+// so numeric order of same-length words is alphabetical order
+#define PACKED_LETTER_BITS 5
+#define PACKED_LETTER_MASK 0x1F
+typedef uint64_t PackedWord;
+
+// Themed word categories; a set of them is a bitmask (bit c is category c)
+#define WORD_CATEGORY_MAX 32
+#define WORD_CATEGORY_NAME_LENGTH 32
+
+// Letter tokens: one lane per letter, padded to a whole number of 128-bit vectors
+#define TOKEN_LETTER_COUNT 26
+#define TOKEN_LANES 32
+
+// Key codes carried in GameInput. Values match raylib's KeyboardKey, so the
+// window front end passes GetKeyPressed() through unchanged.
+typedef enum {
+    GAME_KEY_NONE = 0,
+    GAME_KEY_SPACE = 32,
+    GAME_KEY_ONE = 49,
+    GAME_KEY_NINE = 57,
+    GAME_KEY_A = 65,
+    GAME_KEY_Z = 90,
+    GAME_KEY_ENTER = 257,
+    GAME_KEY_TAB = 258,
+    GAME_KEY_BACKSPACE = 259,
+    GAME_KEY_RIGHT = 262,
+    GAME_KEY_LEFT = 263,
+    GAME_KEY_DOWN = 264,
+    GAME_KEY_UP = 265,
+    GAME_KEY_F2 = 291,
+    GAME_KEY_F3 = 292,
+    GAME_KEY_LEFT_SHIFT = 340,
+    GAME_KEY_RIGHT_SHIFT = 344
+} GameKey;
+
+// Pointer buttons pressed this frame (keys all arrive through the key queue)
+typedef enum {
+    GAME_BUTTON_CLICK = 1 << 0      // Left mouse button, at mouse_x/mouse_y
+} GameButton;
+
+#define GAME_INPUT_MAX_KEYS 16          // Matches raylib's per-frame key queue
+#define GAME_KEY_CODE_LIMIT 512         // Key codes below this can be bound
+
+// Everything one tick needs from the platform
+typedef struct {
+    int keys[GAME_INPUT_MAX_KEYS];  // This frame's key queue in press order (GameKey)
+    int key_count;
+    int keys_dropped;       // Keys that did not fit in keys[]
+    uint32_t buttons;       // GameButton bits pressed this frame
+    float wheel_move;       // Mouse wheel movement this frame
+    int mouse_x;            // Mouse position in screen pixels
+    int mouse_y;
+    float frame_time;       // Seconds since the previous tick
+    double time;            // Platform clock when the input was read (stamps input events)
+    int screen_width;
+    int screen_height;
+    int day;                // Local date as days since 1970-01-01 (daily challenge), 0 if unknown
+} GameInput;
+
+// What a key means to the game; keys map to actions through the binding table
+// (input_actions.c), and gameplay systems only ever see actions
+typedef enum {
+    GAME_ACTION_NONE = 0,
+    GAME_ACTION_LETTER,             // Type or place InputEvent.letter
+    GAME_ACTION_SUBMIT,             // Submit the guess / validate the word / start
+    GAME_ACTION_DELETE,
+    GAME_ACTION_CONTINUE,           // Next level, next puzzle
+    GAME_ACTION_SWITCH_VIEW,
+    GAME_ACTION_TOGGLE_DIRECTION,
+    GAME_ACTION_PREVIOUS,           // Previous word / shorter words
+    GAME_ACTION_NEXT,               // Next word / longer words
+    GAME_ACTION_UP,                 // Scroll up / move up
+    GAME_ACTION_DOWN,
+    GAME_ACTION_DEBUG,
+    GAME_ACTION_LETTER_BAG,
+    GAME_ACTION_TEST_TOKENS,
+    GAME_ACTION_HARD_MODE,
+    GAME_ACTION_COLOR_BLIND,
+    GAME_ACTION_PROFILER,           // Toggle the latency overlay
+    GAME_ACTION_STATS,              // Toggle the statistics screen
+    GAME_ACTION_COUNT
+} GameAction;
+
+typedef struct {
+    double time;            // GameInput.time of the frame the key was read in
+    uint16_t key;           // GameKey that produced it
+    uint8_t action;         // GameAction
+    char letter;            // GAME_ACTION_LETTER only
+} InputEvent;
+
+// Input-to-photon latency. A system that makes an action visible marks it with
+// the event's read time; the front end closes every mark once the frame that
+// draws it has been presented, and files the latency per action.
+#define LATENCY_MAX_MARKS INPUT_EVENT_RING_SIZE  // Marks per tick: one per applied event, so one per ring slot
+#define LATENCY_BUCKET_COUNT 64         // 1 ms buckets; the last one holds 63 ms and up
+#define LATENCY_BUCKET_MS 1.0
+
+typedef struct {
+    double time;            // InputEvent.time of the action
+    uint8_t action;         // GameAction
+} LatencyMark;
+
+typedef struct {
+    uint32_t buckets[GAME_ACTION_COUNT][LATENCY_BUCKET_COUNT];
+    uint32_t count[GAME_ACTION_COUNT];
+    double total_ms[GAME_ACTION_COUNT];
+    double max_ms[GAME_ACTION_COUNT];
+    uint32_t version;       // Bumped per recorded sample
+} LatencyHistograms;
+
+// Job system workers (see jobs.c), sampled by the front end for the profiler
+#define JOB_MAX_WORKERS 16
+
+typedef struct {
+    int worker_count;
+    uint8_t busy_percent[JOB_MAX_WORKERS];  // Share of the time since the last sample spent in jobs
+    uint32_t jobs_run[JOB_MAX_WORKERS];     // Lifetime totals
+    uint32_t jobs_stolen[JOB_MAX_WORKERS];  // ... of which taken from another worker's deque
+} JobsUtilization;
+
+// Actions waiting for the gameplay systems. Every key read in a frame is
+// queued, and game_tick runs the systems once per event, so keys landing in
+// the same frame are all applied, in order.
+#define INPUT_EVENT_RING_SIZE 64        // Must be a power of two
+
+typedef struct {
+    InputEvent events[INPUT_EVENT_RING_SIZE];
+    uint32_t head;          // Next event to consume
+    uint32_t tail;          // Next free slot
+    uint32_t queued;        // Lifetime counters
+    uint32_t consumed;
+    uint32_t dropped;       // Keys lost to a full ring or a full GameInput.keys
+    uint32_t max_depth;     // Deepest the ring has been
+    double last_event_time; // Read time of the last consumed event (for input latency)
+} InputEventRing;
 
 // Enums
 typedef enum {
@@ -29,32 +170,150 @@ typedef enum {
     VIEW_CROSSWORD_COMPLETE = 3
 } GameViewState;
 
+// Word System Structs
+typedef struct {
+    int word_length;
+    int count;
+    const PackedWord* words;      // Sorted ascending
+    const uint8_t* difficulty;    // Per-word difficulty 0..255 (NULL if unknown)
+    const uint16_t* frequency;    // Per-word usage frequency (NULL if unknown)
+    uint64_t hash;                // Of the packed words, taken when the list is loaded
+} WordDictionary;
+
+// Fixed-length kernels for one word length (see word_kernels.c)
+typedef struct {
+    int length;
+    float layout_width_units;  // length + (length - 1) * CELL_SPACING_RATIO
+    void (*score_guess)(const char* guess, const char* target, LetterState* out_states);
+    int (*words_match)(const char* word1, const char* word2);
+    PackedWord (*pack)(const char* word);
+    void (*unpack)(PackedWord packed, char* out_word);
+} WordKernels;
+
 // Game State Structs
 typedef struct {
-    char target_word[WORD_LENGTH + 1];
+    char target_word[MAX_WORD_LENGTH + 1];
+    int word_length;        // Letters per word in the selected mode
     int current_level;
     int guesses_this_level;
     int total_lifetime_guesses;
     GamePlayState play_state;
     float result_display_timer;
     int level_complete;
+    int daily_day;          // Day of the daily challenge being played, 0 in endless levels
+    uint32_t theme;         // Word categories endless targets are drawn from, 0 for every word
 } CoreGameState;
 
+// Hard-mode constraints revealed so far this level. guess_constraints_update
+// folds in each scored guess, so checking a guess never replays the history.
+typedef struct {
+    uint8_t fixed[MAX_WORD_LENGTH];           // Green letter per position (1-26), 0 if none
+    uint32_t required_mask;                   // Letters (bit 0 = A) known to be in the word
+    uint8_t min_count[TOKEN_LETTER_COUNT];    // Known lower bound per letter
+} GuessConstraints;
+
+// On-screen keyboard colors, folded forward as each guess completes so
+// drawing the keyboard never rescans the level's history
 typedef struct {
-    char current_word[WORD_LENGTH + 1];
+    LetterState letters[TOKEN_LETTER_COUNT];  // Best state revealed per letter this level
+    uint32_t version;                         // Bumped when a letter changes or the table resets
+} KeyboardState;
+
+typedef enum {
+    GUESS_VIOLATION_NONE = 0,
+    GUESS_VIOLATION_FIXED = 1,      // A green letter must stay at its position
+    GUESS_VIOLATION_REQUIRED = 2    // A revealed letter must be reused (as often as greens prove)
+} GuessViolationKind;
+
+typedef struct {
+    GuessViolationKind kind;
+    char letter;
+    int position;                   // GUESS_VIOLATION_FIXED only
+} GuessViolation;
+
+typedef struct {
+    char current_word[MAX_WORD_LENGTH + 1];
     int current_letter_pos;
     int word_complete;
     int should_submit;
+    GuessViolation hard_mode_violation;  // Why the last submit was refused; cleared on edit
 } PlayerInputState;
 
 typedef struct {
-    LetterState level_letter_states[MAX_RECENT_GUESSES][WORD_LENGTH];
-    char level_guesses[MAX_RECENT_GUESSES][WORD_LENGTH + 1];
+    LetterState level_letter_states[MAX_RECENT_GUESSES][MAX_WORD_LENGTH];
+    char level_guesses[MAX_RECENT_GUESSES][MAX_WORD_LENGTH + 1];
     int level_guess_count;
-    LetterState current_guess_states[WORD_LENGTH];  // For result display state
-    char current_guess[WORD_LENGTH + 1];           // For result display state
+    LetterState current_guess_states[MAX_WORD_LENGTH];  // For result display state
+    char current_guess[MAX_WORD_LENGTH + 1];           // For result display state
+    GuessConstraints constraints;                      // Everything this level's guesses revealed
+    KeyboardState keyboard;                            // Letter colors for the on-screen keyboard
 } GameHistoryState;
 
+typedef enum {
+    TOKEN_TX_PLACE = 0,     // Letter placed on the crossword (may return the letter it replaced)
+    TOKEN_TX_CLEAR = 1,     // Letter removed from the crossword back to the bag
+    TOKEN_TX_AWARD = 2,     // Level completion reward
+    TOKEN_TX_REFUND = 3,    // Letters returned when a finished crossword is reset
+    TOKEN_TX_GRANT = 4,     // Debug grant
+    TOKEN_TX_KIND_COUNT
+} TokenTransactionKind;
+
+// A batch of per-letter changes applied all-or-nothing by token_ledger_commit
+typedef struct {
+    int16_t delta[TOKEN_LANES];
+    TokenTransactionKind kind;
+} TokenTransaction;
+
+typedef struct {
+    int16_t balance[TOKEN_LANES];           // Tokens held per letter (lanes 26+ stay 0)
+    uint32_t version;                       // Bumped on every committed transaction
+    
+    // Running totals; balance always equals earned - spent + refunded
+    int total_earned;
+    int total_spent;
+    int total_refunded;
+    
+    // Lifetime per-letter histograms
+    uint32_t earned_by_letter[TOKEN_LETTER_COUNT];
+    uint32_t spent_by_letter[TOKEN_LETTER_COUNT];
+    uint32_t refunded_by_letter[TOKEN_LETTER_COUNT];
+    uint32_t transactions_by_kind[TOKEN_TX_KIND_COUNT];
+    uint32_t rejected_transactions;
+} TokenLedger;
+
+// Statistics history (see stats_history.c). Each solved level is one
+// LevelHistoryRecord appended to the on-disk log; the aggregates below are
+// updated in O(1) per guess and per level, so the statistics screen never
+// reads the log back.
+#define STATS_WINDOW_SHORT 10
+#define STATS_WINDOW_LONG 100
+#define STATS_GUESS_BUCKETS 32          // 1..31 guesses; the last holds 32 and up
+#define STATS_TIME_BUCKETS 64           // The last holds 315 s and up
+#define STATS_TIME_BUCKET_MS 5000
+
+typedef struct {
+    uint64_t word;          // Target word, .cwdb packing
+    uint32_t level;
+    uint32_t time_ms;       // Level start to the solving guess
+    uint16_t guesses;
+    uint8_t word_length;
+    char token;             // Letter token awarded
+    int32_t day;            // GameInput.day when it was solved
+} LevelHistoryRecord;
+
+typedef struct {
+    uint32_t levels;        // Levels recorded
+    uint16_t recent_guesses[STATS_WINDOW_LONG];  // Ring: level n at n % STATS_WINDOW_LONG
+    uint32_t short_sum;     // Guesses over the last STATS_WINDOW_SHORT levels
+    uint32_t long_sum;      // ... and over the last STATS_WINDOW_LONG
+    uint64_t total_guesses;
+    uint64_t total_time_ms;
+    uint32_t guess_histogram[STATS_GUESS_BUCKETS];
+    uint32_t time_histogram[STATS_TIME_BUCKETS];
+    uint32_t letter_results[TOKEN_LETTER_COUNT][3];  // Per guessed letter: correct, present, absent
+    uint32_t version;       // Bumped per guess or level recorded
+} StatsAggregates;
+
 typedef struct {
     int levels_completed;
     int current_level_streak;
@@ -62,8 +321,11 @@ typedef struct {
     int total_guesses;
     float average_guesses_per_level;
     int best_level_score;  // minimum guesses for any level
-    int letter_counts[26]; // A=0, B=1, ..., Z=25 - collected letter tokens
+    TokenLedger tokens;    // Collected letter tokens (A=0, B=1, ..., Z=25)
     int show_letter_bag;   // Toggle for letter bag display
+    StatsAggregates history;
+    double level_start_time;   // Clock time the current level started
+    double level_solved_time;  // Clock time of its solving guess
 } GameStatsState;
 
 typedef struct {
@@ -73,6 +335,79 @@ typedef struct {
     int color_blind_mode;
 } GameSettingsState;
 
+#define PROFILE_NAME_SIZE 24            // Player profile names (see profile.c)
+
+// Cached integer text for HUD counters - re-rendered only when the value changes
+typedef struct {
+    int value;
+    int valid;               // 0 until the first update
+    int length;
+    char text[12];           // Fits INT_MIN plus terminator
+} HudCounter;
+
+// Pre-built HUD strings, refreshed by hud_update_system instead of per-frame formatting
+typedef struct {
+    HudCounter current_level;
+    HudCounter guess_number;
+    HudCounter total_guesses;
+    HudCounter solved_guesses;
+    HudCounter levels_completed;
+    HudCounter best_score;
+    HudCounter average_tenths;               // average_guesses_per_level * 10, rounded
+    HudCounter word_number;
+    HudCounter tokens_remaining;
+    HudCounter word_length;
+    HudCounter daily_day;
+    
+    char level_title[32];                    // "WORDLE - LEVEL n" or "DAILY - yyyy-mm-dd"
+    char level_stats[64];                    // "Guess n this level | n total guesses"
+    char level_score[80];                    // "Solved in n guesses! Press SPACE for Level n"
+    char level_complete_text[32];            // "LEVEL n COMPLETE!" or "DAILY COMPLETE!"
+    char lifetime_stats[96];                 // "Levels completed: n | Best: ... | Average: ..."
+    char debug_message[32];                  // "DEBUG: Answer is WORD"
+    char debug_target[MAX_WORD_LENGTH + 1];  // Target word debug_message was built for
+    char word_indicator[32];                 // "Word n - ACROSS"
+    int word_indicator_direction;
+    uint64_t clue_word;                      // Word ID crossword_clue was looked up for
+    uint32_t clue_database;                  // clue_database_version() at that lookup
+    uint32_t crossword_clue;                 // Current word's clue (clue_find), 0 for none
+    char tokens_remaining_text[48];          // "Letter tokens remaining: n"
+    char instruction[48];                    // "Type a n-letter word and press ENTER"
+    char mode_text[24];                      // "< n LETTERS >"
+    char hard_mode_text[48];                 // "Hard mode: 2nd letter must be R"
+    GuessViolation hard_mode_shown;          // Violation hard_mode_text was built for
+    
+    // Speed mode: the timers move at most every tenth of a second, the splits per guess
+    HudCounter speed_level_tenths;
+    HudCounter speed_run_tenths;
+    char speed_timer_text[48];               // "LEVEL 12.3s | RUN 95.1s"
+    uint32_t speed_splits_version;
+    char speed_splits_text[64];              // "Splits: 4.2 3.1 5.0"
+    
+    char profile_text[64];                   // "Player: NAME  (UP/DOWN to switch, N for new)"
+    char profile_shown[PROFILE_NAME_SIZE];   // Name profile_text was built for
+    HudCounter theme;
+    char theme_text[64];                     // "Theme: NAME  (T to change)", empty without categories
+    
+    // Statistics screen, rebuilt when the history aggregates change
+    uint32_t stats_version;
+    int stats_valid;
+    char stats_levels_text[64];              // "Levels solved: n | Time played: n min"
+    char stats_average_text[80];             // "Average guesses - last 10: 3.2 | last 100: 3.8 | all: 4.1"
+    char stats_percentile_text[80];          // "Guesses p50 4 p90 6 | Time p50 35s p90 80s"
+    
+    // Letter bag lines, rebuilt when the ledger or the crossword's needs change
+    uint32_t bag_version;
+    uint32_t bag_need_version;
+    int bag_valid;
+    char letter_bag_text[300];
+    char crossword_bag_text[64];                 // Label (or "none" message) before the entries
+    char crossword_bag_entries[TOKEN_LETTER_COUNT][8];  // "A:3 " per held or needed letter
+    char crossword_bag_entry_letter[TOKEN_LETTER_COUNT];
+    int crossword_bag_entry_count;
+    uint32_t crossword_bag_short_mask;           // Letters the crossword needs more of than the bag holds
+} HudState;
+
 typedef struct {
     float letter_reveal_timer;
     float game_over_timer;
@@ -81,7 +416,7 @@ typedef struct {
     int animate_letters;
     
     // Animation timers and states
-    float letter_pop_timers[WORD_LENGTH];     // Per-letter typing animation timers
+    float letter_pop_timers[MAX_WORD_LENGTH]; // Per-letter typing animation timers
     float cursor_pulse_timer;                 // Cursor blinking animation
     float word_complete_timer;                // Word completion celebration timer
     float level_complete_timer;               // Level completion celebration timer
@@ -101,21 +436,25 @@ typedef struct {
     Vector2 particle_velocities[50];          // Particle velocities
     float particle_lifetimes[50];             // Particle remaining lifetimes
     Color particle_colors[50];                // Particle colors
+    
+    HudState hud;                             // Cached HUD text
 } UIState;
 
 typedef struct {
     int start_x;            // Starting X position
     int start_y;            // Starting Y position
     int direction;          // 0=horizontal, 1=vertical
-    int length;             // Word length (always 5 for now)
+    int length;             // Word length (MIN_WORD_LENGTH..MAX_WORD_LENGTH)
 } CrosswordWord;
 
 typedef struct {
     char solution[9][9];    // Correct letters for the puzzle
     char word_mask[9][9];   // 1 = word cell, 0 = blocked cell
     int level;              // Current crossword level
+    int day;                // Day of a daily crossword, 0 for the regular levels
     CrosswordWord words[10]; // Array of word definitions (max 10 words)
     int word_count;         // Number of words in this level
+    uint32_t categories;    // Categories of a themed crossword, 0 for the others
 } CrosswordLevel;
 
 typedef struct {
@@ -129,10 +468,58 @@ typedef struct {
     int word_validated[9][9]; // Track which words have been validated
     int puzzle_completed;   // Set to 1 when entire crossword is solved
     int current_word_index; // Currently selected word (0-based)
+    
+    // Tokens still needed to finish the puzzle, kept in step with the grid by
+    // crossword_set_cell: per letter, cells still missing it minus wrong cells
+    // holding it (those come back when cleared)
+    int16_t token_need[TOKEN_LANES];
+    uint32_t token_need_version;
 } CrosswordState;
 
+// Local leaderboards (see leaderboard.c). A board is one metric for one
+// profile and mode; the gameplay systems leave each finished result here and
+// the front end files it in the leaderboard store after the tick.
+#define LEADERBOARD_MAX_RESULTS 4       // Results per tick
+
+typedef enum {
+    LEADERBOARD_MODE_WORDLE,
+    LEADERBOARD_MODE_DAILY,
+    LEADERBOARD_MODE_SPEED,
+    LEADERBOARD_MODE_COUNT
+} LeaderboardMode;
+
+typedef enum {
+    LEADERBOARD_FEWEST_GUESSES,     // Guesses to solve a level
+    LEADERBOARD_FASTEST_TIME,       // Milliseconds to solve a speed-run level
+    LEADERBOARD_LONGEST_STREAK,     // max_level_streak of a session
+    LEADERBOARD_METRIC_COUNT
+} LeaderboardMetric;
+
 typedef struct {
-    int last_key_pressed;
+    uint8_t mode;           // LeaderboardMode
+    uint8_t metric;         // LeaderboardMetric
+    uint8_t word_length;
+    uint16_t level;
+    uint32_t value;         // Guesses, milliseconds or levels
+    int32_t day;            // GameInput.day when it was set
+} LeaderboardResult;
+
+// The *_pressed flags describe the one input event being applied in this
+// pass of the gameplay systems (see input_action_system)
+typedef struct {
+    InputEventRing events;  // Actions queued this frame
+    GameAction action;      // Action of the event being applied, GAME_ACTION_NONE if none
+    double action_time;     // Its InputEvent.time
+    double clock;           // GameInput.time of this frame
+    int last_key_pressed;   // Key that produced it
+    LatencyMark latency_marks[LATENCY_MAX_MARKS];  // Actions this tick made visible
+    int latency_mark_count;
+    int show_profiler;      // Latency overlay toggle
+    int show_stats;         // Statistics screen toggle
+    LevelHistoryRecord level_record;  // Level solved this tick, for the history log
+    int level_record_ready;
+    LeaderboardResult leaderboard_results[LEADERBOARD_MAX_RESULTS];  // Results set this tick
+    int leaderboard_result_count;
     int space_pressed;
     int enter_pressed;
     int backspace_pressed;
@@ -140,8 +527,6 @@ typedef struct {
     char pressed_letter;
     double frame_time;
     int debug_mode;
-    int number_key_pressed;
-    int pressed_number;
     float camera_offset_y;
     float target_camera_offset_y;
     int scroll_wheel_move;
@@ -151,8 +536,44 @@ typedef struct {
     int auto_center_paused;
     int tab_pressed;
     int shift_pressed;
+    int left_arrow_pressed;
+    int right_arrow_pressed;
+    int screen_width;       // Window size reported by the last input
+    int screen_height;
+    int today;              // GameInput.day of the last input
+    int profile_index;      // Player profile this state belongs to
+    char profile_name[PROFILE_NAME_SIZE];
+    int profile_step;       // Home screen asked for the previous (-1) or next (1) profile
+    int profile_create;     // ... or for a new one
 } SystemState;
 
+// Timed speed mode (see speed_mode.c). All times come from the platform's
+// monotonic clock via input event timestamps (one reading per frame), never
+// from summed frame times.
+#define SPEED_SPLIT_RING_SIZE 256       // Must be a power of two
+#define SPEED_SPLIT_SOLVED 1            // SpeedSplit.flags: this guess solved the level
+
+typedef struct {
+    uint32_t guess_us;      // Since the previous guess (or the level start)
+    uint32_t level_us;      // Since the level start
+    uint16_t level;
+    uint8_t guess;          // Guess number within the level, 1-based
+    uint8_t flags;
+} SpeedSplit;
+
+typedef struct {
+    int active;
+    double run_start;       // Clock time the run started
+    double level_start;     // Clock time the current level started
+    double last_split;      // Clock time of the last guess this level
+    double level_end;       // Clock time the current level was solved, 0 while running
+    double intermission;    // Seconds spent between levels (solved, next not started)
+    uint64_t last_split_run_us;  // Run time at the latest split
+    SpeedSplit splits[SPEED_SPLIT_RING_SIZE];  // The newest SPEED_SPLIT_RING_SIZE splits
+    uint32_t split_count;   // Splits recorded this run (ring slot = index % size)
+    uint32_t version;       // Bumped per split or run start
+} SpeedModeState;
+
 typedef struct {
     CoreGameState core;
     PlayerInputState input;
@@ -163,8 +584,36 @@ typedef struct {
     SystemState system;
     GameViewState current_view;
     CrosswordState crossword;
+    SpeedModeState speed;
 } GameState;
 
+// Packed per-session state for hosting many sessions (see session_state.c).
+// Holds everything play depends on; UI timers, particles, camera, HUD caches
+// and ledger analytics are rebuilt or restarted when unpacked.
+#define SESSION_MAX_CROSSWORD_CELLS 64         // Word cells of one puzzle, one bit each
+#define SESSION_HISTORY_BYTES 118              // 20 seven-letter guesses at 47 bits
+
+typedef struct {
+    uint64_t target;                           // 5 bits per letter, first letter lowest, 0 ends
+    uint64_t word;                             // Typed input, or the guess being revealed
+    uint64_t cell_letters[5];                  // Bit planes of each word cell's letter (0 = empty)
+    uint64_t cell_states[2];                   // Bit planes of each word cell's LetterState
+    uint32_t total_lifetime_guesses;
+    uint32_t total_guesses;
+    float average_guesses_per_level;
+    uint32_t flags;                            // Small fields, see session_state.c
+    uint16_t level;
+    uint16_t guesses_this_level;
+    uint16_t levels_completed;
+    uint16_t current_level_streak;
+    uint16_t max_level_streak;
+    uint16_t best_level_score;
+    uint16_t crossword_level;
+    uint16_t crossword_flags;                  // Cursor, direction, word index, completion
+    uint8_t tokens[TOKEN_LETTER_COUNT];        // Letter-token balances
+    uint8_t history[SESSION_HISTORY_BYTES];    // Per guess: 5 bits per letter, then its feedback_code
+} SessionState;
+
 // Rendering Structs
 typedef struct {
     int screen_width;
@@ -180,4 +629,32 @@ typedef struct {
     int row_height;
 } LayoutConfig;
 
+// On-screen keyboard panel; width is 0 in views without one
+typedef struct {
+    int x;
+    int y;
+    int width;
+    int height;
+    int key_width;
+    int key_height;
+    int key_spacing;
+} KeyboardLayout;
+
+// One line of wrapped text: a span of the source string
+typedef struct {
+    int start;
+    int length;
+} TextLine;
+
+// Width in pixels of text[0..length)
+typedef int (*TextMeasureFunction)(void* context, const char* text, int length);
+
+typedef struct {
+    int key;                // GameKey the key types
+    int x;                  // Relative to the panel
+    int y;
+    int width;
+    int height;
+} KeyboardKeyRect;
+
 #endif
\ No newline at end of file
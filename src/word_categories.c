@@ -0,0 +1,239 @@
+#include "systems.h"
+#include "worddb.h"
+
+// Themed word categories. A category is a set of .cwdb files, one per word
+// length, holding its words in the packed dictionary format. Membership is
+// kept as one bitmap per category over each length's dictionary index (bit i
+// is dictionary word i), so "a word from categories A or B not seen yet" is an
+// OR of bitmaps, an AND-NOT with the seen bits and a select of the k-th set
+// bit, with no search of any word list. Like the word selectors, the bitmaps
+// are rebuilt when the dictionary they were built for is replaced.
+
+typedef struct {
+    char name[WORD_CATEGORY_NAME_LENGTH];
+    WordDatabase lists[WORD_LENGTH_MODE_COUNT];  // Mapped category files; mapping is NULL where absent
+} WordCategory;
+
+typedef struct {
+    const PackedWord* words;                  // Dictionary the bitmaps were built for
+    int count;
+    uint32_t version;                         // category_version at the build
+    int chunk_count;
+    uint64_t* bits;                           // [category][chunk]
+} CategoryIndex;
+
+static WordCategory word_categories[WORD_CATEGORY_MAX];
+static int word_category_total = 0;
+static uint32_t category_version = 1;         // Bumped when categories are loaded or unloaded
+static CategoryIndex category_indices[WORD_LENGTH_MODE_COUNT];
+
+// ============= LOADING =============
+
+// Loads <directory>/<name>_<n>.cwdb for every supported length as one
+// category. Returns its index, or -1 if no file was found or the table is full.
+int load_word_category(const char* directory, const char* name) {
+    if (word_category_total == WORD_CATEGORY_MAX || name[0] == '\0' ||
+        strlen(name) >= WORD_CATEGORY_NAME_LENGTH) {
+        return -1;
+    }
+    WordCategory* category = &word_categories[word_category_total];
+    memset(category, 0, sizeof(*category));
+    int found = 0;
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s_%d.cwdb", directory, name, length);
+        WordDatabase* list = &category->lists[length - MIN_WORD_LENGTH];
+        if (!word_db_open(path, list)) {
+            continue;
+        }
+        if (list->word_length != length) {
+            word_db_close(list);
+            continue;
+        }
+        found++;
+    }
+    if (found == 0) {
+        return -1;
+    }
+    strcpy(category->name, name);
+    category_version++;
+    return word_category_total++;
+}
+
+// Loads the categories named in <directory>/categories.txt, one per line
+// ('#' starts a comment). Returns how many were loaded.
+int load_word_categories(const char* directory) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/categories.txt", directory);
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return 0;
+    }
+    int loaded = 0;
+    char line[WORD_CATEGORY_NAME_LENGTH + 64];
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "#\r\n")] = '\0';
+        char* name = line + strspn(line, " \t");
+        name[strcspn(name, " \t")] = '\0';
+        if (name[0] != '\0' && word_category_find(name) < 0) {
+            loaded += load_word_category(directory, name) >= 0;
+        }
+    }
+    fclose(file);
+    return loaded;
+}
+
+void unload_word_categories(void) {
+    for (int c = 0; c < word_category_total; c++) {
+        for (int i = 0; i < WORD_LENGTH_MODE_COUNT; i++) {
+            word_db_close(&word_categories[c].lists[i]);
+        }
+    }
+    memset(word_categories, 0, sizeof(word_categories));
+    word_category_total = 0;
+    category_version++;
+    for (int i = 0; i < WORD_LENGTH_MODE_COUNT; i++) {
+        free(category_indices[i].bits);
+        memset(&category_indices[i], 0, sizeof(category_indices[i]));
+    }
+}
+
+int word_category_count(void) {
+    return word_category_total;
+}
+
+const char* word_category_name(int category) {
+    return category >= 0 && category < word_category_total ? word_categories[category].name : NULL;
+}
+
+int word_category_find(const char* name) {
+    for (int c = 0; c < word_category_total; c++) {
+        if (strcmp(word_categories[c].name, name) == 0) {
+            return c;
+        }
+    }
+    return -1;
+}
+
+// ============= BITMAPS =============
+
+// Category bitmaps for a length, rebuilt if the dictionary or the categories
+// changed since the last build. NULL if the length has no dictionary.
+static const CategoryIndex* get_category_index(int word_length) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    if (!dictionary || dictionary->count == 0) {
+        return NULL;
+    }
+    CategoryIndex* index = &category_indices[word_length - MIN_WORD_LENGTH];
+    if (index->words == dictionary->words && index->count == dictionary->count && index->version == category_version) {
+        return index;
+    }
+
+    free(index->bits);
+    memset(index, 0, sizeof(*index));
+    int chunk_count = (dictionary->count + 63) / 64;
+    index->bits = calloc((size_t)(word_category_total > 0 ? word_category_total : 1) * (size_t)chunk_count,
+                         sizeof(uint64_t));
+    if (!index->bits) {
+        return NULL;
+    }
+    index->words = dictionary->words;
+    index->count = dictionary->count;
+    index->version = category_version;
+    index->chunk_count = chunk_count;
+
+    // Both lists are sorted: one merge pass per category
+    for (int c = 0; c < word_category_total; c++) {
+        const WordDatabase* list = &word_categories[c].lists[word_length - MIN_WORD_LENGTH];
+        uint64_t* bits = index->bits + (size_t)c * (size_t)chunk_count;
+        int d = 0;
+        for (int i = 0; list->mapping && i < list->word_count && d < dictionary->count; i++) {
+            while (d < dictionary->count && dictionary->words[d] < list->words[i]) {
+                d++;
+            }
+            if (d < dictionary->count && dictionary->words[d] == list->words[i]) {
+                bits[d >> 6] |= 1ull << (d & 63);
+            }
+        }
+    }
+    return index;
+}
+
+// Chunks (64 words each) in a bitmap over a length's dictionary
+int word_category_chunks(int word_length) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    return dictionary ? (dictionary->count + 63) / 64 : 0;
+}
+
+// Words in any of `categories` (bit c is category c; 0 is every word) and not
+// in `exclude` (NULL for none), as a bitmap of word_category_chunks() chunks.
+// Returns how many there are, or -1 if the length has no dictionary.
+int word_category_filter(int word_length, uint32_t categories, const uint64_t* exclude, uint64_t* out_bits) {
+    const CategoryIndex* index = get_category_index(word_length);
+    if (!index) {
+        return -1;
+    }
+    if (categories == 0) {
+        for (int k = 0; k < index->chunk_count; k++) {
+            out_bits[k] = ~0ull;
+        }
+        if (index->count % 64 != 0) {
+            out_bits[index->chunk_count - 1] = (1ull << (index->count % 64)) - 1;
+        }
+    } else {
+        memset(out_bits, 0, sizeof(uint64_t) * (size_t)index->chunk_count);
+        for (int c = 0; c < word_category_total; c++) {
+            if (categories & (1u << c)) {
+                const uint64_t* bits = index->bits + (size_t)c * (size_t)index->chunk_count;
+                for (int k = 0; k < index->chunk_count; k++) {
+                    out_bits[k] |= bits[k];
+                }
+            }
+        }
+    }
+
+    int members = 0;
+    for (int k = 0; k < index->chunk_count; k++) {
+        if (exclude) {
+            out_bits[k] &= ~exclude[k];
+        }
+        members += __builtin_popcountll(out_bits[k]);
+    }
+    return members;
+}
+
+// Set bits of `bits` in [begin, end)
+int word_bitmap_count(const uint64_t* bits, int begin, int end) {
+    int count = 0;
+    for (int k = begin >> 6; begin < end; k++) {
+        uint64_t chunk = bits[k] & (~0ull << (begin & 63));
+        int chunk_end = (k + 1) * 64;
+        if (end < chunk_end) {
+            chunk &= (1ull << (end & 63)) - 1;
+        }
+        count += __builtin_popcountll(chunk);
+        begin = chunk_end;
+    }
+    return count;
+}
+
+// Index of the k-th (0-based) set bit of `bits` in [begin, end), or -1
+int word_bitmap_select(const uint64_t* bits, int begin, int end, int k) {
+    for (int c = begin >> 6; begin < end && k >= 0; c++) {
+        uint64_t chunk = bits[c] & (~0ull << (begin & 63));
+        int chunk_end = (c + 1) * 64;
+        if (end < chunk_end) {
+            chunk &= (1ull << (end & 63)) - 1;
+        }
+        int count = __builtin_popcountll(chunk);
+        if (k < count) {
+            for (; k > 0; k--) {
+                chunk &= chunk - 1;
+            }
+            return c * 64 + __builtin_ctzll(chunk);
+        }
+        k -= count;
+        begin = chunk_end;
+    }
+    return -1;
+}
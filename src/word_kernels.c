@@ -0,0 +1,73 @@
+#include "systems.h"
+
+// Fixed-length word kernels, instantiated once per supported word length.
+// Each instantiation has a compile-time trip count, so the compiler fully
+// unrolls the loops instead of running a generic runtime-length loop.
+
+#define LETTER_BIT(c) (((unsigned)((c) - 'A') < 26u) ? (1u << ((c) - 'A')) : 0u)
+// Packed letter code 1-26 as text; a mapped database is not rescanned on open,
+// so any other code decodes as 'A' rather than a character past the alphabet
+#define UNPACK_LETTER(code) ((char)('A' - 1 + (((unsigned)(code) - 1u < 26u) ? (unsigned)(code) : 1u)))
+
+#define DEFINE_WORD_KERNELS(N)                                                             \
+    static void score_guess_##N(const char* guess, const char* target, LetterState* out) { \
+        uint32_t target_mask = 0;                                                          \
+        for (int i = 0; i < N; i++) {                                                      \
+            target_mask |= LETTER_BIT(target[i]);                                          \
+        }                                                                                  \
+        for (int i = 0; i < N; i++) {                                                      \
+            out[i] = (guess[i] == target[i]) ? LETTER_CORRECT                              \
+                   : (target_mask & LETTER_BIT(guess[i])) ? LETTER_WRONG_POS               \
+                   : LETTER_NOT_IN_WORD;                                                   \
+        }                                                                                  \
+    }                                                                                      \
+                                                                                           \
+    static int words_match_##N(const char* a, const char* b) {                             \
+        int mismatch = 0;                                                                  \
+        for (int i = 0; i < N; i++) {                                                      \
+            mismatch |= a[i] ^ b[i];                                                       \
+        }                                                                                  \
+        return mismatch == 0;                                                              \
+    }                                                                                      \
+                                                                                           \
+    static PackedWord pack_word_##N(const char* word) {                                    \
+        PackedWord packed = 0;                                                             \
+        for (int i = 0; i < N; i++) {                                                      \
+            packed = (packed << PACKED_LETTER_BITS) | (PackedWord)(word[i] - 'A' + 1);     \
+        }                                                                                  \
+        return packed;                                                                     \
+    }                                                                                      \
+                                                                                           \
+    static void unpack_word_##N(PackedWord packed, char* out_word) {                       \
+        for (int i = N - 1; i >= 0; i--) {                                                 \
+            out_word[i] = UNPACK_LETTER(packed & PACKED_LETTER_MASK);                      \
+            packed >>= PACKED_LETTER_BITS;                                                 \
+        }                                                                                  \
+        out_word[N] = '\0';                                                                \
+    }
+
+DEFINE_WORD_KERNELS(4)
+DEFINE_WORD_KERNELS(5)
+DEFINE_WORD_KERNELS(6)
+DEFINE_WORD_KERNELS(7)
+
+#define WORD_KERNEL_ENTRY(N) \
+    {N, N + (N - 1) * CELL_SPACING_RATIO, score_guess_##N, words_match_##N, pack_word_##N, unpack_word_##N}
+
+static const WordKernels WORD_KERNELS[WORD_LENGTH_MODE_COUNT] = {
+    WORD_KERNEL_ENTRY(4),
+    WORD_KERNEL_ENTRY(5),
+    WORD_KERNEL_ENTRY(6),
+    WORD_KERNEL_ENTRY(7),
+};
+
+int is_supported_word_length(int word_length) {
+    return word_length >= MIN_WORD_LENGTH && word_length <= MAX_WORD_LENGTH;
+}
+
+const WordKernels* get_word_kernels(int word_length) {
+    if (!is_supported_word_length(word_length)) {
+        word_length = DEFAULT_WORD_LENGTH;
+    }
+    return &WORD_KERNELS[word_length - MIN_WORD_LENGTH];
+}
@@ -0,0 +1,391 @@
+#include "systems.h"
+#include "jobs.h"
+#include "worddb.h"
+
+// Level-aware target word selection.
+//
+// Every dictionary word gets a difficulty score (letter rarity, repeated letters
+// and, for built-in sized lists, how many guesses the solver needs). Words are
+// split into equal-size difficulty buckets, each with a frequency-weighted alias
+// table, so drawing a word for a level is O(1). Recently drawn words are tracked
+// in a bitset over the dictionary plus a ring of indices, so repeats within the
+// window are rejected without searching. If a few redraws keep landing on recent
+// words, the word is picked uniformly from the bucket's remaining words instead.
+
+typedef struct {
+    const PackedWord* words;        // Dictionary this selector was built for
+    int count;
+    uint8_t* difficulty;            // Combined per-word difficulty 0..255
+    int* bucket_words;              // Word indices grouped by bucket, easiest first
+    uint32_t* alias_threshold;      // Vose alias table, parallel to bucket_words
+    int* alias_index;               // Alias slot, relative to the bucket start
+    int bucket_start[DIFFICULTY_BUCKET_COUNT + 1];
+    uint64_t* recent_bits;          // One bit per dictionary word
+    int* recent_ring;               // Last repeat_window draws
+    int recent_capacity;
+    int recent_count;
+    int recent_head;
+} WordSelector;
+
+static WordSelector word_selectors[WORD_LENGTH_MODE_COUNT];
+static int word_repeat_window = DEFAULT_WORD_REPEAT_WINDOW;
+static uint64_t selector_rng_state = 0;
+
+// xorshift64*; state must be nonzero
+static uint32_t xorshift64star(uint64_t* state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return (uint32_t)((*state * 0x2545F4914F6CDD1Dull) >> 32);
+}
+
+static uint32_t selector_random(void) {
+    if (selector_rng_state == 0) {
+        initialize_random_seed();
+        selector_rng_state = ((uint64_t)rand() << 32) ^ (uint64_t)rand() ^ 0x9E3779B97F4A7C15ull;
+    }
+    return xorshift64star(&selector_rng_state);
+}
+
+static void free_selector(WordSelector* selector) {
+    free(selector->difficulty);
+    free(selector->bucket_words);
+    free(selector->alias_threshold);
+    free(selector->alias_index);
+    free(selector->recent_bits);
+    free(selector->recent_ring);
+    memset(selector, 0, sizeof(*selector));
+}
+
+#define SOLVER_WORDS_PER_JOB 64
+
+typedef struct {
+    const WordDictionary* dictionary;
+    uint16_t* matrix;
+    uint8_t* difficulty;
+} SolverScores;
+
+// Words [begin, end); each solve is independent, so jobs run them in parallel
+static void add_solver_scores(void* context, int begin, int end) {
+    const SolverScores* scores = context;
+    int* scratch = malloc((size_t)scores->dictionary->count * sizeof(int));
+    if (!scratch) {
+        return;
+    }
+    for (int i = begin; i < end; i++) {
+        int guesses = solver_guess_count(scores->dictionary, scores->matrix, i, scratch);
+        int solve_score = (guesses - 1) * 255 / (SOLVER_MAX_GUESSES - 1);
+        scores->difficulty[i] = (uint8_t)((scores->difficulty[i] + solve_score) / 2);
+    }
+    free(scratch);
+}
+
+static void compute_difficulty(const WordDictionary* dictionary, uint8_t* out_difficulty) {
+    int count = dictionary->count;
+
+    // Packed databases ship their difficulty precomputed
+    if (dictionary->difficulty) {
+        memcpy(out_difficulty, dictionary->difficulty, (size_t)count);
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        out_difficulty[i] = word_db_static_difficulty(dictionary->words[i], dictionary->word_length);
+    }
+
+    // Small lists also get the solver's guess count, weighted equally
+    SolverScores scores = {dictionary, build_feedback_matrix(dictionary), out_difficulty};
+    if (scores.matrix) {
+        jobs_parallel_for(count, SOLVER_WORDS_PER_JOB, add_solver_scores, &scores);
+    }
+    free(scores.matrix);
+}
+
+// Vose's alias method over one bucket; weights are frequency + 1
+static void build_alias_table(WordSelector* selector, const WordDictionary* dictionary, int start, int size) {
+    double* scaled = malloc((size_t)size * sizeof(double));
+    int* small = malloc((size_t)size * sizeof(int));
+    int* large = malloc((size_t)size * sizeof(int));
+    if (!scaled || !small || !large) {
+        // Fall back to a uniform table
+        for (int i = 0; i < size; i++) {
+            selector->alias_threshold[start + i] = UINT32_MAX;
+            selector->alias_index[start + i] = i;
+        }
+        free(scaled);
+        free(small);
+        free(large);
+        return;
+    }
+
+    double total = 0.0;
+    for (int i = 0; i < size; i++) {
+        int word = selector->bucket_words[start + i];
+        scaled[i] = 1.0 + (dictionary->frequency ? dictionary->frequency[word] : 0);
+        total += scaled[i];
+    }
+
+    int small_count = 0;
+    int large_count = 0;
+    for (int i = 0; i < size; i++) {
+        scaled[i] = scaled[i] * size / total;
+        if (scaled[i] < 1.0) {
+            small[small_count++] = i;
+        } else {
+            large[large_count++] = i;
+        }
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        int less = small[--small_count];
+        int more = large[--large_count];
+        selector->alias_threshold[start + less] = (uint32_t)(scaled[less] * 4294967295.0);
+        selector->alias_index[start + less] = more;
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0) {
+            small[small_count++] = more;
+        } else {
+            large[large_count++] = more;
+        }
+    }
+    // Leftovers are full columns (rounding error aside)
+    while (large_count > 0) {
+        int slot = large[--large_count];
+        selector->alias_threshold[start + slot] = UINT32_MAX;
+        selector->alias_index[start + slot] = slot;
+    }
+    while (small_count > 0) {
+        int slot = small[--small_count];
+        selector->alias_threshold[start + slot] = UINT32_MAX;
+        selector->alias_index[start + slot] = slot;
+    }
+
+    free(scaled);
+    free(small);
+    free(large);
+}
+
+static void reset_recent_window(WordSelector* selector) {
+    free(selector->recent_ring);
+    int capacity = word_repeat_window;
+    // Never demand more distinct words than the smallest bucket can supply
+    int smallest_bucket = selector->count / DIFFICULTY_BUCKET_COUNT;
+    if (capacity > smallest_bucket / 2) {
+        capacity = smallest_bucket / 2;
+        GAME_LOG_WARN(LOG_EVENT_WORD_REPEAT_WINDOW_CUT, word_repeat_window, capacity, NULL);
+    }
+    selector->recent_capacity = capacity > 0 ? capacity : 0;
+    selector->recent_ring = capacity > 0 ? malloc((size_t)capacity * sizeof(int)) : NULL;
+    if (!selector->recent_ring) {
+        selector->recent_capacity = 0;
+    }
+    selector->recent_count = 0;
+    selector->recent_head = 0;
+    if (selector->recent_bits) {
+        memset(selector->recent_bits, 0, (size_t)((selector->count + 63) / 64) * sizeof(uint64_t));
+    }
+}
+
+static int difficulty_sort_count[256];
+
+static WordSelector* get_word_selector(int word_length) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    if (!dictionary || dictionary->count == 0) {
+        return NULL;
+    }
+
+    WordSelector* selector = &word_selectors[word_length - MIN_WORD_LENGTH];
+    if (selector->words == dictionary->words && selector->count == dictionary->count) {
+        return selector;
+    }
+
+    // Dictionary changed (first use or a database was loaded): rebuild
+    free_selector(selector);
+    int count = dictionary->count;
+    selector->difficulty = malloc((size_t)count);
+    selector->bucket_words = malloc((size_t)count * sizeof(int));
+    selector->alias_threshold = malloc((size_t)count * sizeof(uint32_t));
+    selector->alias_index = malloc((size_t)count * sizeof(int));
+    selector->recent_bits = calloc((size_t)(count + 63) / 64, sizeof(uint64_t));
+    if (!selector->difficulty || !selector->bucket_words || !selector->alias_threshold ||
+        !selector->alias_index || !selector->recent_bits) {
+        free_selector(selector);
+        return NULL;
+    }
+    selector->words = dictionary->words;
+    selector->count = count;
+
+    compute_difficulty(dictionary, selector->difficulty);
+
+    // Counting sort by difficulty keeps equal scores in dictionary order
+    memset(difficulty_sort_count, 0, sizeof(difficulty_sort_count));
+    for (int i = 0; i < count; i++) {
+        difficulty_sort_count[selector->difficulty[i]]++;
+    }
+    int running = 0;
+    for (int d = 0; d < 256; d++) {
+        int bucket_size = difficulty_sort_count[d];
+        difficulty_sort_count[d] = running;
+        running += bucket_size;
+    }
+    for (int i = 0; i < count; i++) {
+        selector->bucket_words[difficulty_sort_count[selector->difficulty[i]]++] = i;
+    }
+
+    // Equal-size buckets by difficulty rank, so every bucket is populated
+    for (int b = 0; b <= DIFFICULTY_BUCKET_COUNT; b++) {
+        selector->bucket_start[b] = (int)((int64_t)count * b / DIFFICULTY_BUCKET_COUNT);
+    }
+    for (int b = 0; b < DIFFICULTY_BUCKET_COUNT; b++) {
+        int start = selector->bucket_start[b];
+        int size = selector->bucket_start[b + 1] - start;
+        if (size > 0) {
+            build_alias_table(selector, dictionary, start, size);
+        }
+    }
+
+    reset_recent_window(selector);
+    return selector;
+}
+
+int difficulty_bucket_for_level(int level) {
+    int bucket = (level - 1) / LEVELS_PER_DIFFICULTY_BUCKET;
+    if (bucket < 0) bucket = 0;
+    if (bucket >= DIFFICULTY_BUCKET_COUNT) bucket = DIFFICULTY_BUCKET_COUNT - 1;
+    return bucket;
+}
+
+static int draw_from_bucket_with(const WordSelector* selector, int bucket, uint64_t* rng_state) {
+    int start = selector->bucket_start[bucket];
+    int size = selector->bucket_start[bucket + 1] - start;
+    int slot = (int)(xorshift64star(rng_state) % (uint32_t)size);
+    if (xorshift64star(rng_state) > selector->alias_threshold[start + slot]) {
+        slot = selector->alias_index[start + slot];
+    }
+    return selector->bucket_words[start + slot];
+}
+
+static int draw_from_bucket(const WordSelector* selector, int bucket) {
+    selector_random();   // Seeds the shared state on first use
+    return draw_from_bucket_with(selector, bucket, &selector_rng_state);
+}
+
+static void remember_word(WordSelector* selector, int word) {
+    if (selector->recent_capacity == 0) {
+        return;
+    }
+    if (selector->recent_count == selector->recent_capacity) {
+        int oldest = selector->recent_ring[selector->recent_head];
+        selector->recent_bits[oldest >> 6] &= ~(1ull << (oldest & 63));
+    } else {
+        selector->recent_count++;
+    }
+    selector->recent_ring[selector->recent_head] = word;
+    selector->recent_head = (selector->recent_head + 1) % selector->recent_capacity;
+    selector->recent_bits[word >> 6] |= 1ull << (word & 63);
+}
+
+static int is_recent(const WordSelector* selector, int word) {
+    return (int)((selector->recent_bits[word >> 6] >> (word & 63)) & 1ull);
+}
+
+// Uniform pick among the bucket's words outside the window. The window is at
+// most half the smallest bucket, so there is always at least one.
+static int draw_unrecent_from_bucket(const WordSelector* selector, int bucket) {
+    int start = selector->bucket_start[bucket];
+    int end = selector->bucket_start[bucket + 1];
+    int available = 0;
+    for (int i = start; i < end; i++) {
+        available += !is_recent(selector, selector->bucket_words[i]);
+    }
+    int pick = (int)(selector_random() % (uint32_t)available);
+    for (int i = start; ; i++) {
+        if (!is_recent(selector, selector->bucket_words[i]) && pick-- == 0) {
+            return selector->bucket_words[i];
+        }
+    }
+}
+
+// Draws a target word whose difficulty suits `level`, never one of the last
+// get_word_repeat_window draws
+void get_word_for_level(int word_length, int level, char* out_word) {
+    WordSelector* selector = get_word_selector(word_length);
+    if (!selector) {
+        get_random_word(word_length, out_word);
+        return;
+    }
+
+    int bucket = difficulty_bucket_for_level(level);
+    int word = draw_from_bucket(selector, bucket);
+    for (int attempt = 1; attempt < WORD_DRAW_MAX_ATTEMPTS && is_recent(selector, word); attempt++) {
+        word = draw_from_bucket(selector, bucket);
+    }
+    if (is_recent(selector, word)) {
+        word = draw_unrecent_from_bucket(selector, bucket);
+    }
+
+    remember_word(selector, word);
+    get_word_kernels(word_length)->unpack(get_word_dictionary(word_length)->words[word], out_word);
+}
+
+// Same, but from the words of the `theme` categories when it names any of this
+// length. Themes are too small for difficulty tiers, so a themed draw is
+// uniform; it still skips the repeat window until every themed word is in it.
+void get_themed_word_for_level(int word_length, int level, uint32_t theme, char* out_word) {
+    WordSelector* selector = theme != 0 ? get_word_selector(word_length) : NULL;
+    if (!selector) {
+        get_word_for_level(word_length, level, out_word);
+        return;
+    }
+
+    int word = get_random_category_word(word_length, theme, selector->recent_bits, out_word);
+    if (word < 0) {
+        word = get_random_category_word(word_length, theme, NULL, out_word);
+    }
+    if (word < 0) {
+        get_word_for_level(word_length, level, out_word);
+        return;
+    }
+    remember_word(selector, word);
+}
+
+int get_word_difficulty(int word_length, const char* word) {
+    WordSelector* selector = get_word_selector(word_length);
+    if (!selector) {
+        return -1;
+    }
+    int index = dictionary_find(get_word_dictionary(word_length), get_word_kernels(word_length)->pack(word));
+    return index >= 0 ? selector->difficulty[index] : -1;
+}
+
+// Builds every length's selector up front. After this, and as long as no word
+// database is loaded, draw_word_index_for_level may be called from any thread.
+void prepare_word_selectors(void) {
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        get_word_selector(length);
+    }
+}
+
+// Reentrant draw for a level's difficulty tier using the caller's RNG state
+// (nonzero). No repeat window. Returns the dictionary index, or -1.
+int draw_word_index_for_level(int word_length, int level, uint64_t* rng_state) {
+    WordSelector* selector = get_word_selector(word_length);
+    if (!selector) {
+        return -1;
+    }
+    return draw_from_bucket_with(selector, difficulty_bucket_for_level(level), rng_state);
+}
+
+int get_word_repeat_window(int word_length) {
+    WordSelector* selector = get_word_selector(word_length);
+    return selector ? selector->recent_capacity : 0;
+}
+
+void set_word_repeat_window(int window) {
+    word_repeat_window = window > 0 ? window : 0;
+    for (int i = 0; i < WORD_LENGTH_MODE_COUNT; i++) {
+        if (word_selectors[i].words) {
+            reset_recent_window(&word_selectors[i]);
+        }
+    }
+}
@@ -0,0 +1,233 @@
+#include "worddb.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static uint64_t align8(uint64_t offset) {
+    return (offset + 7u) & ~(uint64_t)7u;
+}
+
+uint64_t word_db_pack_word(const char* word, int word_length) {
+    if (word_length <= 0 || word_length > WORD_DB_MAX_WORD_LENGTH) {
+        return 0;
+    }
+    
+    uint64_t packed = 0;
+    for (int i = 0; i < word_length; i++) {
+        char c = word[i];
+        if (c < 'A' || c > 'Z') {
+            return 0;
+        }
+        packed = (packed << WORD_DB_LETTER_BITS) | (uint64_t)(c - 'A' + 1);
+    }
+    return word[word_length] == '\0' ? packed : 0;
+}
+
+// Relative English letter frequencies (per 1000 letters), A..Z
+static const int LETTER_FREQUENCY[26] = {
+    82, 15, 28, 43, 127, 22, 20, 61, 70, 2, 8, 40, 24,
+    67, 75, 19, 1, 60, 63, 91, 28, 10, 24, 2, 20, 1
+};
+
+uint8_t word_db_static_difficulty(uint64_t packed_word, int word_length) {
+    int rarity = 0;
+    int seen = 0;
+    int duplicates = 0;
+    
+    for (int i = 0; i < word_length; i++) {
+        int letter = (int)((packed_word >> (WORD_DB_LETTER_BITS * i)) & 0x1F) - 1;
+        if (letter < 0 || letter >= 26) {
+            continue;
+        }
+        rarity += 127 - LETTER_FREQUENCY[letter];
+        if (seen & (1 << letter)) {
+            duplicates++;
+        }
+        seen |= 1 << letter;
+    }
+    
+    int score = rarity * 160 / (127 * word_length) + duplicates * 40;
+    return (uint8_t)(score > 255 ? 255 : score);
+}
+
+void* word_db_map_file(const char* path, size_t* out_size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return NULL;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) {
+        return NULL;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    *out_size = (size_t)size.QuadPart;
+    return view;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        return NULL;
+    }
+    *out_size = (size_t)info.st_size;
+    return view;
+#endif
+}
+
+void word_db_unmap_file(void* view, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(view);
+#else
+    munmap(view, size);
+#endif
+}
+
+int word_db_section_fits(uint64_t offset, uint64_t count, uint64_t element_size, uint64_t size) {
+    // Subtraction form: offset + count * element_size could wrap
+    return offset <= size && count <= (size - offset) / element_size;
+}
+
+int word_db_words_are_valid(const uint64_t* words, uint64_t count, int word_length) {
+    uint64_t bad = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t word = words[i];
+        bad |= word >> (WORD_DB_LETTER_BITS * word_length);
+        for (int j = 0; j < word_length; j++) {
+            uint64_t letter = (word >> (WORD_DB_LETTER_BITS * j)) & 31;
+            bad |= (uint64_t)(letter == 0 || letter > 26);
+        }
+    }
+    return bad == 0;
+}
+
+int word_db_open(const char* path, WordDatabase* out_database) {
+    memset(out_database, 0, sizeof(*out_database));
+    
+    size_t size = 0;
+    void* view = word_db_map_file(path, &size);
+    if (!view) {
+        return 0;
+    }
+    
+    const WordDbHeader* header = (const WordDbHeader*)view;
+    uint64_t count = (size >= sizeof(WordDbHeader)) ? header->word_count : 0;
+    int valid = size >= sizeof(WordDbHeader) &&
+                header->magic == WORD_DB_MAGIC &&
+                header->version == WORD_DB_VERSION &&
+                (header->flags & WORD_DB_FLAG_LETTERS_CHECKED) &&
+                header->word_length > 0 && header->word_length <= WORD_DB_MAX_WORD_LENGTH &&
+                header->file_size == size &&
+                header->words_offset % 8 == 0 &&
+                word_db_section_fits(header->words_offset, count, sizeof(uint64_t), size) &&
+                word_db_section_fits(header->difficulty_offset, count, sizeof(uint8_t), size) &&
+                header->frequency_offset % 2 == 0 &&
+                word_db_section_fits(header->frequency_offset, count, sizeof(uint16_t), size);
+    if (!valid) {
+        word_db_unmap_file(view, size);
+        return 0;
+    }
+    
+    const uint8_t* base = (const uint8_t*)view;
+    out_database->header = header;
+    out_database->words = (const uint64_t*)(base + header->words_offset);
+    out_database->difficulty = base + header->difficulty_offset;
+    out_database->frequency = (const uint16_t*)(base + header->frequency_offset);
+    out_database->word_length = (int)header->word_length;
+    out_database->word_count = (int)header->word_count;
+    out_database->mapping = view;
+    out_database->mapping_size = size;
+    return 1;
+}
+
+void word_db_close(WordDatabase* database) {
+    if (database->mapping) {
+        word_db_unmap_file(database->mapping, database->mapping_size);
+    }
+    memset(database, 0, sizeof(*database));
+}
+
+static int write_padding(FILE* file, uint64_t from, uint64_t to) {
+    static const uint8_t zeros[8] = {0};
+    return to == from || fwrite(zeros, 1, (size_t)(to - from), file) == (size_t)(to - from);
+}
+
+int word_db_write(const char* path, int word_length, const uint64_t* words,
+                  const uint8_t* difficulty, const uint16_t* frequency, int word_count) {
+    if (word_length <= 0 || word_length > WORD_DB_MAX_WORD_LENGTH || word_count < 0 ||
+        !word_db_words_are_valid(words, (uint64_t)word_count, word_length)) {
+        return 0;
+    }
+    
+    uint64_t count = (uint64_t)word_count;
+    WordDbHeader header = {0};
+    header.magic = WORD_DB_MAGIC;
+    header.version = WORD_DB_VERSION;
+    header.word_length = (uint32_t)word_length;
+    header.word_count = (uint32_t)word_count;
+    header.flags = WORD_DB_FLAG_LETTERS_CHECKED;
+    header.words_offset = align8(sizeof(WordDbHeader));
+    header.difficulty_offset = align8(header.words_offset + count * sizeof(uint64_t));
+    header.frequency_offset = align8(header.difficulty_offset + count * sizeof(uint8_t));
+    header.file_size = align8(header.frequency_offset + count * sizeof(uint16_t));
+    
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return 0;
+    }
+    
+    int ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && write_padding(file, sizeof(header), header.words_offset);
+    ok = ok && fwrite(words, sizeof(uint64_t), count, file) == count;
+    ok = ok && write_padding(file, header.words_offset + count * sizeof(uint64_t), header.difficulty_offset);
+    
+    if (difficulty) {
+        ok = ok && fwrite(difficulty, sizeof(uint8_t), count, file) == count;
+    } else {
+        for (uint64_t i = 0; ok && i < count; i++) {
+            ok = fputc(0, file) != EOF;
+        }
+    }
+    ok = ok && write_padding(file, header.difficulty_offset + count, header.frequency_offset);
+    
+    if (frequency) {
+        ok = ok && fwrite(frequency, sizeof(uint16_t), count, file) == count;
+    } else {
+        static const uint16_t zero = 0;
+        for (uint64_t i = 0; ok && i < count; i++) {
+            ok = fwrite(&zero, sizeof(zero), 1, file) == 1;
+        }
+    }
+    ok = ok && write_padding(file, header.frequency_offset + count * sizeof(uint16_t), header.file_size);
+    
+    if (fclose(file) != 0) {
+        ok = 0;
+    }
+    return ok;
+}
@@ -0,0 +1,80 @@
+#ifndef WORDDB_H
+#define WORDDB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Packed word database file (.cwdb)
+//
+// Layout (little-endian, every section 8-byte aligned):
+//   WordDbHeader
+//   uint64_t words[word_count]        5 bits per letter, A=1..Z=26, first letter
+//                                     in the highest bits; sorted ascending
+//   uint8_t  difficulty[word_count]   0 (easiest) .. 255 (hardest)
+//   uint16_t frequency[word_count]    relative usage frequency, 0 = unknown
+//
+// The word array uses the same encoding as PackedWord in types.h, so a mapped
+// file can be used as a WordDictionary directly with no parsing step. The
+// writer checks every letter and records that in flags; opening trusts the
+// flag and never scans the words, so startup does not grow with the list.
+
+#define WORD_DB_MAGIC 0x42445743u            // "CWDB"
+#define WORD_DB_VERSION 2u                   // 2: flags
+#define WORD_DB_FLAG_LETTERS_CHECKED 1u      // Every word holds only letters 1-26
+#define WORD_DB_LETTER_BITS 5
+#define WORD_DB_MAX_WORD_LENGTH 12           // 12 * 5 bits fits in 64
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t word_length;
+    uint32_t word_count;
+    uint32_t flags;                          // WORD_DB_FLAG_*
+    uint32_t reserved;
+    uint64_t words_offset;
+    uint64_t difficulty_offset;
+    uint64_t frequency_offset;
+    uint64_t file_size;
+} WordDbHeader;
+
+// A mapped database; all pointers point into the mapping
+typedef struct {
+    const WordDbHeader* header;
+    const uint64_t* words;
+    const uint8_t* difficulty;
+    const uint16_t* frequency;
+    int word_length;
+    int word_count;
+    void* mapping;
+    size_t mapping_size;
+} WordDatabase;
+
+// Maps a database file read-only. Validates the header, including the
+// letters-checked flag, in constant time. Returns 1 on success.
+int word_db_open(const char* path, WordDatabase* out_database);
+void word_db_close(WordDatabase* database);
+
+// 1 if every word holds word_length letters of 1-26 and nothing above them
+int word_db_words_are_valid(const uint64_t* words, uint64_t count, int word_length);
+
+// Writes a database. words must be sorted ascending and unique and pass
+// word_db_words_are_valid; difficulty and frequency may be NULL (written as
+// zeros). Returns 1 on success.
+int word_db_write(const char* path, int word_length, const uint64_t* words,
+                  const uint8_t* difficulty, const uint16_t* frequency, int word_count);
+
+// Read-only whole-file mapping, also used for the daily calendar (.cwcal).
+// Returns NULL for a missing or empty file.
+void* word_db_map_file(const char* path, size_t* out_size);
+void word_db_unmap_file(void* view, size_t size);
+// 1 if `count` elements of `element_size` bytes at `offset` lie within `size`
+// bytes, without the overflow of offset + count * element_size
+int word_db_section_fits(uint64_t offset, uint64_t count, uint64_t element_size, uint64_t size);
+
+// Packs an uppercase A-Z word of the given length; returns 0 if it is not one
+uint64_t word_db_pack_word(const char* word, int word_length);
+
+// Dictionary-independent difficulty (0..255) from letter rarity and repeated letters
+uint8_t word_db_static_difficulty(uint64_t packed_word, int word_length);
+
+#endif
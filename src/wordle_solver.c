@@ -0,0 +1,132 @@
+#include "systems.h"
+#include "jobs.h"
+
+// Feedback codes and a small greedy Wordle solver used to rate how many guesses
+// a target word takes to find. Feedback uses the same rules as the game's
+// scoring kernels, so a code identifies exactly what the player would see.
+
+// Base-3 encoding of per-letter feedback (fits in 16 bits up to 10 letters)
+uint16_t feedback_code(const LetterState* states, int word_length) {
+    uint16_t code = 0;
+    for (int i = word_length - 1; i >= 0; i--) {
+        code = (uint16_t)(code * 3 + (states[i] - LETTER_CORRECT));
+    }
+    return code;
+}
+
+#define FEEDBACK_ROWS_PER_JOB 32
+
+typedef struct {
+    const WordKernels* kernels;
+    const char* words;          // Unpacked, `stride` bytes apart
+    int stride;
+    int count;
+    uint16_t* matrix;
+} FeedbackRows;
+
+// Guess rows [begin, end); rows are independent, so jobs fill them in parallel
+static void fill_feedback_rows(void* context, int begin, int end) {
+    const FeedbackRows* rows = context;
+    LetterState states[MAX_WORD_LENGTH];
+    for (int guess = begin; guess < end; guess++) {
+        for (int target = 0; target < rows->count; target++) {
+            rows->kernels->score_guess(&rows->words[guess * rows->stride], &rows->words[target * rows->stride], states);
+            rows->matrix[guess * rows->count + target] = feedback_code(states, rows->kernels->length);
+        }
+    }
+}
+
+// Builds the count x count matrix of feedback codes (row = guess, column = target).
+// Returns NULL if the dictionary is larger than FEEDBACK_MATRIX_MAX_WORDS.
+uint16_t* build_feedback_matrix(const WordDictionary* dictionary) {
+    int count = dictionary->count;
+    if (count <= 0 || count > FEEDBACK_MATRIX_MAX_WORDS) {
+        return NULL;
+    }
+
+    const WordKernels* kernels = get_word_kernels(dictionary->word_length);
+    int stride = kernels->length + 1;
+    char* words = malloc((size_t)count * stride);
+    uint16_t* matrix = malloc((size_t)count * count * sizeof(uint16_t));
+    if (!words || !matrix) {
+        free(words);
+        free(matrix);
+        return NULL;
+    }
+
+    for (int i = 0; i < count; i++) {
+        kernels->unpack(dictionary->words[i], &words[i * stride]);
+    }
+
+    FeedbackRows rows = {kernels, words, stride, count, matrix};
+    jobs_parallel_for(count, FEEDBACK_ROWS_PER_JOB, fill_feedback_rows, &rows);
+
+    free(words);
+    return matrix;
+}
+
+// Picks the candidate whose distinct letters cover the most remaining candidates
+static int choose_guess(const WordDictionary* dictionary, const int* candidates, int candidate_count) {
+    int word_length = dictionary->word_length;
+    int letter_counts[26] = {0};
+
+    for (int c = 0; c < candidate_count; c++) {
+        PackedWord word = dictionary->words[candidates[c]];
+        uint32_t seen = 0;
+        for (int i = 0; i < word_length; i++) {
+            seen |= 1u << ((word >> (PACKED_LETTER_BITS * i)) & PACKED_LETTER_MASK);
+        }
+        for (int letter = 1; letter <= 26; letter++) {
+            letter_counts[letter - 1] += (seen >> letter) & 1u;
+        }
+    }
+
+    int best_candidate = candidates[0];
+    int best_score = -1;
+    for (int c = 0; c < candidate_count; c++) {
+        PackedWord word = dictionary->words[candidates[c]];
+        uint32_t seen = 0;
+        int score = 0;
+        for (int i = 0; i < word_length; i++) {
+            int letter = (int)((word >> (PACKED_LETTER_BITS * i)) & PACKED_LETTER_MASK);
+            if (letter >= 1 && letter <= 26 && !(seen & (1u << letter))) {
+                score += letter_counts[letter - 1];
+                seen |= 1u << letter;
+            }
+        }
+        if (score > best_score) {
+            best_score = score;
+            best_candidate = candidates[c];
+        }
+    }
+    return best_candidate;
+}
+
+// Number of guesses the greedy solver needs to find dictionary word `target`.
+// scratch must hold dictionary->count ints.
+int solver_guess_count(const WordDictionary* dictionary, const uint16_t* feedback_matrix, int target, int* scratch) {
+    int count = dictionary->count;
+    int candidate_count = count;
+    for (int i = 0; i < count; i++) {
+        scratch[i] = i;
+    }
+
+    for (int guesses = 1; guesses <= SOLVER_MAX_GUESSES; guesses++) {
+        int guess = choose_guess(dictionary, scratch, candidate_count);
+        if (guess == target) {
+            return guesses;
+        }
+
+        // Keep only candidates that would have produced the same feedback
+        const uint16_t* row = &feedback_matrix[guess * count];
+        uint16_t observed = row[target];
+        int kept = 0;
+        for (int c = 0; c < candidate_count; c++) {
+            if (row[scratch[c]] == observed) {
+                scratch[kept++] = scratch[c];
+            }
+        }
+        candidate_count = kept;
+    }
+    return SOLVER_MAX_GUESSES;
+}
@@ -1,6 +1,33 @@
 #include "systems.h"
+#include "worddb.h"
 
-static const char* WORDLE_WORDS[] = {
+// Source word lists, one per supported word length. They are packed into
+// sorted per-length dictionaries the first time a dictionary is requested.
+
+static const char* WORDS_4[] = {
+    "ABLE", "ACID", "AGED", "ALSO", "AREA", "ARMY", "AWAY", "BABY", "BACK", "BALL",
+    "BAND", "BANK", "BASE", "BATH", "BEAR", "BEAT", "BELL", "BELT", "BEST", "BIRD",
+    "BLOW", "BLUE", "BOAT", "BODY", "BOND", "BONE", "BOOK", "BOOM", "BORN", "BOSS",
+    "BOTH", "BOWL", "BURN", "BUSH", "BUSY", "CALM", "CAME", "CAMP", "CARD", "CARE",
+    "CASE", "CASH", "CAST", "CELL", "CHAT", "CHIP", "CITY", "CLUB", "COAL", "COAT",
+    "CODE", "COLD", "COOK", "COOL", "COPY", "CORE", "COST", "CREW", "CROP", "DARK",
+    "DATA", "DATE", "DAWN", "DEAL", "DEAR", "DEBT", "DEEP", "DESK", "DIAL", "DIET",
+    "DISH", "DOOR", "DOWN", "DRAW", "DREW", "DROP", "DUAL", "DUST", "DUTY", "EACH",
+    "EARN", "EASE", "EAST", "EASY", "EDGE", "EVEN", "EVER", "FACE", "FACT", "FAIL",
+    "FAIR", "FALL", "FARM", "FAST", "FATE", "FEAR", "FEED", "FEEL", "FILE", "FILL",
+    "FILM", "FIND", "FINE", "FIRE", "FIRM", "FISH", "FIVE", "FLAT", "FLOW", "FOOD",
+    "FOOT", "FORM", "FORT", "FOUR", "FREE", "FUEL", "FULL", "FUND", "GAIN", "GAME",
+    "GATE", "GEAR", "GIFT", "GIVE", "GLAD", "GOAL", "GOLD", "GOLF", "GOOD", "GRAY",
+    "GREW", "GROW", "GULF", "HAIR", "HALF", "HALL", "HAND", "HANG", "HARD", "HARM",
+    "HEAD", "HEAR", "HEAT", "HELD", "HELP", "HERO", "HIGH", "HILL", "HOLD", "HOLE",
+    "HOME", "HOPE", "HOST", "HOUR", "HUGE", "HUNT", "IDEA", "INCH", "IRON", "ITEM",
+    "JUMP", "JURY", "KEEN", "KEEP", "KICK", "KIND", "KING", "KNEE", "KNOW", "LACK",
+    "LAKE", "LAND", "LANE", "LAST", "LATE", "LEAD", "LEFT", "LIFE", "LIFT", "LINE",
+    "LINK", "LION", "LIST", "LOAN", "LOCK", "LONG", "LOOK", "LORD", "LOSS", "LOVE",
+    "LUCK", "MAIL", "MAIN", "MARK", "MASS", "MEAL", "MEAT", "MILD", "MILK", "MIND"
+};
+
+static const char* WORDS_5[] = {
     "ABOUT", "ABOVE", "ABUSE", "ACTOR", "ACUTE", "ADMIT", "ADOPT", "ADULT", "AFTER", "AGAIN",
     "AGENT", "AGREE", "AHEAD", "ALARM", "ALBUM", "ALERT", "ALIEN", "ALIGN", "ALIKE", "ALIVE",
     "ALLOW", "ALONE", "ALONG", "ALTER", "AMBER", "AMEND", "AMONG", "ANGER", "ANGLE", "ANGRY",
@@ -20,10 +47,92 @@ static const char* WORDLE_WORDS[] = {
     "CRASH", "CRAZY", "CREAM", "CRIME", "CRISP", "CROSS", "CROWD", "CROWN", "CRUDE", "CRUSH",
     "CURVE", "CYCLE", "DAILY", "DAIRY", "DANCE", "DATED", "DEALS", "DEATH", "DEBUT", "DELAY",
     "DENSE", "DEPTH", "DOING", "DOLOR", "DOORS", "DOUBT", "DOZEN", "DRAFT", "DRAMA", "DRANK",
-    "DRAWN", "DREAM", "DRESS", "DRILL", "DRINK", "DRIVE", "DRONE", "DROVE", "DRUNK", "DRYING"
+    "DRAWN", "DREAM", "DRESS", "DRILL", "DRINK", "DRIVE", "DRONE", "DROVE", "DRUNK", "EAGLE"
 };
 
-#define TOTAL_WORDS (sizeof(WORDLE_WORDS) / sizeof(WORDLE_WORDS[0]))
+static const char* WORDS_6[] = {
+    "ACROSS", "ACTION", "ACTIVE", "ADVICE", "AFFORD", "AGENCY", "ALMOST", "ANIMAL",
+    "ANSWER", "ANYONE", "APPEAR", "ARRIVE", "ARTIST", "ATTACK", "AUTUMN", "BASKET",
+    "BATTLE", "BEAUTY", "BECOME", "BEHIND", "BETTER", "BEYOND", "BORDER", "BOTTLE",
+    "BOTTOM", "BRANCH", "BREATH", "BRIDGE", "BRIGHT", "BROKEN", "BUDGET", "BURDEN",
+    "BUTTER", "BUTTON", "CAMERA", "CANDLE", "CARBON", "CASTLE", "CENTER", "CHANCE",
+    "CHANGE", "CHARGE", "CHOICE", "CHOOSE", "CHURCH", "CIRCLE", "CLIENT", "CLOSED",
+    "COFFEE", "COLUMN", "COMBAT", "COMEDY", "COMMON", "CORNER", "COTTON", "COUPLE",
+    "COURSE", "CREDIT", "CRISIS", "CUSTOM", "DAMAGE", "DANGER", "DEBATE", "DECADE",
+    "DEFEAT", "DEFEND", "DEGREE", "DEMAND", "DESERT", "DESIGN", "DETAIL", "DINNER",
+    "DIRECT", "DOCTOR", "DOLLAR", "DOUBLE", "DRYING", "DURING", "EASILY", "EATING",
+    "EFFECT", "EFFORT", "EIGHTY", "EITHER", "ELEVEN", "EMPIRE", "ENERGY", "ENGINE",
+    "ENOUGH", "ENTIRE", "ESCAPE", "EVENTS", "EXPECT", "EXPERT", "FABRIC", "FAMILY",
+    "FAMOUS", "FATHER", "FELLOW", "FIGURE", "FINGER", "FINISH", "FLIGHT", "FLOWER",
+    "FOLLOW", "FOREST", "FORGET", "FORMAL", "FOURTH", "FREEZE", "FRIEND", "FUTURE",
+    "GALAXY", "GARDEN", "GENTLE", "GLOBAL", "GOLDEN", "GROUND", "GROWTH", "GUITAR",
+    "HAMMER", "HANDLE", "HAPPEN", "HEALTH", "HEAVEN", "HEIGHT", "HIDDEN", "HOLDER",
+    "HONEST", "IMPACT", "INCOME", "INDEED", "INSECT", "INSIDE", "ISLAND", "JACKET",
+    "JUNGLE", "KITTEN", "LADDER", "LAUNCH", "LAWYER", "LEADER", "LEGEND", "LENGTH",
+    "LESSON", "LETTER", "LIQUID", "LITTLE", "LIVING", "LOVELY"
+};
+
+static const char* WORDS_7[] = {
+    "ABILITY", "ABSENCE", "ACCOUNT", "ADDRESS", "ADVANCE", "ANCIENT", "ANOTHER",
+    "ANXIETY", "ANYBODY", "ARRANGE", "ARTICLE", "BALANCE", "BATTERY", "BEARING",
+    "BEDROOM", "BELIEVE", "BENEATH", "BICYCLE", "BILLION", "BROTHER", "BUILDER",
+    "CABINET", "CAPITAL", "CAPTAIN", "CAREFUL", "CEILING", "CENTRAL", "CENTURY",
+    "CERTAIN", "CHAMBER", "CHANNEL", "CHAPTER", "CHARITY", "CHICKEN", "CIRCUIT",
+    "CLIMATE", "CLOTHES", "COLLECT", "COLLEGE", "COMFORT", "COMMAND", "COMPANY",
+    "COMPARE", "COMPLEX", "CONCERT", "CONDUCT", "CONNECT", "CONTENT", "CONTEXT",
+    "CONTROL", "COUNTRY", "COURAGE", "CRYSTAL", "CULTURE", "CURRENT", "CUSTOMS",
+    "DEFENCE", "DELIVER", "DENSITY", "DEPOSIT", "DESKTOP", "DIAMOND", "DIGITAL",
+    "DISPLAY", "DOLPHIN", "DRAWING", "DYNAMIC", "EASTERN", "ECONOMY", "EDITION",
+    "ELEMENT", "EMOTION", "ENGLISH", "EVENING", "EXAMPLE", "EXPLAIN", "EXPLORE",
+    "EXTREME", "FACTORY", "FASHION", "FEATURE", "FICTION", "FIFTEEN", "FINANCE",
+    "FOREVER", "FORMULA", "FORTUNE", "FORWARD", "FREEDOM", "GALLERY", "GENERAL",
+    "GENUINE", "GIRAFFE", "HARMONY", "HARVEST", "HEADING", "HEALTHY", "HEARING",
+    "HEAVILY", "HELPFUL", "HIGHWAY", "HISTORY", "HOLIDAY", "HOUSING", "HOWEVER",
+    "HUNDRED", "HUSBAND", "IMAGINE", "INITIAL", "INSTEAD", "JOURNAL", "JOURNEY",
+    "JUSTICE", "KITCHEN", "KNOWING", "LANTERN", "LEADING", "LEATHER", "LIBRARY",
+    "LICENSE", "LOBSTER", "MACHINE", "MANAGER", "MASSIVE", "MAXIMUM", "MEANING",
+    "MEASURE", "MESSAGE", "MILLION", "MINERAL", "MINUTES", "MISSION", "MIXTURE",
+    "MONSTER", "MORNING", "MYSTERY", "NATURAL", "NETWORK", "NOTHING", "NUCLEAR"
+};
+
+#define WORD_LIST_COUNT(list) ((int)(sizeof(list) / sizeof(list[0])))
+
+static PackedWord packed_words_4[WORD_LIST_COUNT(WORDS_4)];
+static PackedWord packed_words_5[WORD_LIST_COUNT(WORDS_5)];
+static PackedWord packed_words_6[WORD_LIST_COUNT(WORDS_6)];
+static PackedWord packed_words_7[WORD_LIST_COUNT(WORDS_7)];
+
+typedef struct {
+    const char** source;
+    int count;
+    PackedWord* packed;
+} WordListSource;
+
+static const WordListSource WORD_LIST_SOURCES[WORD_LENGTH_MODE_COUNT] = {
+    {WORDS_4, WORD_LIST_COUNT(WORDS_4), packed_words_4},
+    {WORDS_5, WORD_LIST_COUNT(WORDS_5), packed_words_5},
+    {WORDS_6, WORD_LIST_COUNT(WORDS_6), packed_words_6},
+    {WORDS_7, WORD_LIST_COUNT(WORDS_7), packed_words_7},
+};
+
+static WordDictionary word_dictionaries[WORD_LENGTH_MODE_COUNT];
+static WordDatabase word_databases[WORD_LENGTH_MODE_COUNT];  // Mapped replacements, if any
+
+static int compare_packed_words(const void* a, const void* b) {
+    PackedWord word_a = *(const PackedWord*)a;
+    PackedWord word_b = *(const PackedWord*)b;
+    return (word_a > word_b) - (word_a < word_b);
+}
+
+// FNV-1a over whole packed words: tells one list from another without
+// comparing them word by word
+static uint64_t hash_packed_words(const PackedWord* words, int count) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (int i = 0; i < count; i++) {
+        hash = (hash ^ words[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
 
 void initialize_random_seed(void) {
     static int is_initialized = 0;
@@ -33,8 +142,123 @@ void initialize_random_seed(void) {
     }
 }
 
-const char* get_random_word(void) {
+const WordDictionary* get_word_dictionary(int word_length) {
+    if (!is_supported_word_length(word_length)) {
+        return NULL;
+    }
+    
+    WordDictionary* dictionary = &word_dictionaries[word_length - MIN_WORD_LENGTH];
+    if (dictionary->count == 0) {
+        // Pack and sort once; packed order matches alphabetical order
+        const WordListSource* source = &WORD_LIST_SOURCES[word_length - MIN_WORD_LENGTH];
+        const WordKernels* kernels = get_word_kernels(word_length);
+        for (int i = 0; i < source->count; i++) {
+            source->packed[i] = kernels->pack(source->source[i]);
+        }
+        qsort(source->packed, source->count, sizeof(PackedWord), compare_packed_words);
+        
+        dictionary->word_length = word_length;
+        dictionary->words = source->packed;
+        dictionary->count = source->count;
+        dictionary->hash = hash_packed_words(dictionary->words, dictionary->count);
+    }
+    return dictionary;
+}
+
+int dictionary_find(const WordDictionary* dictionary, PackedWord word) {
+    int low = 0;
+    int high = dictionary->count - 1;
+    
+    while (low <= high) {
+        int mid = low + (high - low) / 2;
+        PackedWord mid_word = dictionary->words[mid];
+        if (mid_word == word) {
+            return mid;
+        } else if (mid_word < word) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return -1;
+}
+
+int is_dictionary_word(const char* word, int word_length) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    if (!dictionary) {
+        return 0;
+    }
+    return dictionary_find(dictionary, get_word_kernels(word_length)->pack(word)) >= 0;
+}
+
+// Maps a packed .cwdb database and uses it in place of the built-in list for its length
+int load_word_database(const char* path) {
+    WordDatabase database;
+    if (!word_db_open(path, &database)) {
+        return 0;
+    }
+    if (!is_supported_word_length(database.word_length) || database.word_count == 0) {
+        word_db_close(&database);
+        return 0;
+    }
+    
+    int mode_index = database.word_length - MIN_WORD_LENGTH;
+    word_db_close(&word_databases[mode_index]);
+    word_databases[mode_index] = database;
+    
+    // The file's word encoding matches PackedWord, so no conversion is needed
+    WordDictionary* dictionary = &word_dictionaries[mode_index];
+    dictionary->word_length = database.word_length;
+    dictionary->count = database.word_count;
+    dictionary->words = database.words;
+    dictionary->difficulty = database.difficulty;
+    dictionary->frequency = database.frequency;
+    dictionary->hash = hash_packed_words(dictionary->words, dictionary->count);
+    return 1;
+}
+
+// Loads <directory>/words_<n>.cwdb for every supported length; returns how many were found
+int load_word_databases(const char* directory) {
+    int loaded = 0;
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/words_%d.cwdb", directory, length);
+        loaded += load_word_database(path);
+    }
+    return loaded;
+}
+
+void unload_word_databases(void) {
+    for (int i = 0; i < WORD_LENGTH_MODE_COUNT; i++) {
+        if (word_databases[i].mapping) {
+            word_db_close(&word_databases[i]);
+            word_dictionaries[i].count = 0;  // Falls back to the built-in list
+            word_dictionaries[i].difficulty = NULL;
+            word_dictionaries[i].frequency = NULL;
+        }
+    }
+}
+
+void get_random_word(int word_length, char* out_word) {
     initialize_random_seed();
-    int random_index = rand() % TOTAL_WORDS;
-    return WORDLE_WORDS[random_index];
-}
\ No newline at end of file
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    int random_index = rand() % dictionary->count;
+    get_word_kernels(word_length)->unpack(dictionary->words[random_index], out_word);
+}
+
+// Random word from any of `categories` (0 for every word) that is not set in
+// `seen` (NULL for none; a bitmap over the dictionary, see word_category_chunks).
+// Returns its dictionary index, or -1 (out_word untouched) if none is left.
+int get_random_category_word(int word_length, uint32_t categories, const uint64_t* seen, char* out_word) {
+    int chunk_count = word_category_chunks(word_length);
+    uint64_t* members = malloc(sizeof(uint64_t) * (size_t)(chunk_count > 0 ? chunk_count : 1));
+    int member_count = members ? word_category_filter(word_length, categories, seen, members) : -1;
+    int word = -1;
+    if (member_count > 0) {
+        initialize_random_seed();
+        word = word_bitmap_select(members, 0, chunk_count * 64, rand() % member_count);
+        get_word_kernels(word_length)->unpack(get_word_dictionary(word_length)->words[word], out_word);
+    }
+    free(members);
+    return word;
+}
@@ -0,0 +1,232 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "worddb.h"
+
+// Word categories: loading .cwdb category files, bitmap filters, draws that
+// skip seen words, bitmap count/select against a naive scan, themed
+// crosswords and the home screen's theme key
+
+#define TEST_CATEGORY_DIRECTORY "."
+
+static int category_bit(int word_length, uint32_t categories, int word) {
+    uint64_t bits[64];
+    CHECK(word_category_chunks(word_length) <= 64);
+    word_category_filter(word_length, categories, NULL, bits);
+    return (int)((bits[word >> 6] >> (word & 63)) & 1);
+}
+
+// <name>_<length>.cwdb from dictionary words [first, first + count), plus a
+// word the dictionary does not have
+static void write_category(const char* name, int word_length, int first, int count) {
+    const WordDictionary* dictionary = get_word_dictionary(word_length);
+    uint64_t words[64];
+    for (int i = 0; i < count; i++) {
+        words[i] = dictionary->words[first + i];
+    }
+    char missing[MAX_WORD_LENGTH + 1] = {0};
+    memset(missing, 'Z', (size_t)word_length);
+    words[count] = word_db_pack_word(missing, word_length);
+    char path[128];
+    snprintf(path, sizeof(path), TEST_CATEGORY_DIRECTORY "/%s_%d.cwdb", name, word_length);
+    CHECK(word_db_write(path, word_length, words, NULL, NULL, count + 1));
+}
+
+static void remove_category(const char* name, int word_length) {
+    char path[128];
+    snprintf(path, sizeof(path), TEST_CATEGORY_DIRECTORY "/%s_%d.cwdb", name, word_length);
+    remove(path);
+}
+
+static void categories_load_from_packed_files(void) {
+    write_category("test_animals", 5, 0, 10);
+    write_category("test_animals", 4, 20, 5);
+    write_category("test_science", 5, 5, 15);
+    FILE* list = fopen(TEST_CATEGORY_DIRECTORY "/categories.txt", "w");
+    CHECK(list != NULL);
+    if (list) {
+        fputs("# Themes\ntest_animals\n  test_science  # physics and friends\ntest_missing\ntest_animals\n", list);
+        fclose(list);
+    }
+
+    CHECK_EQ_INT(load_word_categories(TEST_CATEGORY_DIRECTORY), 2);
+    CHECK_EQ_INT(word_category_count(), 2);
+    int animals = word_category_find("test_animals");
+    int science = word_category_find("test_science");
+    CHECK(animals >= 0 && science >= 0 && animals != science);
+    CHECK(strcmp(word_category_name(science), "test_science") == 0);
+    CHECK(word_category_name(2) == NULL);
+    CHECK_EQ_INT(word_category_find("test_missing"), -1);
+
+    uint64_t bits[64];
+    uint64_t seen[64];
+    uint32_t both = (1u << animals) | (1u << science);
+    CHECK_EQ_INT(word_category_filter(5, 1u << animals, NULL, bits), 10);
+    CHECK_EQ_INT(word_category_filter(5, both, NULL, bits), 20);
+    CHECK_EQ_INT(word_category_filter(4, both, NULL, bits), 5);
+    CHECK_EQ_INT(word_category_filter(6, both, NULL, bits), 0);
+    CHECK_EQ_INT(word_category_filter(5, 0, NULL, bits), get_word_dictionary(5)->count);
+    CHECK_EQ_INT(word_category_filter(3, both, NULL, bits), -1);
+
+    // Science minus animals: an AND-NOT with the other category's bitmap
+    word_category_filter(5, 1u << animals, NULL, seen);
+    CHECK_EQ_INT(word_category_filter(5, 1u << science, seen, bits), 10);
+    CHECK(!category_bit(5, 1u << animals, 10) && category_bit(5, 1u << science, 10));
+    CHECK(category_bit(5, both, 0) && category_bit(5, both, 19) && !category_bit(5, both, 20));
+
+    unload_word_categories();
+    CHECK_EQ_INT(word_category_count(), 0);
+    CHECK_EQ_INT(word_category_filter(5, both, NULL, bits), 0);
+    remove_category("test_animals", 5);
+    remove_category("test_animals", 4);
+    remove_category("test_science", 5);
+    remove(TEST_CATEGORY_DIRECTORY "/categories.txt");
+}
+
+static void random_category_words_skip_seen_ones(void) {
+    write_category("test_birds", 5, 40, 20);
+    int birds = load_word_category(TEST_CATEGORY_DIRECTORY, "test_birds");
+    CHECK(birds >= 0);
+
+    uint64_t seen[64] = {0};
+    for (int n = 0; n < 20; n++) {
+        char word[MAX_WORD_LENGTH + 1] = {0};
+        int index = get_random_category_word(5, 1u << birds, seen, word);
+        CHECK(index >= 40 && index < 60);
+        if (index < 0) {
+            break;
+        }
+        CHECK(!((seen[index >> 6] >> (index & 63)) & 1));
+        seen[index >> 6] |= 1ull << (index & 63);
+        CHECK(is_dictionary_word(word, 5));
+    }
+    char word[MAX_WORD_LENGTH + 1] = "KEPT";
+    CHECK_EQ_INT(get_random_category_word(5, 1u << birds, seen, word), -1);
+    CHECK(strcmp(word, "KEPT") == 0);
+    CHECK(get_random_category_word(5, 0, seen, word) >= 0);
+
+    unload_word_categories();
+    remove_category("test_birds", 5);
+}
+
+// Property: bitmap count and select over random ranges match a bit-by-bit scan
+static void property_bitmap_count_and_select_match_scan(void) {
+    uint64_t bits[8];
+    test_random_seed(50);
+    for (int trial = 0; trial < 2000; trial++) {
+        for (int k = 0; k < 8; k++) {
+            uint64_t density = test_random() % 4;
+            bits[k] = ((uint64_t)test_random() << 32) | test_random();
+            for (uint64_t d = 0; d < density; d++) {
+                bits[k] &= ((uint64_t)test_random() << 32) | test_random();
+            }
+        }
+        int begin = (int)(test_random() % 512);
+        int end = begin + (int)(test_random() % (unsigned)(512 - begin + 1));
+        int expected = 0;
+        int nth = (int)(test_random() % 64);
+        int expected_select = -1;
+        for (int i = begin; i < end; i++) {
+            if ((bits[i >> 6] >> (i & 63)) & 1) {
+                if (expected == nth) {
+                    expected_select = i;
+                }
+                expected++;
+            }
+        }
+        CHECK_EQ_INT(word_bitmap_count(bits, begin, end), expected);
+        CHECK_EQ_INT(word_bitmap_select(bits, begin, end, nth), expected_select);
+    }
+}
+
+static void themed_crosswords_use_only_category_words(void) {
+    // Every other 5-letter word
+    const WordDictionary* dictionary = get_word_dictionary(5);
+    uint64_t words[256];
+    int count = 0;
+    for (int i = 0; i < dictionary->count && count < (int)(sizeof(words) / sizeof(words[0])); i += 2) {
+        words[count++] = dictionary->words[i];
+    }
+    CHECK(word_db_write(TEST_CATEGORY_DIRECTORY "/test_even_5.cwdb", 5, words, NULL, NULL, count));
+    int even = load_word_category(TEST_CATEGORY_DIRECTORY, "test_even");
+    CHECK(even >= 0);
+
+    for (int seed = 0; seed < 20; seed++) {
+        CrosswordLevel level = get_themed_crossword_level(1u << even, seed);
+        CHECK_EQ_INT(level.word_count, 4);
+        for (int w = 0; w < level.word_count; w++) {
+            int index = dictionary_find(dictionary, crossword_word_id(&level, w));
+            CHECK(index >= 0 && index % 2 == 0);
+        }
+    }
+    // A set naming no loaded category has no words to fill the shape
+    CrosswordLevel fallback = get_themed_crossword_level(1u << (even + 1), 0);
+    CHECK_EQ_INT(fallback.word_count, 3);
+
+    unload_word_categories();
+    remove(TEST_CATEGORY_DIRECTORY "/test_even_5.cwdb");
+}
+
+static void t_picks_a_theme_for_targets_and_the_crossword(void) {
+    // Every other 5-letter word, enough to fill the daily shape
+    const WordDictionary* dictionary = get_word_dictionary(5);
+    uint64_t words[256];
+    int count = 0;
+    for (int i = 0; i < dictionary->count && count < (int)(sizeof(words) / sizeof(words[0])); i += 2) {
+        words[count++] = dictionary->words[i];
+    }
+    CHECK(word_db_write(TEST_CATEGORY_DIRECTORY "/test_even_5.cwdb", 5, words, NULL, NULL, count));
+    int even = load_word_category(TEST_CATEGORY_DIRECTORY, "test_even");
+    CHECK_EQ_INT(even, 0);
+
+    GameState state = create_game_state("");
+    state.settings.animations_enabled = 0;
+    state = test_press(state, GAME_KEY_A + ('T' - 'A'));
+    CHECK_EQ_INT(state.core.theme, 1u << even);
+    CHECK(strcmp(state.ui.hud.theme_text, "Theme: test_even  (T to change)") == 0);
+    CHECK_EQ_INT(state.crossword.current_level.categories, 1u << even);
+    for (int w = 0; w < state.crossword.current_level.word_count; w++) {
+        CHECK(dictionary_find(dictionary, crossword_word_id(&state.crossword.current_level, w)) % 2 == 0);
+    }
+
+    // Themed draws skip the repeat window while the category has other words
+    int window = get_word_repeat_window(5);
+    CHECK(window > 0 && window <= count);
+    uint64_t drawn[64] = {0};
+    CHECK(word_category_chunks(5) <= 64);
+    for (int n = 0; n < window; n++) {
+        char word[MAX_WORD_LENGTH + 1] = {0};
+        get_themed_word_for_level(5, n + 1, state.core.theme, word);
+        int index = dictionary_find(dictionary, word_db_pack_word(word, 5));
+        CHECK(index >= 0 && index % 2 == 0);
+        if (index >= 0) {
+            CHECK(!((drawn[index >> 6] >> (index & 63)) & 1));
+            drawn[index >> 6] |= 1ull << (index & 63);
+        }
+    }
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK(dictionary_find(dictionary, word_db_pack_word(state.core.target_word, 5)) % 2 == 0);
+    SessionState session;
+    CHECK(!session_state_pack(&state, &session));
+
+    // The step past the last category is every word and level 1 again
+    state = create_game_state("");
+    state = test_press(state, GAME_KEY_A + ('T' - 'A'));
+    state = test_press(state, GAME_KEY_A + ('T' - 'A'));
+    CHECK_EQ_INT(state.core.theme, 0);
+    CHECK(strcmp(state.ui.hud.theme_text, "Theme: all words  (T to change)") == 0);
+    CHECK_EQ_INT(state.crossword.current_level.categories, 0);
+    CHECK_EQ_INT(state.crossword.current_level.level, 1);
+
+    unload_word_categories();
+    remove(TEST_CATEGORY_DIRECTORY "/test_even_5.cwdb");
+}
+
+static const TestCase CATEGORIES_TESTS[] = {
+    {"categories_load_from_packed_files", categories_load_from_packed_files},
+    {"random_category_words_skip_seen_ones", random_category_words_skip_seen_ones},
+    {"property_bitmap_count_and_select_match_scan", property_bitmap_count_and_select_match_scan},
+    {"themed_crosswords_use_only_category_words", themed_crosswords_use_only_category_words},
+    {"t_picks_a_theme_for_targets_and_the_crossword", t_picks_a_theme_for_targets_and_the_crossword},
+};
+
+TEST_GROUP(categories, CATEGORIES_TESTS);
@@ -0,0 +1,199 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "clues.h"
+#include "worddb.h"
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+// Crossword clues: the .cwcl writer and lookups, a 100k-clue database, the
+// HUD's per-word lookup and the wrapped clue layout
+
+#define TEST_CLUES_PATH "test_clues.cwcl"
+#define TEST_LARGE_CLUES 100000
+
+static uint64_t pack(const char* word) {
+    return word_db_pack_word(word, (int)strlen(word));
+}
+
+static void clues_round_trip_through_the_file(void) {
+    char long_clue[CLUE_MAX_LENGTH + 40];
+    memset(long_clue, 'x', sizeof(long_clue) - 1);
+    long_clue[sizeof(long_clue) - 1] = '\0';
+    ClueSource clues[] = {
+        {pack("SWORD"), "Blade with a hilt"},
+        {pack("CAT"), "Purring pet"},
+        {pack("SWORD"), "Second clue, dropped"},
+        {0, "No answer, skipped"},
+        {pack("CATS"), long_clue},
+        {pack("EMPTY"), ""},
+    };
+    CHECK(clue_db_write(TEST_CLUES_PATH, clues, (int)(sizeof(clues) / sizeof(clues[0]))));
+    CHECK(load_clue_database(TEST_CLUES_PATH));
+    CHECK_EQ_INT(clue_database_count(), 4);
+
+    CHECK(strcmp(clue_text(clue_find(pack("SWORD"))), "Blade with a hilt") == 0);
+    CHECK(strcmp(clue_text(clue_find(pack("CAT"))), "Purring pet") == 0);
+    CHECK_EQ_INT((int)strlen(clue_text(clue_find(pack("CATS")))), CLUE_MAX_LENGTH);
+    CHECK(strcmp(clue_text(clue_find(pack("EMPTY"))), "") == 0);
+    CHECK_EQ_INT((int)clue_find(pack("DOG")), 0);
+    CHECK_EQ_INT((int)clue_find(0), 0);
+    CHECK(clue_text(0) == NULL);
+    CHECK(clue_text(5) == NULL);
+
+    unload_clue_database();
+    CHECK_EQ_INT((int)clue_find(pack("CAT")), 0);
+    // Damaged files are refused
+    FILE* file = fopen(TEST_CLUES_PATH, "ab");
+    CHECK(file != NULL);
+    if (file) {
+        fputc('!', file);
+        fclose(file);
+    }
+    CHECK(!load_clue_database(TEST_CLUES_PATH));
+
+    // So are string and index offsets that wrap past the end of the file
+    CHECK(clue_db_write(TEST_CLUES_PATH, clues, 2));
+    ClueDbHeader header;
+    file = fopen(TEST_CLUES_PATH, "r+b");
+    CHECK(file && fread(&header, sizeof(header), 1, file) == 1);
+    for (int damage = 0; file && damage < 2; damage++) {
+        ClueDbHeader crafted = header;
+        if (damage == 0) {
+            crafted.strings_offset = UINT64_MAX - crafted.strings_size + 2;
+        } else {
+            crafted.index_offset = UINT64_MAX - 7;
+        }
+        fseek(file, 0, SEEK_SET);
+        fwrite(&crafted, sizeof(crafted), 1, file);
+        fflush(file);
+        CHECK(!load_clue_database(TEST_CLUES_PATH));
+    }
+    if (file) {
+        fclose(file);
+    }
+    remove(TEST_CLUES_PATH);
+}
+
+#ifdef __linux__
+static long resident_bytes(void) {
+    long pages = 0;
+    long resident = 0;
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return -1;
+    }
+    int read = fscanf(file, "%ld %ld", &pages, &resident);
+    fclose(file);
+    return read == 2 ? resident * sysconf(_SC_PAGESIZE) : -1;
+}
+#endif
+
+// Seven random letters per answer; the clue text repeats the answer so a
+// lookup can be checked without keeping the list
+static void large_clue_word(int i, char* word) {
+    uint32_t value = (uint32_t)i * 2654435761u;
+    for (int j = 0; j < 7; j++) {
+        word[j] = (char)('A' + (i + j * 7 + (int)(value >> (j * 4)) % 26) % 26);
+    }
+    word[7] = '\0';
+}
+
+static void large_database_stays_out_of_memory(void) {
+    static ClueSource clues[TEST_LARGE_CLUES];
+    static char texts[TEST_LARGE_CLUES][96];
+    for (int i = 0; i < TEST_LARGE_CLUES; i++) {
+        char word[8];
+        large_clue_word(i, word);
+        memcpy(texts[i], "Clue for ", 9);
+        memcpy(texts[i] + 9, word, 8);
+        memset(texts[i] + 16, '.', 72);
+        texts[i][88] = '\0';
+        clues[i].word = pack(word);
+        clues[i].text = texts[i];
+    }
+    CHECK(clue_db_write(TEST_CLUES_PATH, clues, TEST_LARGE_CLUES));
+
+#ifdef __linux__
+    long before = resident_bytes();
+#endif
+    CHECK(load_clue_database(TEST_CLUES_PATH));
+    CHECK(clue_database_count() > TEST_LARGE_CLUES * 9 / 10);
+    // One puzzle's worth of lookups
+    test_random_seed(47);
+    for (int n = 0; n < 10; n++) {
+        int i = (int)(test_random() % TEST_LARGE_CLUES);
+        char word[8];
+        large_clue_word(i, word);
+        const char* text = clue_text(clue_find(pack(word)));
+        CHECK(text != NULL && strncmp(text + 9, word, 7) == 0);
+    }
+#ifdef __linux__
+    // Only the header and the pages the lookups touched are resident
+    long after = resident_bytes();
+    if (before > 0 && after > 0) {
+        CHECK(after - before < (long)(TEST_LARGE_CLUES * (sizeof(ClueIndexEntry) + 89)) / 2);
+    }
+#endif
+    unload_clue_database();
+    remove(TEST_CLUES_PATH);
+}
+
+static void hud_looks_up_the_current_words_clue(void) {
+    GameState state = test_start_crossword(0);
+    const CrosswordLevel* level = &state.crossword.current_level;
+    CHECK(level->word_count >= 2);
+    ClueSource clues[] = {
+        {crossword_word_id(level, 0), "First word"},
+        {crossword_word_id(level, 1), "Second word"},
+    };
+    CHECK(clues[0].word != 0 && clues[1].word != 0);
+    CHECK(clue_db_write(TEST_CLUES_PATH, clues, 2));
+    CHECK(load_clue_database(TEST_CLUES_PATH));
+
+    state = test_tick(state);
+    CHECK(strcmp(clue_text(state.ui.hud.crossword_clue), "First word") == 0);
+    state = test_press(state, GAME_KEY_RIGHT);
+    CHECK_EQ_INT(state.crossword.current_word_index, 1);
+    CHECK(strcmp(clue_text(state.ui.hud.crossword_clue), "Second word") == 0);
+    state = test_press(state, GAME_KEY_RIGHT);
+    if (state.crossword.current_word_index > 1) {
+        CHECK_EQ_INT((int)state.ui.hud.crossword_clue, 0);
+    }
+
+    unload_clue_database();
+    remove(TEST_CLUES_PATH);
+}
+
+static int fixed_width(void* context, const char* text, int length) {
+    (void)text;
+    return length * *(int*)context;
+}
+
+static void wrapped_lines_fit_the_width(void) {
+    int letter_width = 10;
+    TextLine lines[8];
+    const char* text = "Tall wading bird  of marsh and field";
+    int count = text_wrap(text, 100, fixed_width, &letter_width, lines, 8);
+    CHECK_EQ_INT(count, 5);
+    CHECK(lines[0].start == 0 && lines[0].length == 4);
+    CHECK(lines[1].start == 5 && lines[1].length == 6);
+    CHECK(lines[2].length == 8 && strncmp(text + lines[2].start, "bird  of", 8) == 0);
+    CHECK(lines[3].length == 9 && strncmp(text + lines[3].start, "marsh and", 9) == 0);
+    CHECK(lines[4].length == 5 && strncmp(text + lines[4].start, "field", 5) == 0);
+
+    // A word wider than the line is split; lines run out before the text does
+    count = text_wrap("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 100, fixed_width, &letter_width, lines, 2);
+    CHECK_EQ_INT(count, 2);
+    CHECK(lines[0].length == 10 && lines[1].start == 10 && lines[1].length == 10);
+    CHECK_EQ_INT(text_wrap("   ", 100, fixed_width, &letter_width, lines, 8), 0);
+}
+
+static const TestCase CLUES_TESTS[] = {
+    {"clues_round_trip_through_the_file", clues_round_trip_through_the_file},
+    {"large_database_stays_out_of_memory", large_database_stays_out_of_memory},
+    {"hud_looks_up_the_current_words_clue", hud_looks_up_the_current_words_clue},
+    {"wrapped_lines_fit_the_width", wrapped_lines_fit_the_width},
+};
+
+TEST_GROUP(clues, CLUES_TESTS);
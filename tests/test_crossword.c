@@ -0,0 +1,172 @@
+#include "test_framework.h"
+#include "test_support.h"
+
+// Crossword-side logic: cursor helpers, word validation and puzzle completion.
+// Level 1 is SWORD (row 0), STARK (column 1) and CROSS (row 3).
+
+static int grid_matches_solution(const GameState* state) {
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 9; y++) {
+            if (state->crossword.current_level.word_mask[x][y] &&
+                state->crossword.grid[x][y] != state->crossword.current_level.solution[x][y]) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void cursor_starts_on_first_word(void) {
+    GameState state = test_start_crossword(0);
+    CHECK_EQ_INT(state.current_view, VIEW_CROSSWORD);
+    CHECK_EQ_INT(state.crossword.current_word_index, 0);
+    CHECK_EQ_INT(state.crossword.cursor_x, 1);
+    CHECK_EQ_INT(state.crossword.cursor_y, 0);
+    
+    int x, y;
+    CHECK(find_first_editable_cell_in_word(state, 2, &x, &y));
+    CHECK_EQ_INT(x, 0);
+    CHECK_EQ_INT(y, 3);
+    CHECK(!find_first_editable_cell_in_word(state, 7, &x, &y));
+    CHECK_EQ_INT(find_next_incomplete_word(state), 1);
+    CHECK(!find_previous_editable_cell_with_letter(state, 3, 0, &x, &y));
+}
+
+static void placing_requires_a_token(void) {
+    GameState state = test_start_crossword(0);
+    state = test_type(state, "S");
+    CHECK_EQ_INT(state.crossword.grid[1][0], '\0');
+    CHECK_EQ_INT(state.stats.tokens.rejected_transactions, 1);
+}
+
+static void letters_auto_advance_and_backspace_steps_back(void) {
+    GameState state = test_start_crossword(1);
+    state = test_type(state, "SW");
+    CHECK_EQ_INT(state.crossword.grid[1][0], 'S');
+    CHECK_EQ_INT(state.crossword.grid[2][0], 'W');
+    CHECK_EQ_INT(state.crossword.cursor_x, 3);
+    
+    int x, y;
+    CHECK(find_previous_editable_cell_with_letter(state, 3, 0, &x, &y));
+    CHECK_EQ_INT(x, 2);
+    
+    state = test_press(state, GAME_KEY_BACKSPACE);
+    CHECK_EQ_INT(state.crossword.grid[2][0], '\0');
+    CHECK_EQ_INT(state.crossword.cursor_x, 2);
+    CHECK_EQ_INT(token_ledger_count(&state.stats.tokens, 'W'), 1);
+}
+
+static void wrong_word_is_scored_and_cursor_returns(void) {
+    GameState state = test_start_crossword(2);
+    state = test_type(state, "SWORE");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.crossword.letter_states[1][0], LETTER_CORRECT);
+    CHECK_EQ_INT(state.crossword.letter_states[5][0], LETTER_NOT_IN_WORD);
+    CHECK(state.crossword.word_validated[5][0]);
+    CHECK_EQ_INT(state.crossword.current_word_index, 0);
+    CHECK_EQ_INT(state.crossword.puzzle_completed, 0);
+}
+
+static GameState solve_level_one(GameState state) {
+    state = test_type(state, "SWORD");
+    state = test_press(state, GAME_KEY_ENTER);
+    state = test_type(state, "TARK");   // S is shared and locked green
+    state = test_press(state, GAME_KEY_ENTER);
+    state = test_type(state, "COSS");   // R is shared and locked green
+    return test_press(state, GAME_KEY_ENTER);
+}
+
+static void solving_every_word_completes_the_puzzle(void) {
+    GameState state = test_start_crossword(3);
+    state = solve_level_one(state);
+    CHECK(grid_matches_solution(&state));
+    CHECK_EQ_INT(state.crossword.puzzle_completed, 1);
+    CHECK_EQ_INT(state.current_view, VIEW_CROSSWORD_COMPLETE);
+    
+    // Space returns home and refunds the placed letters in one transaction
+    int placed = 13;
+    int balance_before = token_ledger_total(&state.stats.tokens);
+    state = test_press(state, GAME_KEY_SPACE);
+    CHECK_EQ_INT(state.current_view, VIEW_HOME_SCREEN);
+    CHECK_EQ_INT(token_ledger_total(&state.stats.tokens), balance_before + placed);
+    CHECK_EQ_INT(state.stats.tokens.transactions_by_kind[TOKEN_TX_REFUND], 1);
+    CHECK_EQ_INT(state.crossword.puzzle_completed, 0);
+}
+
+// Presses `key`, counting the transition into the completion screen and
+// checking the grid is solved whenever it happens
+static GameState press_counting_completion(GameState state, int key, int* completions) {
+    GameViewState previous_view = state.current_view;
+    state = test_press(state, key);
+    if (previous_view != VIEW_CROSSWORD_COMPLETE && state.current_view == VIEW_CROSSWORD_COMPLETE) {
+        (*completions)++;
+        CHECK(grid_matches_solution(&state));
+        CHECK_EQ_INT(state.crossword.puzzle_completed, 1);
+    }
+    return state;
+}
+
+// Property: under random play followed by solving whatever is left, completion
+// is detected exactly once, only when the grid matches the solution, and
+// nothing re-triggers it afterwards
+static void property_completion_detected_exactly_once(void) {
+    test_random_seed(0xc0ffee31u);
+    for (int game = 0; game < 60; game++) {
+        GameState state = test_start_crossword(20);
+        int completions = 0;
+        
+        for (int step = 0; step < 300; step++) {
+            uint32_t roll = test_random() % 100;
+            int key;
+            if (state.current_view == VIEW_CROSSWORD_COMPLETE) {
+                // Keep poking the completion screen with anything but Space/Tab
+                key = (roll < 50) ? GAME_KEY_ENTER : GAME_KEY_A + (int)(test_random() % 26);
+            } else if (roll < 60) {
+                key = GAME_KEY_A + (state.crossword.current_level.solution[state.crossword.cursor_x][state.crossword.cursor_y] - 'A');
+            } else if (roll < 72) {
+                key = GAME_KEY_A + (int)(test_random() % 26);
+            } else if (roll < 80) {
+                key = GAME_KEY_BACKSPACE;
+            } else if (roll < 94) {
+                key = GAME_KEY_ENTER;
+            } else if (roll < 97) {
+                key = GAME_KEY_RIGHT;
+            } else {
+                key = GAME_KEY_LEFT_SHIFT;
+            }
+            state = press_counting_completion(state, key, &completions);
+        }
+        
+        // Finish the puzzle: move to each word, overwrite its open cells with
+        // the solution and submit it
+        int word_count = state.crossword.current_level.word_count;
+        for (int word = 0; word <= word_count && state.current_view == VIEW_CROSSWORD; word++) {
+            state = press_counting_completion(state, GAME_KEY_RIGHT, &completions);
+            int length = state.crossword.current_level.words[state.crossword.current_word_index].length;
+            for (int i = 0; i < length; i++) {
+                char letter = state.crossword.current_level.solution[state.crossword.cursor_x][state.crossword.cursor_y];
+                state = press_counting_completion(state, GAME_KEY_A + (letter - 'A'), &completions);
+            }
+            state = press_counting_completion(state, GAME_KEY_ENTER, &completions);
+        }
+        CHECK_EQ_INT(state.current_view, VIEW_CROSSWORD_COMPLETE);
+        
+        for (int step = 0; step < 50; step++) {
+            int key = (test_random() % 2) ? GAME_KEY_ENTER : GAME_KEY_A + (int)(test_random() % 26);
+            state = press_counting_completion(state, key, &completions);
+        }
+        CHECK_EQ_INT(completions, 1);
+        CHECK_EQ_INT(state.crossword.puzzle_completed, 1);
+    }
+}
+
+static const TestCase CROSSWORD_TESTS[] = {
+    {"cursor_starts_on_first_word", cursor_starts_on_first_word},
+    {"placing_requires_a_token", placing_requires_a_token},
+    {"letters_auto_advance_and_backspace_steps_back", letters_auto_advance_and_backspace_steps_back},
+    {"wrong_word_is_scored_and_cursor_returns", wrong_word_is_scored_and_cursor_returns},
+    {"solving_every_word_completes_the_puzzle", solving_every_word_completes_the_puzzle},
+    {"property_completion_detected_exactly_once", property_completion_detected_exactly_once},
+};
+
+TEST_GROUP(crossword, CROSSWORD_TESTS);
@@ -0,0 +1,168 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "daily.h"
+#include "worddb.h"
+#include <stddef.h>
+
+// Daily challenge: date arithmetic, seeded selection, the calendar file and
+// starting the daily from the home screen
+
+#define TEST_CALENDAR_PATH "test_daily.cwcal"
+#define TEST_DAY 20744                        // 2026-10-18
+
+static void day_numbers_round_trip_through_dates(void) {
+    CHECK_EQ_INT(daily_day_number(1970, 1, 1), 0);
+    CHECK_EQ_INT(daily_day_number(2000, 3, 1), 11017);
+    CHECK_EQ_INT(daily_day_number(2026, 10, 18), TEST_DAY);
+    for (int day = -800; day < 60000; day += 7) {
+        int year, month, date;
+        daily_date_from_day(day, &year, &month, &date);
+        CHECK_EQ_INT(daily_day_number(year, month, date), day);
+    }
+}
+
+// Property: every day's crossword is made of dictionary words whose crossing
+// cells agree, and the same day always gives the same puzzle
+static void property_daily_crossword_is_consistent(void) {
+    int generated = 0;
+    for (int day = TEST_DAY; day < TEST_DAY + 400; day++) {
+        CrosswordLevel level = get_daily_crossword_level(day);
+        CrosswordLevel again = get_daily_crossword_level(day);
+        CHECK(memcmp(level.solution, again.solution, sizeof(level.solution)) == 0);
+        CHECK_EQ_INT(level.day, day);
+        generated += level.word_count == DAILY_CROSSWORD_WORDS;
+
+        for (int w = 0; w < level.word_count; w++) {
+            const CrosswordWord* word = &level.words[w];
+            char letters[MAX_WORD_LENGTH + 1] = {0};
+            for (int i = 0; i < word->length; i++) {
+                int x = word->start_x + (word->direction == 0 ? i : 0);
+                int y = word->start_y + (word->direction == 1 ? i : 0);
+                CHECK(level.word_mask[x][y]);
+                letters[i] = level.solution[x][y];
+            }
+            CHECK(is_dictionary_word(letters, word->length));
+        }
+
+        char word[MAX_WORD_LENGTH + 1];
+        char word_again[MAX_WORD_LENGTH + 1];
+        get_daily_word(6, day, word);
+        get_daily_word(6, day, word_again);
+        CHECK(strcmp(word, word_again) == 0);
+        CHECK(is_dictionary_word(word, 6));
+    }
+    CHECK(generated > 0);
+}
+
+static void calendar_matches_computed_selection(void) {
+    enum { DAYS = 40 };
+    static char words[DAYS][DAILY_LENGTH_COUNT][MAX_WORD_LENGTH + 1];
+    static CrosswordLevel levels[DAYS];
+    for (int d = 0; d < DAYS; d++) {
+        for (int i = 0; i < DAILY_LENGTH_COUNT; i++) {
+            get_daily_word(MIN_WORD_LENGTH + i, TEST_DAY + d, words[d][i]);
+        }
+        levels[d] = get_daily_crossword_level(TEST_DAY + d);
+    }
+
+    CHECK(daily_calendar_write(TEST_CALENDAR_PATH, TEST_DAY, DAYS));
+    CHECK(load_daily_calendar(TEST_CALENDAR_PATH));
+    for (int d = 0; d < DAYS; d++) {
+        for (int i = 0; i < DAILY_LENGTH_COUNT; i++) {
+            char word[MAX_WORD_LENGTH + 1];
+            get_daily_word(MIN_WORD_LENGTH + i, TEST_DAY + d, word);
+            CHECK(strcmp(word, words[d][i]) == 0);
+        }
+        CrosswordLevel level = get_daily_crossword_level(TEST_DAY + d);
+        CHECK(memcmp(level.solution, levels[d].solution, sizeof(level.solution)) == 0);
+        CHECK_EQ_INT(level.word_count, levels[d].word_count);
+    }
+    unload_daily_calendar();
+
+    // A list of the same size but other words does not use the calendar: mark
+    // the first day's 5-letter entry with a word the replacement list drops
+    const WordDictionary* dictionary = get_word_dictionary(5);
+    static PackedWord replaced[1024];
+    int count = dictionary->count;
+    CHECK(count <= 1024);
+    memcpy(replaced, dictionary->words, sizeof(PackedWord) * (size_t)count);
+    PackedWord dropped = replaced[count - 1];
+    replaced[count - 1] = word_db_pack_word("ZZZZZ", 5);
+    char dropped_word[MAX_WORD_LENGTH + 1];
+    get_word_kernels(5)->unpack(dropped, dropped_word);
+    FILE* file = fopen(TEST_CALENDAR_PATH, "r+b");
+    CHECK(file != NULL);
+    if (file) {
+        fseek(file, (long)(sizeof(DailyCalendarHeader) + offsetof(DailyCalendarEntry, words[1])), SEEK_SET);
+        fwrite(&dropped, sizeof(dropped), 1, file);
+        fclose(file);
+    }
+    CHECK(load_daily_calendar(TEST_CALENDAR_PATH));
+    char word[MAX_WORD_LENGTH + 1];
+    get_daily_word(5, TEST_DAY, word);
+    CHECK(strcmp(word, dropped_word) == 0);
+    CHECK(word_db_write("test_daily_5.cwdb", 5, replaced, NULL, NULL, count));
+    CHECK(load_word_database("test_daily_5.cwdb"));
+    CHECK_EQ_INT(get_word_dictionary(5)->count, count);
+    get_daily_word(5, TEST_DAY, word);
+    CHECK(strcmp(word, dropped_word) != 0);
+    unload_word_databases();
+    remove("test_daily_5.cwdb");
+    get_daily_word(5, TEST_DAY, word);
+    CHECK(strcmp(word, dropped_word) == 0);
+    unload_daily_calendar();
+
+    // An entries offset that wraps past the end of the file is refused
+    DailyCalendarHeader header;
+    file = fopen(TEST_CALENDAR_PATH, "r+b");
+    CHECK(file && fread(&header, sizeof(header), 1, file) == 1);
+    if (file) {
+        header.entries_offset = UINT64_MAX - 7;
+        fseek(file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, file);
+        fclose(file);
+    }
+    CHECK(!load_daily_calendar(TEST_CALENDAR_PATH));
+    remove(TEST_CALENDAR_PATH);
+}
+
+static void d_starts_the_daily_challenge(void) {
+    GameState state = create_game_state("");
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    input.day = TEST_DAY;
+    crosswordle_input_press(&input, GAME_KEY_A + ('D' - 'A'));
+    state = game_tick(state, &input);
+
+    char expected[MAX_WORD_LENGTH + 1];
+    get_daily_word(DEFAULT_WORD_LENGTH, TEST_DAY, expected);
+    CHECK_EQ_INT(state.current_view, VIEW_WORDLE);
+    CHECK_EQ_INT(state.core.daily_day, TEST_DAY);
+    CHECK_EQ_INT(state.crossword.current_level.day, TEST_DAY);
+    CHECK(strcmp(state.core.target_word, expected) == 0);
+    CHECK(strncmp(state.ui.hud.level_title, "DAILY - 2026-10-18", sizeof(state.ui.hud.level_title)) == 0);
+
+    // The packed session keeps the daily word and puzzle
+    SessionState session;
+    CHECK(session_state_pack(&state, &session));
+    GameState unpacked = session_state_unpack(&session);
+    CHECK_EQ_INT(unpacked.core.daily_day, TEST_DAY);
+    CHECK(memcmp(unpacked.crossword.current_level.solution, state.crossword.current_level.solution,
+                 sizeof(state.crossword.current_level.solution)) == 0);
+
+    // Solving it moves on to the endless levels
+    state.settings.animations_enabled = 0;
+    state = test_type(state, expected);
+    state = test_press(state, GAME_KEY_ENTER);
+    state = test_press(state, GAME_KEY_SPACE);
+    CHECK_EQ_INT(state.core.daily_day, 0);
+    CHECK_EQ_INT(state.core.current_level, 2);
+}
+
+static const TestCase DAILY_TESTS[] = {
+    {"day_numbers_round_trip_through_dates", day_numbers_round_trip_through_dates},
+    {"property_daily_crossword_is_consistent", property_daily_crossword_is_consistent},
+    {"calendar_matches_computed_selection", calendar_matches_computed_selection},
+    {"d_starts_the_daily_challenge", d_starts_the_daily_challenge},
+};
+
+TEST_GROUP(daily, DAILY_TESTS);
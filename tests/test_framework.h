@@ -0,0 +1,44 @@
+#ifndef TEST_FRAMEWORK_H
+#define TEST_FRAMEWORK_H
+
+#include <stdio.h>
+
+// Minimal test harness: each test file exports a table of cases, test_main.c
+// runs one group (or all of them) per process so CTest can run groups in parallel.
+
+typedef struct {
+    const char* name;
+    void (*run)(void);
+} TestCase;
+
+typedef struct {
+    const char* name;
+    const TestCase* cases;
+    int count;
+} TestGroup;
+
+extern int test_failures;
+
+#define CHECK(cond)                                                                 \
+    do {                                                                            \
+        if (!(cond)) {                                                              \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+            test_failures++;                                                        \
+        }                                                                           \
+    } while (0)
+
+#define CHECK_EQ_INT(actual, expected)                                              \
+    do {                                                                            \
+        long long actual_value = (long long)(actual);                               \
+        long long expected_value = (long long)(expected);                           \
+        if (actual_value != expected_value) {                                       \
+            fprintf(stderr, "%s:%d: %s == %lld, expected %lld\n",                   \
+                    __FILE__, __LINE__, #actual, actual_value, expected_value);     \
+            test_failures++;                                                        \
+        }                                                                           \
+    } while (0)
+
+#define TEST_GROUP(group_name, cases_array) \
+    const TestGroup group_name##_test_group = {#group_name, cases_array, (int)(sizeof(cases_array) / sizeof(cases_array[0]))}
+
+#endif
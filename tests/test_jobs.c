@@ -0,0 +1,211 @@
+#include <stdatomic.h>
+#include "test_framework.h"
+#include "test_support.h"
+#include "jobs.h"
+
+// Job system: inline fallback, continuations, nested fan-out across the
+// workers, parallel_for against a serial sum, and the main-thread queue
+
+#define TEST_WORKERS 4
+
+static _Atomic int jobs_counter;
+
+typedef struct {
+    int* log;
+    _Atomic int* position;
+    int value;
+} OrderJob;
+
+static void record_order(void* data) {
+    OrderJob* job = data;
+    job->log[atomic_fetch_add(job->position, 1)] = job->value;
+}
+
+static void count_job(void* data) {
+    atomic_fetch_add(&jobs_counter, *(int*)data);
+}
+
+// Each job queues `fan_out` more from inside a worker, down to depth 0
+typedef struct {
+    int depth;
+    int fan_out;
+} TreeJob;
+
+static void tree_job(void* data) {
+    TreeJob* job = data;
+    atomic_fetch_add(&jobs_counter, 1);
+    if (job->depth == 0) {
+        return;
+    }
+    TreeJob child = {job->depth - 1, job->fan_out};
+    JobHandle children[8];
+    for (int i = 0; i < job->fan_out; i++) {
+        children[i] = jobs_submit(tree_job, &child, sizeof(child));
+    }
+    for (int i = 0; i < job->fan_out; i++) {
+        jobs_wait(children[i]);
+    }
+}
+
+static void jobs_without_workers_run_inline(void) {
+    CHECK_EQ_INT(jobs_worker_count(), 0);
+    atomic_store(&jobs_counter, 0);
+    int amount = 5;
+    JobHandle job = jobs_submit(count_job, &amount, sizeof(amount));
+    CHECK(jobs_done(job));
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 5);
+    jobs_then(job, count_job, &amount, sizeof(amount));
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 10);
+}
+
+static void continuations_run_after_their_parents(void) {
+    CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+    for (int round = 0; round < 200; round++) {
+        int log[4] = {0};
+        _Atomic int position = 0;
+        OrderJob first = {log, &position, 1};
+        JobHandle a = jobs_submit(record_order, &first, sizeof(first));
+        OrderJob second = {log, &position, 2};
+        JobHandle b = jobs_then(a, record_order, &second, sizeof(second));
+        OrderJob third = {log, &position, 3};
+        JobHandle c = jobs_then(b, record_order, &third, sizeof(third));
+        jobs_wait(c);
+        CHECK(jobs_done(a) && jobs_done(b));
+        CHECK_EQ_INT(atomic_load(&position), 3);
+        CHECK(log[0] == 1 && log[1] == 2 && log[2] == 3);
+
+        // A continuation of a finished parent (whose slot may be reused) runs at once
+        OrderJob late = {log, &position, 4};
+        jobs_wait(jobs_then(a, record_order, &late, sizeof(late)));
+        CHECK_EQ_INT(log[3], 4);
+    }
+    jobs_shutdown();
+}
+
+// More argument bytes than a slot holds: run inline, never dropped
+typedef struct {
+    int amount;
+    char padding[JOB_DATA_SIZE * 2];
+} OversizedJob;
+
+static void oversized_job(void* data) {
+    atomic_fetch_add(&jobs_counter, ((OversizedJob*)data)->amount);
+}
+
+static void oversized_jobs_run_inline(void) {
+    CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+    atomic_store(&jobs_counter, 0);
+    OversizedJob job = {3, {0}};
+    JobHandle handle = jobs_submit(oversized_job, &job, sizeof(job));
+    CHECK(jobs_done(handle));
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 3);
+
+    int amount = 1;
+    JobHandle parent = jobs_submit(count_job, &amount, sizeof(amount));
+    jobs_wait(jobs_then(parent, oversized_job, &job, sizeof(job)));
+    CHECK(jobs_done(parent));
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 7);
+    jobs_shutdown();
+}
+
+static void nested_jobs_spread_across_workers(void) {
+    CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+    atomic_store(&jobs_counter, 0);
+    // 1 + 6 + 36 + 216 + 1296 jobs, most of them queued from inside workers
+    TreeJob root = {4, 6};
+    jobs_wait(jobs_submit(tree_job, &root, sizeof(root)));
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 1555);
+
+    JobsUtilization utilization;
+    jobs_sample_utilization(&utilization);
+    CHECK_EQ_INT(utilization.worker_count, TEST_WORKERS);
+    uint32_t run = 0;
+    for (int w = 0; w < TEST_WORKERS; w++) {
+        run += utilization.jobs_run[w];
+        CHECK(utilization.jobs_stolen[w] <= utilization.jobs_run[w]);
+        CHECK(utilization.busy_percent[w] <= 100);
+    }
+    // The waiting test thread helps too, so workers ran at most all of them
+    CHECK(run <= 1555);
+    jobs_shutdown();
+    CHECK_EQ_INT(jobs_worker_count(), 0);
+}
+
+typedef struct {
+    const uint32_t* values;
+    _Atomic uint64_t sum;
+    _Atomic int calls;
+} SumContext;
+
+static void sum_range(void* context, int begin, int end) {
+    SumContext* sum = context;
+    uint64_t partial = 0;
+    for (int i = begin; i < end; i++) {
+        partial += sum->values[i];
+    }
+    atomic_fetch_add(&sum->sum, partial);
+    atomic_fetch_add(&sum->calls, 1);
+}
+
+// Property: parallel_for covers every index exactly once, whatever the grain
+static void property_parallel_for_matches_serial_sum(void) {
+    enum { VALUES = 50000 };
+    static uint32_t values[VALUES];
+    test_random_seed(46);
+    uint64_t expected = 0;
+    for (int i = 0; i < VALUES; i++) {
+        values[i] = test_random() % 1000;
+        expected += values[i];
+    }
+    CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+    for (int trial = 0; trial < 50; trial++) {
+        int count = (int)(test_random() % VALUES);
+        int grain = 1 + (int)(test_random() % 2000);
+        uint64_t serial = 0;
+        for (int i = 0; i < count; i++) {
+            serial += values[i];
+        }
+        SumContext sum = {values, 0, 0};
+        jobs_parallel_for(count, grain, sum_range, &sum);
+        CHECK(atomic_load(&sum.sum) == serial);
+        CHECK_EQ_INT(atomic_load(&sum.calls), count == 0 ? 0 : (count + grain - 1) / grain);
+    }
+    SumContext all = {values, 0, 0};
+    jobs_parallel_for(VALUES, 100, sum_range, &all);
+    CHECK(atomic_load(&all.sum) == expected);
+    jobs_shutdown();
+}
+
+static void post_from_job(void* data) {
+    jobs_post_main(count_job, data, sizeof(int));
+}
+
+static void main_queue_runs_callbacks_on_the_draining_thread(void) {
+    CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+    atomic_store(&jobs_counter, 0);
+    int amount = 3;
+    JobHandle handles[10];
+    for (int i = 0; i < 10; i++) {
+        handles[i] = jobs_submit(post_from_job, &amount, sizeof(amount));
+    }
+    for (int i = 0; i < 10; i++) {
+        jobs_wait(handles[i]);
+    }
+    // Posted, not run, until the drain
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 0);
+    CHECK_EQ_INT(jobs_drain_main(), 10);
+    CHECK_EQ_INT(atomic_load(&jobs_counter), 30);
+    CHECK_EQ_INT(jobs_drain_main(), 0);
+    jobs_shutdown();
+}
+
+static const TestCase JOBS_TESTS[] = {
+    {"jobs_without_workers_run_inline", jobs_without_workers_run_inline},
+    {"continuations_run_after_their_parents", continuations_run_after_their_parents},
+    {"oversized_jobs_run_inline", oversized_jobs_run_inline},
+    {"nested_jobs_spread_across_workers", nested_jobs_spread_across_workers},
+    {"property_parallel_for_matches_serial_sum", property_parallel_for_matches_serial_sum},
+    {"main_queue_runs_callbacks_on_the_draining_thread", main_queue_runs_callbacks_on_the_draining_thread},
+};
+
+TEST_GROUP(jobs, JOBS_TESTS);
@@ -0,0 +1,186 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "leaderboard.h"
+
+// Leaderboard store: ordering against a brute-force model across leaf splits
+// and reopens, per-metric ranking, and the results a solved level leaves
+
+#define TEST_LEADERBOARD_PATH "test_leaderboard.cwlb"
+#define MODEL_BOARDS 6
+#define MODEL_RECORDS 6000
+
+typedef struct {
+    uint32_t score;
+    uint32_t sequence;
+} ModelEntry;
+
+static int compare_model(const void* a, const void* b) {
+    const ModelEntry* x = a;
+    const ModelEntry* y = b;
+    if (x->score != y->score) return x->score < y->score ? -1 : 1;
+    return (x->sequence > y->sequence) - (x->sequence < y->sequence);
+}
+
+// Property: top-k of every board matches sorting everything submitted to it
+static void property_top_k_matches_sorted_model(void) {
+    static ModelEntry model[MODEL_BOARDS][MODEL_RECORDS];
+    static LeaderboardRecord top[MODEL_RECORDS];
+    int counts[MODEL_BOARDS] = {0};
+    uint32_t boards[MODEL_BOARDS];
+    for (int b = 0; b < MODEL_BOARDS; b++) {
+        boards[b] = leaderboard_board((uint32_t)(b / 2), LEADERBOARD_MODE_WORDLE,
+                                      b % 2 ? LEADERBOARD_LONGEST_STREAK : LEADERBOARD_FEWEST_GUESSES);
+    }
+
+    remove(TEST_LEADERBOARD_PATH);
+    CHECK(leaderboard_open(TEST_LEADERBOARD_PATH));
+    srand(42);
+    uint32_t sequence = 0;
+    for (int round = 0; round < 3; round++) {
+        // Some rounds arrive in key order (whole-page appends), others at random
+        for (int i = 0; i < MODEL_RECORDS / 3; i++) {
+            int b = round == 1 ? MODEL_BOARDS - 1 : rand() % MODEL_BOARDS;
+            LeaderboardRecord record = {0};
+            record.board = boards[b];
+            record.value = round == 1 ? (uint32_t)i / 4 : (uint32_t)(rand() % 50);
+            leaderboard_submit(record);
+            LeaderboardMetric metric = (LeaderboardMetric)(boards[b] & 0xFF);
+            model[b][counts[b]++] = (ModelEntry){leaderboard_score(metric, record.value), sequence++};
+        }
+        // Reopening loads only the header and the leaf index
+        leaderboard_close();
+        CHECK(leaderboard_open(TEST_LEADERBOARD_PATH));
+    }
+    CHECK_EQ_INT((int)leaderboard_record_count(), MODEL_RECORDS);
+
+    for (int b = 0; b < MODEL_BOARDS; b++) {
+        qsort(model[b], (size_t)counts[b], sizeof(ModelEntry), compare_model);
+        CHECK_EQ_INT(leaderboard_top(boards[b], top, MODEL_RECORDS), counts[b]);
+        CHECK_EQ_INT(leaderboard_top(boards[b], top, 10), counts[b] < 10 ? counts[b] : 10);
+        leaderboard_top(boards[b], top, MODEL_RECORDS);
+        for (int i = 0; i < counts[b]; i++) {
+            CHECK_EQ_INT(top[i].board, boards[b]);
+            CHECK_EQ_INT(top[i].score, model[b][i].score);
+            CHECK_EQ_INT(top[i].sequence, model[b][i].sequence);
+        }
+    }
+    CHECK_EQ_INT(leaderboard_top(leaderboard_board(99, LEADERBOARD_MODE_SPEED, LEADERBOARD_FASTEST_TIME), top, 10), 0);
+    leaderboard_close();
+    remove(TEST_LEADERBOARD_PATH);
+}
+
+static void metrics_rank_best_first(void) {
+    remove(TEST_LEADERBOARD_PATH);
+    CHECK(leaderboard_open(TEST_LEADERBOARD_PATH));
+    static const uint32_t values[] = {4, 2, 7, 2};
+    LeaderboardResult result = {0};
+    for (int i = 0; i < 4; i++) {
+        result.metric = LEADERBOARD_FEWEST_GUESSES;
+        result.value = values[i];
+        leaderboard_submit_result(LEADERBOARD_DEFAULT_PROFILE, &result);
+        result.metric = LEADERBOARD_LONGEST_STREAK;
+        leaderboard_submit_result(LEADERBOARD_DEFAULT_PROFILE, &result);
+    }
+    CHECK(leaderboard_flush());
+
+    LeaderboardRecord top[4];
+    uint32_t fewest = leaderboard_board(LEADERBOARD_DEFAULT_PROFILE, LEADERBOARD_MODE_WORDLE, LEADERBOARD_FEWEST_GUESSES);
+    uint32_t streak = leaderboard_board(LEADERBOARD_DEFAULT_PROFILE, LEADERBOARD_MODE_WORDLE, LEADERBOARD_LONGEST_STREAK);
+    CHECK_EQ_INT(leaderboard_top(fewest, top, 4), 4);
+    CHECK(top[0].value == 2 && top[1].value == 2 && top[2].value == 4 && top[3].value == 7);
+    CHECK(top[0].sequence < top[1].sequence);           // Ties rank oldest first
+    CHECK(top[0].recorded_at != 0);
+    CHECK_EQ_INT(leaderboard_top(streak, top, 4), 4);
+    CHECK(top[0].value == 7 && top[1].value == 4 && top[2].value == 2);
+    leaderboard_close();
+
+    // Not a leaderboard file: refused rather than overwritten
+    FILE* file = fopen(TEST_LEADERBOARD_PATH, "wb");
+    fputs("not a leaderboard", file);
+    fclose(file);
+    CHECK(!leaderboard_open(TEST_LEADERBOARD_PATH));
+    remove(TEST_LEADERBOARD_PATH);
+}
+
+// A crash after a batch's pages are written but before its header is: the
+// file with the old header back in page 0 must read exactly as before
+static void header_from_before_a_batch_still_reads_the_store(void) {
+    static LeaderboardRecord before[2000];
+    static LeaderboardRecord after[2000];
+    uint32_t board = leaderboard_board(LEADERBOARD_DEFAULT_PROFILE, LEADERBOARD_MODE_WORDLE, LEADERBOARD_FEWEST_GUESSES);
+    remove(TEST_LEADERBOARD_PATH);
+    CHECK(leaderboard_open(TEST_LEADERBOARD_PATH));
+    srand(7);
+    for (int batch = 0; batch < 4; batch++) {
+        for (int i = 0; i < 300; i++) {
+            LeaderboardRecord record = {0};
+            record.board = board;
+            record.value = (uint32_t)(rand() % 50);
+            leaderboard_submit(record);
+        }
+        CHECK(leaderboard_flush());
+    }
+    int count = leaderboard_top(board, before, 2000);
+    CHECK_EQ_INT(count, 1200);
+    leaderboard_close();
+
+    LeaderboardFileHeader old_header;
+    FILE* file = fopen(TEST_LEADERBOARD_PATH, "rb");
+    CHECK(file && fread(&old_header, sizeof(old_header), 1, file) == 1);
+    if (file) {
+        fclose(file);
+    }
+
+    // A batch that splits leaves all over the board
+    CHECK(leaderboard_open(TEST_LEADERBOARD_PATH));
+    for (int i = 0; i < 600; i++) {
+        LeaderboardRecord record = {0};
+        record.board = board;
+        record.value = (uint32_t)(rand() % 50);
+        leaderboard_submit(record);
+    }
+    CHECK(leaderboard_flush());
+    CHECK_EQ_INT(leaderboard_top(board, after, 2000), 1800);
+    leaderboard_close();
+
+    file = fopen(TEST_LEADERBOARD_PATH, "r+b");
+    CHECK(file && fwrite(&old_header, sizeof(old_header), 1, file) == 1);
+    if (file) {
+        fclose(file);
+    }
+    CHECK(leaderboard_open(TEST_LEADERBOARD_PATH));
+    CHECK_EQ_INT((int)leaderboard_record_count(), 1200);
+    CHECK_EQ_INT(leaderboard_top(board, after, 2000), count);
+    for (int i = 0; i < count; i++) {
+        CHECK(after[i].sequence == before[i].sequence && after[i].score == before[i].score);
+    }
+    leaderboard_close();
+    remove(TEST_LEADERBOARD_PATH);
+}
+
+static void solved_level_leaves_leaderboard_results(void) {
+    GameState state = test_start_wordle("CRANE");
+    state = test_type(state, "NORTH");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.system.leaderboard_result_count, 0);
+    state = test_type(state, "CRANE");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.system.leaderboard_result_count, 1);
+    CHECK_EQ_INT(state.system.leaderboard_results[0].mode, LEADERBOARD_MODE_WORDLE);
+    CHECK_EQ_INT(state.system.leaderboard_results[0].metric, LEADERBOARD_FEWEST_GUESSES);
+    CHECK_EQ_INT(state.system.leaderboard_results[0].value, 2);
+    CHECK_EQ_INT(state.system.leaderboard_results[0].word_length, 5);
+
+    // Results last one tick: the front end files them right after it
+    state = test_tick(state);
+    CHECK_EQ_INT(state.system.leaderboard_result_count, 0);
+}
+
+static const TestCase LEADERBOARD_TESTS[] = {
+    {"property_top_k_matches_sorted_model", property_top_k_matches_sorted_model},
+    {"metrics_rank_best_first", metrics_rank_best_first},
+    {"header_from_before_a_batch_still_reads_the_store", header_from_before_a_batch_still_reads_the_store},
+    {"solved_level_leaves_leaderboard_results", solved_level_leaves_leaderboard_results},
+};
+
+TEST_GROUP(leaderboard, LEADERBOARD_TESTS);
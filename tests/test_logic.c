@@ -0,0 +1,712 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "render_snapshot.h"
+#include "speed_mode.h"
+#include "worddb.h"
+
+// Wordle-side logic: feedback, kernels, dictionaries, guess flow and word selection
+
+static void letter_state_marks_exact_present_and_absent(void) {
+    CHECK_EQ_INT(calculate_letter_state('C', 0, "CRANE"), LETTER_CORRECT);
+    CHECK_EQ_INT(calculate_letter_state('E', 0, "CRANE"), LETTER_WRONG_POS);
+    CHECK_EQ_INT(calculate_letter_state('Z', 2, "CRANE"), LETTER_NOT_IN_WORD);
+    CHECK(is_letter_in_target_word('N', "CRANE"));
+    CHECK(!is_letter_in_target_word('Q', "CRANE"));
+    CHECK(check_word_match("CRANE", "CRANE"));
+    CHECK(!check_word_match("CRANE", "CRATE"));
+}
+
+static void kernels_score_like_calculate_letter_state(void) {
+    static const char* pairs[][2] = {
+        {"ABLE", "BALE"}, {"CRANE", "NACRE"}, {"SPEEDS", "ERASES"}, {"ABILITY", "BILLION"},
+    };
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        const char* guess = pairs[p][0];
+        const char* target = pairs[p][1];
+        int length = (int)strlen(guess);
+        LetterState states[MAX_WORD_LENGTH];
+        get_word_kernels(length)->score_guess(guess, target, states);
+        for (int i = 0; i < length; i++) {
+            CHECK_EQ_INT(states[i], calculate_letter_state(guess[i], i, target));
+        }
+    }
+}
+
+static void kernels_pack_round_trip_in_alphabetical_order(void) {
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        const WordKernels* kernels = get_word_kernels(length);
+        CHECK_EQ_INT(kernels->length, length);
+        
+        const WordDictionary* dictionary = get_word_dictionary(length);
+        CHECK(dictionary->count > 0);
+        for (int i = 0; i < dictionary->count; i++) {
+            char word[MAX_WORD_LENGTH + 1];
+            kernels->unpack(dictionary->words[i], word);
+            CHECK_EQ_INT((int)strlen(word), length);
+            CHECK(kernels->pack(word) == dictionary->words[i]);
+            CHECK_EQ_INT(dictionary_find(dictionary, dictionary->words[i]), i);
+            if (i > 0) {
+                CHECK(dictionary->words[i - 1] < dictionary->words[i]);
+            }
+        }
+    }
+    CHECK(is_dictionary_word("EAGLE", 5));
+    CHECK(!is_dictionary_word("QQQQQ", 5));
+    CHECK(get_word_kernels(99)->length == DEFAULT_WORD_LENGTH);
+}
+
+static void feedback_codes_are_distinct_per_pattern(void) {
+    LetterState all_correct[5] = {LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT};
+    LetterState one_present[5] = {LETTER_WRONG_POS, LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT};
+    LetterState last_absent[5] = {LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT, LETTER_CORRECT, LETTER_NOT_IN_WORD};
+    CHECK_EQ_INT(feedback_code(all_correct, 5), 0);
+    CHECK_EQ_INT(feedback_code(one_present, 5), 1);
+    CHECK_EQ_INT(feedback_code(last_absent, 5), 2 * 81);
+}
+
+static void typing_and_backspace_edit_the_guess(void) {
+    GameState state = test_start_wordle("CRANE");
+    CHECK_EQ_INT(state.current_view, VIEW_WORDLE);
+    
+    state = test_type(state, "CRAT");
+    CHECK_EQ_INT(state.input.current_letter_pos, 4);
+    state = test_press(state, GAME_KEY_BACKSPACE);
+    CHECK_EQ_INT(state.input.current_letter_pos, 3);
+    state = test_type(state, "NEX");  // Extra letter beyond the word length is ignored
+    CHECK(strcmp(state.input.current_word, "CRANE") == 0);
+}
+
+static void wrong_guess_records_history_without_award(void) {
+    GameState state = test_start_wordle("CRANE");
+    state = test_type(state, "SLATE");
+    state = test_press(state, GAME_KEY_ENTER);
+    
+    CHECK_EQ_INT(state.history.level_guess_count, 1);
+    CHECK_EQ_INT(state.core.guesses_this_level, 1);
+    CHECK_EQ_INT(state.core.play_state, GAME_STATE_INPUT);
+    CHECK_EQ_INT(state.history.level_letter_states[0][2], LETTER_CORRECT);    // A
+    CHECK_EQ_INT(state.history.level_letter_states[0][0], LETTER_NOT_IN_WORD); // S
+    CHECK_EQ_INT(token_ledger_total(&state.stats.tokens), 0);
+}
+
+static void solving_awards_one_target_letter_and_advances(void) {
+    GameState state = test_start_wordle("CRANE");
+    state = test_type(state, "CRANE");
+    state = test_press(state, GAME_KEY_ENTER);
+    
+    CHECK_EQ_INT(state.core.play_state, GAME_STATE_LEVEL_COMPLETE);
+    CHECK_EQ_INT(state.stats.levels_completed, 1);
+    CHECK_EQ_INT(token_ledger_total(&state.stats.tokens), 1);
+    int awarded_from_target = 0;
+    for (const char* c = "CRANE"; *c; c++) {
+        awarded_from_target += token_ledger_count(&state.stats.tokens, *c) > 0;
+    }
+    CHECK_EQ_INT(awarded_from_target, 1);
+    
+    state = test_press(state, GAME_KEY_SPACE);
+    CHECK_EQ_INT(state.core.current_level, 2);
+    CHECK_EQ_INT(state.core.play_state, GAME_STATE_INPUT);
+    CHECK_EQ_INT(state.history.level_guess_count, 0);
+    CHECK(is_dictionary_word(state.core.target_word, state.core.word_length));
+}
+
+static void word_selection_follows_difficulty_tiers(void) {
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        long easy_total = 0;
+        long hard_total = 0;
+        for (int i = 0; i < 64; i++) {
+            char word[MAX_WORD_LENGTH + 1];
+            get_word_for_level(length, 1, word);
+            CHECK(is_dictionary_word(word, length));
+            easy_total += get_word_difficulty(length, word);
+            get_word_for_level(length, 1000, word);
+            hard_total += get_word_difficulty(length, word);
+        }
+        CHECK(easy_total < hard_total);
+    }
+    CHECK_EQ_INT(difficulty_bucket_for_level(1), 0);
+    CHECK_EQ_INT(difficulty_bucket_for_level(1000), DIFFICULTY_BUCKET_COUNT - 1);
+}
+
+// Asking for more than the tiers can supply is cut, and what is left holds:
+// every draw differs from the window's worth of draws before it
+static void word_draws_never_repeat_within_the_window(void) {
+    // The default fits every built-in list
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        CHECK_EQ_INT(get_word_repeat_window(length), DEFAULT_WORD_REPEAT_WINDOW);
+    }
+
+    set_word_repeat_window(1 << 20);
+    for (int length = MIN_WORD_LENGTH; length <= MAX_WORD_LENGTH; length++) {
+        int window = get_word_repeat_window(length);
+        CHECK(window > 0);
+        CHECK(window <= get_word_dictionary(length)->count / DIFFICULTY_BUCKET_COUNT / 2);
+
+        char (*drawn)[MAX_WORD_LENGTH + 1] = malloc((size_t)window * 3 * sizeof(*drawn));
+        for (int i = 0; i < window * 3; i++) {
+            get_word_for_level(length, 1, drawn[i]);
+            for (int back = 1; back <= window && back <= i; back++) {
+                CHECK(strcmp(drawn[i], drawn[i - back]) != 0);
+            }
+        }
+        free(drawn);
+    }
+    set_word_repeat_window(DEFAULT_WORD_REPEAT_WINDOW);
+}
+
+// Property: for random guess/target pairs, feedback is consistent with the target
+static void property_feedback_consistent_with_target(void) {
+    test_random_seed(0x5eed0031u);
+    for (int iteration = 0; iteration < 4000; iteration++) {
+        int length = MIN_WORD_LENGTH + (int)(test_random() % WORD_LENGTH_MODE_COUNT);
+        const WordDictionary* dictionary = get_word_dictionary(length);
+        const WordKernels* kernels = get_word_kernels(length);
+        char guess[MAX_WORD_LENGTH + 1];
+        char target[MAX_WORD_LENGTH + 1];
+        kernels->unpack(dictionary->words[test_random() % dictionary->count], guess);
+        kernels->unpack(dictionary->words[test_random() % dictionary->count], target);
+        
+        LetterState states[MAX_WORD_LENGTH];
+        kernels->score_guess(guess, target, states);
+        int all_correct = 1;
+        for (int i = 0; i < length; i++) {
+            int in_target = strchr(target, guess[i]) != NULL;
+            if (states[i] == LETTER_CORRECT) {
+                CHECK(guess[i] == target[i]);
+            } else if (states[i] == LETTER_WRONG_POS) {
+                CHECK(guess[i] != target[i] && in_target);
+            } else {
+                CHECK(states[i] == LETTER_NOT_IN_WORD && !in_target);
+            }
+            all_correct &= states[i] == LETTER_CORRECT;
+        }
+        CHECK_EQ_INT(all_correct, strcmp(guess, target) == 0);
+        CHECK_EQ_INT(feedback_code(states, length) == 0, all_correct);
+    }
+}
+
+static void hard_mode_refuses_guesses_that_drop_revealed_letters(void) {
+    GameState state = test_start_wordle("CRANE");
+    state.settings.hard_mode = 1;
+    state = test_type(state, "NORTH");                    // N and R present
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.history.level_guess_count, 1);
+
+    state = test_type(state, "BLAST");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.history.level_guess_count, 1);     // Refused, word kept for editing
+    CHECK(strcmp(state.input.current_word, "BLAST") == 0);
+    CHECK_EQ_INT(state.input.hard_mode_violation.kind, GUESS_VIOLATION_REQUIRED);
+    CHECK_EQ_INT(state.input.hard_mode_violation.letter, 'N');
+    CHECK(strcmp(state.ui.hud.hard_mode_text, "Hard mode: guess must contain N") == 0);
+
+    state = test_press(state, GAME_KEY_BACKSPACE);
+    CHECK_EQ_INT(state.input.hard_mode_violation.kind, GUESS_VIOLATION_NONE);
+    for (int i = 0; i < 4; i++) {
+        state = test_press(state, GAME_KEY_BACKSPACE);
+    }
+    state = test_type(state, "BRAND");                   // R, A and N now green
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.history.level_guess_count, 2);
+
+    state = test_type(state, "RINSE");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.input.hard_mode_violation.kind, GUESS_VIOLATION_FIXED);
+    CHECK_EQ_INT(state.input.hard_mode_violation.position, 1);
+    CHECK(strcmp(state.ui.hud.hard_mode_text, "Hard mode: 2nd letter must be R") == 0);
+}
+
+static void keyboard_table_changes_only_when_guesses_complete(void) {
+    GameState state = test_start_wordle("CRANE");
+    uint32_t version = state.history.keyboard.version;
+    state = test_type(state, "NORTH");
+    CHECK_EQ_INT(state.history.keyboard.version, version);   // Typing leaves it alone
+
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK(state.history.keyboard.version != version);
+    CHECK_EQ_INT(state.history.keyboard.letters['N' - 'A'], LETTER_WRONG_POS);
+    CHECK_EQ_INT(state.history.keyboard.letters['O' - 'A'], LETTER_NOT_IN_WORD);
+    CHECK_EQ_INT(state.history.keyboard.letters['C' - 'A'], LETTER_UNKNOWN);
+
+    state = test_type(state, "BRAND");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.history.keyboard.letters['R' - 'A'], LETTER_CORRECT);
+    CHECK_EQ_INT(state.history.keyboard.letters['N' - 'A'], LETTER_CORRECT);
+
+    // A later yellow R never downgrades the green one
+    state = test_type(state, "ROAST");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.history.keyboard.letters['R' - 'A'], LETTER_CORRECT);
+    CHECK_EQ_INT(state.history.keyboard.letters['S' - 'A'], LETTER_NOT_IN_WORD);
+
+    // The packed session rebuilds the same table
+    SessionState session;
+    CHECK(session_state_pack(&state, &session));
+    GameState unpacked = session_state_unpack(&session);
+    CHECK(memcmp(unpacked.history.keyboard.letters, state.history.keyboard.letters,
+                 sizeof(state.history.keyboard.letters)) == 0);
+}
+
+// Clicks the middle of the on-screen key that types `key`
+static GameState test_click_key(GameState state, int key) {
+    KeyboardLayout layout = calculate_keyboard_layout(state.current_view, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    for (int i = 0; i < KEYBOARD_KEY_COUNT; i++) {
+        KeyboardKeyRect on_screen = keyboard_key(&layout, i);
+        if (on_screen.key == key) {
+            crosswordle_input_click(&input, layout.x + on_screen.x + on_screen.width / 2,
+                                    layout.y + on_screen.y + on_screen.height / 2);
+        }
+    }
+    return game_tick(state, &input);
+}
+
+static void clicking_the_on_screen_keyboard_types_keys(void) {
+    KeyboardLayout layout = calculate_keyboard_layout(VIEW_WORDLE, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    uint32_t letters_seen = 0;
+    for (int i = 0; i < KEYBOARD_KEY_COUNT; i++) {
+        KeyboardKeyRect key = keyboard_key(&layout, i);
+        CHECK(key.x >= 0 && key.x + key.width <= layout.width);
+        CHECK(key.y >= 0 && key.y + key.height <= layout.height);
+        CHECK_EQ_INT(keyboard_key_at(&layout, layout.x + key.x, layout.y + key.y + key.height - 1), key.key);
+        if (key.key >= GAME_KEY_A && key.key <= GAME_KEY_Z) {
+            letters_seen |= 1u << (key.key - GAME_KEY_A);
+        }
+    }
+    CHECK_EQ_INT(letters_seen, (1u << TOKEN_LETTER_COUNT) - 1);
+    CHECK_EQ_INT(keyboard_key_at(&layout, layout.x + layout.key_width, layout.y), GAME_KEY_NONE);  // Gap
+    CHECK_EQ_INT(keyboard_key_at(&layout, layout.x - 1, layout.y), GAME_KEY_NONE);
+
+    GameState state = test_start_wordle("CRANE");
+    const char* word = "CRANE";
+    for (int i = 0; word[i]; i++) {
+        state = test_click_key(state, GAME_KEY_A + (word[i] - 'A'));
+    }
+    CHECK(strcmp(state.input.current_word, "CRANE") == 0);
+    state = test_click_key(state, GAME_KEY_BACKSPACE);
+    CHECK(strcmp(state.input.current_word, "CRAN") == 0);
+    state = test_click_key(state, GAME_KEY_A + ('E' - 'A'));
+    state = test_click_key(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.core.play_state, GAME_STATE_LEVEL_COMPLETE);
+}
+
+static void keys_pressed_in_one_frame_are_all_applied(void) {
+    GameState state = test_start_wordle("CRANE");
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    const char* keys = "CRANE";
+    for (int i = 0; keys[i]; i++) {
+        crosswordle_input_press(&input, GAME_KEY_A + (keys[i] - 'A'));
+    }
+    crosswordle_input_press(&input, GAME_KEY_ENTER);
+    state = game_tick(state, &input);
+    CHECK_EQ_INT(state.history.level_guess_count, 1);
+    CHECK_EQ_INT(state.core.play_state, GAME_STATE_LEVEL_COMPLETE);
+    CHECK_EQ_INT(input_event_count(&state.system.events), 0);
+    CHECK_EQ_INT(state.system.events.dropped, 0);
+
+    // Keys beyond the platform queue are counted, not silently lost
+    state = test_start_wordle("CRANE");
+    input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    for (int i = 0; i < GAME_INPUT_MAX_KEYS + 3; i++) {
+        crosswordle_input_press(&input, GAME_KEY_BACKSPACE);
+    }
+    state = game_tick(state, &input);
+    CHECK_EQ_INT(state.system.events.consumed - state.system.events.queued, 0);
+    CHECK_EQ_INT(state.system.events.dropped, 3);
+
+    InputEventRing ring = {0};
+    for (int i = 0; i < INPUT_EVENT_RING_SIZE + 1; i++) {
+        input_event_push(&ring, input_event_for_key(GAME_KEY_ENTER, i));
+    }
+    CHECK_EQ_INT(ring.dropped, 1);
+    InputEvent event;
+    CHECK(input_event_pop(&ring, &event));
+    CHECK_EQ_INT((int)event.time, 0);                        // Oldest first
+}
+
+static void binding_files_remap_keys_to_actions(void) {
+    const char* path = "test_bindings.txt";
+    FILE* file = fopen(path, "w");
+    CHECK(file != NULL);
+    fputs("# AZERTY letters\nQ letter_A\nA letter_Q\n\nSPACE submit  # extra enter\n262 none\n", file);
+    fclose(file);
+
+    CHECK(load_input_bindings(path));
+    CHECK_EQ_INT(input_event_for_key('Q', 0).letter, 'A');
+    CHECK_EQ_INT(input_event_for_key('A', 0).letter, 'Q');
+    CHECK_EQ_INT(input_event_for_key(GAME_KEY_SPACE, 0).action, GAME_ACTION_SUBMIT);
+    CHECK_EQ_INT(input_event_for_key(GAME_KEY_RIGHT, 0).action, GAME_ACTION_NONE);
+    CHECK_EQ_INT(input_event_for_key(GAME_KEY_ENTER, 0).action, GAME_ACTION_SUBMIT);   // Untouched default
+
+    GameState state = test_start_wordle("CRANE");
+    state = test_type(state, "QQ");
+    CHECK(strcmp(state.input.current_word, "AA") == 0);
+
+    // A malformed file changes nothing
+    file = fopen(path, "w");
+    CHECK(file != NULL);
+    fputs("Q letter_B\nENTER launch\n", file);
+    fclose(file);
+    CHECK(!load_input_bindings(path));
+    CHECK_EQ_INT(input_event_for_key('Q', 0).letter, 'A');
+
+    reset_input_bindings();
+    CHECK_EQ_INT(input_event_for_key('Q', 0).letter, 'Q');
+    remove(path);
+}
+
+static void latency_marks_follow_actions_to_the_presented_frame(void) {
+    GameState state = test_start_wordle("CRANE");
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    input.time = 2.0;
+    crosswordle_input_press(&input, GAME_KEY_A + ('C' - 'A'));
+    crosswordle_input_press(&input, GAME_KEY_BACKSPACE);
+    crosswordle_input_press(&input, GAME_KEY_ENTER);            // Nothing to submit: no mark
+    state = game_tick(state, &input);
+    CHECK_EQ_INT(state.system.latency_mark_count, 2);
+    CHECK_EQ_INT(state.system.latency_marks[0].action, GAME_ACTION_LETTER);
+    CHECK_EQ_INT(state.system.latency_marks[1].action, GAME_ACTION_DELETE);
+    CHECK(state.system.latency_marks[0].time == 2.0);
+
+    // The first frame showing the tick closes its marks
+    static RenderSnapshotBuffer snapshots;
+    render_snapshot_init(&snapshots, &state);
+    render_snapshot_publish(&snapshots, &state);
+    static LatencyHistograms histograms;
+    memset(&histograms, 0, sizeof(histograms));
+    render_snapshot_close_marks(render_snapshot_acquire(&snapshots), 0, &histograms, 2.0165);
+    latency_record(&histograms, GAME_ACTION_LETTER, 0.120);    // Lands in the overflow bucket
+    CHECK_EQ_INT(histograms.count[GAME_ACTION_LETTER], 2);
+    CHECK_EQ_INT(histograms.buckets[GAME_ACTION_LETTER][16], 1);
+    CHECK_EQ_INT(histograms.buckets[GAME_ACTION_LETTER][LATENCY_BUCKET_COUNT - 1], 1);
+    CHECK((int)latency_percentile(&histograms, GAME_ACTION_LETTER, 0.5) == 17);
+    CHECK((int)latency_percentile(&histograms, GAME_ACTION_LETTER, 0.99) == 120);
+
+    state = test_tick(state);
+    CHECK_EQ_INT(state.system.latency_mark_count, 0);
+
+    const char* path = "test_latency.csv";
+    CHECK(latency_write_stats(&histograms, path));
+    FILE* file = fopen(path, "r");
+    CHECK(file != NULL);
+    char line[1024];
+    CHECK(fgets(line, sizeof(line), file) && strncmp(line, "action,count,mean_ms,p50_ms", 27) == 0);
+    CHECK(fgets(line, sizeof(line), file) && strncmp(line, "letter,2,", 9) == 0);
+    CHECK(fgets(line, sizeof(line), file) && strncmp(line, "delete,1,", 9) == 0);
+    fclose(file);
+    remove(path);
+}
+
+// A frame can queue as many events as the ring holds; each one keeps its mark
+static void a_full_frame_of_events_keeps_every_mark(void) {
+    GameState state = test_start_wordle("CRANE");
+    KeyboardLayout layout = calculate_keyboard_layout(VIEW_WORDLE, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    for (int i = 0; i < GAME_INPUT_MAX_KEYS; i++) {
+        crosswordle_input_press(&input, i % 2 ? GAME_KEY_BACKSPACE : GAME_KEY_A + ('C' - 'A'));
+    }
+    for (int i = 0; i < KEYBOARD_KEY_COUNT; i++) {
+        KeyboardKeyRect key = keyboard_key(&layout, i);
+        if (key.key == GAME_KEY_A + ('R' - 'A')) {
+            crosswordle_input_click(&input, layout.x + key.x + key.width / 2, layout.y + key.y + key.height / 2);
+        }
+    }
+    state = game_tick(state, &input);
+    CHECK_EQ_INT(state.system.latency_mark_count, GAME_INPUT_MAX_KEYS + 1);
+    CHECK_EQ_INT(state.system.latency_marks[GAME_INPUT_MAX_KEYS].action, GAME_ACTION_LETTER);
+    CHECK_EQ_INT(state.input.current_word[0], 'R');
+}
+
+// One frame read at clock time `time`; frame_time is deliberately unrelated
+static GameState press_at(GameState state, int key, double time) {
+    GameInput input = crosswordle_input(0.5f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    input.time = time;
+    if (key != GAME_KEY_NONE) {
+        crosswordle_input_press(&input, key);
+    }
+    return game_tick(state, &input);
+}
+
+static GameState type_at(GameState state, const char* letters, double time) {
+    for (int i = 0; letters[i]; i++) {
+        state = press_at(state, GAME_KEY_A + (letters[i] - 'A'), time);
+    }
+    return state;
+}
+
+static void speed_mode_times_guesses_from_key_timestamps(void) {
+    GameState state = create_game_state("");
+    state.settings.animations_enabled = 0;
+    state = press_at(state, GAME_KEY_A + ('S' - 'A'), 10.0);
+    CHECK(state.speed.active);
+    CHECK_EQ_INT(state.current_view, VIEW_WORDLE);
+    strcpy(state.core.target_word, "CRANE");
+    state.core.word_length = 5;
+
+    state = type_at(state, "NORTH", 12.0);
+    state = press_at(state, GAME_KEY_ENTER, 13.25);
+    state = type_at(state, "CRANE", 14.0);
+    state = press_at(state, GAME_KEY_ENTER, 15.0);
+    state = press_at(state, GAME_KEY_NONE, 40.0);                // Solved: the level clock stopped
+    CHECK_EQ_INT(state.speed.split_count, 2);
+    CHECK_EQ_INT(speed_split_at(&state.speed, 0)->guess_us, 3250000);
+    CHECK_EQ_INT(speed_split_at(&state.speed, 1)->guess_us, 1750000);
+    CHECK_EQ_INT(speed_split_at(&state.speed, 1)->level_us, 5000000);
+    CHECK_EQ_INT(speed_split_at(&state.speed, 1)->flags, SPEED_SPLIT_SOLVED);
+    CHECK(strcmp(state.ui.hud.speed_timer_text, "LEVEL 5.0s | RUN 5.0s") == 0);
+    CHECK(strcmp(state.ui.hud.speed_splits_text, "Splits: 3.2 1.7") == 0);
+
+    // SPACE starts the next level's clock; the run clock resumes without the pause
+    state = press_at(state, GAME_KEY_SPACE, 20.0);
+    state = press_at(state, GAME_KEY_NONE, 21.05);
+    CHECK(strcmp(state.ui.hud.speed_timer_text, "LEVEL 1.0s | RUN 6.0s") == 0);
+
+    const char* binary_path = "test_speed.cwspd";
+    const char* csv_path = "test_speed.csv";
+    CHECK(speed_mode_write_binary(&state, binary_path));
+    CHECK(speed_mode_write_csv(&state, csv_path));
+    FILE* file = fopen(binary_path, "rb");
+    SpeedResultsHeader header;
+    SpeedSplit splits[2];
+    CHECK(file != NULL && fread(&header, sizeof(header), 1, file) == 1 && fread(splits, sizeof(splits), 1, file) == 1);
+    fclose(file);
+    CHECK_EQ_INT(header.magic, SPEED_RESULTS_MAGIC);
+    CHECK_EQ_INT(header.split_count, 2);
+    CHECK_EQ_INT(header.levels_solved, 1);
+    CHECK_EQ_INT((int)header.run_us, 5000000);
+    CHECK_EQ_INT(splits[0].guess_us, 3250000);
+
+    char line[128];
+    file = fopen(csv_path, "r");
+    CHECK(file != NULL && fgets(line, sizeof(line), file) && fgets(line, sizeof(line), file));
+    CHECK(strcmp(line, "1,1,3250.000,3250.000,0\n") == 0);
+    fclose(file);
+    remove(binary_path);
+    remove(csv_path);
+}
+
+// Constraints built from the game's own scorer, which marks every copy of a
+// target letter, so repeated yellows must not demand repeated letters
+static void guess_constraints_track_repeated_and_absent_letters(void) {
+    const WordKernels* kernels = get_word_kernels(5);
+    GuessConstraints constraints;
+    guess_constraints_reset(&constraints);
+    LetterState states[5];
+    kernels->score_guess("ERROR", "CRANE", states);
+    guess_constraints_update(&constraints, "ERROR", states, 5);
+
+    CHECK_EQ_INT(constraints.min_count['R' - 'A'], 1);
+    CHECK_EQ_INT(constraints.min_count['O' - 'A'], 0);
+    CHECK_EQ_INT(constraints.required_mask, (1u << ('E' - 'A')) | (1u << ('R' - 'A')));
+    CHECK_EQ_INT(constraints.fixed[1], 'R' - 'A' + 1);
+    CHECK_EQ_INT(guess_constraints_check(&constraints, "CRANE", 5).kind, GUESS_VIOLATION_NONE);
+    // The grey O may be guessed again
+    CHECK_EQ_INT(guess_constraints_check(&constraints, "CRONE", 5).kind, GUESS_VIOLATION_NONE);
+
+    // Two greens do prove two copies
+    guess_constraints_reset(&constraints);
+    kernels->score_guess("BABES", "BOBBY", states);
+    guess_constraints_update(&constraints, "BABES", states, 5);
+    CHECK_EQ_INT(constraints.min_count['B' - 'A'], 2);
+    CHECK_EQ_INT(guess_constraints_check(&constraints, "BOBBY", 5).kind, GUESS_VIOLATION_NONE);
+    GuessViolation violation = guess_constraints_check(&constraints, "BOSSY", 5);
+    CHECK_EQ_INT(violation.kind, GUESS_VIOLATION_FIXED);
+    CHECK_EQ_INT(violation.position, 2);
+}
+
+static void hard_mode_accepts_the_target_after_repeated_letters(void) {
+    GameState state = test_start_wordle("CRANE");
+    state.settings.hard_mode = 1;
+    state = test_type(state, "ERROR");                    // R green once, yellow twice
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.history.level_guess_count, 1);
+    state = test_type(state, "CRANE");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.input.hard_mode_violation.kind, GUESS_VIOLATION_NONE);
+    CHECK_EQ_INT(state.history.level_guess_count, 2);
+    CHECK(state.core.level_complete);
+}
+
+static void check_session_round_trip(const GameState* state) {
+    SessionState packed;
+    SessionState repacked;
+    CHECK(session_state_pack(state, &packed));
+    GameState unpacked = session_state_unpack(&packed);
+    CHECK(session_state_pack(&unpacked, &repacked));
+    CHECK(memcmp(&packed, &repacked, sizeof(packed)) == 0);
+
+    CHECK(strcmp(unpacked.core.target_word, state->core.target_word) == 0);
+    CHECK_EQ_INT(unpacked.core.play_state, state->core.play_state);
+    CHECK_EQ_INT(unpacked.current_view, state->current_view);
+    CHECK_EQ_INT(unpacked.history.level_guess_count, state->history.level_guess_count);
+    for (int g = 0; g < state->history.level_guess_count; g++) {
+        CHECK(strcmp(unpacked.history.level_guesses[g], state->history.level_guesses[g]) == 0);
+        CHECK(memcmp(unpacked.history.level_letter_states[g], state->history.level_letter_states[g],
+                     (size_t)state->core.word_length * sizeof(LetterState)) == 0);
+    }
+    if (state->core.play_state != GAME_STATE_SHOWING_RESULT) {
+        CHECK(strcmp(unpacked.input.current_word, state->input.current_word) == 0);
+    }
+    CHECK(memcmp(unpacked.stats.tokens.balance, state->stats.tokens.balance, sizeof(state->stats.tokens.balance)) == 0);
+    CHECK(memcmp(unpacked.crossword.grid, state->crossword.grid, sizeof(state->crossword.grid)) == 0);
+    CHECK(memcmp(unpacked.crossword.letter_states, state->crossword.letter_states, sizeof(state->crossword.letter_states)) == 0);
+    CHECK(memcmp(unpacked.crossword.token_need, state->crossword.token_need, sizeof(state->crossword.token_need)) == 0);
+}
+
+// Property: packing is lossless for play state at any point of random play
+static void property_session_state_round_trips(void) {
+    static const int KEYS[] = {GAME_KEY_ENTER, GAME_KEY_BACKSPACE, GAME_KEY_SPACE, GAME_KEY_TAB};
+    test_random_seed(0x5E55035u);
+    for (int game = 0; game < 8; game++) {
+        GameState state = test_start_crossword(3);
+        state.settings.animations_enabled = game & 1;
+        for (int step = 0; step < 600; step++) {
+            uint32_t roll = test_random();
+            if (roll % 16 == 0) {
+                state = test_type(state, state.core.target_word);
+            } else if (roll % 4 == 0) {
+                state = test_press(state, KEYS[(roll >> 4) % 4]);
+            } else if (roll % 4 == 1) {
+                state = test_tick(state);
+            } else {
+                state = test_press(state, GAME_KEY_A + (int)((roll >> 4) % 26));
+            }
+            if (step % 7 == 0) {
+                check_session_round_trip(&state);
+            }
+        }
+    }
+}
+
+// Headless play on the packed state matches the game for the same guesses
+static void session_state_guess_matches_game(void) {
+    static const char* GUESSES[] = {"SLATE", "CRONY", "CRANE"};
+    GameState state = test_start_wordle("CRANE");
+    SessionState session;
+    session_state_init(&session, 5, "CRANE");
+    for (int i = 0; i < 3; i++) {
+        state = test_type(state, GUESSES[i]);
+        state = test_press(state, GAME_KEY_ENTER);
+        LetterState states[MAX_WORD_LENGTH];
+        CHECK_EQ_INT(session_state_guess(&session, GUESSES[i], states, 0), i == 2);
+        CHECK(memcmp(states, state.history.current_guess_states, sizeof(LetterState) * 5) == 0);
+    }
+    CHECK_EQ_INT(session_state_guess(&session, "CRANE", (LetterState[MAX_WORD_LENGTH]){0}, 0), -1);
+
+    // Same state apart from the settings the test changed and the awarded letter
+    SessionState packed;
+    state.settings.animations_enabled = 1;
+    CHECK(session_state_pack(&state, &packed));
+    memset(packed.tokens, 0, sizeof(packed.tokens));
+    memset(session.tokens, 0, sizeof(session.tokens));
+    CHECK(memcmp(&packed, &session, sizeof(packed)) == 0);
+
+    CHECK(session_state_next_level(&session, "EAGLE"));
+    CHECK_EQ_INT(session.level, 2);
+    CHECK_EQ_INT(session_state_play_state(&session), GAME_STATE_INPUT);
+}
+
+// Writes a two-word database, applies `damage` to its bytes and opens it
+static int open_damaged_database(void (*damage)(uint8_t* bytes, WordDbHeader* header)) {
+    const char* path = "test_damaged.cwdb";
+    uint64_t words[2] = {word_db_pack_word("CRANE", 5), word_db_pack_word("SLATE", 5)};
+    CHECK(word_db_write(path, 5, words, NULL, NULL, 2));
+    static uint8_t bytes[4096];
+    FILE* file = fopen(path, "rb");
+    size_t size = file ? fread(bytes, 1, sizeof(bytes), file) : 0;
+    if (file) {
+        fclose(file);
+    }
+    WordDbHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    damage(bytes, &header);
+    memcpy(bytes, &header, sizeof(header));
+    file = fopen(path, "wb");
+    if (file) {
+        fwrite(bytes, 1, size, file);
+        fclose(file);
+    }
+    WordDatabase database;
+    int opened = word_db_open(path, &database);
+    word_db_close(&database);
+    remove(path);
+    return opened;
+}
+
+static void damage_nothing(uint8_t* bytes, WordDbHeader* header) {
+    (void)bytes;
+    (void)header;
+}
+
+static void damage_wrapping_offset(uint8_t* bytes, WordDbHeader* header) {
+    (void)bytes;
+    header->words_offset = UINT64_MAX - 7;
+}
+
+static void damage_oversized_count(uint8_t* bytes, WordDbHeader* header) {
+    (void)bytes;
+    header->word_count = UINT32_MAX;
+    header->frequency_offset = 2;
+}
+
+static void damage_letters_unchecked(uint8_t* bytes, WordDbHeader* header) {
+    (void)bytes;
+    header->flags &= ~WORD_DB_FLAG_LETTERS_CHECKED;
+}
+
+static void damage_letter_zero(uint8_t* bytes, WordDbHeader* header) {
+    uint64_t* first = (uint64_t*)(bytes + header->words_offset);
+    *first &= ~(uint64_t)31;
+}
+
+static void damage_letter_27(uint8_t* bytes, WordDbHeader* header) {
+    uint64_t* first = (uint64_t*)(bytes + header->words_offset);
+    *first |= 27;
+}
+
+static void word_databases_reject_crafted_files(void) {
+    CHECK(open_damaged_database(damage_nothing));
+    CHECK(!open_damaged_database(damage_wrapping_offset));
+    CHECK(!open_damaged_database(damage_oversized_count));
+    CHECK(!open_damaged_database(damage_letters_unchecked));
+
+    // The writer refuses bad letters; opening does not rescan the words, so a
+    // file edited afterwards still opens, and its letters decode inside A-Z
+    uint64_t bad[1] = {word_db_pack_word("CRANE", 5) & ~(uint64_t)31};
+    CHECK(!word_db_write("test_bad_letters.cwdb", 5, bad, NULL, NULL, 1));
+    CHECK(open_damaged_database(damage_letter_zero));
+    CHECK(open_damaged_database(damage_letter_27));
+    char word[MAX_WORD_LENGTH + 1];
+    get_word_kernels(5)->unpack(bad[0], word);
+    CHECK(strcmp(word, "CRANA") == 0);
+    get_word_kernels(5)->unpack(bad[0] | 27, word);
+    CHECK(strcmp(word, "CRANA") == 0);
+}
+
+static const TestCase LOGIC_TESTS[] = {
+    {"letter_state_marks_exact_present_and_absent", letter_state_marks_exact_present_and_absent},
+    {"kernels_score_like_calculate_letter_state", kernels_score_like_calculate_letter_state},
+    {"kernels_pack_round_trip_in_alphabetical_order", kernels_pack_round_trip_in_alphabetical_order},
+    {"feedback_codes_are_distinct_per_pattern", feedback_codes_are_distinct_per_pattern},
+    {"typing_and_backspace_edit_the_guess", typing_and_backspace_edit_the_guess},
+    {"wrong_guess_records_history_without_award", wrong_guess_records_history_without_award},
+    {"solving_awards_one_target_letter_and_advances", solving_awards_one_target_letter_and_advances},
+    {"word_selection_follows_difficulty_tiers", word_selection_follows_difficulty_tiers},
+    {"word_draws_never_repeat_within_the_window", word_draws_never_repeat_within_the_window},
+    {"property_feedback_consistent_with_target", property_feedback_consistent_with_target},
+    {"hard_mode_refuses_guesses_that_drop_revealed_letters", hard_mode_refuses_guesses_that_drop_revealed_letters},
+    {"keyboard_table_changes_only_when_guesses_complete", keyboard_table_changes_only_when_guesses_complete},
+    {"clicking_the_on_screen_keyboard_types_keys", clicking_the_on_screen_keyboard_types_keys},
+    {"keys_pressed_in_one_frame_are_all_applied", keys_pressed_in_one_frame_are_all_applied},
+    {"binding_files_remap_keys_to_actions", binding_files_remap_keys_to_actions},
+    {"latency_marks_follow_actions_to_the_presented_frame", latency_marks_follow_actions_to_the_presented_frame},
+    {"a_full_frame_of_events_keeps_every_mark", a_full_frame_of_events_keeps_every_mark},
+    {"speed_mode_times_guesses_from_key_timestamps", speed_mode_times_guesses_from_key_timestamps},
+    {"word_databases_reject_crafted_files", word_databases_reject_crafted_files},
+    {"guess_constraints_track_repeated_and_absent_letters", guess_constraints_track_repeated_and_absent_letters},
+    {"hard_mode_accepts_the_target_after_repeated_letters", hard_mode_accepts_the_target_after_repeated_letters},
+    {"property_session_state_round_trips", property_session_state_round_trips},
+    {"session_state_guess_matches_game", session_state_guess_matches_game},
+};
+
+TEST_GROUP(logic, LOGIC_TESTS);
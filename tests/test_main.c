@@ -0,0 +1,79 @@
+#include "test_framework.h"
+#include "test_support.h"
+
+#include <string.h>
+
+// Usage: crosswordle_tests [group]
+// With no argument every group runs; CTest registers one test per group.
+
+int test_failures = 0;
+
+extern const TestGroup logic_test_group;
+extern const TestGroup crossword_test_group;
+extern const TestGroup tokens_test_group;
+extern const TestGroup formatting_test_group;
+extern const TestGroup server_test_group;
+extern const TestGroup daily_test_group;
+extern const TestGroup leaderboard_test_group;
+extern const TestGroup stats_test_group;
+extern const TestGroup profiles_test_group;
+extern const TestGroup snapshot_test_group;
+extern const TestGroup jobs_test_group;
+extern const TestGroup clues_test_group;
+extern const TestGroup puzzle_pack_test_group;
+extern const TestGroup categories_test_group;
+extern const TestGroup solver_test_group;
+
+static const TestGroup* const TEST_GROUPS[] = {
+    &logic_test_group,
+    &crossword_test_group,
+    &tokens_test_group,
+    &formatting_test_group,
+    &server_test_group,
+    &daily_test_group,
+    &leaderboard_test_group,
+    &stats_test_group,
+    &profiles_test_group,
+    &snapshot_test_group,
+    &jobs_test_group,
+    &clues_test_group,
+    &puzzle_pack_test_group,
+    &categories_test_group,
+    &solver_test_group,
+};
+
+#define TEST_GROUP_COUNT (int)(sizeof(TEST_GROUPS) / sizeof(TEST_GROUPS[0]))
+
+static int run_group(const TestGroup* group) {
+    int failed_cases = 0;
+    for (int i = 0; i < group->count; i++) {
+        int failures_before = test_failures;
+        group->cases[i].run();
+        if (test_failures != failures_before) {
+            fprintf(stderr, "FAIL %s.%s\n", group->name, group->cases[i].name);
+            failed_cases++;
+        }
+    }
+    printf("%s: %d/%d passed\n", group->name, group->count - failed_cases, group->count);
+    return failed_cases;
+}
+
+int main(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : NULL;
+    int ran = 0;
+    int failed_cases = 0;
+    
+    for (int g = 0; g < TEST_GROUP_COUNT; g++) {
+        if (only && strcmp(only, TEST_GROUPS[g]->name) != 0) {
+            continue;
+        }
+        failed_cases += run_group(TEST_GROUPS[g]);
+        ran++;
+    }
+    
+    if (ran == 0) {
+        fprintf(stderr, "unknown test group '%s'\n", only);
+        return 2;
+    }
+    return failed_cases == 0 ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "profile.h"
+
+// Player profiles: home screen requests, the LRU cache and write-back
+
+#define TEST_PROFILE_DIR "test_profiles"
+
+static void remove_profile_files(int count) {
+    char path[300];
+    for (int i = 0; i < count; i++) {
+        snprintf(path, sizeof(path), TEST_PROFILE_DIR "/profile_%d.cwpf", i);
+        remove(path);
+    }
+    remove(TEST_PROFILE_DIR "/profiles.txt");
+    remove(TEST_PROFILE_DIR);
+}
+
+static void home_screen_keys_request_profile_changes(void) {
+    GameState state = create_game_state("");
+    state = test_press(state, GAME_KEY_UP);
+    CHECK_EQ_INT(state.system.profile_step, -1);
+    state = test_press(state, GAME_KEY_DOWN);
+    CHECK_EQ_INT(state.system.profile_step, 1);
+    state = test_press(state, GAME_KEY_A + ('N' - 'A'));
+    CHECK(state.system.profile_create);
+    state = test_tick(state);
+    CHECK_EQ_INT(state.system.profile_step, 0);
+    CHECK(!state.system.profile_create);
+}
+
+static void recent_profiles_switch_without_disk_loads(void) {
+    enum { PROFILES = PROFILE_CACHE_SLOTS + 4 };
+    remove_profile_files(PROFILES);
+    CHECK_EQ_INT(profile_store_open(TEST_PROFILE_DIR), 1);
+    GameState state = create_game_state("");
+    CHECK(profile_load(&state, 0));
+    CHECK(strcmp(state.system.profile_name, "Player 1") == 0);
+
+    // N on the home screen adds "Player 2", ... and switches to it; each
+    // profile gets a different token balance and hard mode setting
+    for (int i = 1; i < PROFILES; i++) {
+        state.system.profile_create = 1;
+        CHECK(profile_apply_requests(&state));
+        state.system.profile_create = 0;
+        CHECK_EQ_INT(state.system.profile_index, i);
+        state.stats.tokens.total_earned = 100 + i;
+        state.settings.hard_mode = i % 2;
+    }
+    CHECK_EQ_INT(profile_store_count(), PROFILES);
+    CHECK(strcmp(state.system.profile_name, "Player 12") == 0);
+
+    // Stepping back through the most recent profiles hits the cache
+    uint32_t loads = profile_store_disk_loads();
+    for (int i = PROFILES - 2; i >= PROFILES - PROFILE_CACHE_SLOTS; i--) {
+        state.system.profile_step = -1;
+        CHECK(profile_apply_requests(&state));
+        CHECK_EQ_INT(state.system.profile_index, i);
+        CHECK_EQ_INT(state.stats.tokens.total_earned, 100 + i);
+    }
+    CHECK_EQ_INT((int)profile_store_disk_loads(), (int)loads);
+
+    // The early profiles were evicted, written back and come in from disk
+    CHECK(profile_switch(&state, 1));
+    CHECK_EQ_INT((int)profile_store_disk_loads(), (int)loads + 1);
+    CHECK_EQ_INT(state.stats.tokens.total_earned, 101);
+    CHECK_EQ_INT(state.settings.hard_mode, 1);
+
+    // Stepping wraps around both ends
+    state.system.profile_step = -2;
+    CHECK(profile_apply_requests(&state));
+    CHECK_EQ_INT(state.system.profile_index, PROFILES - 1);
+    profile_store_close();
+
+    // Reopening keeps the names and the saved data
+    CHECK_EQ_INT(profile_store_open(TEST_PROFILE_DIR), PROFILES);
+    CHECK_EQ_INT(profile_store_find("Player 6"), 5);
+    const ProfileData* data = profile_store_get(5);
+    CHECK(data != NULL);
+    CHECK_EQ_INT(data->stats.tokens.total_earned, 105);
+    CHECK_EQ_INT(data->settings.hard_mode, 1);
+    profile_store_close();
+    remove_profile_files(PROFILES);
+}
+
+static const TestCase PROFILES_TESTS[] = {
+    {"home_screen_keys_request_profile_changes", home_screen_keys_request_profile_changes},
+    {"recent_profiles_switch_without_disk_loads", recent_profiles_switch_without_disk_loads},
+};
+
+TEST_GROUP(profiles, PROFILES_TESTS);
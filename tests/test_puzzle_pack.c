@@ -0,0 +1,208 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "puzzle_pack.h"
+
+// Puzzle packs: the .cwpk writer and per-puzzle decoding, damaged records,
+// random grids round-tripping, and pack levels replacing the built-in ones
+
+#define TEST_PACK_PATH "test_puzzles.cwpk"
+#define TEST_RANDOM_PUZZLES 500
+
+static int same_level(const CrosswordLevel* a, const CrosswordLevel* b) {
+    if (a->word_count != b->word_count ||
+        memcmp(a->word_mask, b->word_mask, sizeof(a->word_mask)) != 0) {
+        return 0;
+    }
+    for (int x = 0; x < 9; x++) {
+        for (int y = 0; y < 9; y++) {
+            if (a->word_mask[x][y] && a->solution[x][y] != b->solution[x][y]) {
+                return 0;
+            }
+        }
+    }
+    return memcmp(a->words, b->words, sizeof(CrosswordWord) * (size_t)a->word_count) == 0;
+}
+
+static void packs_round_trip_levels_and_clues(void) {
+    PuzzleSource puzzles[3] = {{get_crossword_level(1), {"Blade with a hilt", NULL, ""}}};
+    puzzles[1].level = get_daily_crossword_level(100);
+    puzzles[1].clues[3] = "Last word";
+    puzzles[2].level = get_daily_crossword_level(101);
+    CHECK(puzzle_pack_write(TEST_PACK_PATH, puzzles, 3));
+    CHECK(load_puzzle_pack(TEST_PACK_PATH));
+    CHECK_EQ_INT(puzzle_pack_count(), 3);
+
+    for (int i = 0; i < 3; i++) {
+        CrosswordLevel level;
+        CHECK(puzzle_pack_level(i, &level));
+        CHECK(same_level(&level, &puzzles[i].level));
+        CHECK_EQ_INT(level.level, i + 1);
+        CHECK_EQ_INT(level.day, 0);
+    }
+    CHECK(strcmp(puzzle_pack_clue(0, 0), "Blade with a hilt") == 0);
+    CHECK(puzzle_pack_clue(0, 1) == NULL);
+    CHECK(puzzle_pack_clue(0, 2) == NULL);
+    CHECK(strcmp(puzzle_pack_clue(1, 3), "Last word") == 0);
+    CHECK(puzzle_pack_clue(1, 4) == NULL);
+    CHECK(puzzle_pack_clue(3, 0) == NULL);
+
+    CrosswordLevel untouched = {0};
+    CHECK(!puzzle_pack_level(3, &untouched));
+    CHECK(!puzzle_pack_level(-1, &untouched));
+    CHECK_EQ_INT(untouched.word_count, 0);
+    unload_puzzle_pack();
+    CHECK_EQ_INT(puzzle_pack_count(), 0);
+
+    // A word off its mask cannot be written
+    puzzles[0].level.words[0].start_y = 1;
+    CHECK(!puzzle_pack_write(TEST_PACK_PATH "2", puzzles, 3));
+    remove(TEST_PACK_PATH "2");
+    remove(TEST_PACK_PATH);
+}
+
+static long file_size(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return -1;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+// Overwrites one byte of the file
+static void poke(const char* path, long offset, int value) {
+    FILE* file = fopen(path, "r+b");
+    CHECK(file != NULL);
+    if (file) {
+        fseek(file, offset, SEEK_SET);
+        fputc(value, file);
+        fclose(file);
+    }
+}
+
+static void damaged_records_fail_alone(void) {
+    PuzzleSource puzzles[2] = {{get_crossword_level(1), {0}}, {get_daily_crossword_level(7), {0}}};
+    CHECK(puzzle_pack_write(TEST_PACK_PATH, puzzles, 2));
+
+    // Record 0's width byte set past the 9x9 grid
+    FILE* file = fopen(TEST_PACK_PATH, "rb");
+    PuzzlePackHeader written = {0};
+    CHECK(file && fread(&written, sizeof(written), 1, file) == 1);
+    if (file) {
+        fclose(file);
+    }
+    poke(TEST_PACK_PATH, (long)written.records_offset, 12);
+    CHECK(load_puzzle_pack(TEST_PACK_PATH));
+    CrosswordLevel level;
+    CHECK(!puzzle_pack_level(0, &level));
+    CHECK(puzzle_pack_level(1, &level));
+    CHECK(same_level(&level, &puzzles[1].level));
+    unload_puzzle_pack();
+
+    // A file whose size disagrees with its header is refused outright
+    long size = file_size(TEST_PACK_PATH);
+    poke(TEST_PACK_PATH, size, 0);
+    CHECK(!load_puzzle_pack(TEST_PACK_PATH));
+    CHECK_EQ_INT(puzzle_pack_count(), 0);
+
+    // So is one whose section offsets wrap past the end of the file
+    CHECK(puzzle_pack_write(TEST_PACK_PATH, puzzles, 2));
+    for (int damage = 0; damage < 2; damage++) {
+        PuzzlePackHeader crafted = written;
+        if (damage == 0) {
+            crafted.offsets_offset = UINT64_MAX - 7;
+        } else {
+            crafted.strings_offset = UINT64_MAX - crafted.strings_size + 2;
+        }
+        file = fopen(TEST_PACK_PATH, "r+b");
+        CHECK(file != NULL);
+        if (file) {
+            fwrite(&crafted, sizeof(crafted), 1, file);
+            fclose(file);
+        }
+        CHECK(!load_puzzle_pack(TEST_PACK_PATH));
+    }
+    remove(TEST_PACK_PATH);
+}
+
+// Random 9x9 levels: words of random length, place and direction, taking the
+// letters already placed where they cross
+static CrosswordLevel random_level(void) {
+    CrosswordLevel level = {0};
+    int attempts = 1 + (int)(test_random() % 20);
+    for (int a = 0; a < attempts && level.word_count < PUZZLE_PACK_MAX_WORDS; a++) {
+        CrosswordWord word;
+        word.length = MIN_WORD_LENGTH + (int)(test_random() % (MAX_WORD_LENGTH - MIN_WORD_LENGTH + 1));
+        word.direction = (int)(test_random() % 2);
+        int along = (int)(test_random() % (unsigned)(9 - word.length + 1));
+        int across = (int)(test_random() % 9);
+        word.start_x = word.direction == 0 ? along : across;
+        word.start_y = word.direction == 0 ? across : along;
+        for (int i = 0; i < word.length; i++) {
+            int x = word.start_x + (word.direction == 0 ? i : 0);
+            int y = word.start_y + (word.direction == 0 ? 0 : i);
+            if (!level.word_mask[x][y]) {
+                level.solution[x][y] = (char)('A' + test_random() % 26);
+                level.word_mask[x][y] = 1;
+            }
+        }
+        level.words[level.word_count++] = word;
+    }
+    return level;
+}
+
+// Property: any level the writer accepts decodes to itself
+static void property_random_levels_round_trip(void) {
+    static PuzzleSource puzzles[TEST_RANDOM_PUZZLES];
+    test_random_seed(49);
+    for (int i = 0; i < TEST_RANDOM_PUZZLES; i++) {
+        puzzles[i].level = random_level();
+    }
+    CHECK(puzzle_pack_write(TEST_PACK_PATH, puzzles, TEST_RANDOM_PUZZLES));
+    CHECK(load_puzzle_pack(TEST_PACK_PATH));
+    CHECK_EQ_INT(puzzle_pack_count(), TEST_RANDOM_PUZZLES);
+    for (int n = 0; n < TEST_RANDOM_PUZZLES; n++) {
+        int i = (int)(test_random() % TEST_RANDOM_PUZZLES);
+        CrosswordLevel level;
+        CHECK(puzzle_pack_level(i, &level));
+        CHECK(same_level(&level, &puzzles[i].level));
+    }
+    unload_puzzle_pack();
+    remove(TEST_PACK_PATH);
+}
+
+static void pack_levels_replace_built_in_and_advance(void) {
+    PuzzleSource puzzles[2] = {{get_crossword_level(1), {0}}, {get_daily_crossword_level(3), {0}}};
+    CHECK(puzzle_pack_write(TEST_PACK_PATH, puzzles, 2));
+    CHECK(load_puzzle_pack(TEST_PACK_PATH));
+
+    GameState state = test_start_crossword(3);
+    CHECK(same_level(&state.crossword.current_level, &puzzles[0].level));
+    state = test_type(state, "SWORD");
+    state = test_press(state, GAME_KEY_ENTER);
+    state = test_type(state, "TARK");
+    state = test_press(state, GAME_KEY_ENTER);
+    state = test_type(state, "COSS");
+    state = test_press(state, GAME_KEY_ENTER);
+    CHECK_EQ_INT(state.current_view, VIEW_CROSSWORD_COMPLETE);
+
+    // The next puzzle follows; past the pack's end are the built-in levels
+    state = test_press(state, GAME_KEY_SPACE);
+    CHECK_EQ_INT(state.crossword.current_level.level, 2);
+    CHECK(same_level(&state.crossword.current_level, &puzzles[1].level));
+    CHECK_EQ_INT(get_crossword_level(3).word_count, 0);
+
+    unload_puzzle_pack();
+    remove(TEST_PACK_PATH);
+}
+
+static const TestCase PUZZLE_PACK_TESTS[] = {
+    {"packs_round_trip_levels_and_clues", packs_round_trip_levels_and_clues},
+    {"damaged_records_fail_alone", damaged_records_fail_alone},
+    {"property_random_levels_round_trip", property_random_levels_round_trip},
+    {"pack_levels_replace_built_in_and_advance", pack_levels_replace_built_in_and_advance},
+};
+
+TEST_GROUP(puzzle_pack, PUZZLE_PACK_TESTS);
@@ -0,0 +1,111 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "server.h"
+
+// Server protocol parsing and per-shard session handling (no threads)
+
+static ServerResponse request(SessionTable* table, const char* line) {
+    ServerRequest parsed = server_parse_request(line, (int)strlen(line));
+    ServerResponse response = {0};
+    session_handle_request(table, &parsed, &response);
+    response.text[response.length] = '\0';
+    return response;
+}
+
+static void parses_requests_and_rejects_bad_input(void) {
+    ServerRequest parsed = server_parse_request("GUESS 42 crane", 14);
+    CHECK_EQ_INT(parsed.op, SERVER_OP_GUESS);
+    CHECK_EQ_INT(parsed.error, SERVER_ERROR_NONE);
+    CHECK_EQ_INT(parsed.session, 42);
+    CHECK(strcmp(parsed.word, "CRANE") == 0);
+
+    parsed = server_parse_request("NEW 7 6", 7);
+    CHECK_EQ_INT(parsed.op, SERVER_OP_NEW);
+    CHECK_EQ_INT(parsed.word_length, 6);
+
+    CHECK_EQ_INT(server_parse_request("NEW 7 9", 7).error, SERVER_ERROR_BAD_LENGTH);
+    CHECK_EQ_INT(server_parse_request("GUESS 1 CR4NE", 13).error, SERVER_ERROR_BAD_WORD);
+    CHECK_EQ_INT(server_parse_request("GUESS x CRANE", 13).op, SERVER_OP_INVALID);
+    CHECK_EQ_INT(server_parse_request("HELLO 1", 7).op, SERVER_OP_INVALID);
+}
+
+static void guess_reports_feedback_code_and_pattern(void) {
+    SessionTable table;
+    session_table_init(&table, 1);
+    CHECK(strcmp(request(&table, "NEW 5").text, "OK 5 NEW 5 1\n") == 0);
+
+    ServerSession* session = session_table_find(&table, 5);
+    CHECK(session != NULL);
+    session_state_init(&session->state, 5, "EAGLE");
+
+    // CRANE vs EAGLE: C absent, R absent, A present, N absent, E correct
+    LetterState states[5] = {LETTER_NOT_IN_WORD, LETTER_NOT_IN_WORD, LETTER_WRONG_POS, LETTER_NOT_IN_WORD, LETTER_CORRECT};
+    char expected[SERVER_RESPONSE_TEXT_SIZE];
+    int length = server_append(expected, 0, "FB 5 ");
+    length += format_int(&expected[length], feedback_code(states, 5));
+    server_append(expected, length, " ..Y.G 1 0\n");
+    CHECK(strcmp(request(&table, "GUESS 5 CRANE").text, expected) == 0);
+
+    CHECK(strcmp(request(&table, "NEXT 5").text, "ERR 5 NOT_SOLVED\n") == 0);
+    CHECK(strcmp(request(&table, "GUESS 5 EAGLE").text, "FB 5 0 GGGGG 2 1\n") == 0);
+    CHECK(strcmp(request(&table, "GUESS 5 EAGLE").text, "ERR 5 SOLVED\n") == 0);
+    CHECK_EQ_INT(session->state.levels_completed, 1);
+
+    // Solving awards exactly one letter of the target
+    int tokens = 0;
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        tokens += session->state.tokens[i];
+    }
+    CHECK_EQ_INT(tokens, 1);
+
+    CHECK(strcmp(request(&table, "NEXT 5").text, "OK 5 LEVEL 2\n") == 0);
+    CHECK(strcmp(request(&table, "GUESS 5 CRANES").text, "ERR 5 BAD_WORD\n") == 0);
+    CHECK(strcmp(request(&table, "END 5").text, "OK 5 END\n") == 0);
+    CHECK(strcmp(request(&table, "GUESS 5 CRANE").text, "ERR 5 UNKNOWN_SESSION\n") == 0);
+    session_table_free(&table);
+}
+
+// Random inserts and removals keep the table consistent with a reference set
+static void property_session_table_matches_reference(void) {
+    enum { ID_RANGE = 2048 };
+    static uint8_t present[ID_RANGE];
+    memset(present, 0, sizeof(present));
+    SessionTable table;
+    session_table_init(&table, 7);
+    test_random_seed(0x5E55u);
+
+    for (int step = 0; step < 20000; step++) {
+        uint64_t id = test_random() % ID_RANGE;
+        char line[48];
+        int length = server_append(line, 0, (test_random() & 3) ? "NEW " : "END ");
+        server_format_u64(&line[length], id);
+        ServerResponse response = request(&table, line);
+        if (line[0] == 'N') {
+            CHECK((response.text[0] == 'O') == !present[id]);
+            present[id] = 1;
+        } else {
+            CHECK((response.text[0] == 'O') == present[id]);
+            present[id] = 0;
+        }
+    }
+
+    int expected_count = 0;
+    for (int id = 0; id < ID_RANGE; id++) {
+        expected_count += present[id];
+        ServerSession* session = session_table_find(&table, (uint64_t)id);
+        CHECK((session != NULL) == present[id]);
+        if (session) {
+            CHECK_EQ_INT(session->id, id);
+        }
+    }
+    CHECK_EQ_INT(table.count, expected_count);
+    session_table_free(&table);
+}
+
+static const TestCase SERVER_TESTS[] = {
+    {"parses_requests_and_rejects_bad_input", parses_requests_and_rejects_bad_input},
+    {"guess_reports_feedback_code_and_pattern", guess_reports_feedback_code_and_pattern},
+    {"property_session_table_matches_reference", property_session_table_matches_reference},
+};
+
+TEST_GROUP(server, SERVER_TESTS);
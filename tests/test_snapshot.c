@@ -0,0 +1,133 @@
+#include <pthread.h>
+#include <sched.h>
+#include "test_framework.h"
+#include "test_support.h"
+#include "render_snapshot.h"
+
+// Render snapshots: handover order, latency marks of skipped snapshots, and
+// untorn snapshots while a producer thread publishes flat out
+
+static RenderSnapshotBuffer snapshot_buffer;
+
+static GameState state_with_mark(int level, double mark_time) {
+    GameState state = create_game_state("");
+    state.core.current_level = level;
+    state.system.latency_mark_count = 1;
+    state.system.latency_marks[0].time = mark_time;
+    state.system.latency_marks[0].action = GAME_ACTION_LETTER;
+    return state;
+}
+
+static void newest_snapshot_carries_skipped_marks(void) {
+    GameState initial = create_game_state("");
+    render_snapshot_init(&snapshot_buffer, &initial);
+    const RenderSnapshot* snapshot = render_snapshot_acquire(&snapshot_buffer);
+    CHECK(snapshot->sequence == 0);
+
+    GameState state = state_with_mark(1, 1.0);
+    CHECK(render_snapshot_publish(&snapshot_buffer, &state) == 1);
+    snapshot = render_snapshot_acquire(&snapshot_buffer);
+    CHECK(snapshot->sequence == 1);
+    CHECK_EQ_INT(snapshot->state.core.current_level, 1);
+    CHECK_EQ_INT(snapshot->mark_count, 1);
+
+    // Nothing new: the same snapshot again
+    CHECK(render_snapshot_acquire(&snapshot_buffer) == snapshot);
+
+    // Three ticks before the next frame: it shows the last and all three marks
+    for (int level = 2; level <= 4; level++) {
+        state = state_with_mark(level, (double)level);
+        render_snapshot_publish(&snapshot_buffer, &state);
+    }
+    CHECK(render_snapshot_wait(&snapshot_buffer, 4, 0.0));
+    CHECK(!render_snapshot_wait(&snapshot_buffer, 5, 0.0));
+    uint64_t presented = snapshot->sequence;
+    snapshot = render_snapshot_acquire(&snapshot_buffer);
+    CHECK(snapshot->sequence == 4);
+    CHECK_EQ_INT(snapshot->state.core.current_level, 4);
+    CHECK_EQ_INT(snapshot->mark_count, 3);
+    for (int i = 0; i < 3; i++) {
+        CHECK(snapshot->marks[i].time == 2.0 + i);
+        CHECK(snapshot->mark_sequence[i] == (uint64_t)(2 + i));
+    }
+    static LatencyHistograms latency;
+    memset(&latency, 0, sizeof(latency));
+    render_snapshot_close_marks(snapshot, presented, &latency, 10.0);
+    CHECK_EQ_INT((int)latency.count[GAME_ACTION_LETTER], 3);
+
+    // Marks of a snapshot the renderer took are not carried again
+    state = state_with_mark(5, 5.0);
+    render_snapshot_publish(&snapshot_buffer, &state);
+    snapshot = render_snapshot_acquire(&snapshot_buffer);
+    CHECK_EQ_INT(snapshot->mark_count, 1);
+}
+
+enum { STRESS_TICKS = 20000 };
+
+static void* publish_ticks(void* arg) {
+    (void)arg;
+    GameState state = create_game_state("");
+    for (int tick = 1; tick <= STRESS_TICKS; tick++) {
+        // Stay within half the pending-mark capacity of the renderer
+        while (tick - atomic_load(&snapshot_buffer.acquired_sequence) > RENDER_SNAPSHOT_MAX_MARKS / 2) {
+            sched_yield();
+        }
+        // Fields far apart in the struct, so a torn copy shows up
+        state.core.current_level = tick;
+        state.stats.levels_completed = tick;
+        state.system.today = tick;
+        state.system.latency_mark_count = 1;
+        state.system.latency_marks[0].time = (double)tick;
+        render_snapshot_publish(&snapshot_buffer, &state);
+    }
+    return NULL;
+}
+
+// Property: every acquired snapshot is one whole published state, sequences
+// never go backwards, and each tick's mark is closed exactly once, in order
+static void property_concurrent_snapshots_are_whole_and_ordered(void) {
+    GameState initial = create_game_state("");
+    render_snapshot_init(&snapshot_buffer, &initial);
+    pthread_t producer;
+    CHECK(pthread_create(&producer, NULL, publish_ticks, NULL) == 0);
+
+    uint64_t last_sequence = 0;
+    uint64_t presented = 0;
+    double last_mark = 0.0;
+    int marks_seen = 0;
+    int torn = 0;
+    int reordered = 0;
+    while (last_sequence < STRESS_TICKS) {
+        const RenderSnapshot* snapshot = render_snapshot_acquire(&snapshot_buffer);
+        if (snapshot->sequence == last_sequence) {
+            sched_yield();
+            continue;
+        }
+        reordered += snapshot->sequence < last_sequence;
+        last_sequence = snapshot->sequence;
+        const GameState* state = &snapshot->state;
+        torn += state->core.current_level != (int)snapshot->sequence ||
+                state->stats.levels_completed != (int)snapshot->sequence ||
+                state->system.today != (int)snapshot->sequence;
+        for (int i = 0; i < snapshot->mark_count; i++) {
+            if (snapshot->mark_sequence[i] > presented) {
+                reordered += snapshot->marks[i].time <= last_mark;
+                last_mark = snapshot->marks[i].time;
+                marks_seen++;
+            }
+        }
+        presented = snapshot->sequence;
+    }
+    pthread_join(producer, NULL);
+    CHECK_EQ_INT(torn, 0);
+    CHECK_EQ_INT(reordered, 0);
+    // The producer never got far enough ahead for marks to be dropped
+    CHECK_EQ_INT(marks_seen, STRESS_TICKS);
+}
+
+static const TestCase SNAPSHOT_TESTS[] = {
+    {"newest_snapshot_carries_skipped_marks", newest_snapshot_carries_skipped_marks},
+    {"property_concurrent_snapshots_are_whole_and_ordered", property_concurrent_snapshots_are_whole_and_ordered},
+};
+
+TEST_GROUP(snapshot, SNAPSHOT_TESTS);
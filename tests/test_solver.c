@@ -0,0 +1,304 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "crossword_solver.h"
+#include "worddb.h"
+#include "jobs.h"
+
+// Crossword fill counter: hand-built unique, ambiguous and impossible grids,
+// the built-in level, counts against brute force on small random grids (with
+// and without workers) and a 15x15 grid with a single fill
+
+#define TEST_WORKERS 4
+#define TEST_MAX_WORDS 4096
+
+typedef struct {
+    PackedWord words[TEST_MAX_WORDS];
+    WordDictionary dictionary;
+} TestLexicon;
+
+static int compare_packed(const void* a, const void* b) {
+    PackedWord left = *(const PackedWord*)a;
+    PackedWord right = *(const PackedWord*)b;
+    return (left > right) - (left < right);
+}
+
+// Sorts and drops duplicates, as a word list file would be
+static const WordDictionary* lexicon_finish(TestLexicon* lexicon, int word_length, int count) {
+    qsort(lexicon->words, (size_t)count, sizeof(PackedWord), compare_packed);
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || lexicon->words[unique - 1] != lexicon->words[i]) {
+            lexicon->words[unique++] = lexicon->words[i];
+        }
+    }
+    lexicon->dictionary = (WordDictionary){word_length, unique, lexicon->words, NULL, NULL};
+    return &lexicon->dictionary;
+}
+
+static const WordDictionary* lexicon_from_list(TestLexicon* lexicon, const char* const* words, int count) {
+    int length = (int)strlen(words[0]);
+    for (int i = 0; i < count; i++) {
+        lexicon->words[i] = word_db_pack_word(words[i], length);
+    }
+    return lexicon_finish(lexicon, length, count);
+}
+
+static CrosswordWord slot(int x, int y, int direction, int length) {
+    return (CrosswordWord){x, y, direction, length};
+}
+
+static int packed_at(PackedWord word, int length, int position) {
+    return (int)((word >> (PACKED_LETTER_BITS * (length - 1 - position))) & PACKED_LETTER_MASK);
+}
+
+// Crossing cells agree and no word is used twice
+static int fill_is_consistent(const CrosswordPattern* pattern, const PackedWord* fill) {
+    uint8_t grid[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID] = {{0}};
+    for (int s = 0; s < pattern->slot_count; s++) {
+        const CrosswordWord* word = &pattern->slots[s];
+        for (int t = 0; t < s; t++) {
+            if (fill[t] == fill[s]) {
+                return 0;
+            }
+        }
+        for (int p = 0; p < word->length; p++) {
+            int x = word->start_x + (word->direction == 0 ? p : 0);
+            int y = word->start_y + (word->direction == 0 ? 0 : p);
+            int letter = packed_at(fill[s], word->length, p);
+            if (grid[x][y] && grid[x][y] != letter) {
+                return 0;
+            }
+            grid[x][y] = (uint8_t)letter;
+        }
+    }
+    return 1;
+}
+
+static int count_fills(const WordDictionary* const* dictionaries, int dictionary_count,
+                       const CrosswordPattern* pattern, CrosswordSolveResult* result) {
+    CrosswordSolver* solver = crossword_solver_create(dictionaries, dictionary_count);
+    int count = crossword_solver_count(solver, pattern, CROSSWORD_SOLVER_MAX_FILLS, result);
+    crossword_solver_destroy(solver);
+    return count;
+}
+
+static void small_grids_are_unique_ambiguous_or_impossible(void) {
+    static TestLexicon lexicon;
+    CrosswordSolveResult result;
+    CrosswordPattern pattern = {3, 3, 2, {slot(0, 0, 0, 3), slot(2, 0, 1, 3)}};
+
+    // Across ends where down starts: only CAT then TOP
+    static const char* const chain[] = {"CAT", "TOP", "DOG"};
+    const WordDictionary* dictionary = lexicon_from_list(&lexicon, chain, 3);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 1);
+    CHECK(result.fills[0][0] == word_db_pack_word("CAT", 3));
+    CHECK(result.fills[0][1] == word_db_pack_word("TOP", 3));
+
+    static const char* const dead_end[] = {"CAT", "DOG"};
+    dictionary = lexicon_from_list(&lexicon, dead_end, 2);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 0);
+
+    // Sharing the first letter, the two words can swap places
+    pattern.slots[1] = slot(0, 0, 1, 3);
+    static const char* const swap[] = {"COW", "CAT", "DOG"};
+    dictionary = lexicon_from_list(&lexicon, swap, 3);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 2);
+    CHECK(fill_is_consistent(&pattern, result.fills[0]));
+    CHECK(fill_is_consistent(&pattern, result.fills[1]));
+    CHECK(result.fills[0][0] != result.fills[1][0]);
+
+    // A word may not fill both slots
+    static const char* const alone[] = {"CAT", "DOG"};
+    dictionary = lexicon_from_list(&lexicon, alone, 2);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 0);
+
+    // Nor across slots that do not touch, which are otherwise counted apart
+    pattern.slots[1] = slot(0, 2, 0, 3);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 2);
+    CHECK(result.fills[0][0] != result.fills[0][1]);
+    CHECK(result.fills[1][0] != result.fills[1][1]);
+    static const char* const single[] = {"CAT"};
+    dictionary = lexicon_from_list(&lexicon, single, 1);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 0);
+
+    // A slot length with no word list has no fill
+    pattern.slots[1] = slot(0, 0, 1, 2);
+    CHECK_EQ_INT(count_fills(&dictionary, 1, &pattern, &result), 0);
+}
+
+static void built_in_level_is_not_unique(void) {
+    CrosswordLevel level = get_crossword_level(1);
+    CrosswordSolveResult result;
+    CHECK(!crossword_verify_level(&level, &result));
+    CHECK_EQ_INT(result.fill_count, 2);
+    CrosswordPattern pattern;
+    CHECK(crossword_pattern_from_level(&level, &pattern));
+    CHECK(fill_is_consistent(&pattern, result.fills[0]));
+    CHECK(fill_is_consistent(&pattern, result.fills[1]));
+
+    CrosswordLevel empty = get_crossword_level(2);
+    CHECK(!crossword_verify_level(&empty, NULL));
+}
+
+static void node_budget_leaves_the_count_unknown(void) {
+    static TestLexicon lexicon;
+    static const char* const swap[] = {"COW", "CAT", "DOG"};
+    const WordDictionary* dictionary = lexicon_from_list(&lexicon, swap, 3);
+    CrosswordSolver* solver = crossword_solver_create(&dictionary, 1);
+    CrosswordSolveResult result;
+
+    // The root pass is a node, so a budget of 1 leaves none to branch in. One
+    // fill is all the root and a single branch have to find.
+    CrosswordPattern pattern = {3, 3, 2, {slot(0, 0, 0, 3), slot(0, 0, 1, 3)}};
+    CHECK_EQ_INT(crossword_solver_count_within(solver, &pattern, 1, 2, &result), 1);
+
+    // Connected, then in two groups counted apart
+    for (int layout = 0; layout < 2; layout++) {
+        CHECK_EQ_INT(crossword_solver_count_within(solver, &pattern, CROSSWORD_SOLVER_MAX_FILLS, 1, &result),
+                     CROSSWORD_SOLVER_UNKNOWN);
+        CHECK_EQ_INT(crossword_solver_count_within(solver, &pattern, CROSSWORD_SOLVER_MAX_FILLS, 1000, &result), 2);
+        pattern.slots[1] = slot(0, 2, 0, 3);
+    }
+    crossword_solver_destroy(solver);
+}
+
+// Every assignment of dictionary words to slots, counted up to 2
+static int brute_force_count(const CrosswordPattern* pattern, const WordDictionary* const* by_length) {
+    int choice[CROSSWORD_SOLVER_MAX_SLOTS] = {0};
+    PackedWord fill[CROSSWORD_SOLVER_MAX_SLOTS];
+    int count = 0;
+    for (;;) {
+        for (int s = 0; s < pattern->slot_count; s++) {
+            fill[s] = by_length[pattern->slots[s].length]->words[choice[s]];
+        }
+        count += fill_is_consistent(pattern, fill);
+        if (count >= 2) {
+            return 2;
+        }
+        int s = 0;
+        while (s < pattern->slot_count && ++choice[s] == by_length[pattern->slots[s].length]->count) {
+            choice[s++] = 0;
+        }
+        if (s == pattern->slot_count) {
+            return count;
+        }
+    }
+}
+
+// Property: on random grids over a four-letter alphabet (so words cross
+// often), the solver's capped count and fills match brute force
+static void property_counts_match_brute_force(void) {
+    static TestLexicon lexicons[2];
+    test_random_seed(48);
+    for (int round = 0; round < 2; round++) {
+        if (round == 1) {
+            CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+        }
+        for (int trial = 0; trial < 150; trial++) {
+            const WordDictionary* dictionaries[2];
+            const WordDictionary* by_length[5] = {0};
+            for (int d = 0; d < 2; d++) {
+                int length = 3 + d;
+                int count = 4 + (int)(test_random() % 10);
+                for (int i = 0; i < count; i++) {
+                    char word[5] = {0};
+                    for (int p = 0; p < length; p++) {
+                        word[p] = (char)('A' + test_random() % 4);
+                    }
+                    lexicons[d].words[i] = word_db_pack_word(word, length);
+                }
+                dictionaries[d] = lexicon_finish(&lexicons[d], length, count);
+                by_length[length] = dictionaries[d];
+            }
+
+            CrosswordPattern pattern = {5, 5, 2 + (int)(test_random() % 3), {{0}}};
+            for (int s = 0; s < pattern.slot_count; s++) {
+                int length = 3 + (int)(test_random() % 2);
+                int direction = (int)(test_random() % 2);
+                int along = (int)(test_random() % (unsigned)(5 - length + 1));
+                int across = (int)(test_random() % 5);
+                pattern.slots[s] = direction == 0 ? slot(along, across, 0, length) : slot(across, along, 1, length);
+            }
+
+            CrosswordSolveResult result;
+            int expected = brute_force_count(&pattern, by_length);
+            CHECK_EQ_INT(count_fills(dictionaries, 2, &pattern, &result), expected);
+            for (int f = 0; f < result.fill_count; f++) {
+                CHECK(fill_is_consistent(&pattern, result.fills[f]));
+            }
+            if (expected == 2) {
+                CHECK(memcmp(result.fills[0], result.fills[1], sizeof(PackedWord) * (size_t)pattern.slot_count) != 0);
+            }
+        }
+        jobs_shutdown();
+    }
+}
+
+// 15x15 with blocks on row 5 and columns 3 and 8: six rectangles of 3-, 4-
+// and 6-letter across words over 5- and 9-letter down words, none square or
+// alike, so no block can be transposed or swapped into a second fill. Random
+// letters plus hundreds of random decoys per length.
+static void fifteen_by_fifteen_fill_is_unique(void) {
+    static TestLexicon lexicons[5];
+    static const int LENGTHS[5] = {3, 4, 5, 6, 9};
+    uint8_t mask[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID];
+    char letters[CROSSWORD_SOLVER_MAX_GRID][CROSSWORD_SOLVER_MAX_GRID];
+    test_random_seed(1515);
+    for (int x = 0; x < 15; x++) {
+        for (int y = 0; y < 15; y++) {
+            mask[x][y] = y != 5 && x != 3 && x != 8;
+            letters[x][y] = (char)('A' + test_random() % 26);
+        }
+    }
+    CrosswordPattern pattern;
+    CHECK(crossword_pattern_from_mask(15, 15, mask, &pattern));
+    CHECK_EQ_INT(pattern.slot_count, 14 * 3 + 13 * 2);
+
+    int counts[5] = {0};
+    PackedWord intended[CROSSWORD_SOLVER_MAX_SLOTS];
+    for (int s = 0; s < pattern.slot_count; s++) {
+        const CrosswordWord* word = &pattern.slots[s];
+        char text[CROSSWORD_SOLVER_MAX_GRID + 1] = {0};
+        for (int p = 0; p < word->length; p++) {
+            text[p] = letters[word->start_x + (word->direction == 0 ? p : 0)][word->start_y + (word->direction == 0 ? 0 : p)];
+        }
+        intended[s] = word_db_pack_word(text, word->length);
+        for (int d = 0; d < 5; d++) {
+            if (LENGTHS[d] == word->length) {
+                lexicons[d].words[counts[d]++] = intended[s];
+            }
+        }
+    }
+    const WordDictionary* dictionaries[5];
+    for (int d = 0; d < 5; d++) {
+        int target = counts[d] + 400;
+        while (counts[d] < target) {
+            char text[CROSSWORD_SOLVER_MAX_GRID + 1] = {0};
+            for (int p = 0; p < LENGTHS[d]; p++) {
+                text[p] = (char)('A' + test_random() % 26);
+            }
+            lexicons[d].words[counts[d]++] = word_db_pack_word(text, LENGTHS[d]);
+        }
+        dictionaries[d] = lexicon_finish(&lexicons[d], LENGTHS[d], counts[d]);
+    }
+
+    for (int round = 0; round < 2; round++) {
+        if (round == 1) {
+            CHECK_EQ_INT(jobs_init(TEST_WORKERS), TEST_WORKERS);
+        }
+        CrosswordSolveResult result;
+        CHECK_EQ_INT(count_fills(dictionaries, 5, &pattern, &result), 1);
+        CHECK(memcmp(result.fills[0], intended, sizeof(PackedWord) * (size_t)pattern.slot_count) == 0);
+        jobs_shutdown();
+    }
+}
+
+static const TestCase SOLVER_TESTS[] = {
+    {"small_grids_are_unique_ambiguous_or_impossible", small_grids_are_unique_ambiguous_or_impossible},
+    {"built_in_level_is_not_unique", built_in_level_is_not_unique},
+    {"node_budget_leaves_the_count_unknown", node_budget_leaves_the_count_unknown},
+    {"property_counts_match_brute_force", property_counts_match_brute_force},
+    {"fifteen_by_fifteen_fill_is_unique", fifteen_by_fifteen_fill_is_unique},
+};
+
+TEST_GROUP(solver, SOLVER_TESTS);
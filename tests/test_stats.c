@@ -0,0 +1,117 @@
+#include "test_framework.h"
+#include "test_support.h"
+#include "stats_history.h"
+#include "worddb.h"
+
+// Statistics history: incremental aggregates against a brute-force model,
+// and solved levels through the columnar log and back
+
+#define TEST_STATS_PATH "test_stats.cwst"
+
+// Property: rolling windows and histogram percentiles match recomputing them
+// from the full history after every level
+static void property_aggregates_match_recomputed_history(void) {
+    enum { LEVELS = 1500 };
+    static uint16_t guesses[LEVELS];
+    StatsAggregates aggregates = {0};
+    srand(7);
+    for (int n = 0; n < LEVELS; n++) {
+        LevelHistoryRecord record = {0};
+        record.guesses = (uint16_t)(1 + rand() % (n % 3 == 0 ? 40 : 8));
+        record.time_ms = (uint32_t)(rand() % 400000);
+        guesses[n] = record.guesses;
+        stats_history_record_level(&aggregates, &record);
+
+        static const int windows[] = {STATS_WINDOW_SHORT, STATS_WINDOW_LONG, 0};
+        for (int w = 0; w < 3; w++) {
+            int count = windows[w] && n + 1 > windows[w] ? windows[w] : n + 1;
+            uint64_t sum = 0;
+            for (int i = n + 1 - count; i <= n; i++) {
+                sum += guesses[i];
+            }
+            CHECK_EQ_INT(stats_history_average_tenths(&aggregates, windows[w]), (int)((sum * 10 + count / 2) / count));
+        }
+    }
+    CHECK_EQ_INT((int)aggregates.levels, LEVELS);
+
+    // Percentile: the smallest guess count covering the fraction, capped at the last bucket
+    for (int p = 1; p <= 9; p++) {
+        double fraction = p / 10.0;
+        uint32_t rank = (uint32_t)(fraction * LEVELS + 0.5);
+        int expected = 0;
+        for (int value = 1; value <= STATS_GUESS_BUCKETS && !expected; value++) {
+            uint32_t covered = 0;
+            for (int i = 0; i < LEVELS; i++) {
+                covered += guesses[i] <= value || value == STATS_GUESS_BUCKETS;
+            }
+            expected = covered >= rank ? value : 0;
+        }
+        CHECK_EQ_INT(stats_history_guess_percentile(&aggregates, fraction), expected);
+    }
+}
+
+static void solved_levels_round_trip_through_the_log(void) {
+    remove(TEST_STATS_PATH);
+    StatsAggregates loaded;
+    CHECK(stats_log_open(TEST_STATS_PATH, &loaded));
+    CHECK_EQ_INT((int)loaded.levels, 0);
+
+    GameState state = test_start_wordle("CRANE");
+    state.stats.level_start_time = 100.0;
+    GameInput input = crosswordle_input(1.0f / 60.0f, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    input.time = 112.5;
+    const char* guesses[] = {"NORTH", "CRANE"};
+    for (int g = 0; g < 2; g++) {
+        for (int i = 0; i < 5; i++) {
+            crosswordle_input_press(&input, GAME_KEY_A + (guesses[g][i] - 'A'));
+        }
+        crosswordle_input_press(&input, GAME_KEY_ENTER);
+    }
+    state = game_tick(state, &input);
+    CHECK(state.system.level_record_ready);
+    const LevelHistoryRecord* record = &state.system.level_record;
+    CHECK_EQ_INT(record->guesses, 2);
+    CHECK_EQ_INT(record->time_ms, 12500);
+    CHECK(record->word == word_db_pack_word("CRANE", 5));
+    CHECK(strchr("CRANE", record->token) != NULL);
+
+    // N and R came back present in NORTH, then every CRANE letter correct
+    const StatsAggregates* history = &state.stats.history;
+    CHECK_EQ_INT(history->letter_results['N' - 'A'][0], 1);
+    CHECK_EQ_INT(history->letter_results['N' - 'A'][1], 1);
+    CHECK_EQ_INT(history->letter_results['O' - 'A'][2], 1);
+    CHECK_EQ_INT(stats_history_average_tenths(history, STATS_WINDOW_SHORT), 20);
+    CHECK_EQ_INT(stats_history_time_percentile_seconds(history, 0.5), 15);
+    CHECK(strcmp(state.ui.hud.stats_average_text, "Average guesses - last 10: 2.0 | last 100: 2.0 | all: 2.0") == 0);
+    CHECK(strcmp(state.ui.hud.stats_percentile_text, "Guesses p50 2 p90 2 | Time p50 15s p90 15s") == 0);
+
+    CHECK(stats_log_append(record, history));
+    LevelHistoryRecord second = *record;
+    second.level = 2;
+    second.guesses = 5;
+    StatsAggregates aggregates = *history;
+    stats_history_record_level(&aggregates, &second);
+    CHECK(stats_log_append(&second, &aggregates));
+    stats_log_close();
+
+    // Reopening restores the aggregates from the header alone
+    CHECK(stats_log_open(TEST_STATS_PATH, &loaded));
+    CHECK(memcmp(&loaded, &aggregates, sizeof(loaded)) == 0);
+    CHECK_EQ_INT((int)stats_log_level_count(), 2);
+    StatsLogBlock block;
+    CHECK(stats_log_read_block(0, &block));
+    CHECK_EQ_INT(block.count, 2);
+    CHECK_EQ_INT(block.guesses[0], 2);
+    CHECK_EQ_INT(block.guesses[1], 5);
+    CHECK_EQ_INT(block.level[1], 2);
+    CHECK_EQ_INT(block.time_ms[0], 12500);
+    stats_log_close();
+    remove(TEST_STATS_PATH);
+}
+
+static const TestCase STATS_TESTS[] = {
+    {"property_aggregates_match_recomputed_history", property_aggregates_match_recomputed_history},
+    {"solved_levels_round_trip_through_the_log", solved_levels_round_trip_through_the_log},
+};
+
+TEST_GROUP(stats, STATS_TESTS);
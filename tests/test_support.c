@@ -0,0 +1,53 @@
+#include "test_support.h"
+
+#define TEST_FRAME_TIME (1.0f / 60.0f)
+
+GameState test_tick(GameState state) {
+    GameInput input = crosswordle_input(TEST_FRAME_TIME, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    return game_tick(state, &input);
+}
+
+GameState test_press(GameState state, int key) {
+    GameInput input = crosswordle_input(TEST_FRAME_TIME, DEFAULT_SCREEN_WIDTH, DEFAULT_SCREEN_HEIGHT);
+    crosswordle_input_press(&input, key);
+    return game_tick(state, &input);
+}
+
+GameState test_type(GameState state, const char* letters) {
+    for (const char* c = letters; *c != '\0'; c++) {
+        state = test_press(state, GAME_KEY_A + (*c - 'A'));
+    }
+    return state;
+}
+
+GameState test_start_wordle(const char* target_word) {
+    GameState state = create_game_state("");
+    state.settings.animations_enabled = 0;  // Guesses resolve in the same frame
+    state = test_press(state, GAME_KEY_ENTER);
+    strcpy(state.core.target_word, target_word);
+    state.core.word_length = (int)strlen(target_word);
+    return state;
+}
+
+GameState test_start_crossword(int tokens) {
+    GameState state = test_start_wordle("CRANE");
+    TokenTransaction grant = token_transaction(TOKEN_TX_GRANT);
+    for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+        token_transaction_add(&grant, (char)('A' + i), tokens);
+    }
+    token_ledger_commit(&state.stats.tokens, &grant);
+    return test_press(state, GAME_KEY_TAB);
+}
+
+static uint32_t random_state = 1;
+
+void test_random_seed(uint32_t seed) {
+    random_state = seed ? seed : 1;
+}
+
+uint32_t test_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+}
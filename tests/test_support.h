@@ -0,0 +1,23 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include "systems.h"
+#include "crosswordle.h"
+
+// One frame with no keys pressed
+GameState test_tick(GameState state);
+// Presses a key for one frame
+GameState test_press(GameState state, int key);
+// Types letters (A-Z) one frame each
+GameState test_type(GameState state, const char* letters);
+
+// Home screen -> Wordle with a known target word
+GameState test_start_wordle(const char* target_word);
+// Fresh game switched to the crossword view holding `tokens` of every letter
+GameState test_start_crossword(int tokens);
+
+// Deterministic per-test random numbers (xorshift32)
+void test_random_seed(uint32_t seed);
+uint32_t test_random(void);
+
+#endif
@@ -0,0 +1,128 @@
+#include "test_framework.h"
+#include "test_support.h"
+
+// Letter-token ledger: transactions, totals and crossword affordability
+
+static void rejected_transaction_changes_nothing(void) {
+    TokenLedger ledger = {0};
+    TokenTransaction award = token_transaction(TOKEN_TX_AWARD);
+    token_transaction_add(&award, 'A', 2);
+    token_transaction_add(&award, 'B', 1);
+    CHECK(token_ledger_commit(&ledger, &award));
+    
+    // Needs two Bs: the A lane alone would be fine, but the batch is all-or-nothing
+    TokenTransaction place = token_transaction(TOKEN_TX_PLACE);
+    token_transaction_add(&place, 'A', -1);
+    token_transaction_add(&place, 'B', -2);
+    CHECK(!token_ledger_commit(&ledger, &place));
+    CHECK_EQ_INT(token_ledger_count(&ledger, 'A'), 2);
+    CHECK_EQ_INT(token_ledger_count(&ledger, 'B'), 1);
+    CHECK_EQ_INT(ledger.rejected_transactions, 1);
+    CHECK_EQ_INT(ledger.version, 1);
+}
+
+static void totals_split_by_transaction_kind(void) {
+    TokenLedger ledger = {0};
+    TokenTransaction grant = token_transaction(TOKEN_TX_GRANT);
+    token_transaction_add(&grant, 'E', 3);
+    CHECK(token_ledger_commit(&ledger, &grant));
+    
+    TokenTransaction place = token_transaction(TOKEN_TX_PLACE);
+    token_transaction_add(&place, 'E', -2);
+    CHECK(token_ledger_commit(&ledger, &place));
+    
+    TokenTransaction clear = token_transaction(TOKEN_TX_CLEAR);
+    token_transaction_add(&clear, 'E', 1);
+    CHECK(token_ledger_commit(&ledger, &clear));
+    
+    CHECK_EQ_INT(ledger.total_earned, 3);
+    CHECK_EQ_INT(ledger.total_spent, 2);
+    CHECK_EQ_INT(ledger.total_refunded, 1);
+    CHECK_EQ_INT(ledger.spent_by_letter['E' - 'A'], 2);
+    CHECK_EQ_INT(ledger.transactions_by_kind[TOKEN_TX_PLACE], 1);
+    CHECK_EQ_INT(token_ledger_total(&ledger), 2);
+}
+
+static void overflowing_lane_is_rejected(void) {
+    TokenLedger ledger = {0};
+    ledger.balance[0] = INT16_MAX - 1;
+    TokenTransaction grant = token_transaction(TOKEN_TX_GRANT);
+    token_transaction_add(&grant, 'A', 5);
+    CHECK(!token_ledger_commit(&ledger, &grant));
+    CHECK_EQ_INT(ledger.balance[0], INT16_MAX - 1);
+}
+
+static void crossword_need_tracks_affordability(void) {
+    GameState state = test_start_crossword(0);
+    // SWORD + TARK + COSS: S x3, R x2, O x2, and one each of W D T A K C
+    CHECK_EQ_INT(state.crossword.token_need['S' - 'A'], 3);
+    CHECK_EQ_INT(state.crossword.token_need['R' - 'A'], 2);
+    CHECK_EQ_INT(state.crossword.token_need['Z' - 'A'], 0);
+    CHECK(!token_ledger_can_afford(&state.stats.tokens, state.crossword.token_need));
+    
+    TokenTransaction award = token_transaction(TOKEN_TX_AWARD);
+    for (const char* c = "SSSRROOWDTAKC"; *c; c++) {
+        token_transaction_add(&award, *c, 1);
+    }
+    token_ledger_commit(&state.stats.tokens, &award);
+    CHECK(token_ledger_can_afford(&state.stats.tokens, state.crossword.token_need));
+    
+    // A wrong letter in a cell still owes the solution letter but frees its own
+    TokenTransaction place_wrong = token_transaction(TOKEN_TX_PLACE);
+    token_transaction_add(&place_wrong, 'S', -1);
+    CHECK(token_ledger_commit(&state.stats.tokens, &place_wrong));
+    crossword_set_cell(&state.crossword, 2, 0, 'S');
+    CHECK_EQ_INT(state.crossword.token_need['S' - 'A'], 2);
+    CHECK_EQ_INT(state.crossword.token_need['W' - 'A'], 1);
+    CHECK(token_ledger_can_afford(&state.stats.tokens, state.crossword.token_need));
+    CHECK_EQ_INT(token_ledger_shortfall(&state.stats.tokens, state.crossword.token_need), 0);
+}
+
+// Property: tokens are conserved across any sequence of place/clear input.
+// Balance plus letters on the grid stays constant, and the ledger's totals
+// always account for the balance.
+static void property_tokens_conserved_across_place_and_clear(void) {
+    test_random_seed(0x70c3e031u);
+    for (int game = 0; game < 40; game++) {
+        GameState state = test_start_crossword((int)(test_random() % 3));
+        int start_total = token_ledger_total(&state.stats.tokens);
+        
+        for (int step = 0; step < 400 && state.current_view == VIEW_CROSSWORD; step++) {
+            uint32_t roll = test_random() % 100;
+            int key = roll < 55 ? GAME_KEY_A + (int)(test_random() % 26)
+                    : roll < 80 ? GAME_KEY_BACKSPACE
+                    : roll < 88 ? GAME_KEY_ENTER
+                    : roll < 94 ? GAME_KEY_RIGHT
+                    : GAME_KEY_DOWN;
+            state = test_press(state, key);
+            
+            int on_grid = 0;
+            for (int x = 0; x < 9; x++) {
+                for (int y = 0; y < 9; y++) {
+                    on_grid += state.crossword.grid[x][y] != '\0';
+                }
+            }
+            const TokenLedger* ledger = &state.stats.tokens;
+            CHECK_EQ_INT(token_ledger_total(ledger) + on_grid, start_total);
+            CHECK_EQ_INT(token_ledger_total(ledger), ledger->total_earned - ledger->total_spent + ledger->total_refunded);
+            for (int i = 0; i < TOKEN_LETTER_COUNT; i++) {
+                CHECK(ledger->balance[i] >= 0);
+            }
+            
+            // Incremental needs agree with a full rescan
+            CrosswordState rescanned = state.crossword;
+            crossword_token_need_reset(&rescanned);
+            CHECK(memcmp(rescanned.token_need, state.crossword.token_need, sizeof(rescanned.token_need)) == 0);
+        }
+    }
+}
+
+static const TestCase TOKEN_TESTS[] = {
+    {"rejected_transaction_changes_nothing", rejected_transaction_changes_nothing},
+    {"totals_split_by_transaction_kind", totals_split_by_transaction_kind},
+    {"overflowing_lane_is_rejected", overflowing_lane_is_rejected},
+    {"crossword_need_tracks_affordability", crossword_need_tracks_affordability},
+    {"property_tokens_conserved_across_place_and_clear", property_tokens_conserved_across_place_and_clear},
+};
+
+TEST_GROUP(tokens, TOKEN_TESTS);
@@ -0,0 +1,119 @@
+// cluepack - converts plain-text clue lists into a packed .cwcl clue database
+//
+// Usage: cluepack -o <output.cwcl> <input.txt>...
+//
+// Input files hold one clue per line: the answer, whitespace, then the clue
+// text ("CRANE Tall wading bird"). Lines starting with '#' are ignored.
+// Answers are upper-cased; anything that is not 1-12 letters A-Z is skipped.
+// An answer listed twice keeps its first clue.
+
+#include "clues.h"
+#include "worddb.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    ClueSource* clues;
+    int count;
+    int capacity;
+} ClueList;
+
+static void clue_list_push(ClueList* list, uint64_t word, const char* text) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 1024;
+        list->clues = realloc(list->clues, (size_t)list->capacity * sizeof(ClueSource));
+        if (!list->clues) {
+            fprintf(stderr, "cluepack: out of memory\n");
+            exit(1);
+        }
+    }
+    char* copy = malloc(strlen(text) + 1);
+    if (!copy) {
+        fprintf(stderr, "cluepack: out of memory\n");
+        exit(1);
+    }
+    strcpy(copy, text);
+    list->clues[list->count].word = word;
+    list->clues[list->count].text = copy;
+    list->count++;
+}
+
+static int read_clue_list(const char* path, ClueList* list) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "cluepack: cannot open %s\n", path);
+        return 0;
+    }
+
+    char line[CLUE_MAX_LENGTH + 64];
+    while (fgets(line, sizeof(line), file)) {
+        if (line[0] == '#') {
+            continue;
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+
+        char* word = line;
+        while (*word == ' ' || *word == '\t') {
+            word++;
+        }
+        char* text = word;
+        while (*text != '\0' && *text != ' ' && *text != '\t') {
+            *text = (char)toupper((unsigned char)*text);
+            text++;
+        }
+        int word_length = (int)(text - word);
+        if (*text != '\0') {
+            *text++ = '\0';
+        }
+        while (*text == ' ' || *text == '\t') {
+            text++;
+        }
+        uint64_t packed = word_db_pack_word(word, word_length);
+        if (packed != 0 && *text != '\0') {
+            clue_list_push(list, packed, text);
+        }
+    }
+
+    fclose(file);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* output_path = NULL;
+    int first_input = argc;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+
+    if (!output_path || first_input >= argc) {
+        fprintf(stderr, "usage: cluepack -o <output.cwcl> <input.txt>...\n");
+        return 2;
+    }
+
+    ClueList list = {0};
+    for (int i = first_input; i < argc; i++) {
+        if (!read_clue_list(argv[i], &list)) {
+            return 1;
+        }
+    }
+
+    if (!clue_db_write(output_path, list.clues, list.count)) {
+        fprintf(stderr, "cluepack: failed to write %s\n", output_path);
+        return 1;
+    }
+
+    printf("cluepack: wrote %s from %d clue lines\n", output_path, list.count);
+    for (int i = 0; i < list.count; i++) {
+        free((char*)list.clues[i].text);
+    }
+    free(list.clues);
+    return 0;
+}
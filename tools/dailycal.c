@@ -0,0 +1,54 @@
+// dailycal - precomputes the daily challenge calendar (.cwcal)
+//
+// Usage: dailycal -o <output.cwcal> [--start YYYY-MM-DD] [--days N] [--data DIR]
+//
+// Writes the daily word for every length and the daily crossword for N days
+// (default 366) from --start (default today). Word databases in --data
+// (default "data") are loaded first so the calendar matches what the game
+// loads; a calendar built against other word lists is ignored at runtime.
+
+#include "systems.h"
+#include "daily.h"
+
+int main(int argc, char** argv) {
+    const char* output_path = NULL;
+    const char* data_directory = "data";
+    int day_count = DAILY_CALENDAR_DEFAULT_DAYS;
+    time_t now = time(NULL);
+    struct tm* local = localtime(&now);
+    int first_day = local ? daily_day_number(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday) : 0;
+    
+    for (int i = 1; i < argc; i++) {
+        int year, month, day;
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (strcmp(argv[i], "--start") == 0 && i + 1 < argc &&
+                   sscanf(argv[++i], "%d-%d-%d", &year, &month, &day) == 3) {
+            first_day = daily_day_number(year, month, day);
+        } else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+            day_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+            data_directory = argv[++i];
+        } else {
+            output_path = NULL;
+            break;
+        }
+    }
+    
+    if (!output_path || day_count <= 0) {
+        fprintf(stderr, "usage: dailycal -o <output.cwcal> [--start YYYY-MM-DD] [--days N] [--data DIR]\n");
+        return 2;
+    }
+    
+    load_word_databases(data_directory);
+    if (!daily_calendar_write(output_path, first_day, day_count)) {
+        fprintf(stderr, "dailycal: failed to write %s\n", output_path);
+        return 1;
+    }
+    
+    int year, month, day;
+    daily_date_from_day(first_day, &year, &month, &day);
+    printf("dailycal: wrote %d days from %04d-%02d-%02d to %s\n", day_count, year, month, day, output_path);
+    unload_word_databases();
+    return 0;
+}
@@ -0,0 +1,235 @@
+// puzzlepack - converts plain-text crosswords into a .cwpk puzzle pack
+//
+// Usage: puzzlepack -o <output.cwpk> <input.txt>...
+//
+// A puzzle is its grid, one row per line (letters for word cells, '.' for
+// blocked ones, at most 9x9), then its clues, one per line: the answer,
+// whitespace, then the clue text ("CROSS Angry"). A blank line ends a
+// puzzle; lines starting with '#' are ignored. The words are the grid's
+// across and down runs of two or more letters, in reading order, and must be
+// 4-7 letters long. Puzzles that break a rule are skipped with a message.
+
+#include "systems.h"
+#include "puzzle_pack.h"
+
+#include <ctype.h>
+
+#define GRID_SIZE 9
+#define MAX_CLUE_LINE 512
+
+typedef struct {
+    PuzzleSource* puzzles;
+    int count;
+    int capacity;
+} PuzzleList;
+
+// The puzzle being read
+typedef struct {
+    char rows[GRID_SIZE][GRID_SIZE + 1];
+    int row_count;
+    char* clue_lines[PUZZLE_PACK_MAX_WORDS * 2];
+    int clue_count;
+    int line;                                 // Of its first row, for messages
+    int valid;
+} PuzzleDraft;
+
+static void* checked_alloc(void* pointer) {
+    if (!pointer) {
+        fprintf(stderr, "puzzlepack: out of memory\n");
+        exit(1);
+    }
+    return pointer;
+}
+
+static char* copy_text(const char* text) {
+    char* copy = checked_alloc(malloc(strlen(text) + 1));
+    strcpy(copy, text);
+    return copy;
+}
+
+static void puzzle_list_push(PuzzleList* list, const PuzzleSource* puzzle) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 256;
+        list->puzzles = checked_alloc(realloc(list->puzzles, (size_t)list->capacity * sizeof(PuzzleSource)));
+    }
+    list->puzzles[list->count++] = *puzzle;
+}
+
+// Adds the run starting at (x, y) in `direction` if it is a word
+static int add_run(PuzzleSource* puzzle, int x, int y, int direction) {
+    CrosswordLevel* level = &puzzle->level;
+    int length = 0;
+    while (x + (direction == 0 ? length : 0) < GRID_SIZE && y + (direction == 0 ? 0 : length) < GRID_SIZE &&
+           level->word_mask[x + (direction == 0 ? length : 0)][y + (direction == 0 ? 0 : length)]) {
+        length++;
+    }
+    if (length < 2) {
+        return 1;
+    }
+    if (length < MIN_WORD_LENGTH || length > MAX_WORD_LENGTH || level->word_count == PUZZLE_PACK_MAX_WORDS) {
+        return 0;
+    }
+    level->words[level->word_count++] = (CrosswordWord){x, y, direction, length};
+    return 1;
+}
+
+static void draft_finish(PuzzleDraft* draft, const char* path, PuzzleList* list) {
+    if (draft->row_count == 0) {
+        for (int c = 0; c < draft->clue_count; c++) {
+            free(draft->clue_lines[c]);
+        }
+        memset(draft, 0, sizeof(*draft));
+        return;
+    }
+
+    PuzzleSource puzzle = {0};
+    CrosswordLevel* level = &puzzle.level;
+    for (int y = 0; y < draft->row_count; y++) {
+        for (int x = 0; draft->rows[y][x] != '\0'; x++) {
+            if (draft->rows[y][x] != '.') {
+                level->solution[x][y] = draft->rows[y][x];
+                level->word_mask[x][y] = 1;
+            }
+        }
+    }
+
+    // Words in reading order: a cell starts an across word if the cell to its
+    // left is blocked, a down word if the cell above is
+    int valid = draft->valid;
+    for (int y = 0; valid && y < GRID_SIZE; y++) {
+        for (int x = 0; valid && x < GRID_SIZE; x++) {
+            if (!level->word_mask[x][y]) {
+                continue;
+            }
+            if (x == 0 || !level->word_mask[x - 1][y]) {
+                valid = add_run(&puzzle, x, y, 0);
+            }
+            if (valid && (y == 0 || !level->word_mask[x][y - 1])) {
+                valid = add_run(&puzzle, x, y, 1);
+            }
+        }
+    }
+    valid = valid && level->word_count > 0;
+    if (!valid) {
+        fprintf(stderr, "puzzlepack: %s:%d: skipped, grid words must be %d-%d letters (at most %d words)\n",
+                path, draft->line, MIN_WORD_LENGTH, MAX_WORD_LENGTH, PUZZLE_PACK_MAX_WORDS);
+    }
+
+    // Each clue goes to the first word with its answer that has none yet
+    for (int c = 0; c < draft->clue_count; c++) {
+        char* answer = draft->clue_lines[c];
+        char* text = answer + strcspn(answer, " \t");
+        *text++ = '\0';
+        text += strspn(text, " \t");
+        int placed = 0;
+        for (int w = 0; valid && !placed && w < level->word_count; w++) {
+            const CrosswordWord* word = &level->words[w];
+            int matches = puzzle.clues[w] == NULL && (int)strlen(answer) == word->length;
+            for (int i = 0; matches && i < word->length; i++) {
+                matches = level->solution[word->start_x + (word->direction == 0 ? i : 0)]
+                                         [word->start_y + (word->direction == 0 ? 0 : i)] == answer[i];
+            }
+            if (matches) {
+                puzzle.clues[w] = copy_text(text);
+                placed = 1;
+            }
+        }
+        if (valid && !placed) {
+            fprintf(stderr, "puzzlepack: %s:%d: clue for %s matches no word\n", path, draft->line, answer);
+        }
+        free(draft->clue_lines[c]);
+    }
+
+    if (valid) {
+        puzzle_list_push(list, &puzzle);
+    }
+    memset(draft, 0, sizeof(*draft));
+}
+
+static int read_puzzles(const char* path, PuzzleList* list) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "puzzlepack: cannot open %s\n", path);
+        return 0;
+    }
+
+    PuzzleDraft draft = {0};
+    char line[MAX_CLUE_LINE];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        if (line[0] == '#') {
+            continue;
+        }
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') {
+            draft_finish(&draft, path, list);
+            continue;
+        }
+        if (draft.line == 0) {
+            draft.line = line_number;
+            draft.valid = 1;
+        }
+
+        for (char* c = line; *c != '\0'; c++) {
+            if (*c == ' ' || *c == '\t') {
+                break;
+            }
+            *c = (char)toupper((unsigned char)*c);
+        }
+        if (strpbrk(line, " \t")) {
+            if (draft.clue_count < PUZZLE_PACK_MAX_WORDS * 2) {
+                draft.clue_lines[draft.clue_count++] = copy_text(line);
+            }
+        } else if (draft.clue_count > 0 || draft.row_count == GRID_SIZE || strlen(line) > GRID_SIZE ||
+                   strspn(line, ".ABCDEFGHIJKLMNOPQRSTUVWXYZ") != strlen(line)) {
+            fprintf(stderr, "puzzlepack: %s:%d: bad grid row\n", path, line_number);
+            draft.valid = 0;
+        } else {
+            strcpy(draft.rows[draft.row_count++], line);
+        }
+    }
+    draft_finish(&draft, path, list);
+
+    fclose(file);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    const char* output_path = NULL;
+    int first_input = argc;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+
+    if (!output_path || first_input >= argc) {
+        fprintf(stderr, "usage: puzzlepack -o <output.cwpk> <input.txt>...\n");
+        return 2;
+    }
+
+    PuzzleList list = {0};
+    for (int i = first_input; i < argc; i++) {
+        if (!read_puzzles(argv[i], &list)) {
+            return 1;
+        }
+    }
+
+    if (!puzzle_pack_write(output_path, list.puzzles, list.count)) {
+        fprintf(stderr, "puzzlepack: failed to write %s\n", output_path);
+        return 1;
+    }
+
+    printf("puzzlepack: wrote %d puzzles to %s\n", list.count, output_path);
+    for (int i = 0; i < list.count; i++) {
+        for (int w = 0; w < PUZZLE_PACK_MAX_WORDS; w++) {
+            free((char*)list.puzzles[i].clues[w]);
+        }
+    }
+    free(list.puzzles);
+    return 0;
+}
@@ -0,0 +1,148 @@
+// wordpack - converts plain-text word lists into packed .cwdb word databases
+//
+// Usage: wordpack -l <length> -o <output.cwdb> <input.txt>...
+//
+// Input files hold one word per line, optionally followed by a usage frequency
+// ("CRANE 812"). Lines starting with '#' are ignored. Words are upper-cased;
+// anything that is not exactly <length> letters A-Z is skipped.
+
+#include "worddb.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t word;
+    uint32_t frequency;
+} PackEntry;
+
+typedef struct {
+    PackEntry* entries;
+    int count;
+    int capacity;
+} PackList;
+
+static int compare_entries(const void* a, const void* b) {
+    const PackEntry* entry_a = (const PackEntry*)a;
+    const PackEntry* entry_b = (const PackEntry*)b;
+    return (entry_a->word > entry_b->word) - (entry_a->word < entry_b->word);
+}
+
+static void pack_list_push(PackList* list, uint64_t word, uint32_t frequency) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 1024;
+        list->entries = realloc(list->entries, (size_t)list->capacity * sizeof(PackEntry));
+        if (!list->entries) {
+            fprintf(stderr, "wordpack: out of memory\n");
+            exit(1);
+        }
+    }
+    list->entries[list->count].word = word;
+    list->entries[list->count].frequency = frequency;
+    list->count++;
+}
+
+static int read_word_list(const char* path, int word_length, PackList* list) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "wordpack: cannot open %s\n", path);
+        return 0;
+    }
+    
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char word[64];
+        unsigned long frequency = 0;
+        if (line[0] == '#' || sscanf(line, "%63s %lu", word, &frequency) < 1) {
+            continue;
+        }
+        for (char* c = word; *c != '\0'; c++) {
+            *c = (char)toupper((unsigned char)*c);
+        }
+        if ((int)strlen(word) != word_length) {
+            continue;
+        }
+        uint64_t packed = word_db_pack_word(word, word_length);
+        if (packed != 0) {
+            pack_list_push(list, packed, frequency > 65535 ? 65535u : (uint32_t)frequency);
+        }
+    }
+    
+    fclose(file);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    int word_length = 0;
+    const char* output_path = NULL;
+    int first_input = argc;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            word_length = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            first_input = i;
+            break;
+        }
+    }
+    
+    if (word_length <= 0 || word_length > WORD_DB_MAX_WORD_LENGTH || !output_path || first_input >= argc) {
+        fprintf(stderr, "usage: wordpack -l <length> -o <output.cwdb> <input.txt>...\n");
+        return 2;
+    }
+    
+    PackList list = {0};
+    for (int i = first_input; i < argc; i++) {
+        if (!read_word_list(argv[i], word_length, &list)) {
+            return 1;
+        }
+    }
+    
+    // Sort, then merge duplicates keeping the highest frequency
+    qsort(list.entries, (size_t)list.count, sizeof(PackEntry), compare_entries);
+    int unique_count = 0;
+    for (int i = 0; i < list.count; i++) {
+        if (unique_count > 0 && list.entries[unique_count - 1].word == list.entries[i].word) {
+            if (list.entries[i].frequency > list.entries[unique_count - 1].frequency) {
+                list.entries[unique_count - 1].frequency = list.entries[i].frequency;
+            }
+            continue;
+        }
+        list.entries[unique_count++] = list.entries[i];
+    }
+    
+    uint64_t* words = malloc((size_t)unique_count * sizeof(uint64_t) + 1);
+    uint8_t* difficulty = malloc((size_t)unique_count + 1);
+    uint16_t* frequency = malloc((size_t)unique_count * sizeof(uint16_t) + 1);
+    if (!words || !difficulty || !frequency) {
+        fprintf(stderr, "wordpack: out of memory\n");
+        return 1;
+    }
+    
+    for (int i = 0; i < unique_count; i++) {
+        words[i] = list.entries[i].word;
+        if (!word_db_words_are_valid(&words[i], 1, word_length)) {
+            fprintf(stderr, "wordpack: packed word %d is not %d letters A-Z\n", i, word_length);
+            return 1;
+        }
+        difficulty[i] = word_db_static_difficulty(words[i], word_length);
+        frequency[i] = (uint16_t)list.entries[i].frequency;
+    }
+    
+    if (!word_db_write(output_path, word_length, words, difficulty, frequency, unique_count)) {
+        fprintf(stderr, "wordpack: failed to write %s\n", output_path);
+        return 1;
+    }
+    
+    printf("wordpack: wrote %d %d-letter words to %s\n", unique_count, word_length, output_path);
+    
+    free(words);
+    free(difficulty);
+    free(frequency);
+    free(list.entries);
+    return 0;
+}